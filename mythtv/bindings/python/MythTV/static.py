@@ -34,6 +34,8 @@ class MARKUP( object ):
     MARK_ASPECT_16_9      = 12
     MARK_ASPECT_2_21_1    = 13
     MARK_ASPECT_CUSTOM    = 14
+    MARK_DAMAGED_START    = 15
+    MARK_DAMAGED_END      = 16
     MARK_VIDEO_WIDTH      = 30
     MARK_VIDEO_HEIGHT     = 31
     MARK_VIDEO_RATE       = 32
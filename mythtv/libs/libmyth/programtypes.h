@@ -67,6 +67,8 @@ enum MarkTypes {
     MARK_ASPECT_16_9   = 12,
     MARK_ASPECT_2_21_1 = 13,
     MARK_ASPECT_CUSTOM = 14,
+    MARK_DAMAGED_START = 15, ///< first frame recorded after lost packets
+    MARK_DAMAGED_END   = 16, ///< keyframe the recording recovered at
     MARK_VIDEO_WIDTH   = 30,
     MARK_VIDEO_HEIGHT  = 31,
     MARK_VIDEO_RATE    = 32,
@@ -36,6 +36,8 @@ HEADERS += ../../external/qjsonwrapper/qjsonwrapper/Json.h
 HEADERS += cleanupguard.h portchecker.h
 HEADERS += mythsorthelper.h
 HEADERS += mythpower.h
+HEADERS += mythstartuptasks.h
+HEADERS += mythmetrics.h
 
 SOURCES += mthread.cpp mthreadpool.cpp
 SOURCES += mythsocket.cpp
@@ -59,6 +61,8 @@ SOURCES += ../../external/qjsonwrapper/qjsonwrapper/Json.cpp
 SOURCES += cleanupguard.cpp portchecker.cpp
 SOURCES += mythsorthelper.cpp
 SOURCES += mythpower.cpp
+SOURCES += mythstartuptasks.cpp
+SOURCES += mythmetrics.cpp
 
 using_qtdbus {
     QT      += dbus
@@ -95,7 +99,7 @@ inc.files += plist.h bswap.h signalhandling.h ffmpeg-mmx.h mythdate.h
 inc.files += mythplugin.h mythpluginapi.h mythqtcompat.h
 inc.files += remotefile.h mythsystemlegacy.h mythtypes.h
 inc.files += threadedfilewriter.h mythsingledownload.h mythsession.h
-inc.files += mythsorthelper.h
+inc.files += mythsorthelper.h mythstartuptasks.h mythmetrics.h
 
 # Allow both #include <blah.h> and #include <libmythbase/blah.h>
 inc2.path  = $${PREFIX}/include/mythtv/libmythbase
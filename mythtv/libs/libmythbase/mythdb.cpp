@@ -1,6 +1,10 @@
+#include <atomic>
+#include <memory>
 #include <vector>
 using namespace std;
 
+#include <QAtomicInt>
+#include <QElapsedTimer>
 #include <QReadWriteLock>
 #include <QTextStream>
 #include <QSqlError>
@@ -62,12 +66,19 @@ struct SingleSetting
 
 using SettingsMap = QHash<QString,QString>;
 
+/// Publish settings added to the cache at most this often
+static const qint64 kSnapshotIntervalMs = 250;
+
 class MythDBPrivate
 {
   public:
     MythDBPrivate();
    ~MythDBPrivate();
 
+    bool FindInSnapshot(const QString &Key, QString &Value) const;
+    void PublishSnapshot(bool Force = false);
+    void InvalidateSnapshot(void);
+
     DatabaseParams  m_dbParams;  ///< Current database host & WOL details
     QString m_localhostname;
     MDBManager m_dbmanager;
@@ -85,6 +96,18 @@ class MythDBPrivate
     /// available
     QList<SingleSetting> m_delayedSettings;
 
+    /// Immutable copy of m_settingsCache, read without m_settingsCacheLock
+    /// Only accessed with std::atomic_load() and std::atomic_store()
+    std::shared_ptr<const SettingsMap> m_snapshot;
+    /// Cleared to read through m_settingsCacheLock only, for comparison
+    volatile bool        m_useSnapshot    {true};
+    /// Whether m_settingsCache has entries that are not in m_snapshot
+    QAtomicInt           m_snapshotStale  {0};
+    QAtomicInteger<qint64> m_lastPublish  {0};
+    QElapsedTimer        m_clock;
+    /// Changed whenever a cached value may have changed
+    QAtomicInteger<uint> m_version        {1};
+
     bool m_haveDBConnection {false};
     bool m_haveSchema {false};
 };
@@ -95,6 +118,7 @@ MythDBPrivate::MythDBPrivate()
 {
     m_localhostname.clear();
     m_settingsCache.reserve(settings_reserve);
+    m_clock.start();
 }
 
 MythDBPrivate::~MythDBPrivate()
@@ -102,6 +126,68 @@ MythDBPrivate::~MythDBPrivate()
     LOG(VB_DATABASE, LOG_INFO, "Destroying MythDBPrivate");
 }
 
+/** \fn MythDBPrivate::FindInSnapshot(const QString&, QString&) const
+ *  \brief Look a setting up without taking any lock.
+ *
+ *   The snapshot is never changed once published.  The shared pointer is
+ *   loaded atomically and the lookup is done on that copy, which keeps a
+ *   replaced snapshot alive until the lookup has finished.
+ */
+bool MythDBPrivate::FindInSnapshot(const QString &Key, QString &Value) const
+{
+    if (!m_useSettingsCache || !m_useSnapshot)
+        return false;
+
+    std::shared_ptr<const SettingsMap> snapshot = std::atomic_load(&m_snapshot);
+    if (!snapshot)
+        return false;
+
+    SettingsMap::const_iterator it = snapshot->constFind(Key);
+    if (it == snapshot->constEnd())
+        return false;
+
+    Value = *it;
+    return true;
+}
+
+/** \fn MythDBPrivate::PublishSnapshot(bool)
+ *  \brief Replace the snapshot with a copy of the settings cache.
+ *
+ *   Settings that are not in the snapshot are still found under the lock, so
+ *   unless Force is set this only copies the cache every few hundred ms while
+ *   it is filling. Call without m_settingsCacheLock held.
+ */
+void MythDBPrivate::PublishSnapshot(bool Force)
+{
+    if (!m_useSettingsCache || !m_useSnapshot || !m_snapshotStale.loadAcquire())
+        return;
+    qint64 now = m_clock.elapsed();
+    if (!Force && now - m_lastPublish.loadAcquire() < kSnapshotIntervalMs &&
+        std::atomic_load(&m_snapshot))
+    {
+        return;
+    }
+
+    QWriteLocker locker(&m_settingsCacheLock);
+    if (!m_snapshotStale.loadAcquire())
+        return;
+
+    // QHash is implicitly shared, so the copy is made when the cache next
+    // changes, and the strings themselves are never copied
+    std::atomic_store(&m_snapshot, std::make_shared<const SettingsMap>(m_settingsCache));
+    m_snapshotStale.storeRelease(0);
+    m_lastPublish.storeRelease(now);
+}
+
+/// \brief Stop readers using the snapshot after a cached value has changed.
+/// Call with m_settingsCacheLock held for writing.
+void MythDBPrivate::InvalidateSnapshot(void)
+{
+    std::atomic_store(&m_snapshot, std::shared_ptr<const SettingsMap>());
+    m_snapshotStale.storeRelease(1);
+    m_version.fetchAndAddOrdered(1);
+}
+
 MythDB::MythDB()
 {
     d = new MythDBPrivate();
@@ -372,6 +458,9 @@ QString MythDB::GetSetting(const QString &_key, const QString &defaultval)
     QString key = _key.toLower();
     QString value = defaultval;
 
+    if (d->FindInSnapshot(key, value))
+        return value;
+
     d->m_settingsCacheLock.lockForRead();
     if (d->m_useSettingsCache)
     {
@@ -380,6 +469,7 @@ QString MythDB::GetSetting(const QString &_key, const QString &defaultval)
         {
             value = *it;
             d->m_settingsCacheLock.unlock();
+            d->PublishSnapshot();
             return value;
         }
     }
@@ -432,8 +522,12 @@ QString MythDB::GetSetting(const QString &_key, const QString &defaultval)
         // another thread may have inserted a value into the cache
         // while we did not have the lock, check first then save
         if (d->m_settingsCache.find(key) == d->m_settingsCache.end())
+        {
             d->m_settingsCache[key] = value;
+            d->m_snapshotStale.storeRelease(1);
+        }
         d->m_settingsCacheLock.unlock();
+        d->PublishSnapshot();
     }
 
     return value;
@@ -552,9 +646,11 @@ bool MythDB::GetSettings(QMap<QString,QString> &_key_value_pairs)
                 key.squeeze();
                 value.squeeze();
                 d->m_settingsCache[key] = value;
+                d->m_snapshotStale.storeRelease(1);
             }
         }
         d->m_settingsCacheLock.unlock();
+        d->PublishSnapshot();
     }
 
     return true;
@@ -623,6 +719,9 @@ QString MythDB::GetSettingOnHost(const QString &_key, const QString &_host,
     QString value = defaultval;
     QString myKey = host + ' ' + key;
 
+    if (d->FindInSnapshot(myKey, value))
+        return value;
+
     d->m_settingsCacheLock.lockForRead();
     if (d->m_useSettingsCache)
     {
@@ -631,6 +730,7 @@ QString MythDB::GetSettingOnHost(const QString &_key, const QString &_host,
         {
             value = *it;
             d->m_settingsCacheLock.unlock();
+            d->PublishSnapshot();
             return value;
         }
     }
@@ -676,8 +776,12 @@ QString MythDB::GetSettingOnHost(const QString &_key, const QString &_host,
         value.squeeze();
         d->m_settingsCacheLock.lockForWrite();
         if (d->m_settingsCache.find(myKey) == d->m_settingsCache.end())
+        {
             d->m_settingsCache[myKey] = value;
+            d->m_snapshotStale.storeRelease(1);
+        }
         d->m_settingsCacheLock.unlock();
+        d->PublishSnapshot();
     }
 
     return value;
@@ -817,6 +921,7 @@ void MythDB::OverrideSettingForSession(
     d->m_overriddenSettings[mk] = mv;
     d->m_settingsCache[mk]      = mv;
     d->m_settingsCache[mk2]     = mv;
+    d->InvalidateSnapshot();
     d->m_settingsCacheLock.unlock();
 }
 
@@ -840,6 +945,7 @@ void MythDB::ClearOverrideSettingForSession(const QString &key)
     if (sit != d->m_settingsCache.end())
         d->m_settingsCache.erase(sit);
 
+    d->InvalidateSnapshot();
     d->m_settingsCacheLock.unlock();
 }
 
@@ -897,9 +1003,24 @@ void MythDB::ClearSettingsCache(const QString &_key)
             clear(d->m_settingsCache, d->m_overriddenSettings, mkl);
     }
 
+    d->InvalidateSnapshot();
     d->m_settingsCacheLock.unlock();
 }
 
+/** \fn MythDB::GetSettingsVersion(void) const
+ *  \brief Return a number that changes whenever a cached setting may have.
+ *
+ *   This is 0 while the settings cache is not in use, as settings are then
+ *   read from the database every time.
+ *  \sa MythSettingHandle
+ */
+uint MythDB::GetSettingsVersion(void) const
+{
+    if (!d->m_useSettingsCache)
+        return 0;
+    return d->m_version.loadAcquire();
+}
+
 void MythDB::ActivateSettingsCache(bool activate)
 {
     if (activate)
@@ -911,6 +1032,16 @@ void MythDB::ActivateSettingsCache(bool activate)
     ClearSettingsCache();
 }
 
+/** \fn MythDB::ActivateSettingsSnapshot(bool)
+ *  \brief Whether cached settings are read from the lock free snapshot, or
+ *         only through the settings cache lock.  For measuring the snapshot.
+ */
+void MythDB::ActivateSettingsSnapshot(bool activate)
+{
+    d->m_useSnapshot = activate;
+    ClearSettingsCache();
+}
+
 void MythDB::WriteDelayedSettings(void)
 {
     if (!HaveValidDatabase())
@@ -1,6 +1,8 @@
 #ifndef MYTHDB_H_
 #define MYTHDB_H_
 
+#include <utility>
+
 #include <QMap>
 #include <QString>
 #include <QVariant>
@@ -38,6 +40,8 @@ class MBASE_PUBLIC MythDB
 
     void ClearSettingsCache(const QString &key = QString());
     void ActivateSettingsCache(bool activate = true);
+    void ActivateSettingsSnapshot(bool activate = true);
+    uint GetSettingsVersion(void) const;
     void OverrideSettingForSession(const QString &key, const QString &newValue);
     void ClearOverrideSettingForSession(const QString &key);
 
@@ -100,4 +104,65 @@ class MBASE_PUBLIC MythDB
  MBASE_PUBLIC  MythDB *GetMythDB();
  MBASE_PUBLIC  void DestroyMythDB();
 
+/** \class MythSettingHandle
+ *  \brief A setting that is looked up once, and again only when it changes.
+ *
+ *   Code that reads the same setting many times a second can keep one of
+ *   these instead of passing the key to MythDB each time.  The key is
+ *   lowercased once, and the value is kept until MythDB::GetSettingsVersion()
+ *   changes, so most calls to Get() are a single atomic load.
+ *
+ *   A handle caches its value without a lock, so each thread should use its
+ *   own, e.g. as a member of the object that needs the setting.
+ */
+template <typename T>
+class MythSettingHandle
+{
+  public:
+    MythSettingHandle(const QString &Key, T Default)
+      : m_key(Key.toLower()), m_default(std::move(Default)) {}
+
+    T Get(void)
+    {
+        MythDB *db = GetMythDB();
+        uint version = db->GetSettingsVersion();
+        if (!version || version != m_version)
+        {
+            m_value = Read(db);
+            m_version = version;
+        }
+        return m_value;
+    }
+
+    const QString &GetKey(void) const { return m_key; }
+
+  private:
+    T Read(MythDB *DB) const;
+
+    QString m_key;
+    T       m_default;
+    T       m_value   {};
+    uint    m_version {0};
+};
+
+template <> inline QString MythSettingHandle<QString>::Read(MythDB *DB) const
+{
+    return DB->GetSetting(m_key, m_default);
+}
+
+template <> inline int MythSettingHandle<int>::Read(MythDB *DB) const
+{
+    return DB->GetNumSetting(m_key, m_default);
+}
+
+template <> inline bool MythSettingHandle<bool>::Read(MythDB *DB) const
+{
+    return DB->GetBoolSetting(m_key, m_default);
+}
+
+template <> inline double MythSettingHandle<double>::Read(MythDB *DB) const
+{
+    return DB->GetFloatSetting(m_key, m_default);
+}
+
 #endif
@@ -0,0 +1,132 @@
+// C++ headers
+#include <algorithm>
+#include <utility>
+
+// Qt headers
+#include <QStringList>
+
+// MythTV headers
+#include "mythmetrics.h"
+
+QMutex             MythMetrics::s_lock;
+QList<MythMetric*> MythMetrics::s_metrics;
+
+MythMetric::MythMetric(QString name, QString help, Type type,
+                       MythMetricLabels labels)
+    : m_name(std::move(name)), m_help(std::move(help)), m_type(type),
+      m_labels(std::move(labels))
+{
+    MythMetrics::Register(this);
+}
+
+MythMetric::~MythMetric()
+{
+    MythMetrics::Unregister(this);
+}
+
+/// \brief Raises the value to at least value, for high-water marks.
+void MythMetric::SetMax(int64_t value)
+{
+    int64_t current = m_value.load(std::memory_order_relaxed);
+    while (current < value &&
+           !m_value.compare_exchange_weak(current, value,
+                                          std::memory_order_relaxed))
+        ;
+}
+
+/// \brief Replaces the labels, e.g. when a writer moves on to a new file.
+void MythMetric::SetLabels(const MythMetricLabels &labels)
+{
+    QMutexLocker locker(&MythMetrics::s_lock);
+    m_labels = labels;
+}
+
+void MythMetrics::Register(MythMetric *metric)
+{
+    QMutexLocker locker(&s_lock);
+    s_metrics.push_back(metric);
+}
+
+void MythMetrics::Unregister(MythMetric *metric)
+{
+    QMutexLocker locker(&s_lock);
+    s_metrics.removeOne(metric);
+}
+
+/** \fn MythMetrics::Snapshot(const QString&)
+ *  \brief Reads every metric whose name starts with prefix.
+ *  \return The samples, ordered by name and then by labels
+ */
+QList<MythMetrics::Sample> MythMetrics::Snapshot(const QString &prefix)
+{
+    QList<Sample> samples;
+    {
+        QMutexLocker locker(&s_lock);
+        for (const auto *metric : s_metrics)
+        {
+            if (!metric->m_name.startsWith(prefix))
+                continue;
+            Sample sample;
+            sample.m_name   = metric->m_name;
+            sample.m_help   = metric->m_help;
+            sample.m_type   = metric->m_type;
+            sample.m_labels = metric->m_labels;
+            sample.m_value  = metric->Value();
+            samples.push_back(sample);
+        }
+    }
+
+    std::stable_sort(samples.begin(), samples.end(),
+                     [](const Sample &a, const Sample &b)
+    {
+        if (a.m_name != b.m_name)
+            return a.m_name < b.m_name;
+        return a.m_labels.values() < b.m_labels.values();
+    });
+    return samples;
+}
+
+static QString escape_label(QString value)
+{
+    value.replace("\\", "\\\\");
+    value.replace("\"", "\\\"");
+    value.replace("\n", "\\n");
+    return value;
+}
+
+/** \fn MythMetrics::ToPrometheus(const QString&)
+ *  \brief Formats a snapshot in the Prometheus text exposition format.
+ *
+ *   Counters are totals, so rates such as bytes per second are left to
+ *   the collector, e.g. rate(mythtv_devicereadbuffer_bytes_total[1m]).
+ */
+QString MythMetrics::ToPrometheus(const QString &prefix)
+{
+    QString text;
+    QString last;
+    for (const auto &sample : Snapshot(prefix))
+    {
+        if (sample.m_name != last)
+        {
+            text += QString("# HELP %1 %2\n").arg(sample.m_name, sample.m_help);
+            text += QString("# TYPE %1 %2\n").arg(sample.m_name,
+                (sample.m_type == MythMetric::kCounter) ? "counter" : "gauge");
+            last = sample.m_name;
+        }
+
+        text += sample.m_name;
+        if (!sample.m_labels.isEmpty())
+        {
+            QStringList labels;
+            for (auto it = sample.m_labels.cbegin();
+                 it != sample.m_labels.cend(); ++it)
+            {
+                labels << QString("%1=\"%2\"")
+                    .arg(it.key(), escape_label(it.value()));
+            }
+            text += "{" + labels.join(",") + "}";
+        }
+        text += QString(" %1\n").arg(sample.m_value);
+    }
+    return text;
+}
@@ -0,0 +1,96 @@
+// -*- Mode: c++ -*-
+#ifndef MYTHMETRICS_H_
+#define MYTHMETRICS_H_
+
+#include <atomic>
+#include <cstdint>
+
+// Qt headers
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+
+// MythTV headers
+#include "mythbaseexp.h"
+
+using MythMetricLabels = QMap<QString,QString>;
+
+/** \class MythMetric
+ *  \brief A single live number, such as the bytes a recorder has read.
+ *
+ *   Updating a metric is one relaxed atomic operation, so it may be done
+ *   for every block a recorder reads or writes.  Each metric is normally
+ *   updated by the one thread that owns it, and only read by the registry
+ *   when a snapshot is taken.  The metric registers itself with
+ *   MythMetrics when it is created and is dropped when it is destroyed,
+ *   so it is usually held as a member of the object it measures.
+ */
+class MBASE_PUBLIC MythMetric
+{
+  public:
+    enum Type {
+        kCounter, ///< Only ever increases, e.g. bytes written
+        kGauge,   ///< May go up or down, e.g. buffer in use
+    };
+
+    MythMetric(QString name, QString help, Type type,
+               MythMetricLabels labels = MythMetricLabels());
+    ~MythMetric();
+
+    MythMetric(const MythMetric &) = delete;            // not copyable
+    MythMetric &operator=(const MythMetric &) = delete; // not copyable
+
+    void Add(int64_t value)
+        { m_value.fetch_add(value, std::memory_order_relaxed); }
+    void Set(int64_t value)
+        { m_value.store(value, std::memory_order_relaxed); }
+    void SetMax(int64_t value);
+    int64_t Value(void) const
+        { return m_value.load(std::memory_order_relaxed); }
+
+    void SetLabels(const MythMetricLabels &labels);
+
+    QString Name(void) const { return m_name; }
+    QString Help(void) const { return m_help; }
+    Type    GetType(void) const { return m_type; }
+
+  private:
+    friend class MythMetrics;
+
+    QString              m_name;
+    QString              m_help;
+    Type                 m_type;
+    MythMetricLabels     m_labels;  // protected by MythMetrics::s_lock
+    std::atomic<int64_t> m_value    {0};
+};
+
+/** \class MythMetrics
+ *  \brief The registry of every live MythMetric in the process.
+ */
+class MBASE_PUBLIC MythMetrics
+{
+  public:
+    struct Sample
+    {
+        QString          m_name;
+        QString          m_help;
+        MythMetric::Type m_type   {MythMetric::kCounter};
+        MythMetricLabels m_labels;
+        int64_t          m_value  {0};
+    };
+
+    static QList<Sample> Snapshot(const QString &prefix = QString());
+    static QString       ToPrometheus(const QString &prefix = QString());
+
+  private:
+    friend class MythMetric;
+
+    static void Register(MythMetric *metric);
+    static void Unregister(MythMetric *metric);
+
+    static QMutex             s_lock;
+    static QList<MythMetric*> s_metrics;
+};
+
+#endif
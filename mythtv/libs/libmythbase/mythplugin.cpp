@@ -90,7 +90,14 @@ void MythPlugin::destroy(void)
         rfunc();
 }
 
-MythPluginManager::MythPluginManager()
+/** \fn MythPluginManager::MythPluginManager(bool)
+ *  \brief Find and initialise the plugins.
+ *
+ *   If Deferred is true the plugins are only found here. Each is initialised
+ *   when it is first used, or by InitDeferred(), so that the caller can show
+ *   its UI before the plugins have registered their keys and jump points.
+ */
+MythPluginManager::MythPluginManager(bool Deferred)
 {
     QString pluginprefix = GetPluginsDir();
 
@@ -116,7 +123,10 @@ MythPluginManager::MythPluginManager()
             library = library.right(library.length() - prefixLength);
             library = library.left(library.length() - suffixLength);
 
-            init_plugin(library);
+            if (Deferred)
+                m_deferred.append(library);
+            else
+                init_plugin(library);
         }
     }
     else
@@ -126,6 +136,7 @@ MythPluginManager::MythPluginManager()
 
 bool MythPluginManager::init_plugin(const QString &plugname)
 {
+    m_deferred.removeAll(plugname);
     QString newname = FindPluginName(plugname);
 
     if (!m_dict[newname])
@@ -157,9 +168,51 @@ bool MythPluginManager::init_plugin(const QString &plugname)
     return true;
 }
 
+/// \brief Initialise a deferred plugin, returning false if it failed.
+bool MythPluginManager::InitIfDeferred(const QString &plugname)
+{
+    if (!m_deferred.contains(plugname))
+        return true;
+    return init_plugin(plugname);
+}
+
+/** \fn MythPluginManager::PreloadLibraries(const QStringList&)
+ *  \brief Load the plugin libraries without initialising them.
+ *
+ *   This is safe to call from any thread, and takes the time spent loading
+ *   and relocating the libraries away from the first use of each plugin.
+ */
+void MythPluginManager::PreloadLibraries(const QStringList &plugnames)
+{
+    foreach (const auto & plugname, plugnames)
+    {
+        QLibrary library(FindPluginName(plugname));
+        if (!library.load())
+        {
+            LOG(VB_GENERAL, LOG_WARNING, QString("Unable to load plugin '%1': %2")
+                .arg(plugname).arg(library.errorString()));
+        }
+    }
+}
+
+/// \brief Initialise the next deferred plugin, returning true if more remain.
+bool MythPluginManager::InitDeferred(void)
+{
+    if (!m_deferred.isEmpty())
+        init_plugin(m_deferred.first());
+    return !m_deferred.isEmpty();
+}
+
+/// \brief Whether the plugin is initialised, or found and not yet tried.
+bool MythPluginManager::IsAvailable(const QString &plugname)
+{
+    return m_deferred.contains(plugname) || GetPlugin(plugname);
+}
+
 // return false on success, true on error
 bool MythPluginManager::run_plugin(const QString &plugname)
 {
+    InitIfDeferred(plugname);
     QString newname = FindPluginName(plugname);
 
     if (!m_dict[newname] && !init_plugin(plugname))
@@ -178,6 +231,7 @@ bool MythPluginManager::run_plugin(const QString &plugname)
 // return false on success, true on error
 bool MythPluginManager::config_plugin(const QString &plugname)
 {
+    InitIfDeferred(plugname);
     QString newname = FindPluginName(plugname);
 
     if (!m_dict[newname] && !init_plugin(plugname))
@@ -195,6 +249,10 @@ bool MythPluginManager::config_plugin(const QString &plugname)
 
 bool MythPluginManager::destroy_plugin(const QString &plugname)
 {
+    // Nothing to do for a plugin that was never initialised
+    if (m_deferred.contains(plugname))
+        return true;
+
     QString newname = FindPluginName(plugname);
 
     if (!m_dict[newname] && !init_plugin(plugname))
@@ -211,6 +269,9 @@ bool MythPluginManager::destroy_plugin(const QString &plugname)
 
 MythPlugin *MythPluginManager::GetPlugin(const QString &plugname)
 {
+    if (!InitIfDeferred(plugname))
+        return nullptr;
+
     QString newname = FindPluginName(plugname);
 
     if (m_moduleMap.find(newname) == m_moduleMap.end())
@@ -229,11 +290,12 @@ void MythPluginManager::DestroyAllPlugins(void)
 
     m_dict.clear();
     m_moduleMap.clear();
+    m_deferred.clear();
 }
 
 QStringList MythPluginManager::EnumeratePlugins(void)
 {
-    QStringList ret;
+    QStringList ret = m_deferred;
     foreach (auto it, m_dict)
         ret << it->getName();
     return ret;
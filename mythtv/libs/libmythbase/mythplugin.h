@@ -7,6 +7,7 @@
 #include <QHash>
 #include <QLibrary>
 #include <QMap>
+#include <QStringList>
 
 // MythTV headers
 #include "mythbaseexp.h"
@@ -62,7 +63,7 @@ class MythPlugin : public QLibrary
 class MBASE_PUBLIC MythPluginManager
 {
   public:
-    MythPluginManager();
+    explicit MythPluginManager(bool Deferred = false);
    ~MythPluginManager() = default;
 
     bool init_plugin(const QString &plugname);
@@ -71,12 +72,20 @@ class MBASE_PUBLIC MythPluginManager
     bool destroy_plugin(const QString &plugname);
 
     MythPlugin *GetPlugin(const QString &plugname);
+    bool IsAvailable(const QString &plugname);
+
+    QStringList GetDeferredPlugins(void) const { return m_deferred; }
+    static void PreloadLibraries(const QStringList &plugnames);
+    bool InitDeferred(void);
 
     QStringList EnumeratePlugins(void);
     void DestroyAllPlugins();
 
   private:
+    bool InitIfDeferred(const QString &plugname);
+
     QHash<QString,MythPlugin*> m_dict;
+    QStringList m_deferred;
 
     QMap<QString, MythPlugin *> m_moduleMap;
 };
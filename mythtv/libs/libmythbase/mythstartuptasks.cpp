@@ -0,0 +1,173 @@
+// C++
+#include <utility>
+
+// Qt
+#include <QRunnable>
+
+// MythTV
+#include "mthreadpool.h"
+#include "mythlogging.h"
+#include "mythstartuptasks.h"
+
+#define LOC QString("Startup: ")
+
+class MythStartupRunnable : public QRunnable
+{
+  public:
+    MythStartupRunnable(MythStartupTasks *Parent, QString Name,
+                        MythStartupTasks::Task Work)
+      : m_parent(Parent), m_name(std::move(Name)), m_work(std::move(Work)) {}
+
+    void run(void) override
+    {
+        QElapsedTimer timer;
+        timer.start();
+        m_work();
+        m_parent->Finished(m_name, timer.elapsed());
+    }
+
+  private:
+    MythStartupTasks      *m_parent {nullptr};
+    QString                m_name;
+    MythStartupTasks::Task m_work;
+};
+
+MythStartupTasks::MythStartupTasks(QString Name)
+  : m_name(std::move(Name))
+{
+    m_total.start();
+}
+
+MythStartupTasks::~MythStartupTasks()
+{
+    // The tasks may use objects owned by the caller
+    WaitAll();
+}
+
+/// \brief Mark the start of a step run by the calling thread.
+void MythStartupTasks::Phase(const QString &Name)
+{
+    EndPhase();
+    m_phase = Name;
+    m_phaseTimer.start();
+}
+
+void MythStartupTasks::EndPhase(void)
+{
+    if (!m_phase.isEmpty())
+        m_phases.append(qMakePair(m_phase, m_phaseTimer.elapsed()));
+    m_phase.clear();
+}
+
+/** \fn MythStartupTasks::Start(const QString&, const Task&, const QStringList&)
+ *  \brief Run Work on the thread pool once the tasks named in After are done.
+ */
+void MythStartupTasks::Start(const QString &Name, const Task &Work,
+                             const QStringList &After)
+{
+    Pending task;
+    task.m_name  = Name;
+    task.m_work  = Work;
+    task.m_after = After;
+
+    {
+        QMutexLocker locker(&m_lock);
+        m_started.append(Name);
+        if (!IsDone(After))
+        {
+            m_waiting.append(task);
+            return;
+        }
+    }
+
+    Launch(task);
+}
+
+void MythStartupTasks::Launch(const Pending &Job)
+{
+    LOG(VB_GENERAL, LOG_DEBUG, LOC + QString("Starting '%1'").arg(Job.m_name));
+    MThreadPool::globalInstance()->start(
+        new MythStartupRunnable(this, Job.m_name, Job.m_work), "StartupTask");
+}
+
+void MythStartupTasks::Finished(const QString &Name, qint64 Elapsed)
+{
+    LOG(VB_GENERAL, LOG_DEBUG, LOC + QString("'%1' took %2ms")
+        .arg(Name).arg(Elapsed));
+
+    QList<Pending> ready;
+    {
+        QMutexLocker locker(&m_lock);
+        m_finished.insert(Name, Elapsed);
+        for (auto it = m_waiting.begin(); it != m_waiting.end(); )
+        {
+            if (IsDone(it->m_after))
+            {
+                ready.append(*it);
+                it = m_waiting.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (const auto & task : qAsConst(ready))
+        Launch(task);
+
+    QMutexLocker locker(&m_lock);
+    m_done.wakeAll();
+}
+
+/// \brief Whether all of the named tasks have finished. Call with m_lock held.
+bool MythStartupTasks::IsDone(const QStringList &Names) const
+{
+    for (const auto & name : qAsConst(Names))
+        if (!m_finished.contains(name))
+            return false;
+    return true;
+}
+
+/// \brief Block until the named task has finished, if it was started.
+void MythStartupTasks::Wait(const QString &Name)
+{
+    QMutexLocker locker(&m_lock);
+    while (m_started.contains(Name) && !m_finished.contains(Name))
+        m_done.wait(&m_lock);
+}
+
+void MythStartupTasks::WaitAll(void)
+{
+    QMutexLocker locker(&m_lock);
+    while (m_finished.size() < m_started.size())
+        m_done.wait(&m_lock);
+}
+
+/// \brief Log the time taken by each phase and task so far.
+void MythStartupTasks::Report(void)
+{
+    EndPhase();
+
+    QStringList phases;
+    for (const auto & phase : qAsConst(m_phases))
+        phases << QString("%1 %2ms").arg(phase.first).arg(phase.second);
+
+    QStringList tasks;
+    {
+        QMutexLocker locker(&m_lock);
+        for (const auto & name : qAsConst(m_started))
+        {
+            if (m_finished.contains(name))
+                tasks << QString("%1 %2ms").arg(name).arg(m_finished.value(name));
+            else
+                tasks << QString("%1 running").arg(name);
+        }
+    }
+
+    LOG(VB_GENERAL, LOG_INFO, LOC + QString("%1 ready in %2ms")
+        .arg(m_name).arg(m_total.elapsed()));
+    LOG(VB_GENERAL, LOG_INFO, LOC + "Phases: " + phases.join(", "));
+    if (!tasks.isEmpty())
+        LOG(VB_GENERAL, LOG_INFO, LOC + "In background: " + tasks.join(", "));
+}
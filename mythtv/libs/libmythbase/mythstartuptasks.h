@@ -0,0 +1,75 @@
+#ifndef MYTHSTARTUPTASKS_H_
+#define MYTHSTARTUPTASKS_H_
+
+// C++
+#include <functional>
+
+// Qt
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QStringList>
+#include <QWaitCondition>
+
+// MythTV
+#include "mythbaseexp.h"
+
+/** \class MythStartupTasks
+ *  \brief Runs the independent steps of program startup in parallel and
+ *         reports how long each took.
+ *
+ *   The program thread marks the steps it runs itself with Phase(). Steps
+ *   that do not need the UI thread, such as database queries and file
+ *   scans, are given to Start() and run on the global MThreadPool once the
+ *   tasks they depend on have finished. The program thread calls Wait()
+ *   before it uses the results of a task.
+ *
+ *   Report() logs the time spent in each phase and task.
+ */
+class MBASE_PUBLIC MythStartupTasks
+{
+  public:
+    using Task = std::function<void(void)>;
+
+    explicit MythStartupTasks(QString Name);
+   ~MythStartupTasks();
+
+    void Phase(const QString &Name);
+    void Start(const QString &Name, const Task &Work,
+               const QStringList &After = QStringList());
+    void Wait(const QString &Name);
+    void WaitAll(void);
+    void Report(void);
+
+  private:
+    Q_DISABLE_COPY(MythStartupTasks)
+    friend class MythStartupRunnable;
+
+    struct Pending
+    {
+        QString     m_name;
+        Task        m_work;
+        QStringList m_after;
+    };
+
+    void Launch(const Pending &Job);
+    void Finished(const QString &Name, qint64 Elapsed);
+    bool IsDone(const QStringList &Names) const;
+    void EndPhase(void);
+
+    QString                      m_name;
+    QElapsedTimer                m_total;
+    QElapsedTimer                m_phaseTimer;
+    QString                      m_phase;
+    QList<QPair<QString,qint64>> m_phases;
+
+    mutable QMutex               m_lock;
+    QWaitCondition               m_done;
+    QList<Pending>               m_waiting;
+    QStringList                  m_started;
+    QHash<QString,qint64>        m_finished;
+};
+
+#endif
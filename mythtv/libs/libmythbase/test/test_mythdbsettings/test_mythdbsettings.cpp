@@ -0,0 +1,173 @@
+/*
+ *  Class TestMythDBSettings
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <thread>
+#include <vector>
+
+#include "test_mythdbsettings.h"
+
+static const int kReaderThreads  = 8;
+static const int kReadsPerThread = 100000;
+
+// Settings are cached without a database by overriding them for the session
+void TestMythDBSettings::initTestCase(void)
+{
+    GetMythDB()->IgnoreDatabase(true);
+    GetMythDB()->SetLocalHostname("testhost");
+
+    // Roughly the settings a player reads while it is running
+    m_keys << "AudioOutputDevice" << "PassThruOutputDevice" << "MixerDevice"
+           << "MaxChannels" << "AudioDefaultUpmix" << "AdvancedAudioSettings"
+           << "SRCQualityOverride" << "PlayBoxOrdering" << "DecodeExtraAudio"
+           << "PlaybackExitPrompt" << "EndOfRecordingExitPrompt"
+           << "JumpToProgramOSD" << "ContinueEmbeddedTVPlay" << "AutomaticSetWatched"
+           << "ClearSavedPosition" << "AltClearSavedPosition"
+           << "UseProgStartMark" << "PlaybackWatchList" << "CommercialSkipMethod"
+           << "AutoCommercialSkip" << "CommRewindAmount" << "CommNotifyAmount"
+           << "MaximumCommercialSkip" << "MergeShortCommBreaks"
+           << "OSDGeneralTimeout" << "OSDProgramInfoTimeout" << "OSDFont"
+           << "EnableMHEG" << "EnableMHEGic" << "PersistentBrowseMode";
+    int value = 0;
+    for (const auto & key : qAsConst(m_keys))
+        GetMythDB()->OverrideSettingForSession(key, QString::number(++value));
+}
+
+void TestMythDBSettings::init(void)
+{
+    GetMythDB()->ActivateSettingsSnapshot(true);
+    GetMythDB()->ActivateSettingsCache(true);
+}
+
+void TestMythDBSettings::cleanupTestCase(void)
+{
+    DestroyMythDB();
+}
+
+void TestMythDBSettings::CachedValues(void)
+{
+    QCOMPARE(GetMythDB()->GetNumSetting("MaxChannels"), 4);
+    // Keys are not case sensitive, and the second read is from the snapshot
+    QCOMPARE(GetMythDB()->GetNumSetting("maxchannels"), 4);
+    QCOMPARE(GetMythDB()->GetSetting("MAXCHANNELS"), QString("4"));
+    QCOMPARE(GetMythDB()->GetNumSetting("NotASetting", 42), 42);
+}
+
+void TestMythDBSettings::OverrideReplacesCachedValue(void)
+{
+    GetMythDB()->OverrideSettingForSession("TestValue", "first");
+    QCOMPARE(GetMythDB()->GetSetting("TestValue"), QString("first"));
+    QCOMPARE(GetMythDB()->GetSetting("TestValue"), QString("first"));
+
+    GetMythDB()->OverrideSettingForSession("TestValue", "second");
+    QCOMPARE(GetMythDB()->GetSetting("TestValue"), QString("second"));
+
+    GetMythDB()->ClearOverrideSettingForSession("TestValue");
+    QCOMPARE(GetMythDB()->GetSetting("TestValue", "default"), QString("default"));
+}
+
+void TestMythDBSettings::VersionChanges(void)
+{
+    uint version = GetMythDB()->GetSettingsVersion();
+    QVERIFY(version != 0);
+
+    // Reading and caching new values does not change anything already read
+    (void)GetMythDB()->GetSetting("OSDFont");
+    QCOMPARE(GetMythDB()->GetSettingsVersion(), version);
+
+    GetMythDB()->ClearSettingsCache();
+    QVERIFY(GetMythDB()->GetSettingsVersion() != version);
+
+    GetMythDB()->ActivateSettingsCache(false);
+    QCOMPARE(GetMythDB()->GetSettingsVersion(), 0U);
+}
+
+void TestMythDBSettings::HandleFollowsChanges(void)
+{
+    MythSettingHandle<int> handle("TestHandle", 5);
+    QCOMPARE(handle.GetKey(), QString("testhandle"));
+    QCOMPARE(handle.Get(), 5);
+
+    GetMythDB()->OverrideSettingForSession("TestHandle", "7");
+    QCOMPARE(handle.Get(), 7);
+
+    // CLEAR_SETTINGS_CACHE clears the whole cache
+    GetMythDB()->ClearSettingsCache();
+    QCOMPARE(handle.Get(), 7);
+
+    GetMythDB()->ClearOverrideSettingForSession("TestHandle");
+    QCOMPARE(handle.Get(), 5);
+
+    MythSettingHandle<bool> flag("EnableMHEG", false);
+    QCOMPARE(flag.Get(), true);
+}
+
+void TestMythDBSettings::RunReaders(bool UseHandles)
+{
+    // QTest macros may only be used on this thread
+    std::vector<int> totals(kReaderThreads, 0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kReaderThreads; ++i)
+    {
+        threads.emplace_back([i, UseHandles, &totals]()
+        {
+            MythSettingHandle<int> handle("OSDGeneralTimeout", 0);
+            int total = 0;
+            for (int j = 0; j < kReadsPerThread; ++j)
+            {
+                if (UseHandles)
+                    total += handle.Get();
+                else
+                    total += GetMythDB()->GetNumSetting("OSDGeneralTimeout", 0);
+            }
+            totals[i] = total;
+        });
+    }
+    for (auto & thread : threads)
+        thread.join();
+    for (int total : totals)
+        QCOMPARE(total, kReadsPerThread * 25);
+}
+
+/// Many threads reading one cached setting through the snapshot
+void TestMythDBSettings::Snapshot_contended(void)
+{
+    (void)GetMythDB()->GetNumSetting("OSDGeneralTimeout");
+    QBENCHMARK {
+        RunReaders(false);
+    }
+}
+
+/// The same without the snapshot, so every read takes the cache lock
+void TestMythDBSettings::Locked_contended(void)
+{
+    GetMythDB()->ActivateSettingsSnapshot(false);
+    (void)GetMythDB()->GetNumSetting("OSDGeneralTimeout");
+    QBENCHMARK {
+        RunReaders(false);
+    }
+    GetMythDB()->ActivateSettingsSnapshot(true);
+}
+
+/// The same through handles, which only check the version
+void TestMythDBSettings::Handle_contended(void)
+{
+    QBENCHMARK {
+        RunReaders(true);
+    }
+}
+
+QTEST_APPLESS_MAIN(TestMythDBSettings)
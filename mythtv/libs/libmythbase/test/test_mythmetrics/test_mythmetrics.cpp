@@ -0,0 +1,126 @@
+/*
+ *  Class TestMythMetrics
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <thread>
+#include <vector>
+
+#include "test_mythmetrics.h"
+
+void TestMythMetrics::CounterAndGauge(void)
+{
+    MythMetric counter("test_counter_total", "A counter", MythMetric::kCounter);
+    counter.Add(5);
+    counter.Add(7);
+    QCOMPARE(counter.Value(), static_cast<int64_t>(12));
+
+    MythMetric gauge("test_gauge", "A gauge", MythMetric::kGauge);
+    gauge.Set(40);
+    gauge.Set(3);
+    QCOMPARE(gauge.Value(), static_cast<int64_t>(3));
+}
+
+void TestMythMetrics::HighWaterMark(void)
+{
+    MythMetric peak("test_peak", "A high-water mark", MythMetric::kGauge);
+    peak.SetMax(10);
+    peak.SetMax(4);
+    QCOMPARE(peak.Value(), static_cast<int64_t>(10));
+    peak.SetMax(11);
+    QCOMPARE(peak.Value(), static_cast<int64_t>(11));
+}
+
+void TestMythMetrics::RegistryFollowsLifetime(void)
+{
+    {
+        MythMetric metric("test_lifetime", "Short lived", MythMetric::kGauge);
+        QCOMPARE(MythMetrics::Snapshot("test_lifetime").size(), 1);
+    }
+    QCOMPARE(MythMetrics::Snapshot("test_lifetime").size(), 0);
+}
+
+void TestMythMetrics::SnapshotPrefixAndOrder(void)
+{
+    MythMetric b("test_order_b", "B", MythMetric::kGauge, {{"input", "2"}});
+    MythMetric a2("test_order_a", "A", MythMetric::kGauge, {{"input", "2"}});
+    MythMetric a1("test_order_a", "A", MythMetric::kGauge, {{"input", "1"}});
+    MythMetric other("other_order", "Other", MythMetric::kGauge);
+
+    QList<MythMetrics::Sample> samples = MythMetrics::Snapshot("test_order_");
+    QCOMPARE(samples.size(), 3);
+    QCOMPARE(samples[0].m_name, QString("test_order_a"));
+    QCOMPARE(samples[0].m_labels["input"], QString("1"));
+    QCOMPARE(samples[1].m_name, QString("test_order_a"));
+    QCOMPARE(samples[1].m_labels["input"], QString("2"));
+    QCOMPARE(samples[2].m_name, QString("test_order_b"));
+}
+
+void TestMythMetrics::PrometheusFormat(void)
+{
+    MythMetric bytes("test_prom_bytes_total", "Bytes read",
+                     MythMetric::kCounter, {{"device", "/dev/dvb/adapter0"}});
+    MythMetric quoted("test_prom_bytes_total", "Bytes read",
+                      MythMetric::kCounter, {{"device", "a\"b\\c"}});
+    MythMetric peak("test_prom_peak", "Peak", MythMetric::kGauge);
+    bytes.Add(188);
+    quoted.Add(376);
+    peak.Set(-1);
+
+    QString expected =
+        "# HELP test_prom_bytes_total Bytes read\n"
+        "# TYPE test_prom_bytes_total counter\n"
+        "test_prom_bytes_total{device=\"/dev/dvb/adapter0\"} 188\n"
+        "test_prom_bytes_total{device=\"a\\\"b\\\\c\"} 376\n"
+        "# HELP test_prom_peak Peak\n"
+        "# TYPE test_prom_peak gauge\n"
+        "test_prom_peak -1\n";
+    QCOMPARE(MythMetrics::ToPrometheus("test_prom_"), expected);
+
+    bytes.SetLabels({{"device", "renamed"}});
+    QVERIFY(MythMetrics::ToPrometheus("test_prom_")
+            .contains("test_prom_bytes_total{device=\"renamed\"} 188\n"));
+}
+
+void TestMythMetrics::ConcurrentAdds(void)
+{
+    static const int kThreads = 8;
+    static const int kAdds    = 100000;
+
+    MythMetric counter("test_concurrent_total", "Contended",
+                       MythMetric::kCounter);
+    MythMetric peak("test_concurrent_peak", "Contended peak",
+                    MythMetric::kGauge);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; t++)
+    {
+        threads.emplace_back([&counter, &peak, t]()
+        {
+            for (int i = 0; i < kAdds; i++)
+            {
+                counter.Add(1);
+                peak.SetMax((t * kAdds) + i);
+            }
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    QCOMPARE(counter.Value(), static_cast<int64_t>(kThreads) * kAdds);
+    QCOMPARE(peak.Value(), static_cast<int64_t>((kThreads * kAdds) - 1));
+}
+
+QTEST_APPLESS_MAIN(TestMythMetrics)
@@ -10,6 +10,7 @@
 #include <unistd.h>
 
 // Qt headers
+#include <QFileInfo>
 #include <QString>
 
 // MythTV headers
@@ -78,8 +79,18 @@ bool ThreadedFileWriter::ReOpen(const QString& newFilename)
     }
 
     if (!newFilename.isEmpty())
+    {
         m_filename = newFilename;
 
+        MythMetricLabels labels = MetricLabels();
+        m_bytesMetric.SetLabels(labels);
+        m_droppedMetric.SetLabels(labels);
+        m_bufferPeakMetric.SetLabels(labels);
+        m_writesMetric.SetLabels(labels);
+        m_writeTimeMetric.SetLabels(labels);
+        m_writePeakMetric.SetLabels(labels);
+    }
+
     m_bufLock.unlock();
 
     return Open();
@@ -195,7 +206,10 @@ int ThreadedFileWriter::Write(const void *data, uint count)
     QMutexLocker locker(&m_bufLock);
 
     if (m_ignoreWrites)
+    {
+        m_droppedMetric.Add(count);
         return -1;
+    }
 
     uint written    = 0;
     uint left       = count;
@@ -216,6 +230,7 @@ int ThreadedFileWriter::Write(const void *data, uint count)
                     "\n\t\t\tis insufficient to deal with the number of on-going "
                     "\n\t\t\trecordings, or you have a disk failure.");
                 m_ignoreWrites = true;
+                m_droppedMetric.Add(left);
                 return -1;
             }
             if (!m_warned)
@@ -261,6 +276,7 @@ int ThreadedFileWriter::Write(const void *data, uint count)
         }
 
         m_totalBufferUse += towrite;
+        m_bufferPeakMetric.SetMax(m_totalBufferUse);
 
         const char *cdata = (const char*) data + written;
         buf->data.insert(buf->data.end(), cdata, cdata+towrite);
@@ -519,6 +535,7 @@ void ThreadedFileWriter::DiskLoop(void)
             {
                 tot += ret;
                 total_written += ret;
+                m_bytesMetric.Add(ret);
                 LOG(VB_FILE, LOG_DEBUG, LOC +
                     QString("total written so far: %1 bytes")
                     .arg(total_written));
@@ -539,6 +556,11 @@ void ThreadedFileWriter::DiskLoop(void)
             lastRegisterTimer.restart();
         }
 
+        int64_t usecs = writeTimer.nsecsElapsed() / 1000;
+        m_writesMetric.Add(1);
+        m_writeTimeMetric.Add(usecs);
+        m_writePeakMetric.SetMax(usecs);
+
         buf->lastUsed = MythDate::current();
         m_emptyBuffers.push_back(buf);
 
@@ -583,6 +605,14 @@ void ThreadedFileWriter::DiskLoop(void)
     }
 }
 
+/// \brief Labels the metrics with the name of the file being written.
+MythMetricLabels ThreadedFileWriter::MetricLabels(void) const
+{
+    MythMetricLabels labels;
+    labels["file"] = QFileInfo(m_filename).fileName();
+    return labels;
+}
+
 void ThreadedFileWriter::TrimEmptyBuffers(void)
 {
     QDateTime cur = MythDate::current();
@@ -16,6 +16,7 @@ using namespace std;
 
 // MythTV headers
 #include "mythbaseexp.h"
+#include "mythmetrics.h"
 #include "mthread.h"
 
 class ThreadedFileWriter;
@@ -69,6 +70,7 @@ class MBASE_PUBLIC ThreadedFileWriter
     void DiskLoop(void);
     void SyncLoop(void);
     void TrimEmptyBuffers(void);
+    MythMetricLabels MetricLabels(void) const;
 
   private:
     // file info
@@ -115,6 +117,26 @@ class MBASE_PUBLIC ThreadedFileWriter
     bool m_warned                        {false};
     bool m_blocking                      {false};
     bool m_registered                    {false};
+
+    // live metrics, labelled with the file name
+    MythMetric m_bytesMetric      {"mythtv_filewriter_bytes_total",
+                                   "Bytes written to disk",
+                                   MythMetric::kCounter, MetricLabels()};
+    MythMetric m_droppedMetric    {"mythtv_filewriter_dropped_bytes_total",
+                                   "Bytes discarded because writes failed",
+                                   MythMetric::kCounter, MetricLabels()};
+    MythMetric m_bufferPeakMetric {"mythtv_filewriter_buffer_peak_bytes",
+                                   "Most bytes waiting to be written",
+                                   MythMetric::kGauge, MetricLabels()};
+    MythMetric m_writesMetric     {"mythtv_filewriter_writes_total",
+                                   "Buffers written to disk",
+                                   MythMetric::kCounter, MetricLabels()};
+    MythMetric m_writeTimeMetric  {"mythtv_filewriter_write_microseconds_total",
+                                   "Time spent writing buffers to disk",
+                                   MythMetric::kCounter, MetricLabels()};
+    MythMetric m_writePeakMetric  {"mythtv_filewriter_write_peak_microseconds",
+                                   "Longest time taken to write a buffer",
+                                   MythMetric::kGauge, MetricLabels()};
 };
 
 #endif
@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: metric.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef METRIC_H_
+#define METRIC_H_
+
+#include <QString>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC Metric : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version"    , "1.0" );
+
+    Q_PROPERTY( QString    Name            READ Name
+                                           WRITE setName        )
+    Q_PROPERTY( QString    Type            READ Type
+                                           WRITE setType        )
+    Q_PROPERTY( QString    Description     READ Description
+                                           WRITE setDescription )
+    Q_PROPERTY( QString    Labels          READ Labels
+                                           WRITE setLabels      )
+    Q_PROPERTY( qlonglong  Value           READ Value
+                                           WRITE setValue       )
+
+    PROPERTYIMP( QString  , Name        )
+    PROPERTYIMP( QString  , Type        )
+    PROPERTYIMP( QString  , Description )
+    PROPERTYIMP( QString  , Labels      )
+    PROPERTYIMP( qlonglong, Value       );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE Metric(QObject *parent = nullptr)
+            : QObject       ( parent ),
+              m_Name        (       ),
+              m_Type        (       ),
+              m_Description (       ),
+              m_Labels      (       ),
+              m_Value       ( 0     )
+        {
+        }
+
+        void Copy( const Metric *src )
+        {
+            m_Name        = src->m_Name        ;
+            m_Type        = src->m_Type        ;
+            m_Description = src->m_Description ;
+            m_Labels      = src->m_Labels      ;
+            m_Value       = src->m_Value       ;
+        }
+
+    private:
+        Q_DISABLE_COPY(Metric);
+};
+
+inline void Metric::InitializeCustomTypes()
+{
+    qRegisterMetaType< Metric* >();
+}
+
+} // namespace DTC
+
+#endif
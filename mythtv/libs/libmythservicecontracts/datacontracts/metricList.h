@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////
+// Program Name: metricList.h
+//
+// Licensed under the GPL v2 or later, see COPYING for details
+//
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef METRICLIST_H_
+#define METRICLIST_H_
+
+#include <QDateTime>
+#include <QVariantList>
+
+#include "serviceexp.h"
+#include "datacontracthelper.h"
+
+#include "metric.h"
+
+namespace DTC
+{
+
+class SERVICE_PUBLIC MetricList : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO( "version", "1.0" );
+
+    // Q_CLASSINFO Used to augment Metadata for properties.
+    // See datacontracthelper.h for details
+
+    Q_CLASSINFO( "Metrics", "type=DTC::Metric");
+
+    Q_PROPERTY( QDateTime    AsOf     READ AsOf     WRITE setAsOf   )
+    Q_PROPERTY( QVariantList Metrics  READ Metrics  DESIGNABLE true )
+
+    PROPERTYIMP       ( QDateTime   , AsOf    )
+    PROPERTYIMP_RO_REF( QVariantList, Metrics );
+
+    public:
+
+        static inline void InitializeCustomTypes();
+
+        Q_INVOKABLE MetricList(QObject *parent = nullptr)
+            : QObject( parent )
+        {
+        }
+
+        void Copy( const MetricList *src )
+        {
+            m_AsOf = src->m_AsOf;
+
+            CopyListContents< Metric >( this, m_Metrics, src->m_Metrics );
+        }
+
+        Metric *AddNewMetric()
+        {
+            // We must make sure the object added to the QVariantList has
+            // a parent of 'this'
+
+            Metric *pObject = new Metric( this );
+            m_Metrics.append( QVariant::fromValue<QObject *>( pObject ));
+
+            return pObject;
+        }
+
+    private:
+        Q_DISABLE_COPY(MetricList);
+};
+
+inline void MetricList::InitializeCustomTypes()
+{
+    qRegisterMetaType< MetricList* >();
+
+    Metric::InitializeCustomTypes();
+}
+
+} // namespace DTC
+
+#endif
@@ -62,6 +62,7 @@ HEADERS += datacontracts/backendInfo.h           datacontracts/envInfo.h
 HEADERS += datacontracts/buildInfo.h             datacontracts/logInfo.h
 HEADERS += datacontracts/genre.h                 datacontracts/genreList.h
 HEADERS += datacontracts/musicMetadataInfo.h     datacontracts/musicMetadataInfoList.h
+HEADERS += datacontracts/metric.h                datacontracts/metricList.h
 
 HEADERS += enums/recStatus.h
 
@@ -123,6 +124,7 @@ incDatacontracts.files += datacontracts/recRuleFilter.h       datacontracts/recR
 incDatacontracts.files += datacontracts/castMember.h          datacontracts/castMemberList.h
 incDatacontracts.files += datacontracts/enum.h                datacontracts/enumItem.h
 incDatacontracts.files += datacontracts/cutting.h             datacontracts/cutList.h
+incDatacontracts.files += datacontracts/metric.h              datacontracts/metricList.h
 incDatacontracts.files += datacontracts/backendInfo.h         datacontracts/envInfo.h
 incDatacontracts.files += datacontracts/buildInfo.h           datacontracts/logInfo.h
 
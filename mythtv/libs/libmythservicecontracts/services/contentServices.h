@@ -39,8 +39,9 @@
 class SERVICE_PUBLIC ContentServices : public Service  //, public QScriptable ???
 {
     Q_OBJECT
-    Q_CLASSINFO( "version"    , "2.0" );
+    Q_CLASSINFO( "version"    , "2.2" );
     Q_CLASSINFO( "DownloadFile_Method",            "POST" )
+    Q_CLASSINFO( "SetLiveStreamPlayhead_Method",   "POST" )
 
     public:
 
@@ -99,6 +100,10 @@ class SERVICE_PUBLIC ContentServices : public Service  //, public QScriptable ??
                                                           int              ChanId,
                                                           const QDateTime &StartTime ) = 0;
 
+        virtual QFileInfo           GetTrickplayIndex   ( int              RecordedId,
+                                                          int              ChanId,
+                                                          const QDateTime &StartTime ) = 0;
+
         virtual QFileInfo           GetMusic            ( int Id ) = 0;
         virtual QFileInfo           GetVideo            ( int Id ) = 0;
 
@@ -141,6 +146,9 @@ class SERVICE_PUBLIC ContentServices : public Service  //, public QScriptable ??
 
         virtual DTC::LiveStreamInfo     *StopLiveStream         ( int Id ) = 0;
         virtual bool                     RemoveLiveStream       ( int Id ) = 0;
+
+        virtual bool                     SetLiveStreamPlayhead  ( int Id,
+                                                                  int Segment ) = 0;
 };
 
 #endif
@@ -25,12 +25,19 @@
 // C headers
 #include <cstdio>
 
+// C++ headers
+#include <algorithm>
+
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QIODevice>
+#include <QMutex>
 #include <QRunnable>
+#include <QThread>
 #include <QUrl>
+#include <QVector>
+#include <QWaitCondition>
 #include <utility>
 
 #include "mythcorecontext.h"
@@ -39,6 +46,7 @@
 #include "mythtimer.h"
 #include "mthreadpool.h"
 #include "mythsystemlegacy.h"
+#include "programinfo.h"
 #include "exitcodes.h"
 #include "mythlogging.h"
 #include "storagegroup.h"
@@ -93,6 +101,251 @@ class HTTPLiveStreamThread : public QRunnable
 };
 
 
+class HTTPLiveStreamParallelThread;
+
+/** \class HTTPLiveStreamSegmentJob
+ *  \brief QRunnable class for running mythtranscode on a range of segments
+ *         of a HTTP Live Stream.
+ */
+class HTTPLiveStreamSegmentJob : public QRunnable
+{
+  public:
+    HTTPLiveStreamSegmentJob(HTTPLiveStreamParallelThread *parent,
+                             int streamid, uint16_t first, uint16_t last)
+      : m_parent(parent), m_streamID(streamid),
+        m_first(first), m_last(last) {}
+
+    void run(void) override; // QRunnable
+
+  private:
+    HTTPLiveStreamParallelThread *m_parent;
+    int      m_streamID;
+    uint16_t m_first;
+    uint16_t m_last;
+};
+
+/** \class HTTPLiveStreamParallelThread
+ *  \brief QRunnable class for transcoding a HTTP Live Stream with several
+ *         mythtranscode processes at once.
+ *
+ *  The stream is split into jobs of "HTTPLiveStreamSegmentsPerJob"
+ *  segments.  Each job seeks to its first segment, and up to
+ *  "HTTPLiveStreamParallelJobs" jobs run at the same time.  The job
+ *  holding the segment nearest to the client's playhead is always started
+ *  next, so a client seeking ahead only waits for the segments it is
+ *  about to play.  Segments are added to the playlists once they and
+ *  every segment before them are complete.
+ */
+class HTTPLiveStreamParallelThread : public QRunnable
+{
+  public:
+    HTTPLiveStreamParallelThread(int streamid, int jobs, uint16_t segments)
+      : m_streamID(streamid), m_maxJobs(jobs), m_segmentCount(segments) {}
+
+    void run(void) override; // QRunnable
+
+    void JobDone(bool ok)
+    {
+        QMutexLocker locker(&m_lock);
+        --m_running;
+        if (!ok)
+            m_failed = true;
+        m_wait.wakeAll();
+    }
+
+  private:
+    void StartJob(MThreadPool &pool, uint16_t first, uint16_t jobSize);
+
+    int            m_streamID;
+    int            m_maxJobs;
+    uint16_t       m_segmentCount;
+    QMutex         m_lock;
+    QWaitCondition m_wait;
+    int            m_running {0};
+    bool           m_failed  {false};
+};
+
+void HTTPLiveStreamSegmentJob::run(void)
+{
+    uint flags = kMSDontBlockInputDevs;
+
+    QString command = GetAppBinDir() +
+        QString("mythtranscode --hls --hlsstreamid %1 --hlssegments %2-%3")
+                .arg(m_streamID).arg(m_first).arg(m_last) + logPropagateArgs;
+
+    uint result = myth_system(command, flags);
+
+    if (result != GENERIC_EXIT_OK)
+    {
+        LOG(VB_GENERAL, LOG_WARNING, SLOC +
+            QString("Command '%1' returned %2")
+                .arg(command).arg(result));
+    }
+
+    m_parent->JobDone(result == GENERIC_EXIT_OK);
+}
+
+void HTTPLiveStreamParallelThread::StartJob(MThreadPool &pool, uint16_t first,
+                                            uint16_t jobSize)
+{
+    // The last job runs to the end of the file, in case the duration
+    // the segment count was estimated from is short.
+    uint16_t last = 0;
+    if (first + jobSize <= m_segmentCount)
+        last = first + jobSize - 1;
+
+    {
+        QMutexLocker locker(&m_lock);
+        ++m_running;
+    }
+    pool.start(new HTTPLiveStreamSegmentJob(this, m_streamID, first, last),
+               QString("HLSSegments%1").arg(first));
+}
+
+void HTTPLiveStreamParallelThread::run(void)
+{
+    HTTPLiveStream hls(m_streamID);
+    auto jobSize = (uint16_t)std::max(1,
+        gCoreContext->GetNumSetting("HTTPLiveStreamSegmentsPerJob", 3));
+
+    QList<uint16_t> pending;
+    for (uint seg = 1; seg <= m_segmentCount; seg += jobSize)
+        pending << seg;
+
+    MThreadPool pool("HTTPLiveStreamJobs");
+    pool.setMaxThreadCount(m_maxJobs);
+
+    // The first job sizes the output and writes the HTML page and the
+    // meta playlist, the others can only start once it is running.
+    StartJob(pool, pending.takeFirst(), jobSize);
+
+    MythTimer startTimer;
+    startTimer.start();
+    HTTPLiveStreamStatus status = hls.GetDBStatus();
+    while (((status == kHLSStatusQueued) || (status == kHLSStatusStarting)) &&
+           (startTimer.elapsed() < 60000))
+    {
+        {
+            QMutexLocker locker(&m_lock);
+            if (!m_running)
+                break;
+            m_wait.wait(&m_lock, 250);
+        }
+        status = hls.GetDBStatus();
+    }
+
+    if (status != kHLSStatusRunning)
+    {
+        LOG(VB_GENERAL, LOG_ERR, SLOC_ERR +
+            QString("Stream %1 failed to start").arg(m_streamID));
+        pool.waitForDone();
+        if (hls.GetDBStatus() != kHLSStatusStopping)
+        {
+            hls.UpdateStatus(kHLSStatusErrored);
+            hls.UpdateStatusMessage("Transcoding Errored");
+        }
+        return;
+    }
+
+    hls.LoadFromDB();
+    hls.WriteEventPlaylist(0);
+    if (hls.GetAudioOnlyBitrate())
+        hls.WriteEventPlaylist(0, true);
+
+    QVector<bool> complete(m_segmentCount + 1, false);
+    uint16_t completed = 0;
+    uint16_t available = 0;
+    bool stopped = false;
+
+    while (true)
+    {
+        m_lock.lock();
+        if (!m_failed && !stopped && !pending.isEmpty() &&
+            (m_running < m_maxJobs))
+        {
+            m_lock.unlock();
+
+            // Start with the job holding the client's playhead, or the
+            // first one after it.  Once everything after the playhead is
+            // queued, fill in backwards from the end.
+            uint16_t playhead = std::max(hls.GetPlayheadSegment(),
+                                         (uint16_t)1);
+            int next = pending.size() - 1;
+            for (int i = 0; i < pending.size(); ++i)
+            {
+                if (pending[i] + jobSize > playhead)
+                {
+                    next = i;
+                    break;
+                }
+            }
+            StartJob(pool, pending.takeAt(next), jobSize);
+            continue;
+        }
+        bool done = (m_running == 0) &&
+                    (pending.isEmpty() || m_failed || stopped);
+        if (!done)
+            m_wait.wait(&m_lock, 1000);
+        m_lock.unlock();
+
+        for (uint16_t seg = 1; seg <= m_segmentCount; ++seg)
+        {
+            if (!complete[seg] && hls.IsSegmentComplete(seg))
+            {
+                complete[seg] = true;
+                ++completed;
+            }
+        }
+        uint16_t listed = available;
+        while ((available < m_segmentCount) && complete[available + 1])
+            ++available;
+
+        // Clients only ever see segments that are complete
+        if (available != listed)
+        {
+            hls.WriteEventPlaylist(available);
+            if (hls.GetAudioOnlyBitrate())
+                hls.WriteEventPlaylist(available, true);
+        }
+        hls.UpdateCompletedSegments(available);
+        hls.UpdatePercentComplete(completed * 100 / m_segmentCount);
+
+        if (done)
+            break;
+
+        if (!stopped && hls.CheckStop())
+            stopped = true;
+    }
+
+    pool.waitForDone();
+
+    if (stopped)
+    {
+        hls.UpdateStatus(kHLSStatusStopped);
+        hls.UpdateStatusMessage("Transcoding Stopped");
+    }
+    else if (m_failed)
+    {
+        hls.UpdateStatus(kHLSStatusErrored);
+        hls.UpdateStatusMessage("Transcoding Errored");
+    }
+    else
+    {
+        // The segment count was estimated, list what was really written.
+        uint16_t count = available;
+        while (hls.IsSegmentComplete(count + 1))
+            ++count;
+        hls.WriteEventPlaylist(count, false, true);
+        if (hls.GetAudioOnlyBitrate())
+            hls.WriteEventPlaylist(count, true, true);
+        hls.UpdateCompletedSegments(count);
+        hls.UpdateStatus(kHLSStatusCompleted);
+        hls.UpdateStatusMessage("Transcoding Completed");
+        hls.UpdatePercentComplete(100);
+    }
+}
+
+
 HTTPLiveStream::HTTPLiveStream(QString srcFile, uint16_t width, uint16_t height,
                                uint32_t bitrate, uint32_t abitrate,
                                uint16_t maxSegments, uint16_t segmentSize,
@@ -155,7 +408,7 @@ HTTPLiveStream::HTTPLiveStream(int streamid)
 
 HTTPLiveStream::~HTTPLiveStream()
 {
-    if (m_writing)
+    if (m_writing && !m_segmentJob)
     {
         WritePlaylist(false, true);
         if (m_audioOnlyBitrate)
@@ -200,6 +453,9 @@ QString HTTPLiveStream::GetFilename(uint16_t segmentNumber, bool fileOnly,
 
 QString HTTPLiveStream::GetCurrentFilename(bool audioOnly, bool encoded) const
 {
+    if (m_segmentJob)
+        return GetFilename(m_curSegment, false, audioOnly, encoded) + ".tmp";
+
     return GetFilename(m_curSegment, false, audioOnly, encoded);
 }
 
@@ -337,6 +593,132 @@ bool HTTPLiveStream::AddSegment(void)
     return true;
 }
 
+/** \fn HTTPLiveStream::StartSegmentJob(uint16_t)
+ *  \brief Write segments starting at \p firstSegment for a parallel transcode.
+ *
+ *  Segment jobs write to a temporary file which CompleteSegment() renames,
+ *  so the coordinating thread can tell a finished segment from one still
+ *  being written.  Status, playlists and segment counts are left to the
+ *  coordinating thread.
+ */
+void HTTPLiveStream::StartSegmentJob(uint16_t firstSegment)
+{
+    m_segmentJob = true;
+    m_curSegment = firstSegment;
+}
+
+bool HTTPLiveStream::CompleteSegment(uint16_t segmentNumber)
+{
+    if (!m_segmentJob)
+        return false;
+
+    bool ok = true;
+    for (bool audioOnly : { false, true })
+    {
+        if (audioOnly && m_audioOutFile.isEmpty())
+            continue;
+
+        QString outFile = GetFilename(segmentNumber, false, audioOnly);
+        QString tmpFile = outFile + ".tmp";
+
+        // The audio only stream is optional
+        if (audioOnly && !QFile::exists(tmpFile))
+            continue;
+
+        if(rename(tmpFile.toLocal8Bit().constData(),
+                  outFile.toLocal8Bit().constData()) == -1)
+        {
+            LOG(VB_RECORD, LOG_ERR, LOC +
+                QString("Error renaming %1 to %2").arg(tmpFile).arg(outFile) +
+                ENO);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+bool HTTPLiveStream::NextSegment(void)
+{
+    if (!m_segmentJob)
+        return AddSegment();
+
+    ++m_curSegment;
+    return true;
+}
+
+bool HTTPLiveStream::IsSegmentComplete(uint16_t segmentNumber) const
+{
+    return QFile::exists(GetFilename(segmentNumber));
+}
+
+bool HTTPLiveStream::UpdateCompletedSegments(uint16_t count)
+{
+    if (m_streamid == -1)
+        return false;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(
+        "UPDATE livestream "
+        "SET startsegment = 1, segmentcount = :COUNT "
+        "WHERE id = :STREAMID; ");
+    query.bindValue(":COUNT", count);
+    query.bindValue(":STREAMID", m_streamid);
+
+    if (query.exec())
+    {
+        m_startSegment = 1;
+        m_segmentCount = count;
+        return true;
+    }
+
+    LOG(VB_GENERAL, LOG_ERR, LOC +
+        QString("Unable to update segment count for streamid %1")
+                .arg(m_streamid));
+    return false;
+}
+
+/** \fn HTTPLiveStream::GetPlayheadSegment(void) const
+ *  \brief Returns the segment the client last reported playing.
+ *
+ *  Parallel transcodes have no single current segment, so the
+ *  currentsegment column holds the client's playhead instead.
+ */
+uint16_t HTTPLiveStream::GetPlayheadSegment(void) const
+{
+    if (m_streamid == -1)
+        return 0;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(
+        "SELECT currentsegment FROM livestream "
+        "WHERE id = :STREAMID; ");
+    query.bindValue(":STREAMID", m_streamid);
+
+    if (!query.exec() || !query.next())
+        return 0;
+
+    return query.value(0).toUInt();
+}
+
+bool HTTPLiveStream::SetPlayheadSegment(int id, uint16_t segmentNumber)
+{
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare(
+        "UPDATE livestream "
+        "SET currentsegment = :SEGMENT "
+        "WHERE id = :STREAMID; ");
+    query.bindValue(":SEGMENT", segmentNumber);
+    query.bindValue(":STREAMID", id);
+
+    if (query.exec() && query.numRowsAffected())
+        return true;
+
+    LOG(VB_GENERAL, LOG_ERR, SLOC +
+        QString("Unable to set playhead for streamid %1").arg(id));
+    return false;
+}
+
 QString HTTPLiveStream::GetHTMLPageName(void) const
 {
     if (m_streamid == -1)
@@ -499,6 +881,63 @@ bool HTTPLiveStream::WritePlaylist(bool audioOnly, bool writeEndTag)
     return true;
 }
 
+/** \fn HTTPLiveStream::WriteEventPlaylist(uint16_t, bool, bool)
+ *  \brief Write a playlist listing the first \p segmentCount segments.
+ *
+ *   Used by parallel transcodes, where segments complete out of order.
+ *   Only segments that are complete, and all those before them, may be
+ *   listed.  The playlist only grows, so it is an EVENT playlist until
+ *   \p writeEndTag marks the stream as finished.
+ */
+bool HTTPLiveStream::WriteEventPlaylist(uint16_t segmentCount, bool audioOnly,
+                                        bool writeEndTag)
+{
+    if (m_streamid == -1)
+        return false;
+
+    QString outFile = GetPlaylistName(audioOnly);
+    QString tmpFile = outFile + ".tmp";
+
+    QFile file(tmpFile);
+
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        LOG(VB_RECORD, LOG_ERR, QString("Error opening %1").arg(tmpFile));
+        return false;
+    }
+
+    file.write(QString(
+        "#EXTM3U\n"
+        "#EXT-X-ALLOW-CACHE:YES\n"
+        "#EXT-X-TARGETDURATION:%1\n"
+        "#EXT-X-MEDIA-SEQUENCE:1\n"
+        "#EXT-X-PLAYLIST-TYPE:EVENT\n"
+        ).arg(m_segmentSize).toLatin1());
+
+    for (uint i = 1; i <= segmentCount; ++i)
+    {
+        file.write(QString(
+            "#EXTINF:%1,\n"
+            "%2\n"
+            ).arg(m_segmentSize)
+             .arg(GetFilename(i, true, audioOnly, true)).toLatin1());
+    }
+
+    if (writeEndTag)
+        file.write("#EXT-X-ENDLIST\n");
+    file.close();
+
+    if(rename(tmpFile.toLatin1().constData(),
+              outFile.toLatin1().constData()) == -1)
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC +
+            QString("Error renaming %1 to %2").arg(tmpFile).arg(outFile) + ENO);
+        return false;
+    }
+
+    return true;
+}
+
 bool HTTPLiveStream::SaveSegmentInfo(void)
 {
     if (m_streamid == -1)
@@ -818,7 +1257,24 @@ DTC::LiveStreamInfo *HTTPLiveStream::StartStream(void)
     if (GetDBStatus() != kHLSStatusQueued)
         return GetLiveStreamInfo();
 
-    auto *streamThread = new HTTPLiveStreamThread(GetStreamID());
+    // Only streams of a known length can be split up front
+    int jobs = gCoreContext->GetNumSetting("HTTPLiveStreamParallelJobs",
+                                           QThread::idealThreadCount() / 2);
+    uint16_t segments = 0;
+    if ((jobs > 1) && m_segmentSize && !m_maxSegments)
+    {
+        ProgramInfo pginfo(m_sourceFile);
+        uint64_t duration = pginfo.QueryTotalDuration() / 1000;
+        segments = (uint16_t)std::min<uint64_t>(
+            (duration + m_segmentSize - 1) / m_segmentSize, UINT16_MAX);
+    }
+
+    QRunnable *streamThread = nullptr;
+    if (segments > 1)
+        streamThread = new HTTPLiveStreamParallelThread(GetStreamID(), jobs,
+                                                        segments);
+    else
+        streamThread = new HTTPLiveStreamThread(GetStreamID());
     MThreadPool::globalInstance()->startReserved(streamThread,
                                                  "HTTPLiveStream");
     MythTimer statusTimer;
@@ -48,6 +48,7 @@ class MTV_PUBLIC HTTPLiveStream
                          bool audioOnly = false, bool encoded = false) const;
     QString  GetCurrentFilename(
         bool audioOnly = false, bool encoded = false) const;
+    uint16_t GetCurrentSegment(void) const { return m_curSegment; }
 
     void SetOutputVars(void);
 
@@ -59,6 +60,18 @@ class MTV_PUBLIC HTTPLiveStream
     bool WriteHTML(void);
     bool WriteMetaPlaylist(void);
     bool WritePlaylist(bool audioOnly = false, bool writeEndTag = false);
+    bool WriteEventPlaylist(uint16_t segmentCount, bool audioOnly = false,
+                            bool writeEndTag = false);
+
+    // Segment jobs, used when a stream is transcoded by several
+    // mythtranscode processes in parallel.
+    void     StartSegmentJob(uint16_t firstSegment);
+    bool     CompleteSegment(uint16_t segmentNumber);
+    bool     NextSegment(void);
+    bool     IsSegmentComplete(uint16_t segmentNumber) const;
+    bool     UpdateCompletedSegments(uint16_t count);
+    uint16_t GetPlayheadSegment(void) const;
+    static bool SetPlayheadSegment(int id, uint16_t segmentNumber);
 
     bool SaveSegmentInfo(void);
 
@@ -81,6 +94,7 @@ class MTV_PUBLIC HTTPLiveStream
 
  protected:
     bool        m_writing          {false};
+    bool        m_segmentJob       {false};
     int         m_streamid         {-1};
     QString     m_sourceFile;
     QString     m_sourceHost;
@@ -26,6 +26,7 @@
 
 // QT
 #include <QObject>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QtAlgorithms>
@@ -58,6 +59,9 @@ using std::min;
 // Constants
 #define PLAYBACK_MINBUFFER 2    // number of segments to prefetch before playback starts
 #define PLAYBACK_READAHEAD 6    // number of segments download queue ahead of playback
+#define PLAYBACK_PARALLEL  3    // number of segments downloaded at the same time
+#define PLAYBACK_AHEADSIZE (64 * 1024 * 1024) // most bytes downloaded ahead of playback
+#define PLAYBACK_CACHESIZE (64 * 1024 * 1024) // most bytes of played segments kept
 #define PLAYLIST_FAILURE   6    // number of consecutive failures after which
                                 // playback will abort
 enum
@@ -440,8 +444,12 @@ public:
         m_cache         = rhs.m_cache;
 #ifdef USING_LIBCRYPTO
         m_keypath       = rhs.m_keypath;
-        m_ivloaded      = rhs.m_ivloaded;
-        memcpy(m_aesIv, rhs.m_aesIv, sizeof(m_aesIv));
+        bool ivloaded   = false;
+        uint8_t iv[AES_BLOCK_SIZE];
+        rhs.GetAESIV(ivloaded, iv);
+        QMutexLocker keylock(&m_keylock);
+        m_ivloaded      = ivloaded;
+        memcpy(m_aesIv, iv, sizeof(m_aesIv));
 #endif
         return *this;
     }
@@ -664,18 +672,23 @@ public:
         /* If the segment is encrypted, decode it */
         if (segment->HasKeyPath())
         {
-            /* Do we have loaded the key ? */
-            if (!segment->KeyLoaded())
+            bool ivloaded = false;
+            uint8_t iv[AES_BLOCK_SIZE];
             {
-                if (ManageSegmentKeys() != RET_OK)
+                // other segments may be downloading at the same time
+                QMutexLocker keylock(&m_keylock);
+                /* Do we have loaded the key ? */
+                if (!segment->KeyLoaded() && ManageSegmentKeys() != RET_OK)
                 {
                     LOG(VB_PLAYBACK, LOG_ERR, LOC +
                         "couldn't retrieve segment AES-128 key");
                     segment->Unlock();
                     return RET_OK;
                 }
+                ivloaded = m_ivloaded;
+                memcpy(iv, m_aesIv, sizeof(iv));
             }
-            if (segment->DecodeData(m_ivloaded ? m_aesIv : nullptr) != RET_OK)
+            if (segment->DecodeData(ivloaded ? iv : nullptr) != RET_OK)
             {
                 segment->Unlock();
                 return RET_ERROR;
@@ -828,13 +841,19 @@ public:
         int padding = max(0, AES_BLOCK_SIZE - (line.size() - 2));
         QByteArray ba = QByteArray(padding, 0x0);
         ba.append(QByteArray::fromHex(QByteArray(line.toLatin1().constData() + 2)));
+        QMutexLocker keylock(&m_keylock);
         memcpy(m_aesIv, ba.constData(), ba.size());
         m_ivloaded = true;
         return true;
     }
-    uint8_t *AESIV(void)
+    /**
+     * copy the IV into iv, as segments of this stream may be downloading
+     */
+    void GetAESIV(bool &ivloaded, uint8_t *iv) const
     {
-        return m_aesIv;
+        QMutexLocker keylock(&m_keylock);
+        ivloaded = m_ivloaded;
+        memcpy(iv, m_aesIv, AES_BLOCK_SIZE);
     }
     void SetKeyPath(const QString &x)
     {
@@ -843,6 +862,7 @@ public:
 
 private:
     QString     m_keypath;              // URL path of the encrypted key
+    mutable QMutex m_keylock;           // one segment loads the keys at a time, guards the IV
     bool        m_ivloaded       {false};
     uint8_t     m_aesIv[AES_BLOCK_SIZE]{0};// IV used when decypher the block
 #endif
@@ -916,9 +936,28 @@ private:
     QMutex          m_lock;
 };
 
+class StreamWorker;
+
+// Extra download thread, so that several segments are downloaded at once
+class SegmentFetcher : public MThread
+{
+public:
+    SegmentFetcher(StreamWorker *parent, int id) :
+        MThread(QString("HLSFetch%1").arg(id)), m_parent(parent)
+    {
+    }
+
+protected:
+    void run(void) override; // MThread
+
+private:
+    StreamWorker   *m_parent         {nullptr};
+};
+
 // Stream Download Thread
 class StreamWorker : public MThread
 {
+    friend class SegmentFetcher;
 public:
     StreamWorker(HLSRingBuffer *parent, int startup, int buffer) : MThread("HLSStream"),
         m_parent(parent), m_segment(startup), m_buffer(buffer)
@@ -939,6 +978,8 @@ public:
                 hls->Cancel();
             }
         }
+        // so that no download thread can miss the signal
+        Wakeup();
         m_lock.unlock();
         wait();
     }
@@ -956,9 +997,20 @@ public:
     {
         m_lock.lock();
         m_segment = val;
+        // segments given up on from here will be tried again
+        for (auto it = m_failed.begin(); it != m_failed.end(); )
+        {
+            if (*it >= val)
+                it = m_failed.erase(it);
+            else
+                ++it;
+        }
         m_lock.unlock();
         Wakeup();
     }
+    /**
+     * true once every segment has been downloaded, or given up on
+     */
     bool IsAtEnd(bool lock = false)
     {
         if (lock)
@@ -966,7 +1018,7 @@ public:
             m_lock.lock();
         }
         int count = m_parent->NumSegments();
-        bool ret = m_segment >= count;
+        bool ret = m_segment >= count && m_inflight.isEmpty();
         if (lock)
         {
             m_lock.unlock();
@@ -992,13 +1044,35 @@ public:
         return true;
     }
 
+    /**
+     * true if segment [segnum] is being downloaded, or will be, rather than
+     * having been given up on. must own lock
+     */
+    bool IsPending(int segnum) const
+    {
+        if (m_inflight.contains(segnum))
+            return true;
+        return !m_failed.contains(segnum) && segnum >= m_segment &&
+            segnum < m_parent->NumSegments();
+    }
+
+    /**
+     * number of segments from the playback position on that are ready,
+     * counting those given up on as playback will skip them
+     */
     int CurrentPlaybackBuffer(bool lock = true)
     {
         if (lock)
         {
             m_lock.lock();
         }
-        int ret = m_segment - m_parent->m_playback->Segment();
+        int segment = m_parent->m_playback->Segment();
+        int ret = 0;
+        while (m_segmap.contains(segment + ret) ||
+               m_failed.contains(segment + ret))
+        {
+            ret++;
+        }
         if (lock)
         {
             m_lock.unlock();
@@ -1020,6 +1094,7 @@ public:
             return;
         QMutexLocker lock(&m_lock);
         m_segmap.insert(segnum, stream);
+        m_failed.remove(segnum);
     }
     void RemoveSegmentFromStream(int segnum)
     {
@@ -1073,13 +1148,19 @@ public:
     }
     int64_t Bandwidth(void) const
     {
+        QMutexLocker lock(&m_lock);
         return m_bandwidth;
     }
-    double AverageNewBandwidth(int64_t bandwidth)
+    /**
+     * The segments are downloaded [active] at a time, so the link carries
+     * about [active] times the bandwidth each download measured.
+     * Recent downloads count most, so that we follow changes on the link.
+     */
+    int64_t UpdateBandwidth(int64_t bandwidth, int active)
     {
-        m_sumbandwidth += bandwidth;
-        m_countbandwidth++;
-        m_bandwidth = m_sumbandwidth / m_countbandwidth;
+        QMutexLocker lock(&m_lock);
+        int64_t total = bandwidth * max(active, 1);
+        m_bandwidth = m_bandwidth ? (m_bandwidth * 3 + total) / 4 : total;
         return m_bandwidth;
     }
 
@@ -1088,115 +1169,155 @@ protected:
     {
         RunProlog();
 
-        int retries = 0;
+        for (int i = 1; i < PLAYBACK_PARALLEL; i++)
+        {
+            auto *fetcher = new SegmentFetcher(this, i);
+            fetcher->start();
+            m_fetchers.push_back(fetcher);
+        }
+
+        DownloadLoop();
+
+        foreach (auto fetcher, m_fetchers)
+        {
+            fetcher->wait();
+            delete fetcher;
+        }
+        m_fetchers.clear();
+
+        RunEpilog();
+    }
+
+    /**
+     * Run by this thread and each SegmentFetcher: claims the next segment
+     * nobody is downloading, downloads it, and starts again.
+     */
+    void DownloadLoop(void)
+    {
         while (!m_interrupted)
         {
             /*
              * we can go into waiting if:
-             * - not live and download is more than 3 segments ahead of playback
+             * - not live and download is more than 6 segments, or
+             *   PLAYBACK_AHEADSIZE bytes, ahead of playback
              * - we are at the end of the stream
+             * - the other threads are downloading what is left
              */
             Lock();
-            HLSStream *hls  = m_parent->GetStream(m_stream);
-            int dnldsegment = m_segment;
-            int playsegment = m_parent->m_playback->Segment();
-            if ((!hls->Live() && (playsegment < dnldsegment - m_buffer)) ||
-                IsAtEnd())
+            int stream      = m_stream;
+            HLSStream *hls  = m_parent->GetStream(stream);
+            int dnldsegment = NextSegment(hls);
+            while (!m_interrupted && dnldsegment < 0)
             {
-                /* wait until
-                 * 1- got interrupted
-                 * 2- we are less than 6 segments ahead of playback
-                 * 3- got asked to seek to a particular segment */
-                while (!m_interrupted && (m_segment == dnldsegment) &&
-                       (((m_segment - playsegment) > m_buffer) || IsAtEnd()))
-                {
-                    WaitForSignal();
-                    // do we have new segments available added by PlaylistWork?
-                    if (hls->Live() && !IsAtEnd())
-                        break;
-                    playsegment = m_parent->m_playback->Segment();
-                }
-                dnldsegment = m_segment;
+                WaitForSignal();
+                stream      = m_stream;
+                hls         = m_parent->GetStream(stream);
+                dnldsegment = NextSegment(hls);
             }
-            Unlock();
-
             if (m_interrupted)
             {
-                Wakeup();
+                Unlock();
                 break;
             }
-            // have we already downloaded the required segment?
-            if (StreamForSegment(dnldsegment) < 0)
-            {
-                uint64_t bw = m_bandwidth;
-                int err = hls->DownloadSegmentData(dnldsegment, bw, m_stream);
-                if (m_interrupted)
-                {
-                    // interrupt early
-                    Wakeup();
-                    break;
-                }
-                bw = AverageNewBandwidth(bw);
-                if (err != RET_OK)
-                {
-                    retries++;
-                    LOG(VB_PLAYBACK, LOG_DEBUG, LOC +
-                        QString("download failed, retry #%1").arg(retries));
-                    if (retries == 1)   // first error
-                        continue;       // will retry immediately
-                    usleep(500000);     // sleep 0.5s
-                    if (retries == 2)   // and retry once again
-                        continue;
-                    if (!m_parent->m_meta) // NOLINT(bugprone-branch-clone)
-                    {
-                        // no other stream to default to, skip packet
-                        retries = 0;
-                    }
-                    else
-                    {
-                        // TODO: should switch to another stream
-                        retries = 0;
-                    }
-                }
-                else
-                {
-                    LOG(VB_PLAYBACK, LOG_DEBUG, LOC +
-                        QString("download completed, %1 segments ahead")
-                        .arg(CurrentLiveBuffer()));
-                    AddSegmentToStream(dnldsegment, m_stream);
-                    if (m_parent->m_meta && hls->Bitrate() != bw)
-                    {
-                        int newstream = BandwidthAdaptation(hls->Id(), bw);
+            m_inflight.insert(dnldsegment);
+            m_failed.remove(dnldsegment);
+            int active = m_inflight.size();
+            m_segment++;
+            Unlock();
+
+            DownloadSegment(hls, dnldsegment, stream, active);
 
-                        if (newstream >= 0 && newstream != m_stream)
-                        {
-                            LOG(VB_PLAYBACK, LOG_INFO, LOC +
-                                QString("switching to %1 bitrate %2 stream; changing "
-                                        "from stream %3 to stream %4")
-                                .arg(bw >= hls->Bitrate() ? "faster" : "lower")
-                                .arg(bw).arg(m_stream).arg(newstream));
-                            m_stream = newstream;
-                        }
-                    }
-                }
-            }
             Lock();
-            if (dnldsegment == m_segment)   // false if seek was called
-            {
-                m_segment++;
-            }
+            m_inflight.remove(dnldsegment);
             Unlock();
             // Signal we're done
             Wakeup();
         }
+        Wakeup();
+    }
 
-        RunEpilog();
+    /**
+     * return the next segment to download, or -1 if we shouldn't start
+     * another download yet. must own lock
+     */
+    int NextSegment(HLSStream *hls)
+    {
+        int count = m_parent->NumSegments();
+        // skip those already downloaded, or being downloaded
+        while (m_segment < count &&
+               (m_segmap.contains(m_segment) || m_inflight.contains(m_segment)))
+        {
+            m_segment++;
+        }
+        if (m_segment >= count)
+            return -1;
+        if (hls->Live())
+            return m_segment;
+
+        int ahead = m_segment - m_parent->m_playback->Segment();
+        uint64_t bytes = (uint64_t)max(ahead, 0) *
+            max(hls->TargetDuration(), 1) * hls->Bitrate() / 8;
+        if (ahead > m_buffer || bytes >= PLAYBACK_AHEADSIZE)
+            return -1;
+        return m_segment;
+    }
+
+    void DownloadSegment(HLSStream *hls, int segnum, int stream, int active)
+    {
+        // retry immediately once, then once more after 0.5s
+        for (int retries = 0; retries < 3; retries++)
+        {
+            if (retries == 2)
+                usleep(500000);
+            if (m_interrupted)
+                return;
+
+            uint64_t bw = Bandwidth() / max(active, 1);
+            int err = hls->DownloadSegmentData(segnum, bw, stream);
+            if (m_interrupted)
+                return;
+            if (err != RET_OK)
+            {
+                LOG(VB_PLAYBACK, LOG_DEBUG, LOC +
+                    QString("download of segment %1 failed, retry #%2")
+                    .arg(segnum).arg(retries + 1));
+                continue;
+            }
+
+            bw = UpdateBandwidth(bw, active);
+            AddSegmentToStream(segnum, stream);
+            LOG(VB_PLAYBACK, LOG_DEBUG, LOC +
+                QString("download of segment %1 completed, %2 segments ahead")
+                .arg(segnum).arg(CurrentLiveBuffer()));
+
+            if (m_parent->m_meta && hls->Bitrate() != bw)
+            {
+                QMutexLocker lock(&m_lock);
+                int newstream = BandwidthAdaptation(hls->Id(), bw);
+
+                if (newstream >= 0 && newstream != m_stream)
+                {
+                    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                        QString("switching to %1 bitrate %2 stream; changing "
+                                "from stream %3 to stream %4")
+                        .arg(bw >= hls->Bitrate() ? "faster" : "lower")
+                        .arg(bw).arg(m_stream).arg(newstream));
+                    m_stream = newstream;
+                }
+            }
+            return;
+        }
+
+        // give up, playback will skip it
+        QMutexLocker lock(&m_lock);
+        m_failed.insert(segnum);
     }
 
     int BandwidthAdaptation(int progid, uint64_t &bandwidth) const
     {
         int candidate = -1;
-        uint64_t bw = bandwidth;
+        // leave some headroom, so that we don't keep switching back and forth
+        uint64_t bw = bandwidth * 4 / 5;
         uint64_t bw_candidate = 0;
 
         int count = m_parent->NumStreams();
@@ -1228,18 +1349,26 @@ protected:
 private:
     HLSRingBuffer  *m_parent         {nullptr};
     bool            m_interrupted    {false};
-                    // measured average download bandwidth (bits per second)
+                    // measured download bandwidth of the link (bits per second)
     int64_t         m_bandwidth      {0};
     int             m_stream         {0};// current HLSStream
-    int             m_segment;  // current segment for downloading
+    int             m_segment;  // next segment for downloading
     int             m_buffer;   // buffer kept between download and playback
     QMap<int,int>   m_segmap;   // segment with streamid used for download
+    QSet<int>       m_inflight; // segments being downloaded
+    QSet<int>       m_failed;   // segments given up on
+    QList<SegmentFetcher*> m_fetchers;
     mutable QMutex  m_lock;
     QWaitCondition  m_waitcond;
-    double          m_sumbandwidth   {0.0};
-    int             m_countbandwidth {0};
 };
 
+void SegmentFetcher::run(void)
+{
+    RunProlog();
+    m_parent->DownloadLoop();
+    RunEpilog();
+}
+
 // Playlist Refresh Thread
 class PlaylistWorker : public MThread
 {
@@ -2680,11 +2809,23 @@ int HLSRingBuffer::safe_read(void *data, uint sz)
             m_playback->AddOffset(used);
             return used;
         }
-        int stream = m_streamworker->StreamForSegment(segnum);
+        // segments are downloaded in parallel, so a later one may be ready
+        // while this one is still on its way
+        m_streamworker->Lock();
+        int stream = m_streamworker->StreamForSegment(segnum, false);
+        while (stream < 0 && !m_error && !m_interrupted &&
+               m_streamworker->IsPending(segnum))
+        {
+            m_streamworker->WaitForSignal(1000);
+            stream = m_streamworker->StreamForSegment(segnum, false);
+        }
+        m_streamworker->Unlock();
+        if (m_interrupted)
+            break;
         if (stream < 0)
         {
-            // we haven't downloaded this segment yet, likely that it was
-            // dropped (livetv?)
+            // we gave up on this segment, or it was dropped (livetv?)
+            // before we got to it
             m_playback->IncrSegment();
             continue;
         }
@@ -2698,7 +2839,8 @@ int HLSRingBuffer::safe_read(void *data, uint sz)
         segment->Lock();
         if (segment->SizePlayed() == segment->Size())
         {
-            if (!hls->Cache() || hls->Live())
+            bool cache = hls->Cache() && !hls->Live();
+            if (!cache)
             {
                 segment->Clear();
                 m_streamworker->RemoveSegmentFromStream(segnum);
@@ -2709,8 +2851,12 @@ int HLSRingBuffer::safe_read(void *data, uint sz)
             }
 
             m_playback->IncrSegment();
+            int32_t size = segment->Size();
             segment->Unlock();
 
+            if (cache)
+                CacheSegment(segnum, size);
+
             /* signal download thread we're about to use a new segment */
             m_streamworker->Wakeup();
             continue;
@@ -2738,6 +2884,38 @@ int HLSRingBuffer::safe_read(void *data, uint sz)
     return used;
 }
 
+/**
+ * Keep played segment [segnum] in memory for seeking back, dropping the
+ * segments furthest from playback once more than PLAYBACK_CACHESIZE is kept
+ */
+void HLSRingBuffer::CacheSegment(int segnum, int32_t size)
+{
+    if (m_cached.contains(segnum))
+        m_cachedbytes -= m_cached[segnum];
+    m_cached.insert(segnum, size);
+    m_cachedbytes += size;
+
+    while (m_cachedbytes > PLAYBACK_CACHESIZE && m_cached.size() > 1)
+    {
+        int current = m_playback->Segment();
+        int drop = (current - m_cached.firstKey() > m_cached.lastKey() - current) ?
+            m_cached.firstKey() : m_cached.lastKey();
+        m_cachedbytes -= m_cached.take(drop);
+
+        int stream = m_streamworker->StreamForSegment(drop);
+        HLSStream *hls = stream < 0 ? nullptr : GetStream(stream);
+        HLSSegment *segment = hls ? hls->GetSegment(drop) : nullptr;
+        if (segment == nullptr)
+            continue;
+        segment->Lock();
+        segment->Clear();
+        segment->Unlock();
+        m_streamworker->RemoveSegmentFromStream(drop);
+        LOG(VB_PLAYBACK, LOG_DEBUG, LOC +
+            QString("dropped played segment %1 from memory").arg(drop));
+    }
+}
+
 /**
  * returns an estimated duration in ms for size amount of data
  * returns 0 if we can't estimate the duration
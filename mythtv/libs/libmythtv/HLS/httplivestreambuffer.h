@@ -97,6 +97,7 @@ private:
     int ChooseSegment(int stream) const;
     int64_t SizeMedia(void) const;
     void WaitUntilBuffered(void);
+    void CacheSegment(int segnum, int32_t size);
     void SanitizeStreams(StreamsList *streams = nullptr);
 
     // private member variables
@@ -124,6 +125,11 @@ private:
      * this will prevent waiting for new data in safe_read
      */
     bool                m_seektoend      {false};
+    /**
+     * played segments kept in memory, and their size
+     */
+    QMap<int,int32_t>   m_cached;
+    int64_t             m_cachedbytes    {0};
 
     friend class StreamWorker;
     StreamWorker       *m_streamworker   {nullptr};
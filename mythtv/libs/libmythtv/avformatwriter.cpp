@@ -216,6 +216,20 @@ bool AVFormatWriter::NextFrameIsKeyFrame(void)
            (m_bufferedVideoFrameTypes.first() == AV_PICTURE_TYPE_I);
 }
 
+/** \fn AVFormatWriter::NextFrameIsForcedKeyFrame(void)
+ *  \brief Whether the next packet written is a keyframe requested with
+ *         ForceKeyFrame(), rather than one of the regular keyframes.
+ */
+bool AVFormatWriter::NextFrameIsForcedKeyFrame(void)
+{
+    while (!m_forcedKeyFrames.isEmpty() &&
+           (m_forcedKeyFrames.first() < m_framesWritten))
+        m_forcedKeyFrames.removeFirst();
+
+    return !m_forcedKeyFrames.isEmpty() &&
+           (m_forcedKeyFrames.first() == m_framesWritten);
+}
+
 int AVFormatWriter::WriteVideoFrame(VideoFrame *frame)
 {
     int framesEncoded = m_framesWritten + m_bufferedVideoFrameTimes.size();
@@ -224,7 +238,13 @@ int AVFormatWriter::WriteVideoFrame(VideoFrame *frame)
     AVPictureFill(m_picture, frame);
     m_picture->pts = framesEncoded + 1;
 
-    if ((framesEncoded % m_keyFrameDist) == 0)
+    if (m_forceKeyFrame)
+    {
+        m_forcedKeyFrames.push_back(framesEncoded);
+        m_forceKeyFrame = false;
+        m_picture->pict_type = AV_PICTURE_TYPE_I;
+    }
+    else if ((framesEncoded % m_keyFrameDist) == 0)
         m_picture->pict_type = AV_PICTURE_TYPE_I;
     else
         m_picture->pict_type = AV_PICTURE_TYPE_NONE;
@@ -426,6 +446,135 @@ int AVFormatWriter::WriteTextFrame(int /*vbimode*/, unsigned char */*buf*/, int
     return 1;
 }
 
+/** \fn AVFormatWriter::InitCopy(const AVFormatContext*)
+ *  \brief Set up the writer to copy the packets of \p input unchanged.
+ *
+ *   Every audio, video and subtitle stream of \p input gets an output
+ *   stream with the same codec parameters and no encoder is opened.
+ *   Call this instead of Init(), and write with WriteCopyPacket() instead
+ *   of WriteVideoFrame() and WriteAudioFrame().
+ */
+bool AVFormatWriter::InitCopy(const AVFormatContext *input)
+{
+    AVOutputFormat *fmt = av_guess_format(m_container.toLatin1().constData(),
+                                          nullptr, nullptr);
+    if (!fmt)
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC +
+            QString("InitCopy(): Unable to guess AVOutputFormat from container %1")
+                    .arg(m_container));
+        return false;
+    }
+
+    m_fmt = *fmt;
+
+    m_ctx = avformat_alloc_context();
+    if (!m_ctx)
+    {
+        LOG(VB_RECORD, LOG_ERR,
+            LOC + "InitCopy(): Unable to allocate AVFormatContext");
+        return false;
+    }
+
+    m_ctx->oformat = &m_fmt;
+    m_ctx->url = av_strdup(m_filename.toLatin1().constData());
+
+    m_copyStreamMap.fill(-1, input->nb_streams);
+    m_copyLastDts.fill(AV_NOPTS_VALUE, input->nb_streams);
+
+    for (uint i = 0; i < input->nb_streams; i++)
+    {
+        const AVStream *in = input->streams[i];
+        AVMediaType type = in->codecpar->codec_type;
+
+        if (((type != AVMEDIA_TYPE_VIDEO) && (type != AVMEDIA_TYPE_AUDIO) &&
+             (type != AVMEDIA_TYPE_SUBTITLE)) ||
+            (in->codecpar->codec_id == AV_CODEC_ID_NONE) ||
+            (in->disposition & AV_DISPOSITION_ATTACHED_PIC))
+            continue;
+
+        AVStream *out = avformat_new_stream(m_ctx, nullptr);
+        if (!out || (avcodec_parameters_copy(out->codecpar, in->codecpar) < 0))
+        {
+            LOG(VB_RECORD, LOG_ERR, LOC +
+                QString("InitCopy(): Unable to copy stream %1").arg(i));
+            return false;
+        }
+        out->codecpar->codec_tag = 0;
+        out->time_base = in->time_base;
+        out->disposition = in->disposition;
+        av_dict_copy(&out->metadata, in->metadata, 0);
+
+        m_copyStreamMap[i] = out->index;
+
+        if ((type == AVMEDIA_TYPE_VIDEO) && !m_videoStream)
+            m_videoStream = out;
+        else if ((type == AVMEDIA_TYPE_AUDIO) && !m_audioStream)
+            m_audioStream = out;
+    }
+
+    if (!m_videoStream)
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC + "InitCopy(): No video stream to copy");
+        return false;
+    }
+
+    return true;
+}
+
+/** \fn AVFormatWriter::WriteCopyPacket(AVPacket*, AVRational)
+ *  \brief Write a packet read from the input given to InitCopy().
+ *
+ *   \p pkt still carries its input stream index and its timestamps in
+ *   the input stream's \p timeBase.  Packets which would take a stream's
+ *   decode time backwards, which only happens around a cut, are dropped.
+ *
+ *   \return 1 if the packet was written, 0 if it was dropped and < 0 on
+ *           error.
+ */
+int AVFormatWriter::WriteCopyPacket(AVPacket *pkt, AVRational timeBase)
+{
+    int inIndex = pkt->stream_index;
+    if ((inIndex < 0) || (inIndex >= m_copyStreamMap.size()) ||
+        (m_copyStreamMap[inIndex] < 0))
+        return 0;
+
+    AVStream *out = m_ctx->streams[m_copyStreamMap[inIndex]];
+    av_packet_rescale_ts(pkt, timeBase, out->time_base);
+
+    if (pkt->dts != AV_NOPTS_VALUE)
+    {
+        if ((m_copyLastDts[inIndex] != AV_NOPTS_VALUE) &&
+            (pkt->dts <= m_copyLastDts[inIndex]))
+            return 0;
+        m_copyLastDts[inIndex] = pkt->dts;
+    }
+
+    pkt->stream_index = out->index;
+    pkt->pos = -1;
+
+    int ret = av_write_frame(m_ctx, pkt);
+    if (ret < 0)
+    {
+        LOG(VB_RECORD, LOG_ERR, LOC + "WriteCopyPacket(): "
+                "av_write_frame couldn't write packet");
+        return ret;
+    }
+
+    if (out == m_videoStream)
+        m_framesWritten++;
+
+    return 1;
+}
+
+long long AVFormatWriter::GetFilePosition(void) const
+{
+    if (!m_ctx || !m_ctx->pb)
+        return -1;
+
+    return avio_tell(m_ctx->pb);
+}
+
 bool AVFormatWriter::ReOpen(const QString& filename)
 {
     bool result = m_ringBuffer->ReOpen(filename);
@@ -6,6 +6,7 @@
 #include "avfringbuffer.h"
 
 #include <QList>
+#include <QVector>
 
 #undef HAVE_AV_CONFIG_H
 extern "C" {
@@ -29,8 +30,15 @@ class MTV_PUBLIC AVFormatWriter : public FileWriterBase
                         long long timecode, int pagenr) override; // FileWriterBase
 
     bool NextFrameIsKeyFrame(void);
+    void ForceKeyFrame(void) { m_forceKeyFrame = true; }
+    bool NextFrameIsForcedKeyFrame(void);
     bool ReOpen(const QString& filename);
 
+    // Packet copy mode, for remuxing without decoding
+    bool InitCopy(const AVFormatContext *input);
+    int  WriteCopyPacket(AVPacket *pkt, AVRational timeBase);
+    long long GetFilePosition(void) const;
+
   private:
     AVStream *AddVideoStream(void);
     bool OpenVideo(void);
@@ -58,7 +66,12 @@ class MTV_PUBLIC AVFormatWriter : public FileWriterBase
 
     QList<long long>       m_bufferedVideoFrameTimes;
     QList<int>             m_bufferedVideoFrameTypes;
+    QList<long long>       m_forcedKeyFrames; ///< frame numbers, in encode order
+    bool                   m_forceKeyFrame    {false};
     QList<long long>       m_bufferedAudioFrameTimes;
+
+    QVector<int>           m_copyStreamMap;   ///< input to output stream index
+    QVector<int64_t>       m_copyLastDts;     ///< per input stream
 };
 
 #endif
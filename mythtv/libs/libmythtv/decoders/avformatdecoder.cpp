@@ -37,6 +37,7 @@ using namespace std;
 #include "DVD/dvdringbuffer.h"
 #include "Bluray/bdringbuffer.h"
 #include "mythavutil.h"
+#include "streaminfocache.h"
 
 #include "lcddevice.h"
 
@@ -413,6 +414,9 @@ void AvFormatDecoder::CloseCodecs()
 
 void AvFormatDecoder::CloseContext()
 {
+    delete m_demuxer;
+    m_demuxer = nullptr;
+
     if (m_ic)
     {
         CloseCodecs();
@@ -443,6 +447,7 @@ int64_t AvFormatDecoder::NormalizeVideoTimecode(int64_t timecode)
     int64_t start_pts = 0;
 
     AVStream *st = nullptr;
+    avcodeclock->lock();
     for (uint i = 0; i < m_ic->nb_streams; i++)
     {
         AVStream *st1 = m_ic->streams[i];
@@ -452,6 +457,7 @@ int64_t AvFormatDecoder::NormalizeVideoTimecode(int64_t timecode)
             break;
         }
     }
+    avcodeclock->unlock();
     if (!st)
         return 0;
 
@@ -586,6 +592,7 @@ bool AvFormatDecoder::DoFastForward(long long desiredFrame, bool discardFrames)
     m_getRawFrames = false;
 
     AVStream *st = nullptr;
+    avcodeclock->lock();
     for (uint i = 0; i < m_ic->nb_streams; i++)
     {
         AVStream *st1 = m_ic->streams[i];
@@ -595,6 +602,7 @@ bool AvFormatDecoder::DoFastForward(long long desiredFrame, bool discardFrames)
             break;
         }
     }
+    avcodeclock->unlock();
 
     int seekDelta = desiredFrame - m_framesPlayed;
 
@@ -620,6 +628,7 @@ bool AvFormatDecoder::DoFastForward(long long desiredFrame, bool discardFrames)
 
     int flags = (m_doRewind || exactseeks) ? AVSEEK_FLAG_BACKWARD : 0;
 
+    DiscardReadAhead();
     if (av_seek_frame(m_ic, -1, ts, flags) < 0)
     {
         LOG(VB_GENERAL, LOG_ERR, LOC +
@@ -839,12 +848,17 @@ void AvFormatDecoder::SeekReset(long long newKey, uint skipFrames,
 
 void AvFormatDecoder::SetEof(bool eof)
 {
-    if (!eof && m_ic && m_ic->pb)
+    if (!eof)
     {
-        LOG(VB_GENERAL, LOG_NOTICE, LOC +
-            QString("Resetting byte context eof (livetv %1 was eof %2)")
-                .arg(m_livetv).arg(m_ic->pb->eof_reached));
-        m_ic->pb->eof_reached = 0;
+        // the demux thread reads through m_ic->pb
+        QMutexLocker locker(avcodeclock);
+        if (m_ic && m_ic->pb)
+        {
+            LOG(VB_GENERAL, LOG_NOTICE, LOC +
+                QString("Resetting byte context eof (livetv %1 was eof %2)")
+                    .arg(m_livetv).arg(m_ic->pb->eof_reached));
+            m_ic->pb->eof_reached = 0;
+        }
     }
     DecoderBase::SetEof(eof);
 }
@@ -928,6 +942,10 @@ extern "C" void HandleStreamChange(void *data)
         QString("streams_changed 0x%1 -- stream count %2")
             .arg((uint64_t)data,0,16).arg(cnt));
 
+    // Read ahead, it is reported in order with the packets
+    if (decoder->m_demuxer && decoder->m_demuxer->StreamsChanged())
+        return;
+
     decoder->m_streamsChanged = true;
 }
 
@@ -967,6 +985,11 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
 
     m_ringBuffer = rbuffer;
 
+    // LiveTV switches files under the decoder, and discs read through
+    // their own ReadPacket(), so those are read one packet at a time
+    m_demuxAhead = !m_livetv && !m_ringBuffer->IsDisc() &&
+                   m_ringBuffer->GetType() != kRingBuffer_MHEG;
+
     // Process frames immediately unless we're decoding
     // a DVD, in which case don't so that we don't show
     // anything whilst probing the data streams.
@@ -1012,6 +1035,12 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
     bool scancomplete = false;
     int  remainingscans  = 5;
 
+    // A LiveTV channel tuned before needs only enough of a probe to
+    // confirm what was learnt about its streams then
+    uint chanid = (m_livetv && m_playbackInfo) ? m_playbackInfo->GetChanID() : 0;
+    bool trycache = chanid != 0;
+    m_cachedStreamInfo = false;
+
     while (!scancomplete && remainingscans--)
     {
         bool found = false;
@@ -1088,6 +1117,13 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
         // it takes to complete the scan).
         m_ic->max_analyze_duration = 60 * AV_TIME_BASE;
 
+        m_cachedStreamInfo = trycache && StreamInfoCache::Seed(chanid, m_ic);
+        if (m_cachedStreamInfo)
+        {
+            m_ic->max_analyze_duration = AV_TIME_BASE / 2;
+            m_ic->fps_probe_size = 0;
+        }
+
         m_avfRingBuffer->SetInInit(m_livetv);
         err = FindStreamInfo();
         if (err < 0)
@@ -1105,6 +1141,13 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
             if (!StreamHasRequiredParameters(m_ic->streams[i]))
             {
                 scancomplete = false;
+                if (m_cachedStreamInfo)
+                {
+                    // What was cached no longer fits, probe in full
+                    StreamInfoCache::Forget(chanid);
+                    trycache = false;
+                    remainingscans++;
+                }
                 if (remainingscans)
                 {
                     CloseContext();
@@ -1149,6 +1192,7 @@ int AvFormatDecoder::OpenFile(RingBuffer *rbuffer, bool novideo,
         CloseContext();
         return err;
     }
+    m_awaitingFirstFrame = true;
 
     AutoSelectTracks(); // This is needed for transcoder
 
@@ -2536,8 +2580,9 @@ int AvFormatDecoder::GetTeletextLanguage(uint lang_idx) const
 int AvFormatDecoder::GetSubtitleLanguage(uint subtitle_index, uint stream_index)
 {
     (void)subtitle_index;
-    AVDictionaryEntry *metatag =
-        av_dict_get(m_ic->streams[stream_index]->metadata, "language", nullptr, 0);
+    AVStream *stream = GetStream(static_cast<int>(stream_index));
+    AVDictionaryEntry *metatag = !stream ? nullptr :
+        av_dict_get(stream->metadata, "language", nullptr, 0);
     return metatag ? get_canonical_lang(metatag->value) :
                      iso639_str3_to_key("und");
 }
@@ -2579,7 +2624,9 @@ int AvFormatDecoder::GetAudioLanguage(uint audio_index, uint stream_index)
 AudioTrackType AvFormatDecoder::GetAudioTrackType(uint stream_index)
 {
     AudioTrackType type = kAudioTypeNormal;
-    AVStream *stream = m_ic->streams[stream_index];
+    AVStream *stream = GetStream(static_cast<int>(stream_index));
+    if (!stream)
+        return type;
 
     if (m_ic->cur_pmt_sect) // mpeg-ts
     {
@@ -3742,6 +3789,18 @@ bool AvFormatDecoder::ProcessVideoFrame(AVStream *Stream, AVFrame *AvFrame)
         m_mythCodecCtx->PostProcessFrame(context, frame);
     }
 
+    if (m_awaitingFirstFrame)
+    {
+        m_awaitingFirstFrame = false;
+        if (m_livetv && m_playbackInfo)
+        {
+            // The demux thread may be adding streams
+            QMutexLocker locker(avcodeclock);
+            StreamInfoCache::Learn(m_playbackInfo->GetChanID(), m_ic);
+        }
+        m_parent->FirstFrameDecoded(m_cachedStreamInfo);
+    }
+
     m_decodedVideoFrame = frame;
     m_gotVideoFrame = true;
     if (++m_fpsSkip >= m_fpsMultiplier)
@@ -4077,7 +4136,7 @@ QString AvFormatDecoder::GetTrackDesc(uint type, uint trackNo) const
             case kAudioTypeNormal :
             {
                 int av_index = m_tracks[kTrackTypeAudio][trackNo].m_av_stream_index;
-                AVStream *s = m_ic->streams[av_index];
+                AVStream *s = GetStream(av_index);
 
                 if (s)
                 {
@@ -4144,7 +4203,8 @@ QByteArray AvFormatDecoder::GetSubHeader(uint trackNo) const
         return QByteArray();
 
     int index = m_tracks[kTrackTypeSubtitle][trackNo].m_av_stream_index;
-    AVCodecContext *ctx = gCodecMap->getCodecContext(m_ic->streams[index]);
+    AVStream *stream = GetStream(index);
+    AVCodecContext *ctx = stream ? gCodecMap->getCodecContext(stream) : nullptr;
     if (!ctx)
         return QByteArray();
 
@@ -4158,20 +4218,26 @@ void AvFormatDecoder::GetAttachmentData(uint trackNo, QByteArray &filename,
     if (trackNo >= m_tracks[kTrackTypeAttachment].size())
         return;
 
+    QMutexLocker locker(avcodeclock);
     int index = m_tracks[kTrackTypeAttachment][trackNo].m_av_stream_index;
-    AVDictionaryEntry *tag = av_dict_get(m_ic->streams[index]->metadata,
+    AVStream *stream = GetStream(index);
+    if (!stream)
+        return;
+
+    AVDictionaryEntry *tag = av_dict_get(stream->metadata,
                                          "filename", nullptr, 0);
     if (tag)
         filename  = QByteArray(tag->value);
-    AVCodecParameters *par = m_ic->streams[index]->codecpar;
+    AVCodecParameters *par = stream->codecpar;
     data = QByteArray((char *)par->extradata, par->extradata_size);
 }
 
 bool AvFormatDecoder::SetAudioByComponentTag(int tag)
 {
+    QMutexLocker locker(avcodeclock);
     for (size_t i = 0; i < m_tracks[kTrackTypeAudio].size(); i++)
     {
-        AVStream *s  = m_ic->streams[m_tracks[kTrackTypeAudio][i].m_av_stream_index];
+        AVStream *s  = GetStream(m_tracks[kTrackTypeAudio][i].m_av_stream_index);
         if (s)
         {
             if ((s->component_tag == tag) ||
@@ -4186,6 +4252,7 @@ bool AvFormatDecoder::SetAudioByComponentTag(int tag)
 
 bool AvFormatDecoder::SetVideoByComponentTag(int tag)
 {
+    QMutexLocker locker(avcodeclock);
     for (uint i = 0; i < m_ic->nb_streams; i++)
     {
         AVStream *s  = m_ic->streams[i];
@@ -4250,6 +4317,8 @@ int AvFormatDecoder::filter_max_ch(const AVFormatContext *ic,
     int selectedTrack = -1;
     int max_seen = -1;
 
+    // The demux thread may be adding streams
+    QMutexLocker locker(avcodeclock);
     for (int f : fs)
     {
         const int stream_index = tracks[f].m_av_stream_index;
@@ -4466,8 +4535,8 @@ int AvFormatDecoder::AutoSelectAudioTrack(void)
         {
             LOG(VB_AUDIO, LOG_INFO, LOC + "Trying to select default track");
             for (size_t i = 0; i < atracks.size(); i++) {
-                int idx = atracks[i].m_av_stream_index;
-                if (m_ic->streams[idx]->disposition & AV_DISPOSITION_DEFAULT)
+                AVStream *stream = GetStream(atracks[i].m_av_stream_index);
+                if (stream && (stream->disposition & AV_DISPOSITION_DEFAULT))
                 {
                     selTrack = i;
                     break;
@@ -4799,7 +4868,9 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
         return false;
     }
 
+    avcodeclock->lock();
     m_hasVideo = HasVideo(m_ic);
+    avcodeclock->unlock();
     m_needDummyVideoFrames = false;
 
     if (!m_hasVideo && (decodetype & kDecodeVideo))
@@ -4817,8 +4888,8 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
        (m_selectedTrack[kTrackTypeVideo].m_av_stream_index > -1))
     {
         int got_picture  = 0;
-        AVStream *stream = m_ic->streams[m_selectedTrack[kTrackTypeVideo]
-                                 .m_av_stream_index];
+        AVStream *stream = GetStream(m_selectedTrack[kTrackTypeVideo]
+                                     .m_av_stream_index);
         MythAVFrame mpa_pic;
         if (!mpa_pic)
             return false;
@@ -4907,7 +4978,7 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
             }
 
             int retval = 0;
-            if (!m_ic || ((retval = ReadPacket(m_ic, pkt, storevideoframes)) < 0))
+            if (!m_ic || ((retval = NextPacket(pkt, storevideoframes)) < 0))
             {
                 if (retval == -EAGAIN)
                     continue;
@@ -4940,15 +5011,19 @@ bool AvFormatDecoder::GetFrame(DecodeType decodetype, bool &Retry)
             continue;
         }
 
-        if (pkt->stream_index >= (int)m_ic->nb_streams)
+        // The demux thread may be adding streams
+        avcodeclock->lock();
+        bool badstream = pkt->stream_index >= (int)m_ic->nb_streams;
+        AVStream *curstream = badstream ? nullptr : m_ic->streams[pkt->stream_index];
+        avcodeclock->unlock();
+
+        if (badstream)
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + "Bad stream");
             av_packet_unref(pkt);
             continue;
         }
 
-        AVStream *curstream = m_ic->streams[pkt->stream_index];
-
         if (!curstream)
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + "Bad stream (NULL)");
@@ -5097,9 +5172,13 @@ void AvFormatDecoder::StreamChangeCheck(void)
     {
         SeekReset(0, 0, true, true);
         avcodeclock->lock();
+        // A LiveTV channel change, fill in what the new PMT does not say
+        m_cachedStreamInfo = m_livetv && m_playbackInfo &&
+            StreamInfoCache::Seed(m_playbackInfo->GetChanID(), m_ic);
         ScanStreams(false);
         avcodeclock->unlock();
         m_streamsChanged = false;
+        m_awaitingFirstFrame = true;
     }
 }
 
@@ -5110,6 +5189,57 @@ int AvFormatDecoder::ReadPacket(AVFormatContext *ctx, AVPacket *pkt, bool &/*sto
     return av_read_frame(ctx, pkt);
 }
 
+/** \fn AvFormatDecoder::NextPacket(AVPacket*, bool&)
+ *  \brief Returns the next packet, from the demux thread if it is in use.
+ *
+ *   The thread is started by the first packet asked for, so that nothing
+ *   is read before the decoder is ready for it.
+ */
+int AvFormatDecoder::NextPacket(AVPacket *pkt, bool &storePacket)
+{
+    if (!m_demuxAhead)
+        return ReadPacket(m_ic, pkt, storePacket);
+
+    if (!m_demuxer)
+    {
+        m_demuxer = new DemuxThread(m_ic, m_ringBuffer);
+        m_demuxer->start();
+    }
+
+    bool streamsChanged = false;
+    int ret = m_demuxer->Take(pkt, streamsChanged);
+    if (streamsChanged)
+        m_streamsChanged = true;
+    return ret;
+}
+
+/// \brief Drops packets read ahead, before the read position is moved.
+void AvFormatDecoder::DiscardReadAhead(void)
+{
+    if (m_demuxer)
+        m_demuxer->Flush();
+}
+
+/** \fn AvFormatDecoder::GetStream(int) const
+ *  \brief Returns the stream at Index, or nullptr if there is none.
+ *
+ *   The demux thread may add streams while it reads, which reallocates
+ *   m_ic->streams, so the table is only read under avcodeclock.  The
+ *   streams themselves stay put until the context is closed.
+ */
+AVStream *AvFormatDecoder::GetStream(int Index) const
+{
+    QMutexLocker locker(avcodeclock);
+    if (!m_ic || Index < 0 || Index >= static_cast<int>(m_ic->nb_streams))
+        return nullptr;
+    return m_ic->streams[Index];
+}
+
+QString AvFormatDecoder::GetDemuxStats(void) const
+{
+    return m_demuxer ? m_demuxer->GetStats() : QString();
+}
+
 bool AvFormatDecoder::HasVideo(const AVFormatContext *ic)
 {
     if (ic && ic->cur_pmt_sect)
@@ -5184,10 +5314,10 @@ QString AvFormatDecoder::GetCodecDecoderName(void) const
 
 QString AvFormatDecoder::GetRawEncodingType(void)
 {
-    int stream = m_selectedTrack[kTrackTypeVideo].m_av_stream_index;
-    if (stream < 0 || !m_ic)
+    AVStream *stream = GetStream(m_selectedTrack[kTrackTypeVideo].m_av_stream_index);
+    if (!stream)
         return QString();
-    return ff_codec_id_string(m_ic->streams[stream]->codecpar->codec_id);
+    return ff_codec_id_string(stream->codecpar->codec_id);
 }
 
 void AvFormatDecoder::SetDisablePassThrough(bool disable)
@@ -5273,11 +5403,9 @@ bool AvFormatDecoder::SetupAudioStream(void)
     AudioInfo old_in    = m_audioIn;
     int requested_channels = 0;
 
-    if ((m_currentTrack[kTrackTypeAudio] >= 0) && m_ic &&
-        (m_selectedTrack[kTrackTypeAudio].m_av_stream_index <=
-         (int) m_ic->nb_streams) &&
-        (curstream = m_ic->streams[m_selectedTrack[kTrackTypeAudio]
-                                 .m_av_stream_index]) &&
+    if ((m_currentTrack[kTrackTypeAudio] >= 0) &&
+        (curstream = GetStream(m_selectedTrack[kTrackTypeAudio]
+                                 .m_av_stream_index)) &&
         (ctx = gCodecMap->getCodecContext(curstream)))
     {
         AudioFormat fmt =
@@ -28,6 +28,7 @@ extern "C" {
 }
 
 #include "avfringbuffer.h"
+#include "demuxthread.h"
 
 class TeletextDecoder;
 class CC608Decoder;
@@ -142,6 +143,7 @@ class AvFormatDecoder : public DecoderBase
 
     QString      GetCodecDecoderName(void) const override; // DecoderBase
     QString      GetRawEncodingType(void) override; // DecoderBase
+    QString      GetDemuxStats(void) const override; // DecoderBase
     MythCodecID  GetVideoCodecID(void) const override { return m_videoCodecId; } // DecoderBase
 
     void SetDisablePassThrough(bool disable) override; // DecoderBase
@@ -253,6 +255,7 @@ class AvFormatDecoder : public DecoderBase
     void UpdateFramesPlayed(void) override; // DecoderBase
     bool DoRewindSeek(long long desiredFrame) override; // DecoderBase
     void DoFastForwardSeek(long long desiredFrame, bool &needflush) override; // DecoderBase
+    void DiscardReadAhead(void) override; // DecoderBase
     virtual void StreamChangeCheck(void);
     virtual void PostProcessTracks(void) { }
     virtual bool IsValidStream(int /*streamid*/) {return true;}
@@ -261,6 +264,8 @@ class AvFormatDecoder : public DecoderBase
                     AVPacket *pkt);
 
     virtual int ReadPacket(AVFormatContext *ctx, AVPacket *pkt, bool &storePacket);
+    int NextPacket(AVPacket *pkt, bool &storePacket);
+    AVStream *GetStream(int Index) const;
 
     PrivateDecoder    *m_privateDec                   {nullptr};
 
@@ -290,11 +295,18 @@ class AvFormatDecoder : public DecoderBase
     int                m_seqCount                     {0};
 
     QList<AVPacket*>   m_storedPackets;
+    /// Reads packets ahead of decoding, when m_demuxAhead
+    DemuxThread       *m_demuxer                      {nullptr};
+    bool               m_demuxAhead                   {false};
 
     int                m_prevGopPos                   {0};
 
     // GetFrame
     bool               m_gotVideoFrame                {false};
+    /// The next video frame is the first since the streams were opened
+    bool               m_awaitingFirstFrame           {false};
+    /// The stream parameters were seeded from StreamInfoCache
+    bool               m_cachedStreamInfo             {false};
     bool               m_hasVideo                     {false};
     bool               m_needDummyVideoFrames         {false};
     bool               m_skipAudio                    {false};
@@ -638,6 +638,7 @@ bool DecoderBase::DoRewindSeek(long long desiredFrame)
         }
     }
 
+    DiscardReadAhead();
     m_ringBuffer->Seek(e.pos, SEEK_SET);
 
     return true;
@@ -864,6 +865,7 @@ void DecoderBase::DoFastForwardSeek(long long desiredFrame, bool &needflush)
 
     if (m_framesPlayed < m_lastKey)
     {
+        DiscardReadAhead();
         m_ringBuffer->Seek(e.pos, SEEK_SET);
         needflush    = true;
         m_framesPlayed = m_lastKey;
@@ -207,6 +207,8 @@ class DecoderBase
 
     virtual QString GetCodecDecoderName(void) const = 0;
     virtual QString GetRawEncodingType(void) { return QString(); }
+    /// Describes packets read ahead of decoding, if any are
+    virtual QString GetDemuxStats(void) const { return QString(); }
     virtual MythCodecID GetVideoCodecID(void) const = 0;
 
     virtual void ResetPosMap(void);
@@ -277,6 +279,8 @@ class DecoderBase
 
     virtual bool DoRewindSeek(long long desiredFrame);
     virtual void DoFastForwardSeek(long long desiredFrame, bool &needflush);
+    /// Called just before the read position is moved
+    virtual void DiscardReadAhead(void) { }
 
     long long ConditionallyUpdatePosMap(long long desiredFrame);
     long long GetLastFrameInPosMap(void) const;
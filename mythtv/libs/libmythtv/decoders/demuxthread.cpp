@@ -0,0 +1,272 @@
+// -*- Mode: c++ -*-
+
+// C++
+#include <cerrno>
+
+// Qt
+#include <QThread>
+
+// MythTV
+#include "mythcorecontext.h"
+#include "mythlogging.h"
+#include "ringbuffer.h"
+#include "demuxthread.h"
+
+#define LOC QString("DemuxThread: ")
+
+/// Most that is read ahead, enough for a couple of seconds of UHD
+static const int kMaxBytes    = 32 * 1024 * 1024;
+static const int kMaxPackets  = 2048;
+/// How much the RingBuffer should hold before a read is started
+static const int kWaitBytes   = 256 * 1024;
+/// Longest wait for it, in ms, before reading anyway
+static const int kWaitTimeout = 100;
+
+DemuxThread::DemuxThread(AVFormatContext *ic, RingBuffer *rbuffer) :
+    MThread("Demux"),
+    m_ic(ic),
+    m_ringBuffer(rbuffer)
+{
+}
+
+DemuxThread::~DemuxThread()
+{
+    {
+        QMutexLocker locker(&m_lock);
+        m_stop = true;
+        m_wait.wakeAll();
+    }
+    wait();
+    Drop();
+}
+
+void DemuxThread::run(void)
+{
+    RunProlog();
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + "Demux thread starting.");
+
+    QMutexLocker locker(&m_lock);
+    while (!m_stop)
+    {
+        if (m_hold || m_changeHold || m_error || IsFull())
+        {
+            m_wait.wait(&m_lock);
+            continue;
+        }
+
+        m_reading = true;
+        locker.unlock();
+
+        // Wait for slow storage without holding up the decoder
+        if (m_ringBuffer)
+            m_ringBuffer->WaitForReadAhead(kWaitBytes, kWaitTimeout);
+
+        AVPacket *pkt = av_packet_alloc();
+        AVMediaType type = AVMEDIA_TYPE_UNKNOWN;
+        int ret = AVERROR(EAGAIN);
+        bool read = pkt && LockCodec();
+        if (read)
+        {
+            m_streamsChanged = false;
+            ret = av_read_frame(m_ic, pkt);
+            if (ret >= 0 && pkt->stream_index < static_cast<int>(m_ic->nb_streams))
+                type = m_ic->streams[pkt->stream_index]->codecpar->codec_type;
+            avcodeclock->unlock();
+        }
+
+        locker.relock();
+        m_reading = false;
+
+        if (!read || ret < 0)
+            av_packet_free(&pkt);
+        if (read && ret < 0 && ret != AVERROR(EAGAIN))
+            m_error = ret;
+
+        if (pkt || (read && m_streamsChanged))
+        {
+            Queued queued;
+            queued.m_pkt            = pkt;
+            queued.m_type           = type;
+            queued.m_streamsChanged = read && m_streamsChanged;
+            m_queue.push_back(queued);
+            if (pkt)
+                m_queuedBytes += pkt->size;
+            if (type == AVMEDIA_TYPE_VIDEO)
+                m_queuedVideo++;
+            else if (type == AVMEDIA_TYPE_AUDIO)
+                m_queuedAudio++;
+
+            // Packets after a stream change are read once it is handled
+            if (queued.m_streamsChanged)
+                m_changeHold = true;
+        }
+        m_wait.wakeAll();
+    }
+
+    Drop();
+    locker.unlock();
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + "Demux thread exiting.");
+    RunEpilog();
+}
+
+/// \brief Takes avcodeclock, unless Flush() or Take() is waiting for us.
+bool DemuxThread::LockCodec(void)
+{
+    while (!avcodeclock->tryLock(10))
+    {
+        QMutexLocker locker(&m_lock);
+        if (m_hold || m_stop)
+            return false;
+    }
+    return true;
+}
+
+bool DemuxThread::IsFull(void) const
+{
+    return m_queuedBytes >= kMaxBytes || m_queue.size() >= kMaxPackets;
+}
+
+void DemuxThread::Drop(void)
+{
+    while (!m_queue.isEmpty())
+    {
+        Queued queued = m_queue.takeFirst();
+        av_packet_free(&queued.m_pkt);
+    }
+    m_queuedBytes = 0;
+    m_queuedVideo = 0;
+    m_queuedAudio = 0;
+}
+
+/** \fn DemuxThread::Take(AVPacket*, bool&)
+ *  \brief Moves the next packet into pkt.
+ *
+ *   When nothing has been read ahead the packet is read here, rather than
+ *   waiting for the thread, since the caller may hold avcodeclock.
+ *
+ *  \param streamsChanged set if the streams changed while it was read
+ *  \return 0, or the error av_read_frame() returned
+ */
+int DemuxThread::Take(AVPacket *pkt, bool &streamsChanged)
+{
+    streamsChanged = false;
+
+    QMutexLocker locker(&m_lock);
+
+    // Nothing is queued after a stream change, so once the queue is empty
+    // the decoder has seen the change and rescanned the streams
+    if (m_queue.isEmpty())
+        m_changeHold = false;
+
+    if (m_queue.isEmpty() && !m_error)
+    {
+        // Stop the thread reading, then check it has not just done so
+        m_hold = true;
+        while (m_reading)
+            m_wait.wait(&m_lock);
+    }
+
+    if (m_queue.isEmpty() && !m_error)
+    {
+        // Still held, so the thread cannot read the packet after this first
+        locker.unlock();
+        avcodeclock->lock();
+        int ret = av_read_frame(m_ic, pkt);
+        AVMediaType type = AVMEDIA_TYPE_UNKNOWN;
+        if (ret >= 0 && pkt->stream_index < static_cast<int>(m_ic->nb_streams))
+            type = m_ic->streams[pkt->stream_index]->codecpar->codec_type;
+        avcodeclock->unlock();
+        locker.relock();
+
+        m_takenVideo += (type == AVMEDIA_TYPE_VIDEO) ? 1 : 0;
+        m_takenAudio += (type == AVMEDIA_TYPE_AUDIO) ? 1 : 0;
+        m_hold = false;
+        m_wait.wakeAll();
+        return ret;
+    }
+
+    m_hold = false;
+    m_wait.wakeAll();
+
+    if (m_queue.isEmpty())
+    {
+        int ret = m_error;
+        m_error = 0;
+        return ret;
+    }
+
+    Queued queued = m_queue.takeFirst();
+    streamsChanged = queued.m_streamsChanged;
+    if (queued.m_type == AVMEDIA_TYPE_VIDEO)
+    {
+        m_queuedVideo--;
+        m_takenVideo++;
+    }
+    else if (queued.m_type == AVMEDIA_TYPE_AUDIO)
+    {
+        m_queuedAudio--;
+        m_takenAudio++;
+    }
+
+    if (!m_rateTimer.isRunning())
+    {
+        m_rateTimer.start();
+    }
+    else if (m_rateTimer.elapsed() >= 1000)
+    {
+        float secs = m_rateTimer.restart() / 1000.0F;
+        m_videoRate  = m_takenVideo / secs;
+        m_audioRate  = m_takenAudio / secs;
+        m_takenVideo = m_takenAudio = 0;
+        LOG(VB_PLAYBACK, LOG_DEBUG, LOC +
+            QString("Decoding %1 video and %2 audio packets/s, "
+                    "%3 packets (%4 KB) queued")
+            .arg(m_videoRate, 0, 'f', 1).arg(m_audioRate, 0, 'f', 1)
+            .arg(m_queue.size()).arg(m_queuedBytes / 1024));
+    }
+
+    if (!queued.m_pkt)
+        return AVERROR(EAGAIN);
+
+    m_queuedBytes -= queued.m_pkt->size;
+    av_packet_move_ref(pkt, queued.m_pkt);
+    av_packet_free(&queued.m_pkt);
+    return 0;
+}
+
+/** \fn DemuxThread::Flush(void)
+ *  \brief Drops everything read ahead, and stops reading until the next
+ *         Take(), so the caller may seek or change the context.
+ */
+void DemuxThread::Flush(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_hold = true;
+    while (m_reading)
+        m_wait.wait(&m_lock);
+    Drop();
+    m_changeHold = false;
+    m_error = 0;
+}
+
+/** \fn DemuxThread::StreamsChanged(void)
+ *  \brief Notes a stream change reported while this thread was reading.
+ *  \return false if called from any other thread
+ */
+bool DemuxThread::StreamsChanged(void)
+{
+    if (QThread::currentThread() != qthread())
+        return false;
+    m_streamsChanged = true;
+    return true;
+}
+
+/// \brief Queue depths and decode rates, for the OSD debug screen.
+QString DemuxThread::GetStats(void) const
+{
+    QMutexLocker locker(&m_lock);
+    return QString("%1v %2a %3 KB @ %4 fps")
+        .arg(m_queuedVideo).arg(m_queuedAudio).arg(m_queuedBytes / 1024)
+        .arg(m_videoRate, 0, 'f', 1);
+}
@@ -0,0 +1,96 @@
+// -*- Mode: c++ -*-
+
+#ifndef DEMUXTHREAD_H
+#define DEMUXTHREAD_H
+
+// Qt
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QWaitCondition>
+
+// MythTV
+#include "mthread.h"
+#include "mythtimer.h"
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+class RingBuffer;
+
+/** \class DemuxThread
+ *  \brief Reads packets from an AVFormatContext ahead of the decoder.
+ *
+ *   AvFormatDecoder used to read each packet just before decoding it, so
+ *   every wait for the storage held up decoding too.  This thread keeps a
+ *   bounded queue of packets, in file order, topped up while the decoder
+ *   works.  Like the decoder it only reads while holding avcodeclock, but
+ *   it waits for the RingBuffer to have data first, without the lock, so
+ *   that slow storage does not stop the queued packets being decoded.
+ *
+ *   The decoder calls Flush() just before it moves the read position.  The
+ *   thread then leaves the context alone until the decoder takes its next
+ *   packet.  Nothing is read after a stream change either, until the decoder
+ *   has taken every packet up to it and asks for the next one, so that it
+ *   can rescan the streams first.
+ *
+ *   av_read_frame() reallocates the stream table when it adds a stream, so
+ *   the decoder must hold avcodeclock to read m_ic->streams.
+ */
+class DemuxThread : public MThread
+{
+  public:
+    DemuxThread(AVFormatContext *ic, RingBuffer *rbuffer);
+    ~DemuxThread() override;
+
+    int     Take(AVPacket *pkt, bool &streamsChanged);
+    void    Flush(void);
+    bool    StreamsChanged(void);
+    QString GetStats(void) const;
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    struct Queued
+    {
+        AVPacket    *m_pkt            {nullptr};
+        AVMediaType  m_type           {AVMEDIA_TYPE_UNKNOWN};
+        bool         m_streamsChanged {false};
+    };
+
+    bool IsFull(void) const;
+    bool LockCodec(void);
+    void Drop(void);
+
+    AVFormatContext       *m_ic             {nullptr};
+    RingBuffer            *m_ringBuffer     {nullptr};
+
+    mutable QMutex         m_lock;
+    QWaitCondition         m_wait;
+    QList<Queued>          m_queue;
+    int                    m_queuedBytes    {0};
+    int                    m_queuedVideo    {0};
+    int                    m_queuedAudio    {0};
+    /// Set by Flush(), the context must not be touched until the next Take()
+    bool                   m_hold           {true};
+    /// Set when the streams changed, nothing more is read until the
+    /// packet after the change is asked for, or Flush()
+    bool                   m_changeHold     {false};
+    bool                   m_reading        {false};
+    bool                   m_stop           {false};
+    /// The last read failed, returned once the queue is empty
+    int                    m_error          {0};
+    /// Set by the stream change callback while this thread reads
+    bool                   m_streamsChanged {false};
+
+    // Decode throughput, in packets taken per second
+    MythTimer              m_rateTimer;
+    int                    m_takenVideo     {0};
+    int                    m_takenAudio     {0};
+    float                  m_videoRate      {0.0F};
+    float                  m_audioRate      {0.0F};
+};
+
+#endif // DEMUXTHREAD_H
@@ -0,0 +1,235 @@
+// -*- Mode: c++ -*-
+
+// C++
+#include <cstring>
+
+// MythTV
+#include "mythlogging.h"
+#include "mythavutil.h"
+#include "streaminfocache.h"
+
+extern "C" {
+#include "libavutil/pixdesc.h"
+}
+
+#define LOC QString("StreamInfoCache: ")
+
+/// Channels remembered before the least recently learnt is dropped
+static const int kMaxChannels = 200;
+
+QMutex                                    StreamInfoCache::s_lock;
+QHash<uint, StreamInfoCache::StreamList>  StreamInfoCache::s_channels;
+QList<uint>                               StreamInfoCache::s_order;
+
+bool StreamInfoCache::IsCacheable(const AVStream *stream)
+{
+    if (stream->disposition & AV_DISPOSITION_ATTACHED_PIC)
+        return false;
+    AVMediaType type = stream->codecpar->codec_type;
+    return (type == AVMEDIA_TYPE_VIDEO || type == AVMEDIA_TYPE_AUDIO) &&
+           stream->codecpar->codec_id != AV_CODEC_ID_NONE;
+}
+
+/** \fn StreamInfoCache::Learn(uint, AVFormatContext*)
+ *  \brief Remembers the parameters of the audio and video streams of ic.
+ *
+ *   Parameters the demuxer has not filled in are taken from the stream's
+ *   open decoder, if it has one.  Nothing is remembered unless every
+ *   stream's parameters are complete.  Call with avcodeclock held, as a
+ *   demux thread may be adding streams to ic.
+ */
+void StreamInfoCache::Learn(uint chanid, AVFormatContext *ic)
+{
+    if (!chanid || !ic)
+        return;
+
+    StreamList streams;
+    for (uint i = 0; i < ic->nb_streams; i++)
+    {
+        AVStream *stream = ic->streams[i];
+        if (!IsCacheable(stream))
+            continue;
+
+        const AVCodecParameters *par = stream->codecpar;
+        StreamInfo info;
+        info.m_id            = stream->id;
+        info.m_type          = par->codec_type;
+        info.m_codec         = par->codec_id;
+        info.m_profile       = par->profile;
+        info.m_level         = par->level;
+        info.m_width         = par->width;
+        info.m_height        = par->height;
+        info.m_format        = par->format;
+        info.m_aspect        = par->sample_aspect_ratio;
+        info.m_frameRate     = stream->avg_frame_rate;
+        info.m_sampleRate    = par->sample_rate;
+        info.m_channels      = par->channels;
+        info.m_channelLayout = par->channel_layout;
+        info.m_frameSize     = par->frame_size;
+        if (par->extradata && par->extradata_size > 0)
+        {
+            info.m_extradata = QByteArray(
+                reinterpret_cast<const char*>(par->extradata),
+                par->extradata_size);
+        }
+
+        const AVCodecContext *avctx = gCodecMap->hasCodecContext(stream);
+        if (avctx)
+        {
+            if (!info.m_width || !info.m_height)
+            {
+                info.m_width  = avctx->width;
+                info.m_height = avctx->height;
+            }
+            if (info.m_format < 0 && info.m_type == AVMEDIA_TYPE_VIDEO)
+            {
+                // A hardware decoder's pix_fmt says nothing about the stream
+                const AVPixFmtDescriptor *desc = av_pix_fmt_desc_get(avctx->pix_fmt);
+                info.m_format = (desc && (desc->flags & AV_PIX_FMT_FLAG_HWACCEL)) ?
+                    avctx->sw_pix_fmt : avctx->pix_fmt;
+            }
+            if (info.m_format < 0 && info.m_type == AVMEDIA_TYPE_AUDIO)
+                info.m_format = avctx->sample_fmt;
+            if (!info.m_sampleRate)
+                info.m_sampleRate = avctx->sample_rate;
+            if (!info.m_channels)
+            {
+                info.m_channels      = avctx->channels;
+                info.m_channelLayout = avctx->channel_layout;
+            }
+            if (info.m_profile == FF_PROFILE_UNKNOWN)
+                info.m_profile = avctx->profile;
+            if (info.m_level == FF_LEVEL_UNKNOWN)
+                info.m_level = avctx->level;
+        }
+
+        bool complete = (info.m_type == AVMEDIA_TYPE_VIDEO) ?
+            (info.m_width && info.m_height && info.m_format >= 0) :
+            (info.m_sampleRate && info.m_channels);
+        if (!complete)
+            return;
+        streams.push_back(info);
+    }
+
+    if (streams.isEmpty())
+        return;
+
+    QMutexLocker locker(&s_lock);
+    s_channels.insert(chanid, streams);
+    s_order.removeOne(chanid);
+    s_order.push_back(chanid);
+    while (s_order.size() > kMaxChannels)
+        s_channels.remove(s_order.takeFirst());
+
+    LOG(VB_PLAYBACK, LOG_DEBUG, LOC + QString("Learnt %1 streams of channel %2")
+        .arg(streams.size()).arg(chanid));
+}
+
+/** \fn StreamInfoCache::Seed(uint, AVFormatContext*)
+ *  \brief Fills in the parameters the demuxer does not know yet from what
+ *         was learnt the last time the channel was tuned.
+ *  \return true if every audio and video stream of ic was known
+ */
+bool StreamInfoCache::Seed(uint chanid, AVFormatContext *ic)
+{
+    if (!chanid || !ic)
+        return false;
+
+    QMutexLocker locker(&s_lock);
+    auto it = s_channels.constFind(chanid);
+    if (it == s_channels.constEnd())
+        return false;
+    const StreamList &cached = *it;
+
+    // Check everything first so that a changed PMT leaves ic untouched
+    QVector<const StreamInfo*> matches(static_cast<int>(ic->nb_streams), nullptr);
+    int seeded = 0;
+    for (uint i = 0; i < ic->nb_streams; i++)
+    {
+        const AVStream *stream = ic->streams[i];
+        if (!IsCacheable(stream))
+            continue;
+        for (const auto & info : cached)
+        {
+            if (info.m_id == stream->id &&
+                info.m_codec == stream->codecpar->codec_id)
+            {
+                matches[static_cast<int>(i)] = &info;
+                break;
+            }
+        }
+        if (!matches[static_cast<int>(i)])
+        {
+            LOG(VB_PLAYBACK, LOG_INFO, LOC +
+                QString("Channel %1 stream 0x%2 has changed, probing it")
+                .arg(chanid).arg(stream->id, 0, 16));
+            return false;
+        }
+        seeded++;
+    }
+    if (!seeded)
+        return false;
+
+    for (uint i = 0; i < ic->nb_streams; i++)
+    {
+        const StreamInfo *info = matches[static_cast<int>(i)];
+        if (!info)
+            continue;
+
+        AVStream *stream = ic->streams[i];
+        AVCodecParameters *par = stream->codecpar;
+        if (par->profile == FF_PROFILE_UNKNOWN)
+            par->profile = info->m_profile;
+        if (par->level == FF_LEVEL_UNKNOWN)
+            par->level = info->m_level;
+        if (!par->width || !par->height)
+        {
+            par->width  = info->m_width;
+            par->height = info->m_height;
+        }
+        if (par->format < 0)
+            par->format = info->m_format;
+        if (!par->sample_aspect_ratio.num)
+            par->sample_aspect_ratio = info->m_aspect;
+        if (!stream->avg_frame_rate.num && info->m_frameRate.num)
+        {
+            stream->avg_frame_rate = info->m_frameRate;
+            stream->r_frame_rate   = info->m_frameRate;
+        }
+        if (!par->sample_rate)
+            par->sample_rate = info->m_sampleRate;
+        if (!par->channels)
+        {
+            par->channels       = info->m_channels;
+            par->channel_layout = info->m_channelLayout;
+        }
+        if (!par->frame_size)
+            par->frame_size = info->m_frameSize;
+        if (!par->extradata_size && !info->m_extradata.isEmpty())
+        {
+            int size = info->m_extradata.size();
+            auto *extradata = static_cast<uint8_t*>(
+                av_mallocz(static_cast<size_t>(size) + AV_INPUT_BUFFER_PADDING_SIZE));
+            if (extradata)
+            {
+                memcpy(extradata, info->m_extradata.constData(),
+                       static_cast<size_t>(size));
+                av_freep(&par->extradata);
+                par->extradata      = extradata;
+                par->extradata_size = size;
+            }
+        }
+    }
+
+    LOG(VB_PLAYBACK, LOG_INFO, LOC + QString("Seeded %1 streams of channel %2")
+        .arg(seeded).arg(chanid));
+    return true;
+}
+
+/// \brief Drops what was learnt about a channel, so it is probed in full.
+void StreamInfoCache::Forget(uint chanid)
+{
+    QMutexLocker locker(&s_lock);
+    s_channels.remove(chanid);
+    s_order.removeOne(chanid);
+}
@@ -0,0 +1,66 @@
+// -*- Mode: c++ -*-
+
+#ifndef STREAMINFOCACHE_H
+#define STREAMINFOCACHE_H
+
+// Qt
+#include <QByteArray>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QVector>
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+/** \class StreamInfoCache
+ *  \brief Remembers the codec parameters of each channel's streams.
+ *
+ *   Probing a freshly tuned LiveTV stream with avformat_find_stream_info()
+ *   reads until every stream has been decoded far enough to know its size,
+ *   pixel format or sample rate, which often takes a second or more.  The
+ *   streams a channel carries rarely change, so what was learnt the last
+ *   time it was tuned is used to fill in the parameters the PMT does not
+ *   give, and the probe only needs to confirm them.
+ *
+ *   Entries are matched stream by stream on PID and codec, so a channel
+ *   whose PMT has changed is probed in full and learnt again.
+ */
+class StreamInfoCache
+{
+  public:
+    static void Learn(uint chanid, AVFormatContext *ic);
+    static bool Seed(uint chanid, AVFormatContext *ic);
+    static void Forget(uint chanid);
+
+  private:
+    struct StreamInfo
+    {
+        int             m_id             {0};
+        AVMediaType     m_type           {AVMEDIA_TYPE_UNKNOWN};
+        AVCodecID       m_codec          {AV_CODEC_ID_NONE};
+        int             m_profile        {FF_PROFILE_UNKNOWN};
+        int             m_level          {FF_LEVEL_UNKNOWN};
+        int             m_width          {0};
+        int             m_height         {0};
+        int             m_format         {-1};
+        AVRational      m_aspect         {0, 1};
+        AVRational      m_frameRate      {0, 1};
+        int             m_sampleRate     {0};
+        int             m_channels       {0};
+        uint64_t        m_channelLayout  {0};
+        int             m_frameSize      {0};
+        QByteArray      m_extradata;
+    };
+    using StreamList = QVector<StreamInfo>;
+
+    static bool IsCacheable(const AVStream *stream);
+
+    static QMutex                  s_lock;
+    static QHash<uint, StreamList> s_channels;
+    /// Least recently learnt first
+    static QList<uint>             s_order;
+};
+
+#endif // STREAMINFOCACHE_H
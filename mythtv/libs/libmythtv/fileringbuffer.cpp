@@ -547,9 +547,44 @@ int FileRingBuffer::safe_read(int /*fd*/, void *data, uint sz)
         if (tot < sz)
             usleep(60000);
     }
+
+    if (tot > 0)
+        AdviseReadAhead();
+
     return tot;
 }
 
+/** \fn FileRingBuffer::AdviseReadAhead(void)
+ *  \brief Asks the kernel to start reading what the read ahead thread
+ *         will want next, so that it is cached before we block on it.
+ *
+ *   The hint covers about as much as the read ahead thread keeps
+ *   buffered, and is renewed once half of it has been read.
+ */
+void FileRingBuffer::AdviseReadAhead(void)
+{
+    long long pos = lseek64(m_fd2, 0, SEEK_CUR);
+    if (pos < 0)
+        return;
+
+    long long window = min(max((long long)m_fillThreshold, 1LL << 20),
+                           16LL << 20);
+    bool hinted = (pos < m_adviseEnd) && (pos >= m_adviseEnd - 2 * window);
+    if (hinted && (pos + window / 2 < m_adviseEnd))
+        return;
+
+    long long start = hinted ? m_adviseEnd : pos;
+#ifndef _MSC_VER
+    if (posix_fadvise(m_fd2, start, pos + window - start,
+                      POSIX_FADV_WILLNEED) != 0)
+    {
+        LOG(VB_FILE, LOG_DEBUG, LOC +
+            QString("safe_read(): fadvise willneed failed: ") + ENO);
+    }
+#endif
+    m_adviseEnd = pos + window;
+}
+
 /** \fn FileRingBuffer::safe_read(RemoteFile*, void*, uint)
  *  \brief Reads data from the RemoteFile.
  *
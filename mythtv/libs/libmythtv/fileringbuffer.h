@@ -39,4 +39,10 @@ class MTV_PUBLIC FileRingBuffer : public RingBuffer
     int safe_read(RemoteFile *rf, void *data, uint sz);
     long long GetRealFileSizeInternal(void) const override; // RingBuffer
     long long SeekInternal(long long pos, int whence) override; // RingBuffer
+
+  private:
+    void AdviseReadAhead(void);
+
+    /// End of the last posix_fadvise() WILLNEED hint
+    long long m_adviseEnd {0};
 };
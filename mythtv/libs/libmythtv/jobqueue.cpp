@@ -12,6 +12,7 @@ using namespace std;
 #include <QFileInfo>
 #include <QRegExp>
 #include <QEvent>
+#include <QThread>
 #include <QCoreApplication>
 
 #include "mythconfig.h"
@@ -22,6 +23,7 @@ using namespace std;
 #include "mythcorecontext.h"
 #include "mythdate.h"
 #include "previewgenerator.h"
+#include "trickplayindex.h"
 #include "compat.h"
 #include "recordingprofile.h"
 #include "recordinginfo.h"
@@ -89,6 +91,15 @@ void JobQueue::customEvent(QEvent *e)
             return;
         QString message = me->Message();
 
+        if (message == "JOBQUEUE_CHANGED")
+        {
+            // A job was queued, had its commands changed or finished
+            // somewhere, re-evaluate the queue now instead of waiting
+            // for the next periodic check.
+            WakeQueue();
+            return;
+        }
+
         if (message.startsWith("LOCAL_JOB"))
         {
             // LOCAL_JOB action ID jobID
@@ -161,6 +172,18 @@ void JobQueue::run(void)
     ProcessQueue();
 }
 
+void JobQueue::WakeQueue(void)
+{
+    QMutexLocker locker(&m_queueThreadCondLock);
+    m_queueChanged = true;
+    m_queueThreadCond.wakeAll();
+}
+
+void JobQueue::NotifyQueueChanged(void)
+{
+    gCoreContext->SendEvent(MythEvent("JOBQUEUE_CHANGED"));
+}
+
 void JobQueue::ProcessQueue(void)
 {
     LOG(VB_JOBQUEUE, LOG_INFO, LOC + "ProcessQueue() started");
@@ -182,11 +205,22 @@ void JobQueue::ProcessQueue(void)
         locker.unlock();
 
         bool startedJobAlready = false;
+        bool atCapacity = false;
         int sleepTime = gCoreContext->GetNumSetting("JobQueueCheckFrequency", 30);
         int maxJobs = gCoreContext->GetNumSetting("JobQueueMaxSimultaneousJobs", 3);
-        LOG(VB_JOBQUEUE, LOG_INFO, LOC +
-            QString("Currently set to run up to %1 job(s) max.")
-                        .arg(maxJobs));
+        if (maxJobs > 0)
+        {
+            LOG(VB_JOBQUEUE, LOG_INFO, LOC +
+                QString("Currently set to run up to %1 job(s) max.")
+                            .arg(maxJobs));
+        }
+        else
+        {
+            LOG(VB_JOBQUEUE, LOG_INFO, LOC +
+                QString("Currently set to run jobs based on load "
+                        "across %1 CPU core(s).")
+                            .arg(QThread::idealThreadCount()));
+        }
 
         jobStatus.clear();
 
@@ -200,6 +234,7 @@ void JobQueue::ProcessQueue(void)
         m_runningJobsLock->unlock();
 
         m_jobsRunning = 0;
+        m_jobWeightRunning = 0;
         GetJobsInQueue(jobs);
 
         if (!jobs.empty())
@@ -214,7 +249,10 @@ void JobQueue::ProcessQueue(void)
                      (status == JOB_STARTING) ||
                      (status == JOB_PAUSED)) &&
                     (hostname == m_hostname))
-                m_jobsRunning++;
+                {
+                    m_jobsRunning++;
+                    m_jobWeightRunning += JobWeight(job.type);
+                }
             }
 
             message = QString("Currently Running %1 jobs.")
@@ -226,7 +264,7 @@ void JobQueue::ProcessQueue(void)
                                    "started.");
                 LOG(VB_JOBQUEUE, LOG_INFO, LOC + message);
             }
-            else if (m_jobsRunning >= maxJobs)
+            else if ((maxJobs > 0) && (m_jobsRunning >= maxJobs))
             {
                 message += " (At Maximum, no new jobs can be started until "
                            "a running job completes)";
@@ -244,7 +282,8 @@ void JobQueue::ProcessQueue(void)
 
 
             for ( int x = 0;
-                 (x < jobs.size()) && (m_jobsRunning < maxJobs); x++)
+                 (x < jobs.size()) && (maxJobs <= 0 || m_jobsRunning < maxJobs);
+                 x++)
             {
                 int jobID = jobs[x].id;
                 int cmds = jobs[x].cmds;
@@ -423,10 +462,21 @@ void JobQueue::ProcessQueue(void)
                     continue;
                 }
 
-                // never start or claim more than one job in a single run
-                if (startedJobAlready)
+                // Once a job did not fit, don't let later (lighter) jobs
+                // jump ahead of it, and don't claim jobs we can't start.
+                if (atCapacity)
                     continue;
 
+                if (inTimeWindow && !HaveCapacityFor(jobs[x], maxJobs))
+                {
+                    message = QString("Deferring '%1' job for %2, not enough "
+                                      "free CPU capacity on this backend.")
+                                      .arg(JobText(jobs[x].type)).arg(logInfo);
+                    LOG(VB_JOBQUEUE, LOG_INFO, LOC + message);
+                    atCapacity = true;
+                    continue;
+                }
+
                 if ((inTimeWindow) &&
                     (hostname.isEmpty()) &&
                     (!ChangeJobHost(jobID, m_hostname)))
@@ -455,6 +505,8 @@ void JobQueue::ProcessQueue(void)
 
                 ProcessJob(jobs[x]);
 
+                m_jobsRunning++;
+                m_jobWeightRunning += JobWeight(jobs[x].type);
                 startedJobAlready = true;
             }
         }
@@ -482,16 +534,70 @@ void JobQueue::ProcessQueue(void)
         }
 
 
+        // Queue changes, job completions and commands arrive as
+        // JOBQUEUE_CHANGED events and wake us up immediately, the
+        // periodic check is only a fallback for missed events and for
+        // jobs whose scheduled run time or run window arrives.
         locker.relock();
-        if (m_processQueue)
+        if (m_processQueue && !m_queueChanged)
         {
             int st = (startedJobAlready) ? (5 * 1000) : (sleepTime * 1000);
             if (st > 0)
                 m_queueThreadCond.wait(locker.mutex(), st);
         }
+        m_queueChanged = false;
     }
 }
 
+/** \brief Relative amount of CPU a job of the given type is expected to use.
+ *
+ *  Used for load based admission, a weight of one roughly corresponds to
+ *  one fully used CPU core.
+ */
+int JobQueue::JobWeight(int jobType)
+{
+    if (jobType == JOB_TRANSCODE)
+        return 2;
+    if (jobType == JOB_METADATA)
+        return 0;
+    return 1;
+}
+
+/** \brief Determine whether this backend has room to start another job.
+ *
+ *  With a fixed JobQueueMaxSimultaneousJobs the running job count is the
+ *  only limit.  When it is set to 0 (automatic) jobs are admitted while
+ *  the expected CPU usage of the running jobs fits within the number of
+ *  CPU cores and the system load average leaves room for another job.
+ *  Where no load average is available, one job per core is allowed.
+ *  At least one job is always allowed to run.
+ */
+bool JobQueue::HaveCapacityFor(const JobQueueEntry &job, int maxJobs) const
+{
+    if (maxJobs > 0)
+        return m_jobsRunning < maxJobs;
+
+    if (m_jobsRunning == 0)
+        return true;
+
+    int cores = max(QThread::idealThreadCount(), 1);
+    if (m_jobWeightRunning + JobWeight(job.type) > cores)
+        return false;
+
+#if !defined(Q_OS_ANDROID) && !defined(_WIN32)
+    double loads[3];
+    if (getloadavg(loads, 3) != -1)
+    {
+        double maxLoad =
+            gCoreContext->GetFloatSetting("JobQueueMaxLoadPerCore", 1.0);
+        return loads[0] < (maxLoad * cores);
+    }
+#endif
+
+    // No load average on this platform, allow one job per core.
+    return m_jobsRunning < cores;
+}
+
 bool JobQueue::QueueRecordingJobs(const RecordingInfo &recinfo, int jobTypes)
 {
     if (jobTypes == JOB_NONE)
@@ -595,6 +701,8 @@ bool JobQueue::QueueJob(int jobType, uint chanid, const QDateTime &recstartts,
         return false;
     }
 
+    NotifyQueueChanged();
+
     return true;
 }
 
@@ -632,6 +740,11 @@ bool JobQueue::QueueJobs(int jobTypes, uint chanid, const QDateTime &recstartts,
         }
     }
 
+    // Queued with the other recording jobs.  A transcode job queues it
+    // again once it has replaced the file.
+    if (jobTypes & JOB_TRICKPLAY)
+        QueueJob(JOB_TRICKPLAY, chanid, recstartts, args, comment, host);
+
     if (jobTypes & JOB_USERJOB1)
         QueueJob(JOB_USERJOB1, chanid, recstartts, args, comment, host);
     if (jobTypes & JOB_USERJOB2)
@@ -937,6 +1050,9 @@ bool JobQueue::ChangeJobCmds(int jobID, int newCmds)
         return false;
     }
 
+    if (newCmds != JOB_RUN)
+        NotifyQueueChanged();
+
     return true;
 }
 
@@ -959,6 +1075,9 @@ bool JobQueue::ChangeJobCmds(int jobType, uint chanid,
         return false;
     }
 
+    if (newCmds != JOB_RUN)
+        NotifyQueueChanged();
+
     return true;
 }
 
@@ -1119,6 +1238,7 @@ QString JobQueue::JobText(int jobType)
         case JOB_TRANSCODE:  return tr("Transcode");
         case JOB_COMMFLAG:   return tr("Flag Commercials");
         case JOB_METADATA:   return tr("Look up Metadata");
+        case JOB_TRICKPLAY:  return tr("Build Trickplay Index");
     }
 
     if (jobType & JOB_USERJOB)
@@ -1449,6 +1569,8 @@ bool JobQueue::AllowedToRun(const JobQueueEntry& job)
                                  break;
             case JOB_PREVIEW:    allowSetting = "JobAllowPreview";
                                  break;
+            case JOB_TRICKPLAY:  allowSetting = "JobAllowTrickplay";
+                                 break;
             default:             return false;
         }
     }
@@ -1755,6 +1877,10 @@ void JobQueue::ProcessJob(const JobQueueEntry& job)
     {
         StartChildJob(MetadataLookupThread, jobID);
     }
+    else if (job.type == JOB_TRICKPLAY)
+    {
+        StartChildJob(TrickplayThread, jobID);
+    }
     else if (job.type & JOB_USERJOB)
     {
         StartChildJob(UserJobThread, jobID);
@@ -1789,6 +1915,8 @@ QString JobQueue::GetJobDescription(int jobType)
         return "Transcode";
     if (jobType == JOB_COMMFLAG)
         return "Commercial Detection";
+    if (jobType == JOB_TRICKPLAY)
+        return "Trickplay Index";
     if (!(jobType & JOB_USERJOB))
         return "Unknown Job";
 
@@ -1865,6 +1993,11 @@ void JobQueue::RemoveRunningJob(int id)
     }
 
     m_runningJobsLock->unlock();
+
+    // Free capacity here and let other hosts start jobs that were
+    // waiting on this recording.
+    WakeQueue();
+    NotifyQueueChanged();
 }
 
 QString JobQueue::PrettyPrint(off_t bytes)
@@ -2096,6 +2229,14 @@ void JobQueue::DoTranscodeThread(int jobID)
                 }
 
                 program_info->SaveTranscodeStatus(TRANSCODING_COMPLETE);
+
+                // The old thumbnails no longer match the new file
+                if (gCoreContext->GetNumSetting("TrickplayInterval", 0) > 0)
+                {
+                    QueueJob(JOB_TRICKPLAY, program_info->GetChanID(),
+                             program_info->GetRecordingStartTime(), "", "",
+                             "");
+                }
             }
             else
             {
@@ -2401,6 +2542,101 @@ void JobQueue::DoFlagCommercialsThread(int jobID)
     m_runningJobsLock->unlock();
 }
 
+void *JobQueue::TrickplayThread(void *param)
+{
+    auto *jts = (JobThreadStruct *)param;
+    JobQueue *jq = jts->jq;
+
+    MThread::ThreadSetup(QString("Trickplay_%1").arg(jts->jobID));
+    jq->DoTrickplayThread(jts->jobID);
+    MThread::ThreadCleanup();
+
+    delete jts;
+
+    return nullptr;
+}
+
+/** \brief Builds the trickplay thumbnail index of a finished recording.
+ *
+ *   This runs in process, TrickplayIndex::Generate() jumps between the
+ *   sample points with the recording's seek table.  It checks for a
+ *   stop request before each thumbnail.
+ */
+void JobQueue::DoTrickplayThread(int jobID)
+{
+    m_runningJobsLock->lock();
+    ProgramInfo *program_info = m_runningJobs[jobID].pginfo;
+    if (!program_info)
+    {
+        ChangeJobStatus(jobID, JOB_ERRORED, "ProgramInfo data not found");
+        RemoveRunningJob(jobID);
+        m_runningJobsLock->unlock();
+        return;
+    }
+    m_runningJobsLock->unlock();
+
+    QString detailstr = QString("%1 recorded from channel %3")
+        .arg(program_info->toString(ProgramInfo::kTitleSubtitle))
+        .arg(program_info->toString(ProgramInfo::kRecordingKey));
+
+    uint interval = gCoreContext->GetNumSetting("TrickplayInterval", 0);
+    if (!interval)
+    {
+        ChangeJobStatus(jobID, JOB_CANCELLED, tr("Trickplay index disabled"));
+        m_runningJobsLock->lock();
+        RemoveRunningJob(jobID);
+        m_runningJobsLock->unlock();
+        return;
+    }
+
+    LOG(VB_GENERAL, LOG_INFO,
+        LOC + "Trickplay Index Starting for " + detailstr);
+    ChangeJobStatus(jobID, JOB_RUNNING);
+
+    auto stopped = [this, jobID]()
+    {
+        QMutexLocker locker(m_runningJobsLock);
+        return m_runningJobs[jobID].flag == JOB_STOP;
+    };
+
+    QString filename = program_info->GetPlaybackURL(false, true);
+    bool ok = QFileInfo::exists(filename) &&
+        TrickplayIndex::Generate(
+            *program_info, filename, interval,
+            QSize(gCoreContext->GetNumSetting("TrickplayWidth", 160), 0),
+            stopped);
+
+    m_runningJobsLock->lock();
+
+    QString comment;
+    if (m_runningJobs[jobID].flag == JOB_STOP)
+    {
+        comment = tr("Aborted by user");
+        ChangeJobStatus(jobID, JOB_ABORTED, comment);
+    }
+    else if (!ok)
+    {
+        comment = tr("Unable to build the trickplay index");
+        ChangeJobStatus(jobID, JOB_ERRORED, comment);
+    }
+    else
+    {
+        ChangeJobStatus(jobID, JOB_FINISHED, tr("Finished."));
+        program_info->SendUpdateEvent();
+    }
+
+    QString msg = tr("Trickplay Index %1", "Job ID")
+        .arg(StatusText(GetJobStatus(jobID)));
+    if (!comment.isEmpty())
+        LOG(VB_GENERAL, LOG_ERR, LOC + msg + ": " + detailstr + " (" +
+            comment + ")");
+    else
+        LOG(VB_GENERAL, LOG_INFO, LOC + msg + ": " + detailstr);
+
+    RemoveRunningJob(jobID);
+    m_runningJobsLock->unlock();
+}
+
 void *JobQueue::UserJobThread(void *param)
 {
     auto *jts = (JobThreadStruct *)param;
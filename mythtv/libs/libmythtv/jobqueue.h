@@ -78,6 +78,7 @@ enum JobTypes {
     JOB_COMMFLAG     = 0x0002,
     JOB_METADATA     = 0x0004,
     JOB_PREVIEW      = 0x0008,
+    JOB_TRICKPLAY    = 0x0010,
 
     JOB_USERJOB      = 0xff00,
     JOB_USERJOB1     = 0x0100,
@@ -90,6 +91,7 @@ static QMap< QString, int > JobNameToType {
     { "Transcode", JOB_TRANSCODE },
     { "Commflag",  JOB_COMMFLAG },
     { "Metadata",  JOB_METADATA },
+    { "Trickplay", JOB_TRICKPLAY },
     { "UserJob1",  JOB_USERJOB1 },
     { "UserJob2",  JOB_USERJOB2 },
     { "UserJob3",  JOB_USERJOB3 },
@@ -228,6 +230,11 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     void ProcessJob(const JobQueueEntry& job);
 
     bool AllowedToRun(const JobQueueEntry& job);
+    bool HaveCapacityFor(const JobQueueEntry& job, int maxJobs) const;
+    static int JobWeight(int jobType);
+
+    void WakeQueue(void);
+    static void NotifyQueueChanged(void);
 
     static bool InJobRunWindow(int orStartsWithinMins = 0);
 
@@ -248,12 +255,16 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     static void *FlagCommercialsThread(void *param);
     void DoFlagCommercialsThread(int jobID);
 
+    static void *TrickplayThread(void *param);
+    void DoTrickplayThread(int jobID);
+
     static void *UserJobThread(void *param);
     void DoUserJobThread(int jobID);
 
     QString                    m_hostname;
 
     int                        m_jobsRunning         {0};
+    int                        m_jobWeightRunning    {0};
     int                        m_jobQueueCPU         {0};
 
     ProgramInfo               *m_pginfo              {nullptr};
@@ -270,6 +281,7 @@ class MTV_PUBLIC JobQueue : public QObject, public QRunnable
     QWaitCondition             m_queueThreadCond;
     QMutex                     m_queueThreadCondLock;
     bool                       m_processQueue        {false};
+    bool                       m_queueChanged        {false};
 };
 
 #endif
@@ -134,6 +134,7 @@ HEADERS += signalmonitorvalue.h     signalmonitorlistener.h
 HEADERS += livetvchain.h            playgroup.h
 HEADERS += channelsettings.h
 HEADERS += previewgenerator.h       previewgeneratorqueue.h
+HEADERS += trickplayindex.h
 HEADERS += transporteditor.h        listingsources.h
 HEADERS += channelgroup.h
 HEADERS += recordingrule.h
@@ -164,6 +165,7 @@ SOURCES += signalmonitorvalue.cpp
 SOURCES += livetvchain.cpp          playgroup.cpp
 SOURCES += channelsettings.cpp
 SOURCES += previewgenerator.cpp     previewgeneratorqueue.cpp
+SOURCES += trickplayindex.cpp
 SOURCES += transporteditor.cpp
 SOURCES += channelgroup.cpp
 SOURCES += recordingrule.cpp
@@ -368,11 +370,15 @@ using_frontend {
     HEADERS += decoders/avformatdecoder.h
     HEADERS += decoders/privatedecoder.h
     HEADERS += decoders/mythcodeccontext.h
+    HEADERS += decoders/streaminfocache.h
+    HEADERS += decoders/demuxthread.h
     SOURCES += decoders/decoderbase.cpp
     SOURCES += decoders/nuppeldecoder.cpp
     SOURCES += decoders/avformatdecoder.cpp
     SOURCES += decoders/privatedecoder.cpp
     SOURCES += decoders/mythcodeccontext.cpp
+    SOURCES += decoders/streaminfocache.cpp
+    SOURCES += decoders/demuxthread.cpp
 
     using_libass {
         DEFINES += USING_LIBASS
@@ -776,6 +782,7 @@ using_backend {
     HEADERS += recorders/rtp/rtpdatapacket.h
     HEADERS += recorders/rtp/rtpfecpacket.h
     HEADERS += recorders/rtp/rtcpdatapacket.h
+    !mingw:!win32-msvc*:HEADERS += recorders/rtp/udpbatchreader.h
 
     SOURCES += recorders/cetonrtsp.cpp
     SOURCES += recorders/iptvchannel.cpp
@@ -786,6 +793,7 @@ using_backend {
 
     SOURCES += recorders/rtp/packetbuffer.cpp
     SOURCES += recorders/rtp/rtppacketbuffer.cpp
+    !mingw:!win32-msvc*:SOURCES += recorders/rtp/udpbatchreader.cpp
 
     # Support for HTTP TS streams
     HEADERS += recorders/httptsstreamhandler.h
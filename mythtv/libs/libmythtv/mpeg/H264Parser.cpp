@@ -335,6 +335,19 @@ bool H264Parser::new_AU(void)
     return result;
 }
 
+/** \fn H264Parser::Resync(void)
+ *  \brief Drops any partly received NAL unit, after the caller has lost
+ *         some of the stream.
+ *
+ *   Unlike Reset() what was learnt from the SPS is kept, so that frames
+ *   continue to be found from the next start code on.
+ */
+void H264Parser::Resync(void)
+{
+    m_syncAccumulator = 0xffffffff;
+    resetRBSP();
+}
+
 void H264Parser::resetRBSP(void)
 {
     m_rbspIndex = 0;
@@ -136,6 +136,7 @@ class H264Parser {
                       uint32_t  byte_count,
                       uint64_t  stream_offset);
     void Reset(void);
+    void Resync(void);
 
     static QString NAL_type_str(uint8_t type);
 
@@ -143,6 +143,7 @@ void MPEGStreamData::Reset(int desiredProgram)
     m_pidsAudio.clear();
 
     m_pidVideoSingleProgram = m_pidPmtSingleProgram = 0xffffffff;
+    m_pidVersion++;
 
     m_patStatus.clear();
 
@@ -596,6 +597,7 @@ bool MPEGStreamData::CreatePMTSingleProgram(const ProgramMapTable &pmt)
 
     m_pidsWriting.clear();
     m_pidVideoSingleProgram = !videoPIDs.empty() ? videoPIDs[0] : 0xffffffff;
+    m_pidVersion++;
     for (size_t i = 1; i < videoPIDs.size(); i++)
         AddWritingPID(videoPIDs[i]);
 
@@ -1819,6 +1821,7 @@ void MPEGStreamData::ResetDecryptionMonitoringState(void)
     m_encryptionPidToInfo.clear();
     m_encryptionPidToPnums.clear();
     m_encryptionPnumToPids.clear();
+    m_pidVersion++;
 }
 
 bool MPEGStreamData::IsProgramDecrypted(uint pnum) const
@@ -4,6 +4,7 @@
 #define MPEGSTREAMDATA_H_
 
 // C++
+#include <atomic>
 #include <cstdint>  // uint64_t
 #include <vector>
 using namespace std;
@@ -116,25 +117,26 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     virtual bool ProcessTSPacket(const TSPacket& tspacket);
     virtual int  ProcessData(const unsigned char *buffer, int len);
     inline  void HandleAdaptationFieldControl(const TSPacket* tspacket);
+    static int ResyncStream(const unsigned char *buffer, int curr_pos, int len);
 
     // Listening
     virtual void AddListeningPID(
         uint pid, PIDPriority priority = kPIDPriorityNormal)
-        { m_pidsListening[pid] = priority; }
+        { AddPID(m_pidsListening, pid, priority); }
     virtual void AddNotListeningPID(uint pid)
         { m_pidsNotListening[pid] = kPIDPriorityNormal; }
     virtual void AddWritingPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsWriting[pid] = priority; }
+        { AddPID(m_pidsWriting, pid, priority); }
     virtual void AddAudioPID(
         uint pid, PIDPriority priority = kPIDPriorityHigh)
-        { m_pidsAudio[pid] = priority; }
+        { AddPID(m_pidsAudio, pid, priority); }
 
-    virtual void RemoveListeningPID(uint pid) { m_pidsListening.remove(pid);  }
+    virtual void RemoveListeningPID(uint pid) { RemovePID(m_pidsListening, pid); }
     virtual void RemoveNotListeningPID(uint pid)
         { m_pidsNotListening.remove(pid); }
-    virtual void RemoveWritingPID(uint pid) { m_pidsWriting.remove(pid);    }
-    virtual void RemoveAudioPID(uint pid)   { m_pidsAudio.remove(pid);      }
+    virtual void RemoveWritingPID(uint pid) { RemovePID(m_pidsWriting, pid);   }
+    virtual void RemoveAudioPID(uint pid)   { RemovePID(m_pidsAudio, pid);     }
 
     virtual bool IsListeningPID(uint pid) const;
     virtual bool IsNotListeningPID(uint pid) const;
@@ -142,6 +144,16 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     bool IsVideoPID(uint pid) const
         { return m_pidVideoSingleProgram == pid; }
     virtual bool IsAudioPID(uint pid) const;
+    /// True if ProcessTSPacket() does anything with packets on pid
+    virtual bool IsProcessingPID(uint pid) const
+    {
+        return IsVideoPID(pid) || IsAudioPID(pid) || IsWritingPID(pid) ||
+            IsListeningPID(pid) || IsEncryptionTestPID(pid);
+    }
+
+    /// Changes whenever the PIDs IsProcessingPID() is true for may have
+    /// changed, so callers can cache it per PID until then
+    uint GetPIDVersion(void) const { return m_pidVersion; }
 
     const pid_map_t& ListeningPIDs(void) const
         { return m_pidsListening; }
@@ -290,8 +302,6 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     void ProcessPMT(const ProgramMapTable *pmt);
     void ProcessEncryptedPacket(const TSPacket &tspacket);
 
-    static int ResyncStream(const unsigned char *buffer, int curr_pos, int len);
-
     void UpdateTimeOffset(uint64_t si_utc_time);
 
     // Caching
@@ -301,6 +311,18 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     void CacheCAT(const ConditionalAccessTable *_cat);
     void CachePMT(const ProgramMapTable *pmt);
 
+    void AddPID(pid_map_t &pids, uint pid, PIDPriority priority)
+    {
+        if (!pids.contains(pid))
+            m_pidVersion++;
+        pids[pid] = priority;
+    }
+    void RemovePID(pid_map_t &pids, uint pid)
+    {
+        if (pids.remove(pid))
+            m_pidVersion++;
+    }
+
   protected:
     int                       m_cardId;
     QString                   m_siStandard                  {"mpeg"};
@@ -321,6 +343,7 @@ class MTV_PUBLIC MPEGStreamData : public EITSource
     pid_map_t                 m_pidsNotListening;
     pid_map_t                 m_pidsWriting;
     pid_map_t                 m_pidsAudio;
+    std::atomic<uint>         m_pidVersion                  {0};
     bool                      m_listeningDisabled           {false};
 
     // Encryption monitoring
@@ -11,7 +11,10 @@ ScanStreamData::ScanStreamData(bool no_default_pid) :
     m_noDefaultPid(no_default_pid)
 {
     if (m_noDefaultPid)
+    {
         m_pidsListening.clear();
+        m_pidVersion++;
+    }
 }
 
 ScanStreamData::~ScanStreamData() { ; }
@@ -44,6 +47,7 @@ void ScanStreamData::Reset(void)
     if (m_noDefaultPid)
     {
         m_pidsListening.clear();
+        m_pidVersion++;
         return;
     }
 
@@ -745,6 +745,12 @@ int MythPlayer::OpenFile(int Retries)
     m_isDummy = false;
     m_liveTV = m_playerCtx->m_tvchain && m_playerCtx->m_buffer->LiveMode();
 
+    // Time LiveTV startup like a channel change, unless it is one
+    m_tuneLock.lock();
+    if (m_liveTV && !m_tuneTimer.isValid())
+        m_tuneTimer.start();
+    m_tuneLock.unlock();
+
     // Dummy setup for livetv transtions. Can we get rid of this?
     if (m_playerCtx->m_tvchain)
     {
@@ -2512,8 +2518,39 @@ void MythPlayer::FileChanged(void)
     m_forcePositionMapSync = true;
 }
 
+/// \brief Starts timing a LiveTV channel change, called as it is asked for.
+void MythPlayer::StartTuneTimer(void)
+{
+    QMutexLocker locker(&m_tuneLock);
+    m_tuneTimer.start();
+}
 
+/** \brief Called from the decoder thread with the first video frame of a
+ *         newly opened or changed stream.
+ *
+ *   Logs how long it took from the channel change being asked for, and
+ *   keeps it for TV::GetStatus().
+ */
+void MythPlayer::FirstFrameDecoded(bool CachedStreamInfo)
+{
+    QMutexLocker locker(&m_tuneLock);
+    if (!m_tuneTimer.isValid())
+        return;
 
+    m_lastTuneLatency = static_cast<int>(m_tuneTimer.elapsed());
+    m_tuneTimer.invalidate();
+    LOG(VB_PLAYBACK, LOG_INFO, LOC +
+        QString("Tune to first frame took %1 ms (%2 stream info)")
+        .arg(m_lastTuneLatency).arg(CachedStreamInfo ? "cached" : "probed"));
+}
+
+/// \return milliseconds from the last channel change to its first frame,
+///         or -1 if none has been timed
+int MythPlayer::GetLastTuneLatency(void) const
+{
+    QMutexLocker locker(&m_tuneLock);
+    return m_lastTuneLatency;
+}
 
 void MythPlayer::JumpToProgram(void)
 {
@@ -4665,6 +4702,27 @@ void MythPlayer::InitForTranscode(bool copyaudio, bool copyvideo)
     }
 }
 
+/** \fn MythPlayer::TranscodeSeek(uint64_t)
+ *  \brief Start a transcode at \p frame rather than at the beginning.
+ *
+ *   Must be called before the first TranscodeGetNextFrame().  The decoder
+ *   seeks to the keyframe before \p frame and decodes up to it, so the
+ *   first frame returned is \p frame itself.
+ */
+bool MythPlayer::TranscodeSeek(uint64_t frame)
+{
+    if (!m_decoderThread)
+        DecoderStart(true/*start paused*/);
+
+    if (!m_decoder)
+        return false;
+
+    WaitForSeek(frame, 0);
+    m_decoder->ClearStoredData();
+    ClearAfterSeek();
+    return GetEof() == kEofStateNone;
+}
+
 bool MythPlayer::TranscodeGetNextFrame(
     int &did_ff, bool &is_key, bool honorCutList)
 {
@@ -4781,6 +4839,7 @@ void MythPlayer::GetPlaybackData(InfoMap &infoMap)
     infoMap.insert("storagerate", m_playerCtx->m_buffer->GetStorageRate());
     infoMap.insert("bufferavail", m_playerCtx->m_buffer->GetAvailableBuffer());
     infoMap.insert("buffersize",  QString::number(m_playerCtx->m_buffer->GetBufferSize() >> 20));
+    infoMap.insert("readahead",   m_playerCtx->m_buffer->GetReadAheadStats());
     int avsync = m_avsyncAvg / 1000;
     infoMap.insert("avsync", tr("%1 ms").arg(avsync));
 
@@ -4791,7 +4850,10 @@ void MythPlayer::GetPlaybackData(InfoMap &infoMap)
         infoMap.insert("videoframes", frames);
     }
     if (m_decoder)
+    {
         infoMap["videodecoder"] = m_decoder->GetCodecDecoderName();
+        infoMap["demuxqueue"]   = m_decoder->GetDemuxStats();
+    }
     if (m_outputJmeter)
     {
         infoMap["framerate"] = QString("%1%2%3")
@@ -285,6 +285,7 @@ class MTV_PUBLIC MythPlayer
 
     // Transcode stuff
     void InitForTranscode(bool copyaudio, bool copyvideo);
+    bool TranscodeSeek(uint64_t frame);
     bool TranscodeGetNextFrame(int &did_ff, bool &is_key, bool honorCutList);
     bool WriteStoredData(
         RingBuffer *outRingBuffer, bool writevideo, long timecodeOffset);
@@ -353,6 +354,9 @@ class MTV_PUBLIC MythPlayer
     // LiveTV public stuff
     void CheckTVChain();
     void FileChangedCallback();
+    void StartTuneTimer(void);
+    void FirstFrameDecoded(bool CachedStreamInfo);
+    int  GetLastTuneLatency(void) const;
 
     // Chapter public stuff
     virtual int  GetNumChapters(void);
@@ -876,6 +880,10 @@ class MTV_PUBLIC MythPlayer
     // LiveTV
     TV *m_tv                              {nullptr};
     bool m_isDummy                        {false};
+    /// Time since the channel change was asked for, until its first frame
+    mutable QMutex m_tuneLock;
+    QElapsedTimer  m_tuneTimer;
+    int  m_lastTuneLatency                {-1};
 
     // Counter for buffering messages
     int  m_bufferingCounter               {0};
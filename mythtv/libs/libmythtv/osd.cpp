@@ -630,6 +630,25 @@ void OSD::SetGraph(const QString &Window, const QString &Graph, int64_t Timecode
         image->SetImage(mi);
 }
 
+void OSD::SetImage(const QString &Window, const QString &Widget,
+                   const QImage &Image, OSDTimeout Timeout)
+{
+    MythScreenType *win = GetWindow(Window);
+    if (!win || !m_currentPainter)
+        return;
+
+    auto *uiimage = dynamic_cast<MythUIImage* >(win->GetChild(Widget));
+    if (!uiimage)
+        return;
+
+    MythImage *image = m_currentPainter->GetFormatImage();
+    image->Assign(Image.scaled(uiimage->GetArea().size(), Qt::KeepAspectRatio,
+                               Qt::SmoothTransformation));
+    uiimage->SetImage(image);
+    image->DecrRef();
+    SetExpiry(Window, Timeout);
+}
+
 bool OSD::Draw(MythPainter* Painter, QSize Size, bool Repaint)
 {
     if (!Painter)
@@ -4,6 +4,7 @@
 // Qt
 #include <QCoreApplication>
 #include <QHash>
+#include <QImage>
 
 // MythTV
 #include "mythtvexp.h"
@@ -162,6 +163,8 @@ class OSD
     void SetText(const QString &Window, const InfoMap &Map, OSDTimeout Timeout);
     void SetRegions(const QString &Window, frm_dir_map_t &Map, long long Total);
     void SetGraph(const QString &Window, const QString &Graph, int64_t Timecode);
+    void SetImage(const QString &Window, const QString &Widget,
+                  const QImage &Image, OSDTimeout Timeout);
     bool IsWindowVisible(const QString &Window);
 
     bool DialogVisible(const QString& Window = QString());
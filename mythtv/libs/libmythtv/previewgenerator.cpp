@@ -87,7 +87,6 @@ PreviewGenerator::PreviewGenerator(const ProgramInfo *pginfo,
 PreviewGenerator::~PreviewGenerator()
 {
     TeardownAll();
-    wait();
 }
 
 void PreviewGenerator::SetOutputFilename(const QString &fileName)
@@ -124,6 +123,17 @@ void PreviewGenerator::AttachSignals(QObject *obj)
 bool PreviewGenerator::RunReal(void)
 {
     QString msg;
+    bool ok = DoRunReal(msg);
+    PostResult(ok, msg);
+    return ok;
+}
+
+/** \fn PreviewGenerator::DoRunReal(QString&)
+ *  \brief Creates the preview in this process, without telling the
+ *         listener about the result.
+ */
+bool PreviewGenerator::DoRunReal(QString &msg)
+{
     QTime tm = QTime::currentTime();
     QElapsedTimer te; te.start();
     bool ok = false;
@@ -176,38 +186,23 @@ bool PreviewGenerator::RunReal(void)
         msg = "Could not access recording";
     }
 
-    QMutexLocker locker(&m_previewLock);
-    if (m_listener)
-    {
-        // keep in sync with default filename in
-        // PreviewGeneratorQueue::GeneratePreviewImage
-        QString output_fn = m_outFileName.isEmpty() ?
-            (m_programInfo.GetPathname()+".png") : m_outFileName;
-
-        QDateTime dt;
-        if (ok)
-        {
-            QFileInfo fi(output_fn);
-            if (fi.exists())
-                dt = fi.lastModified();
-        }
-
-        QString message = (ok) ? "PREVIEW_SUCCESS" : "PREVIEW_FAILED";
-        QStringList list;
-        list.push_back(QString::number(m_programInfo.GetRecordingID()));
-        list.push_back(output_fn);
-        list.push_back(msg);
-        list.push_back(dt.isValid()?dt.toUTC().toString(Qt::ISODate):"");
-        list.push_back(m_token);
-        QCoreApplication::postEvent(m_listener, new MythEvent(message, list));
-    }
-
     return ok;
 }
 
 bool PreviewGenerator::Run(void)
 {
     QString msg;
+    bool ok = DoRun(msg);
+    PostResult(ok, msg);
+    return ok;
+}
+
+/** \fn PreviewGenerator::DoRun(QString&)
+ *  \brief Creates the preview with mythpreviewgen, or on the backend,
+ *         without telling the listener about the result.
+ */
+bool PreviewGenerator::DoRun(QString &msg)
+{
     QTime tm = QTime::currentTime();
     QElapsedTimer te; te.start();
     bool ok = false;
@@ -319,10 +314,26 @@ bool PreviewGenerator::Run(void)
         }
     }
 
+    return ok;
+}
+
+/** \fn PreviewGenerator::CreateResultEvent(bool,const QString&,QObject*&)
+ *  \brief Builds the PREVIEW_SUCCESS or PREVIEW_FAILED event for the
+ *         listener.
+ *
+ *  Returns nullptr when nobody is listening.  The caller posts the
+ *  event, the listener may delete this generator as soon as it arrives.
+ */
+MythEvent *PreviewGenerator::CreateResultEvent(bool ok, const QString &msg,
+                                               QObject *&listener)
+{
     QMutexLocker locker(&m_previewLock);
+    listener = m_listener;
+    if (!listener)
+        return nullptr;
 
-    // Backdate file to start of preview time in case a bookmark was made
-    // while we were generating the preview.
+    // keep in sync with default filename in
+    // PreviewGeneratorQueue::GeneratePreviewImage
     QString output_fn = m_outFileName.isEmpty() ?
         (m_programInfo.GetPathname()+".png") : m_outFileName;
 
@@ -335,18 +346,21 @@ bool PreviewGenerator::Run(void)
     }
 
     QString message = (ok) ? "PREVIEW_SUCCESS" : "PREVIEW_FAILED";
-    if (m_listener)
-    {
-        QStringList list;
-        list.push_back(QString::number(m_programInfo.GetRecordingID()));
-        list.push_back(output_fn);
-        list.push_back(msg);
-        list.push_back(dt.isValid()?dt.toUTC().toString(Qt::ISODate):"");
-        list.push_back(m_token);
-        QCoreApplication::postEvent(m_listener, new MythEvent(message, list));
-    }
+    QStringList list;
+    list.push_back(QString::number(m_programInfo.GetRecordingID()));
+    list.push_back(output_fn);
+    list.push_back(msg);
+    list.push_back(dt.isValid()?dt.toUTC().toString(Qt::ISODate):"");
+    list.push_back(m_token);
+    return new MythEvent(message, list);
+}
 
-    return ok;
+void PreviewGenerator::PostResult(bool ok, const QString &msg)
+{
+    QObject *listener = nullptr;
+    MythEvent *result = CreateResultEvent(ok, msg, listener);
+    if (result)
+        QCoreApplication::postEvent(listener, result);
 }
 
 void PreviewGenerator::run(void)
@@ -18,6 +18,7 @@
 class PreviewGenerator;
 class QByteArray;
 class MythSocket;
+class MythEvent;
 class QObject;
 class QEvent;
 
@@ -32,6 +33,7 @@ class MTV_PUBLIC PreviewGenerator : public QObject, public MThread
                               const QSize   &previewSize,
                               const QString &infile,
                               const QString &outfile);
+    friend class PreviewGeneratorRunnable;
 
     Q_OBJECT
 
@@ -79,6 +81,11 @@ class MTV_PUBLIC PreviewGenerator : public QObject, public MThread
     bool IsLocal(void) const;
 
     bool RunReal(void);
+    bool DoRunReal(QString &msg);
+    bool DoRun(QString &msg);
+    MythEvent *CreateResultEvent(bool ok, const QString &msg,
+                                 QObject *&listener);
+    void PostResult(bool ok, const QString &msg);
 
     static char *GetScreenGrab(const ProgramInfo &pginfo,
                                const QString     &filename,
@@ -8,12 +8,14 @@ using std::max;
 // QT
 #include <QCoreApplication>
 #include <QFileInfo>
+#include <QRunnable>
 
 // libmythbase
 #include "mythcorecontext.h"
 #include "mythlogging.h"
 #include "mythdirs.h"
 #include "mthread.h"
+#include "mthreadpool.h"
 
 // libmyth
 #include "mythcontext.h"
@@ -26,6 +28,40 @@ using std::max;
 
 PreviewGeneratorQueue *PreviewGeneratorQueue::s_pgq = nullptr;
 
+/**
+ * Generates a single preview on one of the preview pool threads.
+ *
+ * The pool threads live as long as the queue, so their database
+ * connections are reused from one preview to the next instead of
+ * every preview paying for a new process, MythContext and database
+ * connection.  When previews are not generated in process the worker
+ * only waits for mythpreviewgen.
+ *
+ * The queue deletes the generator as soon as it sees the result, so
+ * the result is posted as the very last thing run() does.
+ */
+class PreviewGeneratorRunnable : public QRunnable
+{
+  public:
+    PreviewGeneratorRunnable(PreviewGenerator *gen, bool inProcess)
+        : m_gen(gen), m_inProcess(inProcess) {}
+
+    void run(void) override // QRunnable
+    {
+        QString msg;
+        bool ok = m_inProcess ? m_gen->DoRunReal(msg) : m_gen->DoRun(msg);
+
+        QObject *listener = nullptr;
+        MythEvent *result = m_gen->CreateResultEvent(ok, msg, listener);
+        if (result)
+            QCoreApplication::postEvent(listener, result);
+    }
+
+  private:
+    PreviewGenerator *m_gen       {nullptr};
+    bool              m_inProcess {true};
+};
+
 /**
  * Create the singleton queue of preview generators.  This should be
  * called once at program start-up.  All generation requests on this
@@ -87,12 +123,29 @@ PreviewGeneratorQueue::PreviewGeneratorQueue(
     m_mode(mode),
     m_maxAttempts(maxAttempts), m_minBlockSeconds(minBlockSeconds)
 {
+    m_inProcess = gCoreContext->GetBoolSetting("PreviewGeneratorInProcess", true);
+
     if (PreviewGenerator::kLocal & mode)
     {
         int idealThreads = QThread::idealThreadCount();
-        m_maxThreads = (idealThreads >= 1) ? idealThreads * 2 : 2;
+        if (m_inProcess)
+        {
+            // Generation is CPU bound once nothing is forked,
+            // one worker per core is enough.
+            m_maxThreads = (idealThreads >= 1) ? idealThreads : 1;
+        }
+        else
+        {
+            m_maxThreads = (idealThreads >= 1) ? idealThreads * 2 : 2;
+        }
     }
 
+    m_pool = new MThreadPool("PreviewGeneratorPool");
+    m_pool->setMaxThreadCount(m_maxThreads);
+    // Keep idle workers, and their database connections, around
+    // for the bursts of requests seen when a recording list opens.
+    m_pool->setExpiryTimeout(5 * 60 * 1000);
+
     moveToThread(qthread());
     start();
 }
@@ -107,6 +160,14 @@ PreviewGeneratorQueue::PreviewGeneratorQueue(
  */
 PreviewGeneratorQueue::~PreviewGeneratorQueue()
 {
+    // let running generators finish before they are deleted
+    if (m_pool)
+    {
+        m_pool->waitForDone();
+        delete m_pool;
+        m_pool = nullptr;
+    }
+
     // disconnect preview generators
     QMutexLocker locker(&m_lock);
     // NOLINTNEXTLINE(modernize-loop-convert)
@@ -648,7 +709,8 @@ void PreviewGeneratorQueue::UpdatePreviewGeneratorThreads(void)
         if (it != m_previewMap.end() && (*it).m_gen && !(*it).m_genStarted)
         {
             m_running++;
-            (*it).m_gen->start();
+            m_pool->start(new PreviewGeneratorRunnable((*it).m_gen, m_inProcess),
+                          "PreviewGenerator");
             (*it).m_genStarted = true;
         }
     }
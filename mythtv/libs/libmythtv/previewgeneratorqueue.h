@@ -13,6 +13,7 @@
 #include "mthread.h"
 
 class ProgramInfo;
+class MThreadPool;
 class QSize;
 
 /**
@@ -147,6 +148,11 @@ class MTV_PUBLIC PreviewGeneratorQueue : public QObject, public MThread
     /// The maximum number of threads that may concurrently generate
     /// previews.
     uint                   m_maxThreads {2};
+    /// Worker threads that run the preview generators.
+    MThreadPool           *m_pool       {nullptr};
+    /// Generate previews inside this process, instead of forking a
+    /// mythpreviewgen process per preview.
+    bool                   m_inProcess  {true};
     /// How many times total will the code attempt to generate a
     /// preview for a specific file, before giving up and ignoring all
     /// future requests.
@@ -57,6 +57,7 @@ bool DeviceReadBuffer::Setup(const QString &streamName, int streamfd,
     m_videoDevice   = streamName;
     m_videoDevice   = m_videoDevice.isNull() ? "" : m_videoDevice;
     m_streamFd      = streamfd;
+    SetMetricLabels();
 
     // Setup device ringbuffer
     m_eof           = false;
@@ -89,6 +90,7 @@ bool DeviceReadBuffer::Setup(const QString &streamName, int streamfd,
     }
     m_endPtr = m_buffer + m_size;
     memset(m_buffer, 0xFF, m_size + m_readQuanta);
+    m_sizeMetric.Set(m_size);
 
     // Initialize statistics
     m_maxUsed        = 0;
@@ -138,6 +140,7 @@ void DeviceReadBuffer::Reset(const QString &streamName, int streamfd)
     m_videoDevice   = streamName;
     m_videoDevice   = m_videoDevice.isNull() ? "" : m_videoDevice;
     m_streamFd      = streamfd;
+    SetMetricLabels();
 
     m_used          = 0;
     m_readPtr       = m_buffer;
@@ -282,6 +285,8 @@ void DeviceReadBuffer::IncrWritePointer(uint len)
     m_used     += len;
     m_writePtr += len;
     m_writePtr  = (m_writePtr >= m_endPtr) ? m_buffer + (m_writePtr - m_endPtr) : m_writePtr;
+    m_bytesMetric.Add(len);
+    m_usedPeakMetric.SetMax(m_used);
 #if REPORT_RING_STATS
     m_maxUsed = max(m_used, m_maxUsed);
     m_avgUsed = ((m_avgUsed * m_avgBufWriteCnt) + m_used) / (m_avgBufWriteCnt+1);
@@ -572,6 +577,7 @@ bool DeviceReadBuffer::CheckForErrors(
         if (EOVERFLOW == errno)
         {
             LOG(VB_GENERAL, LOG_ERR, LOC + "Driver buffers overflowed");
+            m_overflowMetric.Add(1);
             return false;
         }
 
@@ -727,6 +733,17 @@ void DeviceReadBuffer::ReportStats(void)
 #endif
 }
 
+/// \brief Labels the metrics with the device, called with m_lock held.
+void DeviceReadBuffer::SetMetricLabels(void)
+{
+    MythMetricLabels labels;
+    labels["device"] = m_videoDevice;
+    m_bytesMetric.SetLabels(labels);
+    m_overflowMetric.SetLabels(labels);
+    m_sizeMetric.SetLabels(labels);
+    m_usedPeakMetric.SetLabels(labels);
+}
+
 /*
  * vim:ts=4:sw=4:ai:et:si:sts=4
  */
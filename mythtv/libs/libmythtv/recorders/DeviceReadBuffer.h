@@ -10,6 +10,7 @@
 #include <QWaitCondition>
 #include <QString>
 
+#include "mythmetrics.h"
 #include "mythtimer.h"
 #include "tspacket.h"
 #include "mthread.h"
@@ -81,6 +82,7 @@ class DeviceReadBuffer : protected MThread
 
     bool CheckForErrors(ssize_t read_len, size_t requested_len, uint &errcnt);
     void ReportStats(void);
+    void SetMetricLabels(void);
 
     QString                 m_videoDevice;
     int                     m_streamFd              {-1};
@@ -123,6 +125,20 @@ class DeviceReadBuffer : protected MThread
     size_t                  m_avgBufReadCnt         {0};
     size_t                  m_avgBufSleepCnt        {0};
     MythTimer               m_lastReport;
+
+    // live metrics, labelled with the device
+    MythMetric              m_bytesMetric     {"mythtv_devicereadbuffer_bytes_total",
+                                               "Bytes read from the device",
+                                               MythMetric::kCounter};
+    MythMetric              m_overflowMetric  {"mythtv_devicereadbuffer_overflows_total",
+                                               "Times the driver buffers overflowed",
+                                               MythMetric::kCounter};
+    MythMetric              m_sizeMetric      {"mythtv_devicereadbuffer_size_bytes",
+                                               "Size of the buffer",
+                                               MythMetric::kGauge};
+    MythMetric              m_usedPeakMetric  {"mythtv_devicereadbuffer_used_peak_bytes",
+                                               "Most bytes waiting to be processed",
+                                               MythMetric::kGauge};
 };
 
 #endif // _DEVICEREADBUFFER_H_
@@ -55,6 +55,11 @@ DTVRecorder::DTVRecorder(TVRec *rec) :
         gCoreContext->GetNumSetting("MinimumRecordingQuality", 95);
 
     m_containerFormat = formatMPEG2_TS;
+
+    MythMetricLabels labels;
+    labels["input"] = QString::number(m_tvrec ? m_tvrec->GetInputId() : 0);
+    m_packetMetric.SetLabels(labels);
+    m_ccErrorMetric.SetLabels(labels);
 }
 
 DTVRecorder::~DTVRecorder(void)
@@ -140,6 +145,7 @@ void DTVRecorder::ResetForNewFile(void)
 
     m_startCode                  = 0xffffffff;
     m_firstKeyframe              = -1;
+    m_damaged                    = false;
     m_hasWrittenOtherKeyframe    = false;
     m_lastKeyframeSeen           = 0;
     m_lastGopSeen                = 0;
@@ -159,6 +165,7 @@ void DTVRecorder::ResetForNewFile(void)
     m_positionMapDelta.clear();
     m_durationMap.clear();
     m_durationMapDelta.clear();
+    m_damageMapDelta.clear();
 
     locker.unlock();
     DTVRecorder::ClearStatistics();
@@ -196,6 +203,8 @@ void DTVRecorder::Reset(void)
     {
         m_curRecording->ClearPositionMap(MARK_GOP_BYFRAME);
         m_curRecording->ClearPositionMap(MARK_DURATION_MS);
+        m_curRecording->ClearMarkupMap(MARK_DAMAGED_START);
+        m_curRecording->ClearMarkupMap(MARK_DAMAGED_END);
     }
 }
 
@@ -795,6 +804,11 @@ void DTVRecorder::HandleKeyframe(int64_t extra)
             m_durationMapDelta[frameNum] = llround(m_totalDuration);
         }
     }
+    if (m_damaged)
+    {
+        m_damageMapDelta[frameNum] = MARK_DAMAGED_END;
+        m_damaged = false;
+    }
     m_positionMapLock.unlock();
 }
 
@@ -1025,9 +1039,47 @@ void DTVRecorder::HandleH264Keyframe(void)
         m_durationMap[frameNum]      = llround(m_totalDuration);
         m_durationMapDelta[frameNum] = llround(m_totalDuration);
     }
+    if (m_damaged)
+    {
+        m_damageMapDelta[frameNum] = MARK_DAMAGED_END;
+        m_damaged = false;
+    }
     m_positionMapLock.unlock();
 }
 
+/** \fn DTVRecorder::HandleVideoLoss(uint)
+ *  \brief Resynchronises the keyframe search after video packets were lost,
+ *         and marks where the damage starts.
+ *
+ *   The lost packets leave the search part way through a start code or
+ *   NAL unit, which could otherwise join up with bytes after the gap and
+ *   find a frame or keyframe that is not there, or miss the next real one.
+ *   The frame the loss hit, and those up to the next keyframe, which may
+ *   refer to it, are marked from MARK_DAMAGED_START to MARK_DAMAGED_END.
+ *
+ *   \todo Nothing reads these marks yet. Players and commflag should
+ *         skip to the MARK_DAMAGED_END keyframe instead of decoding the
+ *         broken pictures.
+ */
+void DTVRecorder::HandleVideoLoss(uint streamType)
+{
+    m_startCode = 0xffffffff;
+    if (streamType == StreamID::H264Video)
+        m_h264Parser.Resync();
+
+    if (m_damaged || m_firstKeyframe < 0)
+        return;
+    m_damaged = true;
+
+    uint64_t frameNum = (m_framesWrittenCount) ? m_framesWrittenCount - 1 : 0;
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Video lost in frame %1, damaged until the next keyframe")
+        .arg(frameNum));
+
+    QMutexLocker locker(&m_positionMapLock);
+    m_damageMapDelta[frameNum] = MARK_DAMAGED_START;
+}
+
 void DTVRecorder::FindPSKeyFrames(const uint8_t *buffer, uint len)
 {
     const uint maxKFD = kMaxKeyFrameDistance;
@@ -1418,13 +1470,17 @@ bool DTVRecorder::ProcessTSPacket(const TSPacket &tspacket)
     const uint pid = tspacket.PID();
 
     if (pid != 0x1fff)
+    {
         m_packetCount.fetchAndAddAcquire(1);
+        m_packetMetric.Add(1);
+    }
 
     // Check continuity counter
     uint old_cnt = m_continuityCounter[pid];
     if ((pid != 0x1fff) && !CheckCC(pid, tspacket.ContinuityCounter()))
     {
         int v = m_continuityErrorCount.fetchAndAddRelaxed(1) + 1;
+        m_ccErrorMetric.Add(1);
         double erate = v * 100.0 / m_packetCount.fetchAndAddRelaxed(0);
         LOG(VB_RECORD, LOG_WARNING, LOC +
             QString("PID 0x%1 discontinuity detected ((%2+1)%16!=%3) %4%")
@@ -1484,6 +1540,11 @@ bool DTVRecorder::ProcessVideoTSPacket(const TSPacket &tspacket)
 
     uint streamType = m_streamId[tspacket.PID()];
 
+    // The continuity counter itself is checked in ProcessAVTSPacket(),
+    // but the keyframe search must know of lost packets before this one
+    if (!ContinuityFollows(tspacket.PID(), tspacket.ContinuityCounter()))
+        HandleVideoLoss(streamType);
+
     if (tspacket.HasPayload() && tspacket.PayloadStart())
     {
         if (m_bufferPackets && m_firstKeyframe >= 0 && !m_payloadBuffer.empty())
@@ -1547,13 +1608,17 @@ bool DTVRecorder::ProcessAVTSPacket(const TSPacket &tspacket)
     const uint pid = tspacket.PID();
 
     if (pid != 0x1fff)
+    {
         m_packetCount.fetchAndAddAcquire(1);
+        m_packetMetric.Add(1);
+    }
 
     // Check continuity counter
     uint old_cnt = m_continuityCounter[pid];
     if ((pid != 0x1fff) && !CheckCC(pid, tspacket.ContinuityCounter()))
     {
         int v = m_continuityErrorCount.fetchAndAddRelaxed(1) + 1;
+        m_ccErrorMetric.Add(1);
         double erate = v * 100.0 / m_packetCount.fetchAndAddRelaxed(0);
         LOG(VB_RECORD, LOG_WARNING, LOC +
             QString("A/V PID 0x%1 discontinuity detected ((%2+1)%16!=%3) %4%")
@@ -16,6 +16,7 @@ using namespace std;
 #include <QAtomicInt>
 #include <QString>
 
+#include "mythmetrics.h"
 #include "streamlisteners.h"
 #include "recorderbase.h"
 #include "H264Parser.h"
@@ -114,12 +115,15 @@ class DTVRecorder :
     bool FindH264Keyframes(const TSPacket* tspacket);
     void HandleH264Keyframe(void);
 
+    void HandleVideoLoss(uint streamType);
+
     // MPEG2 PS support (Hauppauge PVR-x50/PVR-500)
     void FindPSKeyFrames(const uint8_t *buffer, uint len) override; // PSStreamListener
 
     // For handling other (non audio/video) packets
     bool FindOtherKeyframes(const TSPacket *tspacket);
 
+    inline bool ContinuityFollows(uint pid, uint new_cnt) const;
     inline bool CheckCC(uint pid, uint new_cnt);
 
     virtual QString GetSIStandard(void) const { return "mpeg"; }
@@ -138,6 +142,8 @@ class DTVRecorder :
     unsigned long long       m_lastGopSeen                {0};
     unsigned long long       m_lastSeqSeen                {0};
     unsigned long long       m_lastKeyframeSeen           {0};
+    /// Video was lost since the last keyframe, see HandleVideoLoss()
+    bool                     m_damaged                    {false};
     unsigned int             m_audioBytesRemaining        {0};
     unsigned int             m_videoBytesRemaining        {0};
     unsigned int             m_otherBytesRemaining        {0};
@@ -191,6 +197,13 @@ class DTVRecorder :
     QDateTime                m_tsFirstDt[256];
     mutable QAtomicInt       m_packetCount                {0};
     mutable QAtomicInt       m_continuityErrorCount       {0};
+    // Live totals, unlike the counts above these are not reset per file
+    MythMetric               m_packetMetric {"mythtv_recorder_packets_total",
+                                             "Transport stream packets recorded",
+                                             MythMetric::kCounter};
+    MythMetric               m_ccErrorMetric {"mythtv_recorder_continuity_errors_total",
+                                              "Continuity counter errors seen",
+                                              MythMetric::kCounter};
     unsigned long long       m_framesSeenCount            {0};
     unsigned long long       m_framesWrittenCount         {0};
     double                   m_totalDuration              {0.0}; // usec
@@ -212,11 +225,17 @@ class DTVRecorder :
     static const unsigned char kPayloadStartSeen = 0x2;
 };
 
+/// \brief True unless packets of pid were lost before this one.
+inline bool DTVRecorder::ContinuityFollows(uint pid, uint new_cnt) const
+{
+    return ((((m_continuityCounter[pid] + 1) & 0xf) == new_cnt) ||
+            (m_continuityCounter[pid] == new_cnt) ||
+            (m_continuityCounter[pid] == 0xFF));
+}
+
 inline bool DTVRecorder::CheckCC(uint pid, uint new_cnt)
 {
-    bool ok = ((((m_continuityCounter[pid] + 1) & 0xf) == new_cnt) ||
-               (m_continuityCounter[pid] == new_cnt) ||
-               (m_continuityCounter[pid] == 0xFF));
+    bool ok = ContinuityFollows(pid, new_cnt);
 
     m_continuityCounter[pid] = new_cnt & 0xf;
 
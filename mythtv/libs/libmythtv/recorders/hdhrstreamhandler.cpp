@@ -169,8 +169,7 @@ void HDHRStreamHandler::run(void)
             continue;
         }
 
-        for (auto sit = m_streamDataList.cbegin(); sit != m_streamDataList.cend(); ++sit)
-            remainder = sit.key()->ProcessData(data_buffer, data_length);
+        remainder = ProcessData(data_buffer, data_length);
 
         WriteMPTS(data_buffer, data_length - remainder);
 
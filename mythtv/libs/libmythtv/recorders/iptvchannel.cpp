@@ -116,6 +116,13 @@ void IPTVChannel::OpenStreamHandler(void)
     }
 }
 
+bool IPTVChannel::GetFECStatistics(uint64_t &recovered, uint64_t &lost) const
+{
+    QMutexLocker locker(&m_streamLock);
+    return m_streamHandler &&
+        m_streamHandler->GetFECStatistics(recovered, lost);
+}
+
 void IPTVChannel::CloseStreamHandler(void)
 {
     LOG(VB_CHANNEL, LOG_INFO, LOC + "CloseStreamHandler()");
@@ -1,5 +1,8 @@
 // -*- Mode: c++ -*-
 
+// C++ headers
+#include <algorithm>
+
 // MythTV headers
 #include "iptvsignalmonitor.h"
 #include "mpegstreamdata.h"
@@ -26,7 +29,11 @@ IPTVSignalMonitor::IPTVSignalMonitor(int db_cardnum,
                                      IPTVChannel *_channel,
                                      bool _release_stream,
                                      uint64_t _flags)
-    : DTVSignalMonitor(db_cardnum, _channel, _release_stream, _flags)
+    : DTVSignalMonitor(db_cardnum, _channel, _release_stream, _flags),
+      m_fecRecovered(tr("FEC Recovered"),     "fec_recovered",
+                     0,      true,      0, 65535, 0),
+      m_fecLost     (tr("FEC Unrecoverable"), "fec_lost",
+                     65535,  false,     0, 65535, 0)
 {
     LOG(VB_CHANNEL, LOG_INFO, LOC + "ctor");
     m_signalLock.SetValue(0);
@@ -59,6 +66,18 @@ void IPTVSignalMonitor::Stop(void)
     LOG(VB_CHANNEL, LOG_INFO, LOC + "Stop() -- end");
 }
 
+QStringList IPTVSignalMonitor::GetStatusList(void) const
+{
+    QStringList list = DTVSignalMonitor::GetStatusList();
+    QMutexLocker locker(&m_statusLock);
+    if (m_hasFEC)
+    {
+        list<<m_fecRecovered.GetName()<<m_fecRecovered.GetStatus();
+        list<<m_fecLost.GetName()<<m_fecLost.GetStatus();
+    }
+    return list;
+}
+
 void IPTVSignalMonitor::SetStreamData(MPEGStreamData *data)
 {
     DTVSignalMonitor::SetStreamData(data);
@@ -91,6 +110,16 @@ void IPTVSignalMonitor::UpdateValues(void)
         m_locked = true;
     }
 
+    uint64_t recovered = 0;
+    uint64_t lost = 0;
+    if (GetIPTVChannel()->GetFECStatistics(recovered, lost))
+    {
+        QMutexLocker locker(&m_statusLock);
+        m_hasFEC = true;
+        m_fecRecovered.SetValue(static_cast<int>(std::min(recovered, UINT64_C(65535))));
+        m_fecLost.SetValue(static_cast<int>(std::min(lost, UINT64_C(65535))));
+    }
+
     EmitStatus();
     if (IsAllGood())
         SendMessageAllGood();
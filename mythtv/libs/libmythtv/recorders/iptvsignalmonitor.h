@@ -17,6 +17,7 @@ class IPTVSignalMonitor : public DTVSignalMonitor
     ~IPTVSignalMonitor() override;
 
     void Stop(void) override; // SignalMonitor
+    QStringList GetStatusList(void) const override; // DTVSignalMonitor
 
     // DTVSignalMonitor
     void SetStreamData(MPEGStreamData *data) override; // DTVSignalMonitor
@@ -34,6 +35,9 @@ class IPTVSignalMonitor : public DTVSignalMonitor
   protected:
     bool m_streamHandlerStarted {false};
     bool m_locked               {false};
+    bool m_hasFEC               {false};
+    SignalMonitorValue m_fecRecovered;
+    SignalMonitorValue m_fecLost;
 };
 
 #endif // _IPTVSIGNALMONITOR_H_
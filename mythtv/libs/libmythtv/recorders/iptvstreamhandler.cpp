@@ -8,7 +8,11 @@
 # include <sys/socket.h>
 # include <netinet/in.h>
 # include <netinet/ip.h>
+# include <poll.h>
 #endif
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 
 // Qt headers
 #include <QUdpSocket>
@@ -23,6 +27,9 @@
 #include "rtpdatapacket.h"
 #include "rtpfecpacket.h"
 #include "rtcpdatapacket.h"
+#ifndef _WIN32
+#include "udpbatchreader.h"
+#endif
 #include "mythlogging.h"
 #include "cetonrtsp.h"
 
@@ -112,6 +119,23 @@ IPTVStreamHandler::IPTVStreamHandler(const IPTVTuningData &tuning, int inputid)
     m_useRtpStreaming = m_tuning.IsRTP();
 }
 
+/** \fn IPTVStreamHandler::GetFECStatistics(uint64_t&, uint64_t&) const
+ *  \brief Counts the packets rebuilt from SMPTE 2022-1 FEC, and the ones
+ *         that were lost anyway.
+ *  \return false if the stream has no FEC
+ */
+bool IPTVStreamHandler::GetFECStatistics(uint64_t &recovered,
+                                         uint64_t &lost) const
+{
+    QMutexLocker locker(&m_bufferLock);
+    auto *buffer = dynamic_cast<RTPPacketBuffer*>(m_buffer);
+    if (!buffer || !buffer->HasFEC())
+        return false;
+    recovered = buffer->GetRecoveredCount();
+    lost      = buffer->GetLostCount();
+    return true;
+}
+
 void IPTVStreamHandler::run(void)
 {
     RunProlog();
@@ -217,7 +241,9 @@ void IPTVStreamHandler::run(void)
             // the requested server
             m_sender[i] = dest_addr;
         }
+#ifdef _WIN32
         m_readHelpers[i] = new IPTVStreamHandlerReadHelper(this,m_sockets[i],i);
+#endif
 
         // we need to open the descriptor ourselves so we
         // can set some socket options
@@ -231,6 +257,7 @@ void IPTVStreamHandler::run(void)
         int buf_size = 2 * 1024 * max(tuning.GetBitrate(i)/1000, 500U);
         if (!tuning.GetBitrate(i))
             buf_size = 2 * 1024 * 1024;
+#ifdef _WIN32
         int err = setsockopt(fd, SOL_SOCKET, SO_RCVBUF,
                             (char *)&buf_size, sizeof(buf_size));
         if (err)
@@ -239,6 +266,16 @@ void IPTVStreamHandler::run(void)
                 QString("Increasing buffer size to %1 failed")
                 .arg(buf_size) + ENO);
         }
+#else
+        int actual_size = UDPBatchReader::SetReceiveBufferSize(fd, buf_size);
+        if (actual_size >= 0 && actual_size < buf_size)
+        {
+            LOG(VB_GENERAL, LOG_WARNING, LOC +
+                QString("Receive buffer is %1 bytes, wanted %2. Raise "
+                        "net.core.rmem_max to avoid losing packets.")
+                .arg(actual_size).arg(buf_size));
+        }
+#endif
 
         m_sockets[i]->setSocketDescriptor(
             fd, QAbstractSocket::UnconnectedState, QIODevice::ReadOnly);
@@ -273,12 +310,18 @@ void IPTVStreamHandler::run(void)
 
     if (!error)
     {
+        m_bufferLock.lock();
         if (m_tuning.IsRTP() || m_tuning.IsRTSP())
             m_buffer = new RTPPacketBuffer(tuning.GetBitrate(0));
         else
             m_buffer = new UDPPacketBuffer(tuning.GetBitrate(0));
+        m_bufferLock.unlock();
         m_writeHelper = new IPTVStreamHandlerWriteHelper(this);
         m_writeHelper->Start();
+#ifndef _WIN32
+        m_receiver = new IPTVStreamHandlerReceiver(this);
+        m_receiver->start();
+#endif
     }
 
     if (!error && rtsp)
@@ -294,6 +337,7 @@ void IPTVStreamHandler::run(void)
         }
         if (m_rtspRtcpPort > 0)
         {
+            QMutexLocker locker(&m_bufferLock);
             m_writeHelper->SendRTCPReport();
             m_writeHelper->StartRTCPRR();
         }
@@ -306,6 +350,10 @@ void IPTVStreamHandler::run(void)
     }
 
     // Clean up
+#ifndef _WIN32
+    delete m_receiver;
+    m_receiver = nullptr;
+#endif
     for (uint i = 0; i < IPTV_SOCKET_COUNT; i++)
     {
         if (m_sockets[i])
@@ -316,8 +364,10 @@ void IPTVStreamHandler::run(void)
             m_readHelpers[i] = nullptr;
         }
     }
+    m_bufferLock.lock();
     delete m_buffer;
     m_buffer = nullptr;
+    m_bufferLock.unlock();
     delete m_writeHelper;
     m_writeHelper = nullptr;
 
@@ -347,6 +397,7 @@ void IPTVStreamHandlerReadHelper::ReadPending(void)
     QHostAddress sender;
     quint16 senderPort = 0;
     bool sender_null = m_sender.isNull();
+    QMutexLocker locker(&m_parent->m_bufferLock);
 
     if (0 == m_stream)
     {
@@ -394,6 +445,9 @@ void IPTVStreamHandlerReadHelper::ReadPending(void)
             }
         }
     }
+
+    if (m_parent->m_writeHelper)
+        m_parent->m_writeHelper->ProcessPackets();
 }
 
 IPTVStreamHandlerWriteHelper::~IPTVStreamHandlerWriteHelper()
@@ -413,15 +467,31 @@ IPTVStreamHandlerWriteHelper::~IPTVStreamHandlerWriteHelper()
 
 void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
 {
+    QMutexLocker locker(&m_parent->m_bufferLock);
+
     if (event->timerId() == m_timerRtcp)
     {
         SendRTCPReport();
         return;
     }
 
-    if (!m_parent->m_buffer->HasAvailablePacket())
+    ProcessPackets();
+}
+
+/** \fn IPTVStreamHandlerWriteHelper::ProcessPackets(void)
+ *  \brief Hands the TS data of every packet that is ready to the listeners.
+ *
+ *   The data is gathered into one buffer so that the listener lock is taken,
+ *   and each MPEGStreamData called, once per batch instead of once per
+ *   datagram.  Call with m_parent->m_bufferLock held.
+ */
+void IPTVStreamHandlerWriteHelper::ProcessPackets(void)
+{
+    if (!m_parent->m_buffer || !m_parent->m_buffer->HasAvailablePacket())
         return;
 
+    m_batch.clear();
+
     while (!m_parent->m_useRtpStreaming)
     {
         UDPPacket packet(m_parent->m_buffer->PopDataPacket());
@@ -429,25 +499,9 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
         if (packet.GetDataReference().isEmpty())
             break;
 
-        int remainder = 0;
-        {
-            QMutexLocker locker(&m_parent->m_listenerLock);
-            QByteArray &data = packet.GetDataReference();
-            for (auto sit = m_parent->m_streamDataList.cbegin();
-                 sit != m_parent->m_streamDataList.cend(); ++sit)
-            {
-                remainder = sit.key()->ProcessData(
-                    reinterpret_cast<const unsigned char*>(data.data()),
-                    data.size());
-            }
-        }
-
-        if (remainder != 0)
-        {
-            LOG(VB_RECORD, LOG_INFO, LOC_WH +
-                QString("data_length = %1 remainder = %2")
-                .arg(packet.GetDataReference().size()).arg(remainder));
-        }
+        const QByteArray &data = packet.GetDataReference();
+        m_batch.insert(m_batch.end(), data.constData(),
+                       data.constData() + data.size());
 
         m_parent->m_buffer->FreePacket(packet);
     }
@@ -489,26 +543,27 @@ void IPTVStreamHandlerWriteHelper::timerEvent(QTimerEvent* event)
                 QString("Processing RTP packet(seq:%1 ts:%2)")
                 .arg(m_lastSequenceNumber).arg(m_lastTimestamp));
 
-            m_parent->m_listenerLock.lock();
+            m_batch.insert(m_batch.end(), ts_packet.GetTSData(),
+                           ts_packet.GetTSData() + ts_packet.GetTSDataSize());
+        }
+        m_parent->m_buffer->FreePacket(packet);
+    }
 
-            int remainder = 0;
-            for (auto sit = m_parent->m_streamDataList.cbegin();
-                 sit != m_parent->m_streamDataList.cend(); ++sit)
-            {
-                remainder = sit.key()->ProcessData(
-                    ts_packet.GetTSData(), ts_packet.GetTSDataSize());
-            }
+    if (m_batch.empty())
+        return;
 
-            m_parent->m_listenerLock.unlock();
+    int remainder = 0;
+    {
+        QMutexLocker locker(&m_parent->m_listenerLock);
+        remainder = m_parent->ProcessData(m_batch.data(),
+                                          static_cast<int>(m_batch.size()));
+    }
 
-            if (remainder != 0)
-            {
-                LOG(VB_RECORD, LOG_INFO, LOC_WH +
-                    QString("data_length = %1 remainder = %2")
-                    .arg(ts_packet.GetTSDataSize()).arg(remainder));
-            }
-        }
-        m_parent->m_buffer->FreePacket(packet);
+    if (remainder != 0)
+    {
+        LOG(VB_RECORD, LOG_INFO, LOC_WH +
+            QString("data_length = %1 remainder = %2")
+            .arg(m_batch.size()).arg(remainder));
     }
 }
 
@@ -535,3 +590,189 @@ void IPTVStreamHandlerWriteHelper::SendRTCPReport(void)
                                           m_parent->m_rtspRtcpPort);
     m_previousLastSequenceNumber = m_lastSequenceNumber;
 }
+
+#ifndef _WIN32
+
+/// How long to wait in poll() before checking whether to stop
+static const int kReceivePollMs    = 100;
+static const int kReceiveStatsMs   = 10000;
+
+IPTVStreamHandlerReceiver::IPTVStreamHandlerReceiver(IPTVStreamHandler *p)
+    : MThread("IPTVReceive"), m_parent(p)
+{
+    for (uint i = 0; i < IPTV_SOCKET_COUNT; i++)
+    {
+        if (m_parent->m_sockets[i] &&
+            m_parent->m_sockets[i]->socketDescriptor() >= 0)
+        {
+            m_readers[i] = new UDPBatchReader(
+                static_cast<int>(m_parent->m_sockets[i]->socketDescriptor()));
+        }
+    }
+}
+
+IPTVStreamHandlerReceiver::~IPTVStreamHandlerReceiver()
+{
+    Stop();
+    for (auto & reader : m_readers)
+    {
+        delete reader;
+        reader = nullptr;
+    }
+}
+
+void IPTVStreamHandlerReceiver::Stop(void)
+{
+    m_stop = true;
+    wait();
+}
+
+void IPTVStreamHandlerReceiver::run(void)
+{
+    RunProlog();
+
+    // The QUdpSockets are never read, so Qt stops watching them after the
+    // first readyRead() and leaves the descriptors to us
+    vector<struct pollfd> fds;
+    vector<uint> streams;
+    for (uint i = 0; i < IPTV_SOCKET_COUNT; i++)
+    {
+        if (!m_readers[i])
+            continue;
+        struct pollfd fd {};
+        fd.fd     = static_cast<int>(m_parent->m_sockets[i]->socketDescriptor());
+        fd.events = POLLIN;
+        fds.push_back(fd);
+        streams.push_back(i);
+    }
+
+    m_statsTimer.start();
+
+    while (!m_stop && !fds.empty())
+    {
+        int ret = poll(fds.data(), fds.size(), kReceivePollMs);
+        if (ret < 0 && errno != EINTR)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC_WH + "Polling sockets failed" + ENO);
+            break;
+        }
+
+        bool received = false;
+        for (size_t i = 0; ret > 0 && i < fds.size(); i++)
+        {
+            if (fds[i].revents & POLLIN)
+                received |= ReadSocket(streams[i]);
+        }
+
+        if (received)
+        {
+            QMutexLocker locker(&m_parent->m_bufferLock);
+            m_parent->m_writeHelper->ProcessPackets();
+        }
+
+        if (m_statsTimer.elapsed() > kReceiveStatsMs)
+            LogStatistics();
+    }
+
+    RunEpilog();
+}
+
+/** \fn IPTVStreamHandlerReceiver::ReadSocket(uint)
+ *  \brief Moves every datagram queued on one socket into the packet buffer.
+ *  \return true if any datagram was added
+ */
+bool IPTVStreamHandlerReceiver::ReadSocket(uint stream)
+{
+    UDPBatchReader *reader = m_readers[stream];
+    const QHostAddress &expected = m_parent->m_sender[stream];
+    bool sender_null = expected.isNull();
+    bool received = false;
+
+    struct timespec now {};
+    clock_gettime(CLOCK_REALTIME, &now);
+    int64_t now_us = static_cast<int64_t>(now.tv_sec) * 1000000 +
+                     now.tv_nsec / 1000;
+
+    int count = 0;
+    do
+    {
+        count = reader->Read();
+        if (count < 0)
+        {
+            LOG(VB_RECORD, LOG_ERR, LOC_WH +
+                QString("Reading socket(%1) failed").arg(stream) + ENO);
+            break;
+        }
+
+        QMutexLocker locker(&m_parent->m_bufferLock);
+        for (int i = 0; i < count; i++)
+        {
+            if (!sender_null && QHostAddress(reader->GetSender(i)) != expected)
+            {
+                LOG(VB_RECORD, LOG_WARNING, LOC_WH +
+                    QString("Received on socket(%1) %2 bytes from non expected "
+                            "sender:%3 (expected:%4) ignoring")
+                    .arg(stream).arg(reader->GetSize(i))
+                    .arg(QHostAddress(reader->GetSender(i)).toString())
+                    .arg(expected.toString()));
+                continue;
+            }
+
+            if (reader->IsTruncated(i) && !m_warnedTruncated)
+            {
+                LOG(VB_GENERAL, LOG_WARNING, LOC_WH +
+                    QString("Datagrams larger than %1 bytes are truncated")
+                    .arg(UDPBatchReader::kDefaultSlotSize));
+                m_warnedTruncated = true;
+            }
+
+            if (reader->GetKernelTime(i))
+                m_maxDelay = max(m_maxDelay, now_us - reader->GetKernelTime(i));
+
+            UDPPacket packet(m_parent->m_buffer->GetEmptyPacket());
+            QByteArray &data = packet.GetDataReference();
+            data.resize(static_cast<int>(reader->GetSize(i)));
+            memcpy(data.data(), reader->GetData(i), reader->GetSize(i));
+
+            if (0 == stream)
+                m_parent->m_buffer->PushDataPacket(packet);
+            else
+                m_parent->m_buffer->PushFECPacket(packet, stream - 1);
+            received = true;
+        }
+
+        if (count > 0)
+        {
+            m_packets += static_cast<uint>(count);
+            m_batches++;
+        }
+    }
+    while (count == static_cast<int>(UDPBatchReader::kDefaultSlots) && !m_stop);
+
+    uint32_t drops = reader->GetKernelDrops();
+    if (drops != m_drops[stream])
+    {
+        LOG(VB_GENERAL, LOG_WARNING, LOC_WH +
+            QString("Kernel dropped %1 datagrams on socket(%2), the receive "
+                    "buffer is too small or we are reading too slowly")
+            .arg(drops - m_drops[stream]).arg(stream));
+        m_drops[stream] = drops;
+    }
+
+    return received;
+}
+
+void IPTVStreamHandlerReceiver::LogStatistics(void)
+{
+    LOG(VB_RECORD, LOG_DEBUG, LOC_WH +
+        QString("Received %1 datagrams in %2 batches in %3ms, "
+                "up to %4us after the kernel")
+        .arg(m_packets).arg(m_batches).arg(m_statsTimer.elapsed())
+        .arg(m_maxDelay));
+    m_packets  = 0;
+    m_batches  = 0;
+    m_maxDelay = 0;
+    m_statsTimer.start();
+}
+
+#endif // _WIN32
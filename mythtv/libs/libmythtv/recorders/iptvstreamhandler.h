@@ -3,9 +3,11 @@
 #ifndef _IPTVSTREAMHANDLER_H_
 #define _IPTVSTREAMHANDLER_H_
 
+#include <atomic>
 #include <vector>
 using namespace std;
 
+#include <QElapsedTimer>
 #include <QHostAddress>
 #include <QUdpSocket>
 #include <QString>
@@ -17,6 +19,7 @@ using namespace std;
 
 #include "channelutil.h"
 #include "streamhandler.h"
+#include "mthread.h"
 
 #define IPTV_SOCKET_COUNT   3
 #define RTCP_TIMER          10
@@ -26,6 +29,7 @@ class DTVSignalMonitor;
 class MPEGStreamData;
 class PacketBuffer;
 class IPTVChannel;
+class UDPBatchReader;
 
 class IPTVStreamHandlerReadHelper : QObject
 {
@@ -63,12 +67,15 @@ public:
     }
 
     void SendRTCPReport(void);
+    void ProcessPackets(void);
 
 private:
     void timerEvent(QTimerEvent *event) override; // QObject
 
 private:
     IPTVStreamHandler *m_parent                        {nullptr};
+    /// TS data from every packet that is ready, handed over in one call
+    vector<unsigned char> m_batch;
     int                m_timer                         {0};
     int                m_timerRtcp                     {0};
     uint               m_lastSequenceNumber            {0};
@@ -78,10 +85,45 @@ private:
     int                m_lostInterval                  {0};
 };
 
+#ifndef _WIN32
+/** \class IPTVStreamHandlerReceiver
+ *  \brief Reads the stream sockets on its own thread, many datagrams per
+ *         system call, and hands each batch straight to the listeners.
+ */
+class IPTVStreamHandlerReceiver : public MThread
+{
+  public:
+    explicit IPTVStreamHandlerReceiver(IPTVStreamHandler *p);
+    ~IPTVStreamHandlerReceiver() override;
+
+    void Stop(void);
+
+  protected:
+    void run(void) override; // MThread
+
+  private:
+    bool ReadSocket(uint stream);
+    void LogStatistics(void);
+
+    IPTVStreamHandler *m_parent                        {nullptr};
+    UDPBatchReader    *m_readers[IPTV_SOCKET_COUNT]    {};
+    uint32_t           m_drops[IPTV_SOCKET_COUNT]      {};
+    std::atomic<bool>  m_stop                          {false};
+    bool               m_warnedTruncated               {false};
+
+    // Statistics since they were last logged
+    QElapsedTimer      m_statsTimer;
+    uint64_t           m_packets                       {0};
+    uint64_t           m_batches                       {0};
+    int64_t            m_maxDelay                      {0};
+};
+#endif
+
 class IPTVStreamHandler : public StreamHandler
 {
     friend class IPTVStreamHandlerReadHelper;
     friend class IPTVStreamHandlerWriteHelper;
+    friend class IPTVStreamHandlerReceiver;
   public:
     static IPTVStreamHandler *Get(const IPTVTuningData &tuning, int inputid);
     static void Return(IPTVStreamHandler * & ref, int inputid);
@@ -95,6 +137,8 @@ class IPTVStreamHandler : public StreamHandler
         StreamHandler::AddListener(data, false, false, output_file);
     }
 
+    bool GetFECStatistics(uint64_t &recovered, uint64_t &lost) const;
+
   protected:
     explicit IPTVStreamHandler(const IPTVTuningData &tuning, int inputid);
 
@@ -106,6 +150,11 @@ class IPTVStreamHandler : public StreamHandler
     IPTVStreamHandlerReadHelper  *m_readHelpers[IPTV_SOCKET_COUNT] {};
     QHostAddress                  m_sender[IPTV_SOCKET_COUNT];
     IPTVStreamHandlerWriteHelper *m_writeHelper       {nullptr};
+#ifndef _WIN32
+    IPTVStreamHandlerReceiver    *m_receiver          {nullptr};
+#endif
+    /// Protects m_buffer and the write helper's RTP statistics
+    mutable QMutex                m_bufferLock;
     PacketBuffer                 *m_buffer            {nullptr};
 
     bool                          m_useRtpStreaming;
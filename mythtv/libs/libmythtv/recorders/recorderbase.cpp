@@ -592,6 +592,7 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
     m_positionMapLock.lock();
 
     bool has_delta = !m_positionMapDelta.empty();
+    bool has_damage = !m_damageMapDelta.empty();
     // set pm_elapsed to a fake large value if the timer hasn't yet started
     uint pm_elapsed = (m_positionMapTimer.isRunning()) ?
         m_positionMapTimer.elapsed() : ~0;
@@ -599,7 +600,7 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
     needToSave |= (m_positionMap.size() < 30) &&
         has_delta && (pm_elapsed >= 1500);
     // save every 10 seconds later on
-    needToSave |= has_delta && (pm_elapsed >= 10000);
+    needToSave |= (has_delta || has_damage) && (pm_elapsed >= 10000);
     // Assume that m_durationMapDelta is the same size as
     // m_positionMapDelta and implicitly use the same logic about when
     // to same m_durationMapDelta.
@@ -607,6 +608,8 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
     if (m_curRecording && needToSave)
     {
         m_positionMapTimer.start();
+        frm_dir_map_t damageCopy(m_damageMapDelta);
+        m_damageMapDelta.clear();
         if (has_delta)
         {
             // copy the delta map because most times we are called it will be in
@@ -629,6 +632,9 @@ void RecorderBase::SavePositionMap(bool force, bool finished)
             m_positionMapLock.unlock();
         }
 
+        if (!damageCopy.empty())
+            m_curRecording->SaveMarkupMap(damageCopy);
+
         if (m_ringBuffer && !finished) // Finished Recording will update the final size for us
         {
             m_curRecording->SaveFilesize(m_ringBuffer->GetWritePosition());
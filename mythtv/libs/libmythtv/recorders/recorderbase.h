@@ -348,6 +348,8 @@ class MTV_PUBLIC RecorderBase : public QRunnable
     frm_pos_map_t  m_positionMapDelta;
     frm_pos_map_t  m_durationMap;
     frm_pos_map_t  m_durationMapDelta;
+    /// MARK_DAMAGED_START/END marks not yet saved
+    frm_dir_map_t  m_damageMapDelta;
     MythTimer      m_positionMapTimer;
 
     // ProgStart mark support
@@ -3,21 +3,82 @@
  * Distributed as part of MythTV under GPL v2 and later.
  */
 
-#include "udppacket.h"
+#include "rtpdatapacket.h"
 
 #ifndef _RTP_FEC_PACKET_H_
 #define _RTP_FEC_PACKET_H_
 
 /** \brief RTP FEC Packet
+ *
+ *  SMPTE 2022-1 Forward Error Correction packet.  The FEC header follows
+ *  the RTP header and says which media packets were protected: every
+ *  Offset'th packet, NA of them, starting at SNBase.  Column FEC has
+ *  Offset L and NA D, row FEC has Offset 1 and NA L.  The payload is the
+ *  XOR of everything after the fixed RTP header of the protected packets,
+ *  and the recovery fields are the XOR of their header fields, so any one
+ *  missing packet can be rebuilt from the others.
  */
-class RTPFECPacket : public UDPPacket
+class RTPFECPacket : public RTPDataPacket
 {
   public:
-    explicit RTPFECPacket(const UDPPacket &o) : UDPPacket(o) { }
-    explicit RTPFECPacket(uint64_t key) : UDPPacket(key) { }
-    RTPFECPacket(void) : UDPPacket(0ULL) { }
+    explicit RTPFECPacket(const UDPPacket &o) : RTPDataPacket(o) { }
+    explicit RTPFECPacket(uint64_t key) : RTPDataPacket(key) { }
+    RTPFECPacket(void) : RTPDataPacket(0ULL) { }
 
-    // TODO
+    static const uint kHeaderSize = 16;
+
+    bool IsValid(void) const override // UDPPacket
+    {
+        if (!RTPDataPacket::IsValid())
+            return false;
+        if (m_off + kHeaderSize > static_cast<uint>(m_data.size()))
+            return false;
+        // Only XOR FEC is defined, and it must protect something
+        return GetFECType() == 0 && GetNA() > 0 && GetOffset() > 0;
+    }
+
+    uint GetSNBase(void) const
+    {
+        return ntohs(*reinterpret_cast<const uint16_t*>(FEC()));
+    }
+
+    uint GetLengthRecovery(void) const
+    {
+        return ntohs(*reinterpret_cast<const uint16_t*>(FEC() + 2));
+    }
+
+    uint GetPTRecovery(void) const { return FEC()[4] & 0x7f; }
+
+    uint GetTSRecovery(void) const
+    {
+        return ntohl(*reinterpret_cast<const uint32_t*>(FEC() + 8));
+    }
+
+    /// True for row FEC, false for column FEC
+    bool IsRow(void) const { return (FEC()[12] >> 6) & 0x1; }
+    uint GetFECType(void) const { return (FEC()[12] >> 3) & 0x7; }
+    uint GetOffset(void) const { return FEC()[13]; }
+    uint GetNA(void) const { return FEC()[14]; }
+
+    /// Bits of the RTP header that are recovered along with the payload
+    uint GetHeaderRecovery(void) const { return m_data[0] & 0x3f; }
+    uint GetMarkerRecovery(void) const { return m_data[1] & 0x80; }
+
+    const unsigned char *GetFECData(void) const
+    {
+        return FEC() + kHeaderSize;
+    }
+
+    uint GetFECDataSize(void) const
+    {
+        return m_data.size() - m_off - kHeaderSize;
+    }
+
+  private:
+    const unsigned char *FEC(void) const
+    {
+        return reinterpret_cast<const unsigned char*>(m_data.data()) + m_off;
+    }
 };
 
 #endif // _RTP_FEC_PACKET_H_
@@ -5,69 +5,353 @@
  */
 
 #include <algorithm>
+#include <cstring>
 using namespace std;
 
 #include "rtppacketbuffer.h"
 #include "rtpdatapacket.h"
 #include "rtpfecpacket.h"
+#include "mythlogging.h"
+
+#define LOC QString("RTPPacketBuffer: ")
+
+/// Must be a power of two and more than twice the largest window
+static const uint     kRingSize      = 1024;
+static const uint64_t kRingMask      = kRingSize - 1;
+/// How long to wait for a reordered packet when there is no FEC
+static const uint     kReorderWindow = 100;
+static const uint     kMaxWindow     = kRingSize / 2;
+
+RTPPacketBuffer::RTPPacketBuffer(unsigned int bitrate) :
+    PacketBuffer(bitrate),
+    m_ring(kRingSize),
+    m_window(kReorderWindow)
+{
+}
+
+/// \brief Extends a 16 bit sequence number to the one nearest the newest.
+uint64_t RTPPacketBuffer::ExtendSequence(uint seq) const
+{
+    auto delta = static_cast<int16_t>(
+        static_cast<uint16_t>(seq - (m_newest & 0xFFFF)));
+    return m_newest + delta;
+}
+
+bool RTPPacketBuffer::Have(uint64_t seq) const
+{
+    const Slot &slot = m_ring[seq & kRingMask];
+    return slot.m_valid && slot.m_seq == seq;
+}
+
+void RTPPacketBuffer::Store(uint64_t seq, const RTPDataPacket &packet)
+{
+    Slot &slot = m_ring[seq & kRingMask];
+    if (slot.m_valid && slot.m_seq == seq)
+    {
+        // Duplicate, or it arrived after it was rebuilt from FEC
+        FreePacket(packet);
+        return;
+    }
+    slot.m_packet = packet;
+    slot.m_seq    = seq;
+    slot.m_valid  = true;
+}
 
 void RTPPacketBuffer::PushDataPacket(const UDPPacket &udp_packet)
 {
     RTPDataPacket packet(udp_packet);
+    if (!packet.IsValid())
+    {
+        FreePacket(packet);
+        return;
+    }
 
-    uint key = packet.GetSequenceNumber();
-
-    bool large_was_seen_recently = m_largeSequenceNumberSeenRecently > 0;
-    m_largeSequenceNumberSeenRecently = 
-        (key > (1U<<15)) ? 500 : m_largeSequenceNumberSeenRecently - 1;
-    m_largeSequenceNumberSeenRecently =
-        max(m_largeSequenceNumberSeenRecently, 0);
+    // Start from a large number so that the extended numbers never wrap
+    uint64_t seq = m_started ? ExtendSequence(packet.GetSequenceNumber())
+                             : (1ULL << 32) + packet.GetSequenceNumber();
 
-    if (m_largeSequenceNumberSeenRecently > 0)
+    if (!m_started || seq >= m_head + kRingSize || seq + kRingSize < m_head)
     {
-        if (key < 500) 
-            key += 1ULL<<16;
+        // The sender has restarted or we have been away for a long time
+        Restart(seq);
     }
-    else if (large_was_seen_recently)
+    else if (seq < m_head)
     {
-        m_currentSequence += 1ULL<<16;
+        // Given up on or already handed on
+        FreePacket(packet);
+        return;
     }
 
-    key += m_currentSequence;
+    Store(seq, packet);
+    m_newest = max(m_newest, seq);
+    Release();
+}
 
-/*
-    LOG(VB_RECORD, LOG_DEBUG, QString("Pushing %1 as %2 (lr %3)")
-        .arg(packet.GetSequenceNumber()).arg(key)
-        .arg(m_largeSequenceNumberSeenRecently));
-*/
+/// \brief Hands on the packets we have and starts again from seq.
+void RTPPacketBuffer::Restart(uint64_t seq)
+{
+    if (m_started)
+    {
+        LOG(VB_RECORD, LOG_INFO, LOC + "Sequence discontinuity, restarting");
+        for (uint64_t i = m_head; i <= m_newest; i++)
+        {
+            if (Have(i))
+                m_available_packets.push_back(m_ring[i & kRingMask].m_packet);
+        }
+    }
+
+    for (auto & slot : m_ring)
+    {
+        slot.m_packet = RTPDataPacket();
+        slot.m_valid  = false;
+    }
+    m_fec.clear();
 
-    m_unorderedPackets[key] = packet;
+    m_started = true;
+    m_head    = seq;
+    m_newest  = seq;
+}
 
-    // TODO pushing packets onto the ordered list should be based on
-    // the bitrate and the M+N of the FEC.. but for now...
-    const int kHighWaterMark = 500;
-    const int kLowWaterMark  = 100;
-    if (m_unorderedPackets.size() > kHighWaterMark)
+/** \fn RTPPacketBuffer::Release(void)
+ *  \brief Hands on packets in sequence order.
+ *
+ *   A missing packet is waited for until the newest packet is m_window
+ *   past it.  Then it is rebuilt from FEC if possible, or skipped.
+ */
+void RTPPacketBuffer::Release(void)
+{
+    while (m_head <= m_newest)
     {
-        while (m_unorderedPackets.size() > kLowWaterMark)
+        if (!Have(m_head))
+        {
+            if (m_newest - m_head < m_window)
+                break;
+            if (!Recover(m_head, 1))
+            {
+                m_lost++;
+                m_head++;
+                continue;
+            }
+        }
+
+        Slot &slot = m_ring[m_head & kRingMask];
+        m_available_packets.push_back(slot.m_packet);
+        if (!HasFEC())
         {
-            QMap<uint64_t, RTPDataPacket>::iterator it =
-                m_unorderedPackets.begin();
-/*
-            LOG(VB_RECORD, LOG_DEBUG, QString("Popping %1 as %2")
-                .arg((*it).GetSequenceNumber()).arg(it.key()));
-*/
-            m_available_packets.push_back(*it);
-            m_unorderedPackets.erase(it);
+            // Nothing will need it again, let the buffer be reused
+            slot.m_packet = RTPDataPacket();
+            slot.m_valid  = false;
         }
+        m_head++;
     }
+
+    PruneFEC();
 }
 
-void RTPPacketBuffer::PushFECPacket(
-    const UDPPacket &packet, uint fec_stream_num)
+void RTPPacketBuffer::PushFECPacket(const UDPPacket &packet, uint fec_stream_num)
 {
     (void) fec_stream_num;
-    // TODO IMPLEMENT
-    // for now just free the packet for immediate reuse
-    FreePacket(packet);
+
+    RTPFECPacket fec_packet(packet);
+    if (!m_started || !fec_packet.IsValid() ||
+        (fec_packet.GetNA() - 1) * fec_packet.GetOffset() >= kMaxWindow)
+    {
+        FreePacket(packet);
+        return;
+    }
+
+    FEC fec;
+    fec.m_packet = fec_packet;
+    fec.m_base   = ExtendSequence(fec_packet.GetSNBase());
+    fec.m_offset = fec_packet.GetOffset();
+    fec.m_count  = fec_packet.GetNA();
+
+    // Even when it is too late to be used, it tells us the matrix size
+    // and that released packets must be kept for the FEC that follows
+    UpdateWindow(fec_packet);
+
+    uint64_t last = fec.m_base + (fec.m_count - 1) * fec.m_offset;
+    if (last < m_head)
+    {
+        // Everything it protects has been handed on
+        FreePacket(packet);
+        return;
+    }
+
+    m_fec.push_back(fec);
+
+    // Rebuild lost packets now rather than when they hold up the stream
+    for (uint j = 0; j < fec.m_count; j++)
+    {
+        uint64_t seq = fec.m_base + j * fec.m_offset;
+        if (seq >= m_head && seq <= m_newest && !Have(seq))
+            Recover(seq, 1);
+    }
+
+    Release();
+}
+
+/// \brief Sizes the window from the FEC matrix, L columns by D rows.
+void RTPPacketBuffer::UpdateWindow(const RTPFECPacket &fec)
+{
+    uint columns = m_fecColumns;
+    uint rows    = m_fecRows;
+    if (fec.IsRow())
+    {
+        columns = fec.GetNA();
+    }
+    else
+    {
+        columns = fec.GetOffset();
+        rows    = fec.GetNA();
+    }
+
+    if (columns == m_fecColumns && rows == m_fecRows)
+        return;
+
+    m_fecColumns = columns;
+    m_fecRows    = rows;
+
+    // Column FEC is sent while the following matrix is being sent
+    m_window = max(kReorderWindow, 2 * m_fecColumns * max(m_fecRows, 1U));
+    m_window = min(m_window, kMaxWindow);
+
+    LOG(VB_RECORD, LOG_INFO, LOC + QString("FEC with L=%1 D=%2, waiting up to "
+                                           "%3 packets for lost packets")
+        .arg(m_fecColumns).arg(m_fecRows).arg(m_window));
+}
+
+/** \fn RTPPacketBuffer::Recover(uint64_t, int)
+ *  \brief Rebuilds a missing packet from any FEC packet that protects it.
+ *
+ *   If the only FEC packets protecting it are missing one other packet too,
+ *   that packet is rebuilt first when Depth allows, which is how row and
+ *   column FEC together repair bursts neither could alone.
+ */
+bool RTPPacketBuffer::Recover(uint64_t seq, int depth)
+{
+    for (const auto & fec : m_fec)
+    {
+        if (seq < fec.m_base)
+            continue;
+        uint64_t diff = seq - fec.m_base;
+        if (diff % fec.m_offset || diff / fec.m_offset >= fec.m_count)
+            continue;
+
+        uint missing = 0;
+        uint64_t other = 0;
+        for (uint j = 0; j < fec.m_count && missing < 3; j++)
+        {
+            uint64_t protected_seq = fec.m_base + j * fec.m_offset;
+            if (!Have(protected_seq))
+            {
+                missing++;
+                if (protected_seq != seq)
+                    other = protected_seq;
+            }
+        }
+
+        if (missing == 1 && Rebuild(fec, seq))
+            return true;
+        if (missing == 2 && depth > 0 && Recover(other, depth - 1) &&
+            Rebuild(fec, seq))
+            return true;
+    }
+    return false;
+}
+
+/// \brief XORs the FEC packet with the packets it protects, except seq.
+bool RTPPacketBuffer::Rebuild(const FEC &fec, uint64_t seq)
+{
+    const RTPFECPacket &fec_packet = fec.m_packet;
+    uint size = fec_packet.GetFECDataSize();
+    vector<unsigned char> payload(fec_packet.GetFECData(),
+                                  fec_packet.GetFECData() + size);
+
+    uint header    = fec_packet.GetHeaderRecovery();
+    uint marker    = fec_packet.GetMarkerRecovery();
+    uint type      = fec_packet.GetPTRecovery();
+    uint timestamp = fec_packet.GetTSRecovery();
+    uint length    = fec_packet.GetLengthRecovery();
+    uint ssrc      = 0;
+
+    for (uint j = 0; j < fec.m_count; j++)
+    {
+        uint64_t protected_seq = fec.m_base + j * fec.m_offset;
+        if (protected_seq == seq)
+            continue;
+
+        const RTPDataPacket &packet = m_ring[protected_seq & kRingMask].m_packet;
+        QByteArray data = packet.GetData();
+        const auto *bytes = reinterpret_cast<const unsigned char*>(data.constData());
+        uint data_size = data.size() - 12;
+
+        header    ^= bytes[0] & 0x3f;
+        marker    ^= bytes[1] & 0x80;
+        type      ^= bytes[1] & 0x7f;
+        timestamp ^= packet.GetTimeStamp();
+        length    ^= data_size;
+        ssrc       = packet.GetSynchronizationSource();
+
+        uint common = min(size, data_size);
+        for (uint k = 0; k < common; k++)
+            payload[k] ^= bytes[12 + k];
+    }
+
+    if (length > size)
+    {
+        LOG(VB_RECORD, LOG_DEBUG, LOC +
+            QString("FEC rebuilt a %1 byte packet from %2 bytes")
+            .arg(length).arg(size));
+        return false;
+    }
+
+    UDPPacket udp_packet(GetEmptyPacket());
+    QByteArray &data = udp_packet.GetDataReference();
+    data.resize(12 + length);
+    auto *bytes = reinterpret_cast<unsigned char*>(data.data());
+    bytes[0]  = 0x80 | header;
+    bytes[1]  = marker | type;
+    bytes[2]  = (seq >> 8) & 0xff;
+    bytes[3]  = seq & 0xff;
+    bytes[4]  = (timestamp >> 24) & 0xff;
+    bytes[5]  = (timestamp >> 16) & 0xff;
+    bytes[6]  = (timestamp >> 8) & 0xff;
+    bytes[7]  = timestamp & 0xff;
+    bytes[8]  = (ssrc >> 24) & 0xff;
+    bytes[9]  = (ssrc >> 16) & 0xff;
+    bytes[10] = (ssrc >> 8) & 0xff;
+    bytes[11] = ssrc & 0xff;
+    if (length)
+        memcpy(bytes + 12, payload.data(), length);
+
+    RTPDataPacket packet(udp_packet);
+    if (!packet.IsValid())
+    {
+        FreePacket(packet);
+        return false;
+    }
+
+    LOG(VB_RECORD, LOG_DEBUG, LOC + QString("Rebuilt packet %1 from %2 FEC")
+        .arg(seq & 0xFFFF).arg(fec_packet.IsRow() ? "row" : "column"));
+    Store(seq, packet);
+    if (seq >= m_head)
+        m_recovered++;
+    return true;
+}
+
+/// \brief Drops FEC packets that protect nothing we might still need.
+void RTPPacketBuffer::PruneFEC(void)
+{
+    auto expired = [this](const FEC &fec)
+    {
+        uint64_t last = fec.m_base + (fec.m_count - 1) * fec.m_offset;
+        return last + m_window < m_head;
+    };
+    for (const auto & fec : m_fec)
+    {
+        if (expired(fec))
+            FreePacket(fec.m_packet);
+    }
+    m_fec.erase(remove_if(m_fec.begin(), m_fec.end(), expired), m_fec.end());
 }
@@ -7,16 +7,26 @@
 #ifndef _RTP_PACKET_BUFFER_H_
 #define _RTP_PACKET_BUFFER_H_
 
-#include <QMap>
+#include <vector>
 
 #include "rtpdatapacket.h"
+#include "rtpfecpacket.h"
 #include "packetbuffer.h"
 
+/** \class RTPPacketBuffer
+ *  \brief Puts RTP packets back in sequence order, and rebuilds missing
+ *         ones from SMPTE 2022-1 FEC packets when it can.
+ *
+ *   Packets are kept in a ring indexed by sequence number.  A packet is
+ *   handed on as soon as every packet before it has been, so when nothing
+ *   is lost nothing waits.  A missing packet holds up the ones after it
+ *   until the stream has moved a window past it; the window is sized from
+ *   the FEC matrix so the column FEC protecting it has time to arrive.
+ */
 class RTPPacketBuffer : public PacketBuffer
 {
   public:
-    explicit RTPPacketBuffer(unsigned int bitrate) :
-        PacketBuffer(bitrate) {}
+    explicit RTPPacketBuffer(unsigned int bitrate);
 
     /// Adds RFC 3550 RTP data packet
     void PushDataPacket(const UDPPacket &udp_packet) override; // PacketBuffer
@@ -24,12 +34,52 @@ class RTPPacketBuffer : public PacketBuffer
     /// Adds SMPTE 2022 Forward Error Correction Stream packet
     void PushFECPacket(const UDPPacket &packet, unsigned int fec_stream_num) override; // PacketBuffer
 
+    /// Whether any FEC packets have been received
+    bool HasFEC(void) const { return m_fecColumns || m_fecRows; }
+    /// Packets rebuilt from FEC
+    uint64_t GetRecoveredCount(void) const { return m_recovered; }
+    /// Packets that were missing and could not be rebuilt
+    uint64_t GetLostCount(void) const { return m_lost; }
+
   private:
-    int      m_largeSequenceNumberSeenRecently { 0   };
-    uint64_t m_currentSequence                 { 0LL };
+    struct Slot
+    {
+        RTPDataPacket m_packet;
+        uint64_t      m_seq   {0};
+        bool          m_valid {false};
+    };
+
+    struct FEC
+    {
+        RTPFECPacket  m_packet;
+        uint64_t      m_base   {0};
+        uint          m_offset {0};
+        uint          m_count  {0};
+    };
+
+    uint64_t ExtendSequence(uint seq) const;
+    bool Have(uint64_t seq) const;
+    void Store(uint64_t seq, const RTPDataPacket &packet);
+    void Release(void);
+    void Restart(uint64_t seq);
+    void UpdateWindow(const RTPFECPacket &fec);
+    bool Recover(uint64_t seq, int depth);
+    bool Rebuild(const FEC &fec, uint64_t seq);
+    void PruneFEC(void);
 
-    /// The key is the RTP sequence number + sequence if applicable
-    QMap<uint64_t, RTPDataPacket> m_unorderedPackets;
+    std::vector<Slot> m_ring;
+    std::vector<FEC>  m_fec;
+    bool     m_started    {false};
+    /// Extended sequence number of the next packet to hand on
+    uint64_t m_head       {0};
+    /// Highest extended sequence number received
+    uint64_t m_newest     {0};
+    /// How far m_newest may get past a missing packet before it is given up
+    uint     m_window;
+    uint     m_fecColumns {0};
+    uint     m_fecRows    {0};
+    uint64_t m_recovered  {0};
+    uint64_t m_lost       {0};
 };
 
 #endif // _RTP_PACKET_BUFFER_H_
@@ -0,0 +1,149 @@
+/* -*- Mode: c++ -*-
+ * UDPBatchReader
+ * Distributed as part of MythTV under GPL v2 and later.
+ */
+
+// POSIX headers
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+// MythTV headers
+#include "udpbatchreader.h"
+
+#ifdef __linux__
+/// Room for a timestamp and a drop counter
+static const size_t kControlSize = 64;
+#endif
+
+UDPBatchReader::UDPBatchReader(int fd, unsigned int slots,
+                               unsigned int slot_size) :
+    m_fd(fd),
+    m_slots(slots ? slots : 1),
+    m_slotSize(slot_size),
+    m_data(static_cast<size_t>(m_slots) * m_slotSize),
+    m_sizes(m_slots, 0),
+    m_truncated(m_slots, false),
+    m_times(m_slots, 0),
+    m_senders(m_slots)
+{
+#ifdef __linux__
+    int on = 1;
+    setsockopt(m_fd, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on));
+    setsockopt(m_fd, SOL_SOCKET, SO_RXQ_OVFL, &on, sizeof(on));
+
+    m_msgs.resize(m_slots);
+    m_iovs.resize(m_slots);
+    m_control.resize(m_slots * kControlSize);
+    for (unsigned int i = 0; i < m_slots; i++)
+    {
+        m_iovs[i].iov_base = &m_data[static_cast<size_t>(i) * m_slotSize];
+        m_iovs[i].iov_len  = m_slotSize;
+    }
+#endif
+}
+
+int UDPBatchReader::Read(void)
+{
+#ifdef __linux__
+    // recvmmsg() overwrites the lengths, so they are reset for every call
+    for (unsigned int i = 0; i < m_slots; i++)
+    {
+        struct msghdr &hdr = m_msgs[i].msg_hdr;
+        hdr.msg_name       = &m_senders[i];
+        hdr.msg_namelen    = sizeof(m_senders[i]);
+        hdr.msg_iov        = &m_iovs[i];
+        hdr.msg_iovlen     = 1;
+        hdr.msg_control    = &m_control[i * kControlSize];
+        hdr.msg_controllen = kControlSize;
+        hdr.msg_flags      = 0;
+        m_msgs[i].msg_len  = 0;
+    }
+
+    int count = recvmmsg(m_fd, m_msgs.data(), m_slots, MSG_DONTWAIT, nullptr);
+    if (count < 0)
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+
+    for (int i = 0; i < count; i++)
+    {
+        struct msghdr &hdr = m_msgs[i].msg_hdr;
+        m_sizes[i]     = m_msgs[i].msg_len;
+        m_truncated[i] = (hdr.msg_flags & MSG_TRUNC) != 0;
+        m_times[i]     = 0;
+
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr); cmsg;
+             cmsg = CMSG_NXTHDR(&hdr, cmsg))
+        {
+            if (cmsg->cmsg_level != SOL_SOCKET)
+                continue;
+            if (cmsg->cmsg_type == SO_TIMESTAMPNS)
+            {
+                struct timespec ts {};
+                memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+                m_times[i] = static_cast<int64_t>(ts.tv_sec) * 1000000 +
+                             ts.tv_nsec / 1000;
+            }
+            else if (cmsg->cmsg_type == SO_RXQ_OVFL)
+            {
+                memcpy(&m_drops, CMSG_DATA(cmsg), sizeof(m_drops));
+            }
+        }
+    }
+    return count;
+#else
+    int count = 0;
+    while (count < static_cast<int>(m_slots))
+    {
+        socklen_t namelen = sizeof(m_senders[count]);
+        ssize_t size = recvfrom(
+            m_fd, &m_data[static_cast<size_t>(count) * m_slotSize], m_slotSize,
+            MSG_DONTWAIT, reinterpret_cast<struct sockaddr*>(&m_senders[count]),
+            &namelen);
+        if (size < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+                break;
+            return count ? count : -1;
+        }
+        m_sizes[count]     = static_cast<unsigned int>(size);
+        m_truncated[count] = false;
+        m_times[count]     = 0;
+        count++;
+    }
+    return count;
+#endif
+}
+
+/** \fn UDPBatchReader::SetReceiveBufferSize(int, int)
+ *  \brief Asks for a socket receive buffer of at least bytes.
+ *
+ *   The kernel silently caps SO_RCVBUF at net.core.rmem_max, so on Linux
+ *   SO_RCVBUFFORCE is tried as well, which works when we have
+ *   CAP_NET_ADMIN.
+ *
+ *  \return the size the kernel actually gave us, or -1 if unknown
+ */
+int UDPBatchReader::SetReceiveBufferSize(int fd, int bytes)
+{
+    setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes));
+
+    int actual = 0;
+    socklen_t len = sizeof(actual);
+    if (getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &actual, &len) < 0)
+        return -1;
+#ifdef __linux__
+    // Linux doubles the size to allow for its own bookkeeping
+    actual /= 2;
+    if (actual < bytes &&
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &bytes, sizeof(bytes)) == 0)
+    {
+        len = sizeof(actual);
+        if (getsockopt(fd, SOL_SOCKET, SO_RCVBUF, &actual, &len) < 0)
+            return -1;
+        actual /= 2;
+    }
+#endif
+    return actual;
+}
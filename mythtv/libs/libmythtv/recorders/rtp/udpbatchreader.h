@@ -0,0 +1,78 @@
+/* -*- Mode: c++ -*-
+ * UDPBatchReader
+ * Distributed as part of MythTV under GPL v2 and later.
+ */
+
+#ifndef _UDP_BATCH_READER_H_
+#define _UDP_BATCH_READER_H_
+
+#include <cinttypes>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include "mythtvexp.h"
+
+/** \class UDPBatchReader
+ *  \brief Reads every datagram queued on a UDP socket with as few system
+ *         calls as possible.
+ *
+ *   On Linux a single recvmmsg() call fills a ring of preallocated slots,
+ *   and the kernel reports when each datagram arrived and how many it had
+ *   to drop because the socket buffer was full.  Elsewhere the slots are
+ *   filled with one recvfrom() call per datagram.  Not available on
+ *   Windows.
+ *
+ *   The slots are reused by the next Read(), so the caller must copy out
+ *   anything it wants to keep first.
+ */
+class MTV_PUBLIC UDPBatchReader
+{
+  public:
+    static const unsigned int kDefaultSlots    = 64;
+    /// Large enough for jumbo frames; IPTV datagrams are normally 1316 bytes
+    static const unsigned int kDefaultSlotSize = 9216;
+
+    explicit UDPBatchReader(int fd,
+                            unsigned int slots     = kDefaultSlots,
+                            unsigned int slot_size = kDefaultSlotSize);
+
+    /// Reads the queued datagrams without blocking.
+    /// \return the number read, or -1 on a socket error
+    int Read(void);
+
+    const unsigned char *GetData(int i) const
+        { return &m_data[static_cast<size_t>(i) * m_slotSize]; }
+    unsigned int GetSize(int i) const { return m_sizes[i]; }
+    /// True if the datagram was larger than a slot and was cut short
+    bool IsTruncated(int i) const { return m_truncated[i]; }
+    const struct sockaddr *GetSender(int i) const
+        { return reinterpret_cast<const struct sockaddr*>(&m_senders[i]); }
+    /// Time the kernel received the datagram, in microseconds since the
+    /// epoch, or 0 if the kernel does not report it
+    int64_t GetKernelTime(int i) const { return m_times[i]; }
+
+    /// Datagrams the kernel has dropped on this socket since it was opened
+    uint32_t GetKernelDrops(void) const { return m_drops; }
+
+    static int SetReceiveBufferSize(int fd, int bytes);
+
+  private:
+    int                          m_fd;
+    unsigned int                 m_slots;
+    unsigned int                 m_slotSize;
+    std::vector<unsigned char>   m_data;
+    std::vector<unsigned int>    m_sizes;
+    std::vector<bool>            m_truncated;
+    std::vector<int64_t>         m_times;
+    uint32_t                     m_drops    {0};
+    std::vector<struct sockaddr_storage> m_senders;
+#ifdef __linux__
+    std::vector<struct mmsghdr>  m_msgs;
+    std::vector<struct iovec>    m_iovs;
+    std::vector<unsigned char>   m_control;
+#endif
+};
+
+#endif // _UDP_BATCH_READER_H_
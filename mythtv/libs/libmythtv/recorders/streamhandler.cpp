@@ -66,6 +66,7 @@ void StreamHandler::AddListener(MPEGStreamData *data,
     }
 
     m_streamDataList[data] = std::move(output_file);
+    m_routeVersions.clear();
 
     m_listenerLock.unlock();
 
@@ -102,6 +103,7 @@ void StreamHandler::RemoveListener(MPEGStreamData *data)
             RemoveNamedOutputFile(*it);
         m_streamDataList.erase(it);
     }
+    m_routeVersions.clear();
 
     m_listenerLock.unlock();
 
@@ -346,6 +348,153 @@ PIDPriority StreamHandler::GetPIDPriority(uint pid) const
     return tmp;
 }
 
+/** \fn StreamHandler::ProcessData(const unsigned char*, int)
+ *  \brief Hands each TS packet in buffer to the listeners that process
+ *         its PID.
+ *
+ *   Each listener used to be handed the whole multiplex, and looked up
+ *   every packet's PID in its own tables, so with several recordings from
+ *   one multiplex most of the work was spent on packets the recording did
+ *   not want.  Here the packets are split up by PID once, and each
+ *   listener is only asked which PIDs it processes as they are first
+ *   seen.  The routes are kept until a listener is added or removed, or
+ *   one of them changes its PIDs, which MPEGStreamData::GetPIDVersion()
+ *   tells us.  That is checked at the start of each block and after
+ *   every table packet, since parsing a table is what normally changes
+ *   the PIDs, but most tables, such as EIT, do not.
+ *
+ *   Only the PID filtering is shared.  Each listener still parses its own
+ *   tables and PES headers, so a PID wanted by several listeners, such as
+ *   the PAT, is parsed by each of them.
+ *
+ *   Must be called with m_listenerLock held.
+ *
+ *  \return number of bytes at the end of buffer that were not processed
+ */
+int StreamHandler::ProcessData(const unsigned char *buffer, int len)
+{
+    int remainder = RouteData(buffer, len);
+    m_bytesMetric.Add(len - remainder);
+    return remainder;
+}
+
+int StreamHandler::RouteData(const unsigned char *buffer, int len)
+{
+    if (m_streamDataList.size() < 2)
+    {
+        int remainder = 0;
+        for (auto sit = m_streamDataList.cbegin();
+             sit != m_streamDataList.cend(); ++sit)
+            remainder = sit.key()->ProcessData(buffer, len);
+        return remainder;
+    }
+
+    // Listeners may have changed their PIDs since the last block
+    UpdatePIDRoutes();
+
+    int pos = 0;
+    bool resync = false;
+
+    while (pos + int(TSPacket::kSize) <= len)
+    { // while we have a whole packet left...
+        if (buffer[pos] != SYNC_BYTE || resync)
+        {
+            int newpos = MPEGStreamData::ResyncStream(buffer, pos+1, len);
+            LOG(VB_RECORD, LOG_DEBUG, LOC +
+                QString("Resyncing @ %1+1 w/len %2 -> %3")
+                .arg(pos).arg(len).arg(newpos));
+            if (newpos == -1)
+                return len - pos;
+            if (newpos == -2)
+                return TSPacket::kSize;
+            pos = newpos;
+        }
+
+        const auto *pkt = reinterpret_cast<const TSPacket*>(&buffer[pos]);
+        pos += TSPacket::kSize; // Advance to next TS packet
+        resync = false;
+
+        bool tables = false;
+        for (const auto & listener : GetPIDRoute(pkt->PID()))
+        {
+            listener.first->ProcessTSPacket(*pkt);
+            tables |= listener.second;
+        }
+        if (tables)
+            UpdatePIDRoutes();
+
+        // Same as MPEGStreamData::ProcessData(), resync after a bad packet
+        // unless the next one is in sync
+        if (pkt->TransportError() && pos + int(TSPacket::kSize) <= len &&
+            buffer[pos] != SYNC_BYTE)
+        {
+            pos -= TSPacket::kSize;
+            resync = true;
+        }
+    }
+
+    return len - pos;
+}
+
+const StreamHandler::PIDRoute &StreamHandler::GetPIDRoute(uint pid)
+{
+    if (m_pidRoutes.empty())
+    {
+        m_pidRoutes.resize(0x2000);
+        m_pidRouted.resize(0x2000, false);
+    }
+
+    PIDRoute &route = m_pidRoutes[pid];
+    if (!m_pidRouted[pid])
+    {
+        for (auto sit = m_streamDataList.cbegin();
+             sit != m_streamDataList.cend(); ++sit)
+        {
+            MPEGStreamData *data = sit.key();
+            if (data->IsProcessingPID(pid))
+                route.emplace_back(data, data->IsListeningPID(pid));
+        }
+        m_pidRouted[pid] = true;
+        m_routedPids.push_back(pid);
+    }
+    return route;
+}
+
+/// \brief Drops the PID routes if any listener's PIDs have changed.
+void StreamHandler::UpdatePIDRoutes(void)
+{
+    if (m_routeVersions.size() == static_cast<size_t>(m_streamDataList.size()))
+    {
+        bool same = true;
+        size_t i = 0;
+        for (auto sit = m_streamDataList.cbegin();
+             same && sit != m_streamDataList.cend(); ++sit, ++i)
+        {
+            same = (m_routeVersions[i].first == sit.key()) &&
+                (m_routeVersions[i].second == sit.key()->GetPIDVersion());
+        }
+        if (same)
+            return;
+    }
+
+    m_routeVersions.clear();
+    for (auto sit = m_streamDataList.cbegin();
+         sit != m_streamDataList.cend(); ++sit)
+        m_routeVersions.emplace_back(sit.key(), sit.key()->GetPIDVersion());
+
+    ClearPIDRoutes();
+}
+
+void StreamHandler::ClearPIDRoutes(void)
+{
+    for (uint pid : m_routedPids)
+    {
+        m_pidRoutes[pid].clear();
+        m_pidRouted[pid] = false;
+    }
+    m_routedPids.clear();
+}
+
 void StreamHandler::WriteMPTS(unsigned char * buffer, uint len)
 {
     if (m_mptsTfw == nullptr)
@@ -18,6 +18,7 @@ using namespace std;
 #include "mpegstreamdata.h" // for PIDPriority
 #include "mthread.h"
 #include "mythdate.h"
+#include "mythmetrics.h"
 
 class ThreadedFileWriter;
 
@@ -91,6 +92,8 @@ class StreamHandler : protected MThread, public DeviceReaderCB
 
     PIDPriority GetPIDPriority(uint pid) const;
 
+    int  ProcessData(const unsigned char *buffer, int len);
+
     // DeviceReaderCB
     void ReaderPaused(int fd) override { (void) fd; } // DeviceReaderCB
     void PriorityEvent(int fd) override { (void) fd; } // DeviceReaderCB
@@ -141,6 +144,28 @@ class StreamHandler : protected MThread, public DeviceReaderCB
     using StreamDataList = QMap<MPEGStreamData*,QString>;
     mutable QMutex      m_listenerLock         {QMutex::Recursive};
     StreamDataList      m_streamDataList;
+
+  private:
+    int  RouteData(const unsigned char *buffer, int len);
+
+    /// The listeners processing a PID, and whether it carries tables for them
+    using PIDRoute = vector<pair<MPEGStreamData*,bool> >;
+    const PIDRoute &GetPIDRoute(uint pid);
+    void UpdatePIDRoutes(void);
+    void ClearPIDRoutes(void);
+
+    // The following are only used by ProcessData(), and cleared by
+    // AddListener() and RemoveListener(), under m_listenerLock
+    vector<PIDRoute>    m_pidRoutes;
+    vector<bool>        m_pidRouted;
+    vector<uint>        m_routedPids;
+    /// Each listener's GetPIDVersion() when the routes were built
+    vector<pair<MPEGStreamData*,uint> > m_routeVersions;
+
+    MythMetric          m_bytesMetric {"mythtv_streamhandler_bytes_total",
+                                       "Bytes received from the device",
+                                       MythMetric::kCounter,
+                                       {{"device", m_device}}};
 };
 
 #endif // _STREAM_HANDLER_H_
@@ -1211,7 +1211,9 @@ class TranscodeLossless : public MythUICheckBoxSetting, public CodecParamStorage
                                 "keep audio and video formats identical to "
                                 "the source.  This should result in the "
                                 "highest quality, but won't save as much "
-                                "space."));
+                                "space.  H.264 and HEVC recordings are never "
+                                "reencoded, their cuts are moved to the "
+                                "nearest keyframes instead."));
     };
 };
 
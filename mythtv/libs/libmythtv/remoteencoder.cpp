@@ -621,6 +621,25 @@ bool RemoteEncoder::CheckChannel(const QString& channel)
     return false;
 }
 
+/** \fn RemoteEncoder::StandbyTune(const QString&)
+ *  \brief Asks an idle recorder to tune to a channel LiveTV may change to
+ *         next, so that a switch to it does not wait for a lock.
+ *         <b>This only works on local recorders.</b>
+ *  \return true if the recorder is tuning or has tuned the channel
+ *  \sa TVRec::StandbyTune(const QString&)
+ */
+bool RemoteEncoder::StandbyTune(const QString& channel)
+{
+    QStringList strlist( QString("QUERY_RECORDER %1").arg(m_recordernum) );
+    strlist << "STANDBY_TUNE";
+    strlist << channel;
+
+    if (SendReceiveStringList(strlist, 1))
+        return strlist[0].toInt() != 0;
+
+    return false;
+}
+
 /** \fn RemoteEncoder::ShouldSwitchToAnotherCard(QString)
  *  \brief Checks if named channel exists on current tuner, or
  *         another tuner.
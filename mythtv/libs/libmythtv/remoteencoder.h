@@ -68,6 +68,7 @@ class MTV_PUBLIC RemoteEncoder
     int  SetSignalMonitoringRate(int rate, bool notifyFrontend = true);
     uint GetSignalLockTimeout(const QString& input);
     bool CheckChannel(const QString& channel);
+    bool StandbyTune(const QString& channel);
     bool ShouldSwitchToAnotherCard(const QString& channelid);
     bool CheckChannelPrefix(const QString &prefix, uint &complete_valid_channel_on_rec,
                             bool &is_extra_char_useful, QString &needed_spacer);
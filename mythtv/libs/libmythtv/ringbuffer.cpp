@@ -39,6 +39,10 @@
 const int  RingBuffer::kDefaultOpenTimeout = 2000; // ms
 const int  RingBuffer::kLiveTVOpenTimeout  = 10000;
 
+// Seconds of the stream the read ahead thread tries to keep buffered
+static const float kReadAheadMinSecs = 2.0F;
+static const float kReadAheadMaxSecs = 30.0F;
+
 #define LOC      QString("RingBuf(%1): ").arg(m_filename)
 
 QMutex      RingBuffer::s_subExtLock;
@@ -371,9 +375,6 @@ void RingBuffer::CalcReadAheadThresh(void)
     m_readsAllowed   = false;
     m_readsDesired   = false;
 
-    // loop without sleeping if the buffered data is less than this
-    m_fillThreshold = 7 * m_bufferSize / 8;
-
     const uint KB2   =   2*1024;
     const uint KB4   =   4*1024;
     const uint KB8   =   8*1024;
@@ -427,6 +428,10 @@ void RingBuffer::CalcReadAheadThresh(void)
                                      "for low bitrate stream.");
     }
 
+    // loop without sleeping if the buffered data is less than this
+    m_consumeRate = max(estbitrate, 1U) * 125; // kbit/s -> bytes/s
+    CalcFillThreshold();
+
     LOG(VB_FILE, LOG_INFO, LOC +
         QString("CalcReadAheadThresh(%1 Kb)\n\t\t\t -> "
                 "threshold(%2 KB) min read(%3 KB) blk size(%4 KB)")
@@ -434,6 +439,73 @@ void RingBuffer::CalcReadAheadThresh(void)
             .arg(m_fillMin/1024).arg(m_readBlockSize/1024));
 }
 
+/** \fn RingBuffer::CalcFillThreshold(void)
+ *  \brief Sets m_fillThreshold to m_readAheadSecs of the stream, and asks
+ *         for a larger buffer when that does not fit in this one.
+ *
+ *   WARNING: Must be called with rwlock in write lock state, or in read
+ *            lock state from the read ahead thread.
+ */
+void RingBuffer::CalcFillThreshold(void)
+{
+    float secs = max(m_readAheadSecs, kReadAheadMinSecs);
+    auto want = static_cast<uint64_t>(m_consumeRate * secs);
+    uint64_t most = 7ULL * m_bufferSize / 8;
+
+    if (want > most && m_bufferSize < BUFFER_SIZE_MAXIMUM)
+    {
+        // Whole megabytes, so that it does not grow a little at a time
+        uint64_t size = ((want * 8 / 7) | 0xFFFFF) + 1;
+        m_wantBufferSize = min(size, (uint64_t)BUFFER_SIZE_MAXIMUM);
+    }
+
+    auto least = static_cast<uint64_t>(2 * max(m_fillMin, m_readBlockSize));
+    m_fillThreshold = static_cast<int>(min(max(want, least), most));
+}
+
+/** \fn RingBuffer::UpdateReadAhead(int, int)
+ *  \brief Adapts how far ahead to read to the storage's latency and
+ *         throughput.
+ *
+ *   Enough is buffered to ride out several of the slowest recent reads,
+ *   and when the storage barely keeps up with the stream, as much as
+ *   the memory budget allows.  Called by the read ahead thread after
+ *   every read that was not cut short by the end of the file.
+ *
+ *  \param bytes   size of the read
+ *  \param elapsed time the read took, in ms
+ */
+void RingBuffer::UpdateReadAhead(int bytes, int elapsed)
+{
+    m_readLatency     = (m_readLatency * 7 + elapsed) / 8;
+    m_readLatencyPeak = max(elapsed,
+                            m_readLatencyPeak - (m_readLatencyPeak + 15) / 16);
+    if (elapsed > 0 && bytes >= CHUNK)
+    {
+        uint64_t rate = bytes * 1000ULL / elapsed;
+        m_readThroughput = m_readThroughput ?
+            (m_readThroughput * 7 + rate) / 8 : rate;
+    }
+
+    float secs = kReadAheadMinSecs + (4 * m_readLatencyPeak / 1000.0F);
+    if (m_readThroughput && m_readThroughput < m_consumeRate * 3ULL / 2)
+        secs = kReadAheadMaxSecs;
+    secs = min(secs, kReadAheadMaxSecs);
+
+    if (fabs(secs - m_readAheadSecs) < 0.5F)
+        return;
+
+    m_readAheadSecs = secs;
+    CalcFillThreshold();
+
+    LOG(VB_FILE, LOG_INFO, LOC +
+        QString("Read latency %1 ms (peak %2 ms) at %3 KB/s, "
+                "reading %4 s ahead -> threshold(%5 KB)")
+            .arg(m_readLatency.load()).arg(m_readLatencyPeak)
+            .arg(m_readThroughput / 1024).arg(secs, 0, 'f', 1)
+            .arg(m_fillThreshold / 1024));
+}
+
 bool RingBuffer::IsNearEnd(double /*fps*/, uint vvf) const
 {
     QReadLocker lock(&m_rwLock);
@@ -494,6 +566,20 @@ int RingBuffer::GetReadBufAvail(void) const
     return ReadBufAvail();
 }
 
+/** \fn RingBuffer::WaitForReadAhead(int, int)
+ *  \brief Waits up to timeout ms for count bytes to be read ahead.
+ *
+ *   This lets a reader wait for slow storage before taking its own locks,
+ *   so that the read which follows does not block while holding them.
+ *  \return bytes available for reading from the buffer
+ */
+int RingBuffer::WaitForReadAhead(int count, int timeout)
+{
+    QReadLocker lock(&m_rwLock);
+
+    return WaitForAvail(count, timeout);
+}
+
 long long RingBuffer::GetRealFileSize(void) const
 {
     {
@@ -844,6 +930,8 @@ void RingBuffer::CreateReadAheadBuffer(void)
         if (m_unknownBitrate)
             newsize *= BUFFER_FACTOR_BITRATE;
     }
+    // or larger, if that is what the read ahead needs
+    newsize = max(newsize, m_wantBufferSize);
 
     // N.B. Don't try and make it smaller - bad things happen...
     if (m_readAheadBuffer && oldsize >= newsize)
@@ -1081,6 +1169,10 @@ void RingBuffer::run(void)
                     QString("total read so far: %1 bytes")
                     .arg(m_internalReadPos));
             }
+
+            // A short read is the end of the file, not slow storage
+            if (read_return == totfree)
+                UpdateReadAhead(read_return, sr_elapsed);
         }
         else
         {
@@ -1186,6 +1278,14 @@ void RingBuffer::run(void)
             eofreads = 0;
         }
 
+        // The read ahead wants more than fits, grow the buffer
+        if (m_wantBufferSize > m_bufferSize && !m_commsError)
+        {
+            m_rwLock.unlock();
+            CreateReadAheadBuffer();
+            m_rwLock.lockForRead();
+        }
+
         LOG(VB_FILE, LOG_DEBUG, LOC + "@ end of read ahead loop");
 
         if (!m_readsAllowed || m_commsError || m_ateof || m_setSwitchToNext ||
@@ -1650,6 +1750,20 @@ QString RingBuffer::GetAvailableBuffer(void)
     return QString("%1%").arg(lroundf((float)avail / (float)m_bufferSize * 100.0F));
 }
 
+/// \brief Seconds of the stream buffered, of those wanted, and the
+///        average read latency, for the OSD debug screen.
+QString RingBuffer::GetReadAheadStats(void) const
+{
+    if (m_type == kRingBuffer_DVD || m_type == kRingBuffer_BD)
+        return "N/A";
+
+    float rate   = m_consumeRate.load();
+    float avail  = (float)GetReadBufAvail() / rate;
+    float target = (float)m_fillThreshold.load() / rate;
+    return QString("%1/%2 s, %3 ms").arg(avail, 0, 'f', 1)
+        .arg(target, 0, 'f', 1).arg(m_readLatency.load());
+}
+
 uint64_t RingBuffer::UpdateDecoderRate(uint64_t latest)
 {
     if (!m_bitrateMonitorEnabled)
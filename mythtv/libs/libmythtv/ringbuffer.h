@@ -3,6 +3,8 @@
 #ifndef _RINGBUFFER_H_
 #define _RINGBUFFER_H_
 
+#include <atomic>
+
 #include <QReadWriteLock>
 #include <QWaitCondition>
 #include <QString>
@@ -27,6 +29,8 @@ extern "C" {
 
 // about one second at 35mbit
 #define BUFFER_SIZE_MINIMUM (4 * 1024 * 1024)
+// most the read ahead buffer may grow to, about 6 seconds at 80mbit
+#define BUFFER_SIZE_MAXIMUM (64 * 1024 * 1024)
 #define BUFFER_FACTOR_NETWORK  2
 #define BUFFER_FACTOR_BITRATE  2
 #define BUFFER_FACTOR_MATROSKA 2
@@ -88,6 +92,7 @@ class MTV_PUBLIC RingBuffer : protected MThread
     QString GetDecoderRate(void);
     QString GetStorageRate(void);
     QString GetAvailableBuffer(void);
+    QString GetReadAheadStats(void) const;
     uint    GetBufferSize(void) { return m_bufferSize; }
     long long GetWritePosition(void) const;
     /// \brief Returns the size of the file we are reading/writing,
@@ -105,6 +110,7 @@ class MTV_PUBLIC RingBuffer : protected MThread
 
     // LiveTV used utilities
     int GetReadBufAvail() const;
+    int WaitForReadAhead(int count, int timeout);
     bool SetReadInternalMode(bool mode);
     bool IsReadInternalMode(void) { return m_readInternalMode; }
 
@@ -181,6 +187,8 @@ class MTV_PUBLIC RingBuffer : protected MThread
     void run(void) override; // MThread
     void CreateReadAheadBuffer(void);
     void CalcReadAheadThresh(void);
+    void UpdateReadAhead(int bytes, int elapsed);
+    void CalcFillThreshold(void);
     bool PauseAndWait(void);
     virtual int safe_read(void *data, uint sz) = 0;
 
@@ -267,9 +275,16 @@ class MTV_PUBLIC RingBuffer : protected MThread
     bool                   m_setSwitchToNext  {false};
     uint                   m_rawBitrate       {8000};
     float                  m_playSpeed        {1.0F};
-    int                    m_fillThreshold    {65536};
+    std::atomic<int>       m_fillThreshold    {65536}; // (see note 2)
     int                    m_fillMin          {-1};
     int                    m_readBlockSize    {CHUNK};
+    // Adaptive read ahead, see UpdateReadAhead() (see note 1)
+    std::atomic<uint>      m_consumeRate      {1000000}; // bytes/s (note 2)
+    std::atomic<int>       m_readLatency      {0};       // ms (note 2)
+    int                    m_readLatencyPeak  {0};       // ms
+    uint64_t               m_readThroughput   {0};       // bytes/s
+    float                  m_readAheadSecs    {0.0F};
+    uint                   m_wantBufferSize   {0};
     int                    m_wantToRead       {0};
     int                    m_numFailures      {0};    // (see note 1)
     bool                   m_commsError       {false};
@@ -295,11 +310,15 @@ class MTV_PUBLIC RingBuffer : protected MThread
     QMutex                 m_storageReadLock;
     QMap<qint64, uint64_t> m_storageReads;
 
-    // note 1: numfailures is modified with only a read lock in the
-    // read ahead thread, but this is safe since all other places
-    // that use it are protected by a write lock. But this is a
-    // fragile state of affairs and care must be taken when modifying
-    // code or locking around this variable.
+    // note 1: numfailures and the adaptive read ahead state are modified
+    // with only a read lock in the read ahead thread, but this is safe
+    // since all other places that use them are protected by a write lock.
+    // But this is a fragile state of affairs and care must be taken when
+    // modifying code or locking around these variables.
+
+    // note 2: these are also read by GetReadAheadStats() from the UI
+    // thread, which a read lock would not keep out of the read ahead
+    // thread's updates, so they are atomic.
 
     /// Condition to signal that the read ahead thread is running
     QWaitCondition         m_generalWait; // protected by rwLock
@@ -0,0 +1,170 @@
+/*
+ *  Class TestDTVRecorder
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include "mythcorecontext.h"
+#include "dtvrecorder.h"
+#include "mpegtables.h"
+#include "test_dtvrecorder.h"
+
+/// A DTVRecorder with neither a tuner nor a ringbuffer, which lets the
+/// tests reach its keyframe and continuity bookkeeping
+class TestRecorder : public DTVRecorder
+{
+  public:
+    TestRecorder() : DTVRecorder(nullptr) {}
+
+    void run(void) override {} // RecorderBase
+
+    using DTVRecorder::ContinuityFollows;
+    using DTVRecorder::CheckCC;
+    using DTVRecorder::HandleH264Keyframe;
+    using DTVRecorder::HandleVideoLoss;
+
+    void SetCounter(uint pid, uint cnt) { m_continuityCounter[pid] = cnt; }
+    void SetFramesWritten(uint64_t frames) { m_framesWrittenCount = frames; }
+    void SetFirstKeyframe(int frame) { m_firstKeyframe = frame; }
+
+    frm_dir_map_t DamageMarks(void)
+    {
+        QMutexLocker locker(&m_positionMapLock);
+        return m_damageMapDelta;
+    }
+};
+
+void TestDTVRecorder::initTestCase(void)
+{
+    gCoreContext = new MythCoreContext("bin_version", nullptr);
+}
+
+void TestDTVRecorder::ContinuityFollows_data(void)
+{
+    QTest::addColumn<uint>("last");
+    QTest::addColumn<uint>("next");
+    QTest::addColumn<bool>("follows");
+
+    QTest::newRow("next")          <<  5U <<  6U << true;
+    QTest::newRow("wraparound")    << 15U <<  0U << true;
+    QTest::newRow("duplicate")     <<  5U <<  5U << true;
+    QTest::newRow("duplicate 15")  << 15U << 15U << true;
+    QTest::newRow("first packet")  << 0xFFU << 9U << true;
+    QTest::newRow("lost one")      <<  5U <<  7U << false;
+    QTest::newRow("lost at wrap")  << 15U <<  1U << false;
+    QTest::newRow("lost fifteen")  <<  5U <<  4U << false;
+    QTest::newRow("no wrap at 16") << 15U << 16U << false;
+}
+
+/// Only the next counter, or a repeat of the last, follows on
+void TestDTVRecorder::ContinuityFollows(void)
+{
+    QFETCH(uint, last);
+    QFETCH(uint, next);
+    QFETCH(bool, follows);
+
+    TestRecorder rec;
+    rec.SetCounter(0x100, last);
+    QCOMPARE(rec.ContinuityFollows(0x100, next), follows);
+}
+
+/// CheckCC() remembers each PID's counter, ContinuityFollows() does not
+void TestDTVRecorder::CheckCC(void)
+{
+    TestRecorder rec;
+    rec.SetCounter(0x100, 14);
+    rec.SetCounter(0x101, 3);
+
+    QVERIFY(rec.ContinuityFollows(0x100, 15));
+    QVERIFY(!rec.ContinuityFollows(0x100, 0));
+
+    QVERIFY(rec.CheckCC(0x100, 15));
+    QVERIFY(rec.CheckCC(0x100, 0));
+    QVERIFY(rec.CheckCC(0x100, 0));
+    QVERIFY(!rec.CheckCC(0x100, 2));
+    QVERIFY(rec.ContinuityFollows(0x100, 3));
+
+    // other PIDs keep their own counter
+    QVERIFY(rec.ContinuityFollows(0x101, 4));
+    QVERIFY(!rec.ContinuityFollows(0x101, 5));
+}
+
+/// A loss queues MARK_DAMAGED_START at the frame it hit, and the next
+/// keyframe closes it with MARK_DAMAGED_END
+void TestDTVRecorder::DamagedMarks(void)
+{
+    TestRecorder rec;
+    rec.SetFirstKeyframe(0);
+
+    rec.SetFramesWritten(10);
+    rec.HandleVideoLoss(StreamID::MPEG2Video);
+    frm_dir_map_t marks = rec.DamageMarks();
+    QCOMPARE(marks.size(), 1);
+    QCOMPARE(marks.value(9), MARK_DAMAGED_START);
+
+    // more losses before the keyframe stay in the same region
+    rec.SetFramesWritten(12);
+    rec.HandleVideoLoss(StreamID::MPEG2Video);
+    QCOMPARE(rec.DamageMarks(), marks);
+
+    rec.SetFramesWritten(15);
+    rec.HandleH264Keyframe();
+    marks = rec.DamageMarks();
+    QCOMPARE(marks.size(), 2);
+    QCOMPARE(marks.value(9),  MARK_DAMAGED_START);
+    QCOMPARE(marks.value(15), MARK_DAMAGED_END);
+
+    // later keyframes are not damaged
+    rec.SetFramesWritten(27);
+    rec.HandleH264Keyframe();
+    QCOMPARE(rec.DamageMarks(), marks);
+
+    // and a new loss starts a new region
+    rec.SetFramesWritten(31);
+    rec.HandleVideoLoss(StreamID::MPEG2Video);
+    rec.SetFramesWritten(40);
+    rec.HandleH264Keyframe();
+    marks = rec.DamageMarks();
+    QCOMPARE(marks.size(), 4);
+    QCOMPARE(marks.value(30), MARK_DAMAGED_START);
+    QCOMPARE(marks.value(40), MARK_DAMAGED_END);
+}
+
+/// An H.264 loss also resyncs the parser, and is marked the same way
+void TestDTVRecorder::DamagedMarks_H264(void)
+{
+    TestRecorder rec;
+    rec.SetFirstKeyframe(0);
+
+    rec.SetFramesWritten(100);
+    rec.HandleVideoLoss(StreamID::H264Video);
+    rec.SetFramesWritten(125);
+    rec.HandleH264Keyframe();
+
+    frm_dir_map_t marks = rec.DamageMarks();
+    QCOMPARE(marks.size(), 2);
+    QCOMPARE(marks.value(99),  MARK_DAMAGED_START);
+    QCOMPARE(marks.value(125), MARK_DAMAGED_END);
+}
+
+/// Nothing has been written before the first keyframe, so there is
+/// nothing to mark
+void TestDTVRecorder::DamagedMarks_beforeKeyframe(void)
+{
+    TestRecorder rec;
+    rec.HandleVideoLoss(StreamID::MPEG2Video);
+    QVERIFY(rec.DamageMarks().empty());
+}
+
+QTEST_APPLESS_MAIN(TestDTVRecorder)
@@ -24,6 +24,99 @@
 #include "channelscan/iptvchannelfetcher.h"
 #include "recorders/rtp/rtpdatapacket.h"
 #include "recorders/rtp/rtptsdatapacket.h"
+#include "recorders/rtp/rtppacketbuffer.h"
+
+/* #11852 - RTP packet from VLC - minimal RTP header and 7 TS packets */
+static const unsigned char packet_data0[1328] = {
+    0x80, 0xA1, 0xB0, 0x16, 0x66, 0x2D, 0x90, 0x6E,  0x32, 0x4C, 0x6F, 0x10, 0x47, 0x00, 0x45, 0x17,
+    0x69, 0x4D, 0x0E, 0xCC, 0xD9, 0x49, 0x8B, 0x3F,  0xAB, 0x6A, 0x0C, 0xA8, 0xBA, 0x69, 0x0E, 0x49,
+    0x49, 0xEA, 0x90, 0x5E, 0xD3, 0xC4, 0xD0, 0x98,  0x53, 0x81, 0x0A, 0xD1, 0xCC, 0x67, 0xB0, 0x3A,
+    0xDA, 0x08, 0x6A, 0x53, 0xF8, 0xD4, 0xF0, 0x8C,  0xAE, 0xC3, 0x35, 0x32, 0x18, 0x05, 0x4E, 0xB3,
+    0x0E, 0xAD, 0x4C, 0x19, 0xC8, 0xDA, 0xEB, 0x02,  0x9C, 0xBF, 0xD3, 0xC6, 0xBF, 0xC1, 0xD0, 0x67,
+    0xB2, 0xDB, 0xC4, 0x03, 0xBB, 0x2A, 0xFE, 0xE4,  0xA0, 0xED, 0x28, 0x88, 0x28, 0x08, 0x43, 0x76,
+    0x11, 0xAE, 0xBB, 0x24, 0x53, 0x2D, 0x81, 0x81,  0x4F, 0x24, 0xFC, 0x09, 0x90, 0xC1, 0xCA, 0x0C,
+    0xE9, 0x52, 0x40, 0x76, 0x1C, 0xD5, 0x27, 0x9A,  0x06, 0x69, 0xAE, 0x7E, 0xDA, 0x7D, 0xC7, 0x18,
+    0x4A, 0xCA, 0x74, 0x47, 0x82, 0x3B, 0x40, 0xC9,  0x8B, 0xE3, 0xDC, 0xEC, 0x93, 0x4C, 0x24, 0x0A,
+    0x94, 0x57, 0xD5, 0x13, 0x19, 0xB2, 0xC3, 0xEE,  0xFF, 0xE1, 0xFB, 0x27, 0x0A, 0x9C, 0x84, 0x8F,
+    0x9B, 0x1B, 0x10, 0x3B, 0xDA, 0x33, 0xAB, 0x2F,  0xE4, 0x0B, 0x1C, 0x2A, 0x63, 0x18, 0xD2, 0xD7,
+    0x78, 0x03, 0x9F, 0xDC, 0x08, 0xCE, 0x7C, 0xD3,  0x31, 0x4A, 0xA1, 0xE9, 0x01, 0x35, 0x75, 0xAF,
+    0xB2, 0x4F, 0x17, 0x90, 0x2F, 0x77, 0xE5, 0xF4,  0x47, 0x00, 0x45, 0x18, 0x17, 0x65, 0x97, 0x7C,
+    0xBE, 0xBA, 0x6D, 0xB2, 0xF8, 0x2F, 0x25, 0xFF,  0x54, 0x52, 0x7A, 0xDB, 0x91, 0x20, 0x09, 0xB6,
+    0xEA, 0x61, 0xB0, 0x93, 0x2B, 0xF6, 0x85, 0xA9,  0xF8, 0x16, 0xA6, 0x9A, 0x49, 0x20, 0x94, 0x04,
+    0xB6, 0x37, 0x82, 0x46, 0x25, 0x25, 0x47, 0xD7,  0xC2, 0xA1, 0xAA, 0x4F, 0xA2, 0x97, 0xE7, 0x46,
+
+    0xDD, 0x61, 0x45, 0x95, 0x4F, 0x7F, 0x64, 0x24,  0x82, 0x9C, 0xBC, 0x43, 0x92, 0xFD, 0x0C, 0xDF,
+    0xF4, 0x27, 0xBB, 0x6E, 0x8B, 0xC3, 0x4C, 0x62,  0xA2, 0xEC, 0x93, 0x5E, 0xD1, 0x40, 0x3D, 0xDF,
+    0xC9, 0xB6, 0x47, 0x03, 0xC7, 0x01, 0x04, 0xF7,  0xA3, 0x56, 0xA5, 0x55, 0x0E, 0x63, 0xD6, 0x07,
+    0xAA, 0x63, 0x51, 0xDD, 0x75, 0xEE, 0x34, 0x55,  0xEA, 0x8A, 0x80, 0xDD, 0xC0, 0x6D, 0xD0, 0x57,
+    0x79, 0xE0, 0x57, 0x55, 0xA9, 0xB9, 0xCB, 0x1B,  0x34, 0xB9, 0x1D, 0xB7, 0x68, 0x8B, 0x53, 0xF3,
+    0x95, 0xFC, 0x24, 0xC0, 0x8A, 0x40, 0xAC, 0xA9,  0x46, 0x3C, 0x6A, 0xB1, 0x5A, 0xED, 0x1B, 0xE0,
+    0xB5, 0xDD, 0x3C, 0xDD, 0x3B, 0xDA, 0xB4, 0x10,  0xAD, 0xE2, 0xED, 0xBD, 0xEC, 0xA7, 0xC3, 0x9A,
+    0x48, 0x4B, 0xAF, 0x2B, 0x61, 0xBB, 0x39, 0x78,  0xB9, 0xDD, 0x1E, 0xE9, 0xC8, 0x0D, 0xB1, 0x43,
+    0xA9, 0x5D, 0x4B, 0xB6, 0x47, 0x00, 0x45, 0x19,  0x29, 0x5E, 0xFE, 0xAB, 0x76, 0xF6, 0xF3, 0x6A,
+    0xC2, 0x94, 0xB4, 0xAD, 0xFA, 0xE5, 0xE7, 0x01,  0x7A, 0xE3, 0x67, 0x48, 0x44, 0x7F, 0x22, 0x91,
+    0x66, 0xFF, 0x55, 0x33, 0xB0, 0x86, 0xD6, 0xAA,  0xFF, 0x4D, 0xAF, 0x06, 0x08, 0x00, 0x00, 0xDD,
+    0xF4, 0xB2, 0x3E, 0x7B, 0x32, 0x57, 0x14, 0xA1,  0xF9, 0xEB, 0xCF, 0x8B, 0x13, 0x66, 0x1A, 0xDB,
+    0x86, 0x37, 0xA5, 0x5C, 0x5E, 0x28, 0x92, 0xA3,  0xE6, 0xD7, 0x90, 0x0F, 0x1F, 0x03, 0x1E, 0x1F,
+    0xC1, 0xBC, 0xAE, 0x41, 0x03, 0x11, 0x64, 0xAA,  0x5D, 0x46, 0x5C, 0xA5, 0x06, 0xF8, 0xD4, 0xE0,
+    0x26, 0x76, 0xC7, 0xD7, 0xD5, 0x92, 0x0F, 0x77,  0x5B, 0x2C, 0xCC, 0xCD, 0xCD, 0xD0, 0xE0, 0x58,
+    0xCE, 0x98, 0x33, 0x79, 0x46, 0xD6, 0x72, 0x4C,  0xB7, 0x1C, 0xBE, 0x8C, 0x84, 0x27, 0x43, 0x79,
+
+    0xA6, 0x10, 0x03, 0x09, 0xC9, 0xD6, 0x90, 0x44,  0x5B, 0x5E, 0xEB, 0x67, 0xA2, 0xD0, 0xB7, 0x61,
+    0x8B, 0x9E, 0x2A, 0x51, 0xE9, 0xA2, 0x7C, 0x58,  0x26, 0x35, 0x27, 0x52, 0x05, 0xAF, 0x73, 0xD4,
+    0xE1, 0xA0, 0x17, 0xE5, 0x70, 0x28, 0x2F, 0x59,  0x41, 0xFB, 0xA2, 0x51, 0xE0, 0x79, 0x5A, 0xEC,
+    0x4B, 0xDF, 0xEE, 0x97, 0x57, 0x08, 0xA8, 0x2B,  0xA9, 0xF2, 0x00, 0xA3, 0x28, 0xDC, 0x07, 0xE3,
+    0x47, 0x00, 0x45, 0x3A, 0x22, 0x00, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xB1,  0x20, 0xD6, 0x84, 0x21, 0x82, 0x03, 0xDE, 0x6D,
+    0x86, 0xF3, 0xAC, 0x4C, 0x10, 0x5C, 0x6F, 0x85,  0x49, 0x41, 0x9F, 0xCD, 0x1A, 0x4C, 0x9F, 0x7F,
+    0xD7, 0xE6, 0x33, 0x89, 0xED, 0xFC, 0x90, 0x77,  0x5F, 0xDA, 0xBA, 0xE8, 0x05, 0x96, 0x6C, 0x03,
+    0xD9, 0xBF, 0xD5, 0x3C, 0xCA, 0x9A, 0x6F, 0x05,  0xFA, 0x0D, 0x27, 0x6B, 0xA6, 0x7E, 0xCD, 0x8D,
+    0xB7, 0x37, 0x0A, 0x6D, 0x0C, 0x88, 0x2E, 0x41,  0xD3, 0x9A, 0xAF, 0xD8, 0x76, 0x67, 0x8D, 0x6F,
+    0xB4, 0x25, 0xB6, 0xA8, 0xAC, 0x43, 0x52, 0x09,  0xBE, 0xBE, 0xA5, 0x1F, 0x55, 0x8B, 0xF9, 0x32,
+    0xA0, 0xC7, 0x43, 0x55, 0x0D, 0x84, 0x6F, 0xF4,  0xD9, 0x6E, 0xC4, 0xE2, 0xFE, 0xA3, 0x49, 0x13,
+    0x70, 0xC8, 0xD4, 0x5B, 0xAE, 0x8A, 0xA8, 0xD1,  0xBA, 0x9B, 0x3D, 0xDA, 0x05, 0x1B, 0xA0, 0xFC,
+    0x25, 0x1D, 0xEB, 0xD8, 0x14, 0x74, 0xD6, 0x2A,  0xA9, 0x99, 0x47, 0x59, 0x7D, 0xFC, 0x26, 0xF6,
+    0x96, 0xD0, 0x71, 0x7D, 0x2D, 0x0B, 0x55, 0xDE,  0x51, 0x1C, 0xA7, 0x80, 0x47, 0x40, 0x00, 0x3A,
+
+    0xA6, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,  0x00, 0xB0, 0x0D, 0xEA, 0xD4, 0xF9, 0x00, 0x00,
+    0x00, 0x01, 0xE0, 0x42, 0xFC, 0x60, 0x82, 0x3A,  0x47, 0x40, 0x42, 0x3A, 0x90, 0x00, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x02, 0xB0,
+    0x23, 0x00, 0x01, 0xF3, 0x00, 0x00, 0xE0, 0x45,  0xF0, 0x00, 0x03, 0xE0, 0x44, 0xF0, 0x06, 0x0A,
+    0x04, 0x65, 0x6E, 0x67, 0x00, 0x1B, 0xE0, 0x45,  0xF0, 0x06, 0x0A, 0x04, 0x65, 0x6E, 0x67, 0x00,
+    0xDA, 0xA4, 0x80, 0x10, 0x47, 0x40, 0x45, 0x1B,  0x00, 0x00, 0x01, 0xE0, 0x08, 0x38, 0x80, 0xC0,
+    0x0A, 0x33, 0x98, 0xB7, 0xEF, 0x71, 0x13, 0x98,  0xB7, 0xB7, 0x31, 0x00, 0x00, 0x00, 0x01, 0x09,
+    0xE0, 0x00, 0x00, 0x00, 0x01, 0x41, 0x9F, 0x06,  0x42, 0x12, 0xFF, 0xF7, 0xA1, 0x2F, 0x45, 0xC1,
+    0xBC, 0x6F, 0xCE, 0x62, 0x3F, 0xBD, 0xF6, 0x2E,  0x98, 0x69, 0x52, 0x4A, 0xA6, 0xDF, 0xEA, 0xC5,
+    0x70, 0x3F, 0xF8, 0x94, 0x01, 0xF7, 0x07, 0x0F,  0x6C, 0xC5, 0x4B, 0x16, 0x7A, 0xA8, 0xEE, 0xF4,
+    0x4B, 0x16, 0x8B, 0x66, 0x1B, 0x90, 0xBB, 0xFA,  0xCF, 0x5D, 0xBD, 0x63, 0x30, 0x58, 0x12, 0x62,
+    0x2E, 0xA4, 0xA6, 0xBB, 0xC2, 0xB0, 0xFF, 0xFD,  0xE3, 0xB2, 0xA9, 0x8E, 0xC1, 0xE3, 0x49, 0x40,
+    0x66, 0x06, 0xDB, 0xCE, 0x77, 0xD0, 0x32, 0xAE,  0xC3, 0x61, 0x13, 0xF1, 0x6E, 0x8B, 0xC8, 0x4A,
+    0xE0, 0x64, 0x82, 0x7A, 0x91, 0xEC, 0xC4, 0x0C,  0xAD, 0xFD, 0x3F, 0xB6, 0x86, 0x8F, 0xC7, 0x5A,
+
+    0xF5, 0xEE, 0x3D, 0x0D, 0x89, 0x24, 0x83, 0x8B,  0x65, 0xC6, 0x5B, 0x09, 0xAA, 0xE4, 0x2E, 0x52,
+    0xE7, 0x91, 0x31, 0x1F, 0x53, 0x2D, 0x59, 0x33,  0x9A, 0x6D, 0xD4, 0x2C, 0xE1, 0xE8, 0x62, 0x6B,
+    0x08, 0x37, 0x91, 0xA4, 0xAA, 0x17, 0xF0, 0x99,  0x44, 0x3F, 0x71, 0x25, 0x3C, 0x6E, 0xDF, 0x67
+};
 
 class TestIPTVRecorder: public QObject
 {
@@ -252,98 +345,6 @@ class TestIPTVRecorder: public QObject
      */
     static void ParseRTP(void)
     {
-        /* #11852 - RTP packet from VLC - minimal RTP header and 7 TS packets */
-        unsigned char packet_data0[1328] = {
-            0x80, 0xA1, 0xB0, 0x16, 0x66, 0x2D, 0x90, 0x6E,  0x32, 0x4C, 0x6F, 0x10, 0x47, 0x00, 0x45, 0x17,
-            0x69, 0x4D, 0x0E, 0xCC, 0xD9, 0x49, 0x8B, 0x3F,  0xAB, 0x6A, 0x0C, 0xA8, 0xBA, 0x69, 0x0E, 0x49,
-            0x49, 0xEA, 0x90, 0x5E, 0xD3, 0xC4, 0xD0, 0x98,  0x53, 0x81, 0x0A, 0xD1, 0xCC, 0x67, 0xB0, 0x3A,
-            0xDA, 0x08, 0x6A, 0x53, 0xF8, 0xD4, 0xF0, 0x8C,  0xAE, 0xC3, 0x35, 0x32, 0x18, 0x05, 0x4E, 0xB3,
-            0x0E, 0xAD, 0x4C, 0x19, 0xC8, 0xDA, 0xEB, 0x02,  0x9C, 0xBF, 0xD3, 0xC6, 0xBF, 0xC1, 0xD0, 0x67,
-            0xB2, 0xDB, 0xC4, 0x03, 0xBB, 0x2A, 0xFE, 0xE4,  0xA0, 0xED, 0x28, 0x88, 0x28, 0x08, 0x43, 0x76,
-            0x11, 0xAE, 0xBB, 0x24, 0x53, 0x2D, 0x81, 0x81,  0x4F, 0x24, 0xFC, 0x09, 0x90, 0xC1, 0xCA, 0x0C,
-            0xE9, 0x52, 0x40, 0x76, 0x1C, 0xD5, 0x27, 0x9A,  0x06, 0x69, 0xAE, 0x7E, 0xDA, 0x7D, 0xC7, 0x18,
-            0x4A, 0xCA, 0x74, 0x47, 0x82, 0x3B, 0x40, 0xC9,  0x8B, 0xE3, 0xDC, 0xEC, 0x93, 0x4C, 0x24, 0x0A,
-            0x94, 0x57, 0xD5, 0x13, 0x19, 0xB2, 0xC3, 0xEE,  0xFF, 0xE1, 0xFB, 0x27, 0x0A, 0x9C, 0x84, 0x8F,
-            0x9B, 0x1B, 0x10, 0x3B, 0xDA, 0x33, 0xAB, 0x2F,  0xE4, 0x0B, 0x1C, 0x2A, 0x63, 0x18, 0xD2, 0xD7,
-            0x78, 0x03, 0x9F, 0xDC, 0x08, 0xCE, 0x7C, 0xD3,  0x31, 0x4A, 0xA1, 0xE9, 0x01, 0x35, 0x75, 0xAF,
-            0xB2, 0x4F, 0x17, 0x90, 0x2F, 0x77, 0xE5, 0xF4,  0x47, 0x00, 0x45, 0x18, 0x17, 0x65, 0x97, 0x7C,
-            0xBE, 0xBA, 0x6D, 0xB2, 0xF8, 0x2F, 0x25, 0xFF,  0x54, 0x52, 0x7A, 0xDB, 0x91, 0x20, 0x09, 0xB6,
-            0xEA, 0x61, 0xB0, 0x93, 0x2B, 0xF6, 0x85, 0xA9,  0xF8, 0x16, 0xA6, 0x9A, 0x49, 0x20, 0x94, 0x04,
-            0xB6, 0x37, 0x82, 0x46, 0x25, 0x25, 0x47, 0xD7,  0xC2, 0xA1, 0xAA, 0x4F, 0xA2, 0x97, 0xE7, 0x46,
-
-            0xDD, 0x61, 0x45, 0x95, 0x4F, 0x7F, 0x64, 0x24,  0x82, 0x9C, 0xBC, 0x43, 0x92, 0xFD, 0x0C, 0xDF,
-            0xF4, 0x27, 0xBB, 0x6E, 0x8B, 0xC3, 0x4C, 0x62,  0xA2, 0xEC, 0x93, 0x5E, 0xD1, 0x40, 0x3D, 0xDF,
-            0xC9, 0xB6, 0x47, 0x03, 0xC7, 0x01, 0x04, 0xF7,  0xA3, 0x56, 0xA5, 0x55, 0x0E, 0x63, 0xD6, 0x07,
-            0xAA, 0x63, 0x51, 0xDD, 0x75, 0xEE, 0x34, 0x55,  0xEA, 0x8A, 0x80, 0xDD, 0xC0, 0x6D, 0xD0, 0x57,
-            0x79, 0xE0, 0x57, 0x55, 0xA9, 0xB9, 0xCB, 0x1B,  0x34, 0xB9, 0x1D, 0xB7, 0x68, 0x8B, 0x53, 0xF3,
-            0x95, 0xFC, 0x24, 0xC0, 0x8A, 0x40, 0xAC, 0xA9,  0x46, 0x3C, 0x6A, 0xB1, 0x5A, 0xED, 0x1B, 0xE0,
-            0xB5, 0xDD, 0x3C, 0xDD, 0x3B, 0xDA, 0xB4, 0x10,  0xAD, 0xE2, 0xED, 0xBD, 0xEC, 0xA7, 0xC3, 0x9A,
-            0x48, 0x4B, 0xAF, 0x2B, 0x61, 0xBB, 0x39, 0x78,  0xB9, 0xDD, 0x1E, 0xE9, 0xC8, 0x0D, 0xB1, 0x43,
-            0xA9, 0x5D, 0x4B, 0xB6, 0x47, 0x00, 0x45, 0x19,  0x29, 0x5E, 0xFE, 0xAB, 0x76, 0xF6, 0xF3, 0x6A,
-            0xC2, 0x94, 0xB4, 0xAD, 0xFA, 0xE5, 0xE7, 0x01,  0x7A, 0xE3, 0x67, 0x48, 0x44, 0x7F, 0x22, 0x91,
-            0x66, 0xFF, 0x55, 0x33, 0xB0, 0x86, 0xD6, 0xAA,  0xFF, 0x4D, 0xAF, 0x06, 0x08, 0x00, 0x00, 0xDD,
-            0xF4, 0xB2, 0x3E, 0x7B, 0x32, 0x57, 0x14, 0xA1,  0xF9, 0xEB, 0xCF, 0x8B, 0x13, 0x66, 0x1A, 0xDB,
-            0x86, 0x37, 0xA5, 0x5C, 0x5E, 0x28, 0x92, 0xA3,  0xE6, 0xD7, 0x90, 0x0F, 0x1F, 0x03, 0x1E, 0x1F,
-            0xC1, 0xBC, 0xAE, 0x41, 0x03, 0x11, 0x64, 0xAA,  0x5D, 0x46, 0x5C, 0xA5, 0x06, 0xF8, 0xD4, 0xE0,
-            0x26, 0x76, 0xC7, 0xD7, 0xD5, 0x92, 0x0F, 0x77,  0x5B, 0x2C, 0xCC, 0xCD, 0xCD, 0xD0, 0xE0, 0x58,
-            0xCE, 0x98, 0x33, 0x79, 0x46, 0xD6, 0x72, 0x4C,  0xB7, 0x1C, 0xBE, 0x8C, 0x84, 0x27, 0x43, 0x79,
-
-            0xA6, 0x10, 0x03, 0x09, 0xC9, 0xD6, 0x90, 0x44,  0x5B, 0x5E, 0xEB, 0x67, 0xA2, 0xD0, 0xB7, 0x61,
-            0x8B, 0x9E, 0x2A, 0x51, 0xE9, 0xA2, 0x7C, 0x58,  0x26, 0x35, 0x27, 0x52, 0x05, 0xAF, 0x73, 0xD4,
-            0xE1, 0xA0, 0x17, 0xE5, 0x70, 0x28, 0x2F, 0x59,  0x41, 0xFB, 0xA2, 0x51, 0xE0, 0x79, 0x5A, 0xEC,
-            0x4B, 0xDF, 0xEE, 0x97, 0x57, 0x08, 0xA8, 0x2B,  0xA9, 0xF2, 0x00, 0xA3, 0x28, 0xDC, 0x07, 0xE3,
-            0x47, 0x00, 0x45, 0x3A, 0x22, 0x00, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xB1,  0x20, 0xD6, 0x84, 0x21, 0x82, 0x03, 0xDE, 0x6D,
-            0x86, 0xF3, 0xAC, 0x4C, 0x10, 0x5C, 0x6F, 0x85,  0x49, 0x41, 0x9F, 0xCD, 0x1A, 0x4C, 0x9F, 0x7F,
-            0xD7, 0xE6, 0x33, 0x89, 0xED, 0xFC, 0x90, 0x77,  0x5F, 0xDA, 0xBA, 0xE8, 0x05, 0x96, 0x6C, 0x03,
-            0xD9, 0xBF, 0xD5, 0x3C, 0xCA, 0x9A, 0x6F, 0x05,  0xFA, 0x0D, 0x27, 0x6B, 0xA6, 0x7E, 0xCD, 0x8D,
-            0xB7, 0x37, 0x0A, 0x6D, 0x0C, 0x88, 0x2E, 0x41,  0xD3, 0x9A, 0xAF, 0xD8, 0x76, 0x67, 0x8D, 0x6F,
-            0xB4, 0x25, 0xB6, 0xA8, 0xAC, 0x43, 0x52, 0x09,  0xBE, 0xBE, 0xA5, 0x1F, 0x55, 0x8B, 0xF9, 0x32,
-            0xA0, 0xC7, 0x43, 0x55, 0x0D, 0x84, 0x6F, 0xF4,  0xD9, 0x6E, 0xC4, 0xE2, 0xFE, 0xA3, 0x49, 0x13,
-            0x70, 0xC8, 0xD4, 0x5B, 0xAE, 0x8A, 0xA8, 0xD1,  0xBA, 0x9B, 0x3D, 0xDA, 0x05, 0x1B, 0xA0, 0xFC,
-            0x25, 0x1D, 0xEB, 0xD8, 0x14, 0x74, 0xD6, 0x2A,  0xA9, 0x99, 0x47, 0x59, 0x7D, 0xFC, 0x26, 0xF6,
-            0x96, 0xD0, 0x71, 0x7D, 0x2D, 0x0B, 0x55, 0xDE,  0x51, 0x1C, 0xA7, 0x80, 0x47, 0x40, 0x00, 0x3A,
-
-            0xA6, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00,  0x00, 0xB0, 0x0D, 0xEA, 0xD4, 0xF9, 0x00, 0x00,
-            0x00, 0x01, 0xE0, 0x42, 0xFC, 0x60, 0x82, 0x3A,  0x47, 0x40, 0x42, 0x3A, 0x90, 0x00, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
-            0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x02, 0xB0,
-            0x23, 0x00, 0x01, 0xF3, 0x00, 0x00, 0xE0, 0x45,  0xF0, 0x00, 0x03, 0xE0, 0x44, 0xF0, 0x06, 0x0A,
-            0x04, 0x65, 0x6E, 0x67, 0x00, 0x1B, 0xE0, 0x45,  0xF0, 0x06, 0x0A, 0x04, 0x65, 0x6E, 0x67, 0x00,
-            0xDA, 0xA4, 0x80, 0x10, 0x47, 0x40, 0x45, 0x1B,  0x00, 0x00, 0x01, 0xE0, 0x08, 0x38, 0x80, 0xC0,
-            0x0A, 0x33, 0x98, 0xB7, 0xEF, 0x71, 0x13, 0x98,  0xB7, 0xB7, 0x31, 0x00, 0x00, 0x00, 0x01, 0x09,
-            0xE0, 0x00, 0x00, 0x00, 0x01, 0x41, 0x9F, 0x06,  0x42, 0x12, 0xFF, 0xF7, 0xA1, 0x2F, 0x45, 0xC1,
-            0xBC, 0x6F, 0xCE, 0x62, 0x3F, 0xBD, 0xF6, 0x2E,  0x98, 0x69, 0x52, 0x4A, 0xA6, 0xDF, 0xEA, 0xC5,
-            0x70, 0x3F, 0xF8, 0x94, 0x01, 0xF7, 0x07, 0x0F,  0x6C, 0xC5, 0x4B, 0x16, 0x7A, 0xA8, 0xEE, 0xF4,
-            0x4B, 0x16, 0x8B, 0x66, 0x1B, 0x90, 0xBB, 0xFA,  0xCF, 0x5D, 0xBD, 0x63, 0x30, 0x58, 0x12, 0x62,
-            0x2E, 0xA4, 0xA6, 0xBB, 0xC2, 0xB0, 0xFF, 0xFD,  0xE3, 0xB2, 0xA9, 0x8E, 0xC1, 0xE3, 0x49, 0x40,
-            0x66, 0x06, 0xDB, 0xCE, 0x77, 0xD0, 0x32, 0xAE,  0xC3, 0x61, 0x13, 0xF1, 0x6E, 0x8B, 0xC8, 0x4A,
-            0xE0, 0x64, 0x82, 0x7A, 0x91, 0xEC, 0xC4, 0x0C,  0xAD, 0xFD, 0x3F, 0xB6, 0x86, 0x8F, 0xC7, 0x5A,
-
-            0xF5, 0xEE, 0x3D, 0x0D, 0x89, 0x24, 0x83, 0x8B,  0x65, 0xC6, 0x5B, 0x09, 0xAA, 0xE4, 0x2E, 0x52,
-            0xE7, 0x91, 0x31, 0x1F, 0x53, 0x2D, 0x59, 0x33,  0x9A, 0x6D, 0xD4, 0x2C, 0xE1, 0xE8, 0x62, 0x6B,
-            0x08, 0x37, 0x91, 0xA4, 0xAA, 0x17, 0xF0, 0x99,  0x44, 0x3F, 0x71, 0x25, 0x3C, 0x6E, 0xDF, 0x67
-        };
-
         /* #11852 - RTP packet from A1 TV - small with RTP header extensions */
         unsigned char packet_data1[216] = {
             0x90, 0x21, 0x70, 0x40, 0x5B, 0xBA, 0x12, 0x0E,  0x00, 0x00, 0x00, 0x01, 0xBE, 0xDE, 0x00, 0x03,
@@ -459,7 +460,7 @@ class TestIPTVRecorder: public QObject
 
         /* regression test of working packet */
         RTPDataPacket packet0;
-        packet0.GetDataReference().append((char*)packet_data0, sizeof(packet_data0));
+        packet0.GetDataReference().append((const char*)packet_data0, sizeof(packet_data0));
         QVERIFY (packet0.IsValid());
         RTPTSDataPacket ts_packet0(packet0);
         QCOMPARE (ts_packet0.GetTSData()[0], (uint8_t)0x47);
@@ -486,4 +487,170 @@ class TestIPTVRecorder: public QObject
         QCOMPARE (ts_packet2.GetTSData()[0], (uint8_t)0x47);
         QCOMPARE (ts_packet2.GetTSDataSize(), (unsigned int)7 * 188);
     }
+
+    /**
+     * Replay the VLC packet as a stream with SMPTE 2022-1 FEC, drop some
+     * packets and check they are rebuilt.
+     */
+    static void FECRecovery_data(void)
+    {
+        QTest::addColumn<QList<int> >("drops");
+        QTest::addColumn<int>("lost");
+
+        // Packet n is in row n / L and column n % L of its matrix
+        QTest::newRow("none")   << QList<int>() << 0;
+        QTest::newRow("single") << (QList<int>() << 23) << 0;
+        QTest::newRow("one per row")
+            << (QList<int>() << 40 << 46 << 52 << 58) << 0;
+        // A burst as long as a row is repaired by the column FEC
+        QTest::newRow("burst")  << (QList<int>() << 60 << 61 << 62 << 63 << 64) << 0;
+        // Two in a row and two in a column, each fixed after another
+        QTest::newRow("row and column")
+            << (QList<int>() << 80 << 81 << 85) << 0;
+        // Two in each of two rows and two columns is beyond XOR FEC
+        QTest::newRow("square") << (QList<int>() << 100 << 101 << 105 << 106) << 4;
+        // Across the 16 bit sequence number wrap
+        QTest::newRow("wrap")   << (QList<int>() << 139 << 140) << 0;
+    }
+
+    static void FECRecovery(void)
+    {
+        QFETCH(QList<int>, drops);
+        QFETCH(int, lost);
+
+        // Sequence numbers wrap during the stream
+        const uint kFirst   = 65536 - 140;
+        const uint kColumns = 5;
+        const uint kRows    = 4;
+        const uint kMatrix  = kColumns * kRows;
+        const uint kPackets = 20 * kMatrix;
+
+        QVector<QByteArray> media;
+        for (uint i = 0; i < kPackets; i++)
+            media << MakeMediaPacket((kFirst + i) & 0xFFFF, i);
+
+        RTPPacketBuffer buffer(0);
+        QList<QByteArray> columns;
+        for (uint i = 0; i < kPackets; i++)
+        {
+            if (!drops.contains(static_cast<int>(i)))
+                Push(buffer, media[i]);
+
+            if (i % kColumns == kColumns - 1)
+                Push(buffer, MakeFECPacket(media, i + 1 - kColumns, 1, kColumns), 1);
+
+            // Column FEC is sent during the following matrix
+            if (i % kMatrix == kColumns - 1 && !columns.isEmpty())
+            {
+                foreach (const QByteArray &column, columns)
+                    Push(buffer, column, 0);
+                columns.clear();
+            }
+            if (i % kMatrix == kMatrix - 1 && i + kMatrix < kPackets)
+            {
+                for (uint c = 0; c < kColumns; c++)
+                {
+                    columns << MakeFECPacket(media, i + 1 - kMatrix + c,
+                                             kColumns, kRows);
+                }
+            }
+        }
+
+        QVERIFY(buffer.HasFEC());
+        QCOMPARE(buffer.GetRecoveredCount(), static_cast<uint64_t>(drops.size() - lost));
+        QCOMPARE(buffer.GetLostCount(), static_cast<uint64_t>(lost));
+
+        // Everything not lost comes out in order and as it was sent
+        int received = 0;
+        uint last = 0;
+        while (buffer.HasAvailablePacket())
+        {
+            RTPDataPacket packet(buffer.PopDataPacket());
+            QVERIFY(packet.IsValid());
+            uint index = (packet.GetSequenceNumber() - kFirst) & 0xFFFF;
+            QVERIFY(received == 0 || index > last);
+            QVERIFY(packet.GetData() == media[index]);
+            last = index;
+            received++;
+            buffer.FreePacket(packet);
+        }
+        // Nothing is held back once every gap is filled or given up on
+        QCOMPARE(received, static_cast<int>(kPackets) - lost);
+    }
+
+  private:
+    static QByteArray MakeMediaPacket(uint seq, uint index)
+    {
+        QByteArray data(reinterpret_cast<const char*>(packet_data0),
+                        sizeof(packet_data0));
+        data[2] = static_cast<char>(seq >> 8);
+        data[3] = static_cast<char>(seq & 0xFF);
+        data[7] = static_cast<char>(index);
+        // Make every payload different but keep the TS sync bytes
+        for (int i = 13; i < data.size(); i++)
+        {
+            if ((i - 12) % 188)
+                data[i] = static_cast<char>(data[i] ^ (index * 7 + i));
+        }
+        return data;
+    }
+
+    /// XOR FEC over count packets offset apart, starting with media[first]
+    static QByteArray MakeFECPacket(const QVector<QByteArray> &media,
+                                    uint first, uint offset, uint count)
+    {
+        int size = 0;
+        for (uint j = 0; j < count; j++)
+            size = qMax(size, media[first + j * offset].size() - 12);
+
+        QByteArray fec(12 + 16 + size, 0);
+        fec[0] = static_cast<char>(0x80);
+        fec[1] = 96;
+        uint length = 0;
+        uint type = 0;
+        uint timestamp = 0;
+        for (uint j = 0; j < count; j++)
+        {
+            RTPDataPacket packet;
+            packet.GetDataReference() = media[first + j * offset];
+            const QByteArray &data = packet.GetDataReference();
+            // The header bits and marker are recovered from the FEC's own
+            fec[0]     = static_cast<char>(fec[0] ^ (data[0] & 0x3F));
+            fec[1]     = static_cast<char>(fec[1] ^ (data[1] & 0x80));
+            length    ^= data.size() - 12;
+            type      ^= packet.GetPayloadType();
+            timestamp ^= packet.GetTimeStamp();
+            for (int k = 12; k < data.size(); k++)
+                fec[16 + k] = static_cast<char>(fec[16 + k] ^ data[k]);
+        }
+
+        RTPDataPacket base;
+        base.GetDataReference() = media[first];
+        uint seq = base.GetSequenceNumber();
+        fec[12] = static_cast<char>(seq >> 8);
+        fec[13] = static_cast<char>(seq & 0xFF);
+        fec[14] = static_cast<char>(length >> 8);
+        fec[15] = static_cast<char>(length & 0xFF);
+        fec[16] = static_cast<char>(0x80 | type);
+        fec[20] = static_cast<char>(timestamp >> 24);
+        fec[21] = static_cast<char>(timestamp >> 16);
+        fec[22] = static_cast<char>(timestamp >> 8);
+        fec[23] = static_cast<char>(timestamp);
+        fec[24] = static_cast<char>(offset == 1 ? 0x40 : 0x00);
+        fec[25] = static_cast<char>(offset);
+        fec[26] = static_cast<char>(count);
+        return fec;
+    }
+
+    /// Pushes a media packet, or an FEC packet if fec_stream is set
+    static void Push(RTPPacketBuffer &buffer, const QByteArray &data,
+                     int fec_stream = -1)
+    {
+        UDPPacket packet(buffer.GetEmptyPacket());
+        packet.GetDataReference() = data;
+        if (fec_stream >= 0)
+            buffer.PushFECPacket(packet, fec_stream);
+        else
+            buffer.PushDataPacket(packet);
+    }
 };
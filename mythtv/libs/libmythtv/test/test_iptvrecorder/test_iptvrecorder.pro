@@ -9,6 +9,8 @@ INCLUDEPATH += . ../.. ../../mpeg ../../../libmythui ../../../libmyth ../../../l
 INCLUDEPATH += ../../../libmythservicecontracts
 
 LIBS += ../../$(OBJECTS_DIR)iptvchannelfetcher.o
+LIBS += ../../$(OBJECTS_DIR)packetbuffer.o
+LIBS += ../../$(OBJECTS_DIR)rtppacketbuffer.o
 LIBS += ../../$(OBJECTS_DIR)scanmonitor.o
 LIBS += ../../$(OBJECTS_DIR)moc_scanmonitor.o
 LIBS += -L../../../libmythbase -lmythbase-$$LIBVERSION
@@ -0,0 +1,259 @@
+/*
+ *  Class TestStreamHandler
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <memory>
+#include <vector>
+
+#include "mpegstreamdata.h"
+#include "streamhandler.h"
+#include "streamlisteners.h"
+#include "tspacket.h"
+#include "test_streamhandler.h"
+
+/// Services on the test multiplex, as with six recordings from one mux
+static const uint kServices = 6;
+
+/// Counts the packets it is handed on each PID
+class PacketCounter : public TSPacketListener
+{
+  public:
+    bool ProcessTSPacket(const TSPacket &tspacket) override
+    {
+        m_packets[tspacket.PID()]++;
+        return true;
+    }
+
+    QMap<uint,int> m_packets;
+};
+
+/// A StreamHandler fed from memory rather than a device
+class MemoryStreamHandler : public StreamHandler
+{
+  public:
+    MemoryStreamHandler() : StreamHandler("memory", 0) {}
+    ~MemoryStreamHandler() override
+    {
+        QMutexLocker locker(&m_listenerLock);
+        m_streamDataList.clear();
+    }
+
+    void Add(MPEGStreamData *data)
+    {
+        QMutexLocker locker(&m_listenerLock);
+        m_streamDataList[data] = QString();
+    }
+
+    int Process(const QByteArray &buffer)
+    {
+        QMutexLocker locker(&m_listenerLock);
+        return ProcessData(reinterpret_cast<const unsigned char*>(buffer.constData()),
+                           buffer.size());
+    }
+};
+
+/// One recording: writes the video and audio PIDs of one service
+struct Recording
+{
+    explicit Recording(uint service)
+      : m_data(new MPEGStreamData(static_cast<int>(service) + 1, 0, false))
+    {
+        m_data->AddWritingPID(0x100 + (service * 0x10));
+        m_data->AddWritingPID(0x101 + (service * 0x10));
+        m_data->AddWritingListener(&m_counter);
+    }
+
+    std::unique_ptr<MPEGStreamData> m_data;
+    PacketCounter                   m_counter;
+};
+
+static std::vector<std::unique_ptr<Recording> > Recordings(uint count)
+{
+    std::vector<std::unique_ptr<Recording> > recordings;
+    for (uint i = 0; i < count; i++)
+        recordings.emplace_back(new Recording(i));
+    return recordings;
+}
+
+static void AppendPacket(QByteArray &buffer, uint pid)
+{
+    std::unique_ptr<TSPacket> pkt(TSPacket::CreatePayloadOnlyPacket());
+    pkt->SetPID(pid);
+    buffer.append(reinterpret_cast<const char*>(pkt->data()),
+                  static_cast<int>(TSPacket::kSize));
+}
+
+void TestStreamHandler::initTestCase(void)
+{
+    // Mostly video, some audio, EIT and padding, about 1.3 MB
+    for (int i = 0; i < 1000; i++)
+    {
+        for (uint service = 0; service < kServices; service++)
+        {
+            AppendPacket(m_multiplex, 0x100 + (service * 0x10));
+            if (i % 8 == 0)
+                AppendPacket(m_multiplex, 0x101 + (service * 0x10));
+        }
+        if (i % 16 == 0)
+            AppendPacket(m_multiplex, 0x12);
+        if (i % 4 == 0)
+            AppendPacket(m_multiplex, 0x1FFF);
+    }
+}
+
+/// Each listener gets exactly the packets of its own PIDs
+void TestStreamHandler::RoutesByPID(void)
+{
+    MemoryStreamHandler handler;
+    auto recordings = Recordings(kServices);
+    for (auto & recording : recordings)
+        handler.Add(recording->m_data.get());
+
+    QCOMPARE(handler.Process(m_multiplex), 0);
+
+    for (uint service = 0; service < kServices; service++)
+    {
+        const QMap<uint,int> &packets = recordings[service]->m_counter.m_packets;
+        QCOMPARE(packets.size(), 2);
+        QCOMPARE(packets.value(0x100 + (service * 0x10)), 1000);
+        QCOMPARE(packets.value(0x101 + (service * 0x10)), 125);
+    }
+}
+
+/// A single listener still processes the data itself
+void TestStreamHandler::SingleListener(void)
+{
+    MemoryStreamHandler handler;
+    auto recordings = Recordings(1);
+    handler.Add(recordings[0]->m_data.get());
+
+    QCOMPARE(handler.Process(m_multiplex), 0);
+    QCOMPARE(recordings[0]->m_counter.m_packets.value(0x100), 1000);
+    QCOMPARE(recordings[0]->m_counter.m_packets.value(0x101), 125);
+}
+
+/// Out of sync data is skipped, and a partial packet left over, as in
+/// MPEGStreamData::ProcessData()
+void TestStreamHandler::Resync(void)
+{
+    QByteArray buffer("junk");
+    buffer.append(m_multiplex.left(static_cast<int>(TSPacket::kSize) * 100));
+    buffer.append(m_multiplex.mid(static_cast<int>(TSPacket::kSize) * 100, 50));
+
+    auto expected = Recordings(2);
+    int expectedLeft = 0;
+    for (auto & recording : expected)
+    {
+        expectedLeft = recording->m_data->ProcessData(
+            reinterpret_cast<const unsigned char*>(buffer.constData()), buffer.size());
+    }
+
+    MemoryStreamHandler handler;
+    auto recordings = Recordings(2);
+    for (auto & recording : recordings)
+        handler.Add(recording->m_data.get());
+
+    QCOMPARE(handler.Process(buffer), expectedLeft);
+    QCOMPARE(expectedLeft, 50);
+    for (size_t i = 0; i < recordings.size(); i++)
+        QCOMPARE(recordings[i]->m_counter.m_packets, expected[i]->m_counter.m_packets);
+}
+
+/// The PID version only changes when a PID is added or removed
+void TestStreamHandler::PIDVersion(void)
+{
+    MPEGStreamData data(1, 0, false);
+
+    uint version = data.GetPIDVersion();
+    data.AddListeningPID(0x12);
+    QVERIFY(data.GetPIDVersion() != version);
+
+    version = data.GetPIDVersion();
+    data.AddListeningPID(0x12, kPIDPriorityHigh);
+    data.RemoveWritingPID(0x100);
+    data.AddNotListeningPID(0x200);
+    QCOMPARE(data.GetPIDVersion(), version);
+
+    data.RemoveListeningPID(0x12);
+    QVERIFY(data.GetPIDVersion() != version);
+
+    version = data.GetPIDVersion();
+    data.AddAudioPID(0x101);
+    QVERIFY(data.GetPIDVersion() != version);
+}
+
+/// A listener's PID changes are routed from the next block on
+void TestStreamHandler::PIDChanges(void)
+{
+    MemoryStreamHandler handler;
+    auto recordings = Recordings(2);
+    for (auto & recording : recordings)
+        handler.Add(recording->m_data.get());
+
+    recordings[0]->m_data->RemoveWritingPID(0x101);
+    QCOMPARE(handler.Process(m_multiplex), 0);
+    QCOMPARE(recordings[0]->m_counter.m_packets.value(0x100), 1000);
+    QCOMPARE(recordings[0]->m_counter.m_packets.value(0x101), 0);
+
+    recordings[0]->m_data->AddWritingPID(0x101);
+    QCOMPARE(handler.Process(m_multiplex), 0);
+    QCOMPARE(recordings[0]->m_counter.m_packets.value(0x100), 2000);
+    QCOMPARE(recordings[0]->m_counter.m_packets.value(0x101), 125);
+    QCOMPARE(recordings[1]->m_counter.m_packets.value(0x111), 250);
+}
+
+/// The multiplex split by PID once, for six recordings
+void TestStreamHandler::Multiplex_routed(void)
+{
+    MemoryStreamHandler handler;
+    auto recordings = Recordings(kServices);
+    for (auto & recording : recordings)
+        handler.Add(recording->m_data.get());
+
+    QBENCHMARK {
+        handler.Process(m_multiplex);
+    }
+}
+
+/// As Multiplex_routed, with every recording also reading the EIT
+void TestStreamHandler::Multiplex_routedEIT(void)
+{
+    MemoryStreamHandler handler;
+    auto recordings = Recordings(kServices);
+    for (auto & recording : recordings)
+    {
+        recording->m_data->AddListeningPID(0x12);
+        handler.Add(recording->m_data.get());
+    }
+
+    QBENCHMARK {
+        handler.Process(m_multiplex);
+    }
+}
+
+/// What each of six recordings filtering the whole multiplex cost
+void TestStreamHandler::Multiplex_perListener(void)
+{
+    auto recordings = Recordings(kServices);
+    const auto *buffer = reinterpret_cast<const unsigned char*>(m_multiplex.constData());
+
+    QBENCHMARK {
+        for (auto & recording : recordings)
+            recording->m_data->ProcessData(buffer, m_multiplex.size());
+    }
+}
+
+QTEST_APPLESS_MAIN(TestStreamHandler)
@@ -0,0 +1,163 @@
+/*
+ *  Class TestUDPBatchReader
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+#include "udpbatchreader.h"
+#include "test_udpbatchreader.h"
+
+/// Seven TS packets, as most IPTV streams send them
+static const int kDatagramSize  = 7 * 188;
+static const int kBenchPackets  = 200000;
+static const int kIdleMs        = 500;
+
+static double ThreadCPUSeconds(void)
+{
+    struct timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// Multicast looped back through 127.0.0.1, so no network is needed
+void TestUDPBatchReader::initTestCase(void)
+{
+    m_receiver = socket(AF_INET, SOCK_DGRAM, 0);
+    m_sender   = socket(AF_INET, SOCK_DGRAM, 0);
+    QVERIFY(m_receiver >= 0 && m_sender >= 0);
+
+    m_group.sin_family      = AF_INET;
+    m_group.sin_addr.s_addr = inet_addr("239.255.42.1");
+    QCOMPARE(bind(m_receiver, reinterpret_cast<struct sockaddr*>(&m_group),
+                  sizeof(m_group)), 0);
+    socklen_t len = sizeof(m_group);
+    getsockname(m_receiver, reinterpret_cast<struct sockaddr*>(&m_group), &len);
+
+    struct ip_mreq mreq {};
+    mreq.imr_multiaddr        = m_group.sin_addr;
+    mreq.imr_interface.s_addr = htonl(INADDR_LOOPBACK);
+    if (setsockopt(m_receiver, IPPROTO_IP, IP_ADD_MEMBERSHIP,
+                   &mreq, sizeof(mreq)) < 0)
+        QSKIP("Cannot join a multicast group on the loopback interface");
+
+    struct in_addr iface {};
+    iface.s_addr = htonl(INADDR_LOOPBACK);
+    setsockopt(m_sender, IPPROTO_IP, IP_MULTICAST_IF, &iface, sizeof(iface));
+
+    int size = UDPBatchReader::SetReceiveBufferSize(m_receiver, 8 * 1024 * 1024);
+    qDebug() << "Receive buffer" << size << "bytes";
+}
+
+void TestUDPBatchReader::cleanupTestCase(void)
+{
+    close(m_receiver);
+    close(m_sender);
+}
+
+void TestUDPBatchReader::Send(int count, int size)
+{
+    std::vector<char> data(size);
+    for (int i = 0; i < count; i++)
+    {
+        data[0] = static_cast<char>(i);
+        sendto(m_sender, data.data(), data.size(), 0,
+               reinterpret_cast<struct sockaddr*>(&m_group), sizeof(m_group));
+    }
+}
+
+void TestUDPBatchReader::ReadsEveryDatagram(void)
+{
+    UDPBatchReader reader(m_receiver);
+    Send(100, kDatagramSize);
+
+    int total = 0;
+    int count = 0;
+    while ((count = reader.Read()) > 0)
+    {
+        for (int i = 0; i < count; i++)
+        {
+            QCOMPARE(reader.GetSize(i), static_cast<unsigned int>(kDatagramSize));
+            QCOMPARE(reader.GetData(i)[0], static_cast<unsigned char>(total + i));
+            QVERIFY(!reader.IsTruncated(i));
+#ifdef __linux__
+            QVERIFY(reader.GetKernelTime(i) > 0);
+#endif
+        }
+        total += count;
+    }
+    QCOMPARE(count, 0);
+    QCOMPARE(total, 100);
+}
+
+/** \brief Receive a burst on this thread while another thread sends it and
+ *         report datagrams per second of receiver CPU time.
+ */
+void TestUDPBatchReader::Measure(bool batched)
+{
+    UDPBatchReader reader(m_receiver);
+    std::vector<char> data(UDPBatchReader::kDefaultSlotSize);
+    struct pollfd fd {};
+    fd.fd     = m_receiver;
+    fd.events = POLLIN;
+
+    std::thread sender([this]() { Send(kBenchPackets, kDatagramSize); });
+
+    QElapsedTimer timer;
+    timer.start();
+    double cpu = ThreadCPUSeconds();
+    long received = 0;
+    while (poll(&fd, 1, kIdleMs) > 0)
+    {
+        if (batched)
+        {
+            int count = reader.Read();
+            if (count > 0)
+                received += count;
+        }
+        else
+        {
+            // One system call per datagram, as QUdpSocket makes
+            while (recv(m_receiver, data.data(), data.size(), MSG_DONTWAIT) > 0)
+                received++;
+        }
+    }
+    cpu = ThreadCPUSeconds() - cpu;
+    qint64 wall = timer.elapsed() - kIdleMs;
+    sender.join();
+
+    QVERIFY(received > 0);
+    qDebug() << (batched ? "Batched:" : "Single:") << received << "of"
+             << kBenchPackets << "datagrams in" << wall << "ms,"
+             << qRound64(received / cpu) << "datagrams/s per core";
+}
+
+void TestUDPBatchReader::Throughput_batched(void)
+{
+    Measure(true);
+}
+
+void TestUDPBatchReader::Throughput_single(void)
+{
+    Measure(false);
+}
+
+QTEST_APPLESS_MAIN(TestUDPBatchReader)
@@ -0,0 +1,41 @@
+/*
+ *  Class TestUDPBatchReader
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+
+#include <netinet/in.h>
+
+#include <QtTest/QtTest>
+
+class TestUDPBatchReader : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase(void);
+    void cleanupTestCase(void);
+    void ReadsEveryDatagram(void);
+    void Throughput_batched(void);
+    void Throughput_single(void);
+
+  private:
+    void Send(int count, int size);
+    void Measure(bool batched);
+
+    int                m_receiver  {-1};
+    int                m_sender    {-1};
+    struct sockaddr_in m_group     {};
+};
@@ -0,0 +1,311 @@
+// C++ headers
+#include <algorithm>
+#include <cstring>
+
+// Qt headers
+#include <QBuffer>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryFile>
+#include <QVector>
+#include <QtEndian>
+
+// MythTV headers
+#include "mythlogging.h"
+#include "mythmiscutil.h"
+#include "programinfo.h"
+#include "remotefile.h"
+#include "ringbuffer.h"
+#include "mythplayer.h"
+#include "playercontext.h"
+#include "mythavutil.h"
+#include "trickplayindex.h"
+
+#define LOC QString("Trickplay: ")
+
+const char TrickplayIndex::kMagic[8] = { 'M','Y','T','H','T','R','I','K' };
+
+/** \fn TrickplayIndex::Open(const QString&)
+ *  \brief Map an existing index file into memory.
+ *
+ *   A myth:// URL is read from its backend into memory instead.  The
+ *   header and entry table are validated against the file size, so a
+ *   truncated or foreign file is rejected rather than read past its end.
+ */
+bool TrickplayIndex::Open(const QString &filename)
+{
+    Close();
+
+    if (filename.startsWith("myth://"))
+    {
+        if (!RemoteFile::Exists(filename))
+            return false;
+        RemoteFile remote(filename, false, false);
+        if (!remote.SaveAs(m_buffer) || m_buffer.isEmpty())
+        {
+            Close();
+            return false;
+        }
+        m_data = reinterpret_cast<uchar*>(m_buffer.data());
+        m_size = m_buffer.size();
+    }
+    else
+    {
+        m_file.setFileName(filename);
+        if (!m_file.open(QIODevice::ReadOnly))
+            return false;
+
+        m_size = m_file.size();
+        if (m_size > 0)
+            m_data = m_file.map(0, m_size);
+        if (!m_data)
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC +
+                QString("Unable to map '%1'").arg(filename));
+            Close();
+            return false;
+        }
+    }
+
+    if (m_size < static_cast<qint64>(sizeof(TrickplayHeader)))
+    {
+        Close();
+        return false;
+    }
+
+    const auto *header = reinterpret_cast<const TrickplayHeader*>(m_data);
+    uint32_t count = qFromLittleEndian(header->m_count);
+    qint64 tableEnd = sizeof(TrickplayHeader) +
+        (static_cast<qint64>(count) * sizeof(TrickplayEntry));
+    if ((memcmp(header->m_magic, kMagic, sizeof(kMagic)) != 0) ||
+        (qFromLittleEndian(header->m_version) != kVersion) ||
+        (tableEnd > m_size))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("'%1' is not a valid trickplay index").arg(filename));
+        Close();
+        return false;
+    }
+
+    m_header  = header;
+    m_entries = reinterpret_cast<const TrickplayEntry*>(
+        m_data + sizeof(TrickplayHeader));
+    return true;
+}
+
+void TrickplayIndex::Close(void)
+{
+    if (m_data && m_buffer.isEmpty())
+        m_file.unmap(m_data);
+    m_buffer.clear();
+    m_data    = nullptr;
+    m_size    = 0;
+    m_header  = nullptr;
+    m_entries = nullptr;
+    m_file.close();
+}
+
+uint TrickplayIndex::GetInterval(void) const
+{
+    return m_header ? qFromLittleEndian(m_header->m_interval) : 0;
+}
+
+uint TrickplayIndex::GetCount(void) const
+{
+    return m_header ? qFromLittleEndian(m_header->m_count) : 0;
+}
+
+QSize TrickplayIndex::GetThumbnailSize(void) const
+{
+    if (!m_header)
+        return {};
+    return { qFromLittleEndian(m_header->m_width),
+             qFromLittleEndian(m_header->m_height) };
+}
+
+/** \fn TrickplayIndex::GetImageAt(uint) const
+ *  \brief Returns the JPEG data of the thumbnail closest before \p seconds.
+ *
+ *   The returned array references the index data, it must not be used
+ *   after the index is closed.
+ */
+QByteArray TrickplayIndex::GetImageAt(uint seconds) const
+{
+    uint interval = GetInterval();
+    uint count    = GetCount();
+    if (!interval || !count)
+        return {};
+
+    uint idx = std::min(seconds / interval, count - 1);
+    const TrickplayEntry &entry = m_entries[idx];
+    qint64 offset = qFromLittleEndian(entry.m_offset);
+    qint64 size   = qFromLittleEndian(entry.m_size);
+    if (!size || (offset + size > m_size))
+        return {};
+
+    return QByteArray::fromRawData(
+        reinterpret_cast<const char*>(m_data + offset), static_cast<int>(size));
+}
+
+/** \fn TrickplayIndex::Generate(const ProgramInfo&,const QString&,uint,const QSize&,const std::function<bool()>&)
+ *  \brief Create the trickplay index for a recording.
+ *
+ *   Grabs one frame every \p interval seconds, jumping between them with
+ *   the position map so only the frames from the preceding keyframe are
+ *   decoded, and stores them scaled to \p size.  If only the width of
+ *   \p size is set, the height follows the video aspect ratio.
+ *
+ *   \p cancelled, if set, is polled before each frame.  Once it returns
+ *   true no index is written and this returns false.
+ */
+bool TrickplayIndex::Generate(const ProgramInfo &pginfo, const QString &infile,
+                              uint interval, const QSize &size,
+                              const std::function<bool()> &cancelled)
+{
+    if (!interval || (size.width() <= 0))
+        return false;
+
+    RingBuffer *rbuf = RingBuffer::Create(infile, false, false, 0);
+    if (!rbuf || !rbuf->IsOpen())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC + "Could not open file: " +
+            QString("'%1'").arg(infile));
+        delete rbuf;
+        return false;
+    }
+
+    auto *ctx = new PlayerContext(kPreviewGeneratorInUseID);
+    ctx->SetRingBuffer(rbuf);
+    ctx->SetPlayingInfo(&pginfo);
+    ctx->SetPlayer(new MythPlayer((PlayerFlags)(kAudioMuted | kVideoIsNull | kNoITV)));
+    MythPlayer *player = ctx->m_player;
+    player->SetPlayerInfo(nullptr, nullptr, ctx);
+
+    if ((player->OpenFile() < 0) || !player->InitVideo())
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to initialize video for '%1'").arg(infile));
+        delete ctx;
+        return false;
+    }
+
+    double fps = player->GetFrameRate();
+    uint64_t totalFrames = player->GetTotalFrameCount();
+    int duration = (fps > 0.0 && totalFrames > 0) ?
+        static_cast<int>(totalFrames / fps) :
+        pginfo.GetRecordingStartTime().secsTo(pginfo.GetRecordingEndTime());
+    if ((fps <= 0.0) || (duration <= 0))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Unable to determine length of '%1'").arg(infile));
+        delete ctx;
+        return false;
+    }
+
+    QSize thumbSize = size;
+    if (thumbSize.height() <= 0)
+    {
+        float aspect = player->GetVideoAspect();
+        if (aspect <= 0.0F)
+            aspect = 16.0F / 9.0F;
+        thumbSize.setHeight(static_cast<int>(thumbSize.width() / aspect) & ~1);
+    }
+
+    uint count = (duration + interval - 1) / interval;
+    QVector<QByteArray> images(count);
+    MythAVCopy copyCtx;
+    for (uint i = 0; i < count; i++)
+    {
+        if (cancelled && cancelled())
+        {
+            LOG(VB_GENERAL, LOG_INFO, LOC +
+                QString("Cancelled after %1 of %2 thumbnails for '%3'")
+                    .arg(i).arg(count).arg(infile));
+            delete ctx;
+            return false;
+        }
+
+        auto frameNum = static_cast<long long>(i * interval * fps);
+        VideoFrame *frame = player->GetRawVideoFrame(frameNum);
+        if (!frame)
+            continue;
+        if (!frame->buf || (frame->width <= 0) || (frame->height <= 0))
+        {
+            player->DiscardVideoFrame(frame);
+            continue;
+        }
+
+        unsigned char *rgb = CreateBuffer(FMT_RGB32, frame->width, frame->height);
+        AVFrame retbuf;
+        memset(&retbuf, 0, sizeof(AVFrame));
+        copyCtx.Copy(&retbuf, frame, rgb, AV_PIX_FMT_RGB32);
+        QImage thumb = QImage(rgb, frame->width, frame->height,
+                              QImage::Format_RGB32)
+            .scaled(thumbSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+        av_freep(&rgb);
+        player->DiscardVideoFrame(frame);
+
+        QBuffer buffer(&images[i]);
+        buffer.open(QIODevice::WriteOnly);
+        thumb.save(&buffer, "JPEG", 70);
+    }
+
+    delete ctx;
+
+    TrickplayHeader header {};
+    memcpy(header.m_magic, kMagic, sizeof(kMagic));
+    header.m_version  = qToLittleEndian(kVersion);
+    header.m_interval = qToLittleEndian(static_cast<uint32_t>(interval));
+    header.m_count    = qToLittleEndian(static_cast<uint32_t>(count));
+    header.m_width    = qToLittleEndian(static_cast<uint16_t>(thumbSize.width()));
+    header.m_height   = qToLittleEndian(static_cast<uint16_t>(thumbSize.height()));
+
+    QVector<TrickplayEntry> entries(count);
+    uint64_t offset = sizeof(TrickplayHeader) + (count * sizeof(TrickplayEntry));
+    for (uint i = 0; i < count; i++)
+    {
+        entries[i].m_offset   = qToLittleEndian(offset);
+        entries[i].m_size     = qToLittleEndian(static_cast<uint32_t>(images[i].size()));
+        entries[i].m_reserved = 0;
+        offset += images[i].size();
+    }
+
+    QString filename = GetFilename(infile);
+    QTemporaryFile f(QFileInfo(filename).absoluteFilePath() + ".XXXXXX");
+    f.setAutoRemove(false);
+    bool ok = f.open();
+    ok = ok && (f.write(reinterpret_cast<const char*>(&header),
+                        sizeof(header)) == sizeof(header));
+    ok = ok && (f.write(reinterpret_cast<const char*>(entries.constData()),
+                        count * sizeof(TrickplayEntry)) ==
+                static_cast<qint64>(count * sizeof(TrickplayEntry)));
+    for (uint i = 0; ok && (i < count); i++)
+        ok = (f.write(images[i]) == images[i].size());
+    f.close();
+
+    if (ok)
+    {
+        if (!makeFileAccessible(f.fileName().toLocal8Bit().constData()))
+        {
+            LOG(VB_GENERAL, LOG_ERR, LOC + "Unable to change permissions on "
+                "trickplay index. Backends and frontends running under "
+                "different users will be unable to access it");
+        }
+        QFile::remove(filename);
+        ok = f.rename(filename);
+    }
+
+    if (!ok)
+    {
+        f.remove();
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Failed to write '%1'").arg(filename));
+        return false;
+    }
+
+    LOG(VB_GENERAL, LOG_INFO, LOC +
+        QString("Saved %1 thumbnails %2x%3 every %4s to '%5'")
+            .arg(count).arg(thumbSize.width()).arg(thumbSize.height())
+            .arg(interval).arg(filename));
+    return true;
+}
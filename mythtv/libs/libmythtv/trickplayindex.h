@@ -0,0 +1,86 @@
+// -*- Mode: c++ -*-
+#ifndef TRICKPLAY_INDEX_H_
+#define TRICKPLAY_INDEX_H_
+
+#include <cstdint>
+#include <functional>
+
+#include <QByteArray>
+#include <QString>
+#include <QFile>
+#include <QSize>
+
+#include "mythtvexp.h"
+
+class ProgramInfo;
+
+/** \class TrickplayIndex
+ *  \brief A compact file of downscaled keyframe thumbnails for a recording.
+ *
+ *   The index lives next to the recording as "<recording>.trickplay" and is
+ *   laid out so that it can be memory mapped and used without parsing:
+ *
+ *   - a fixed size TrickplayHeader,
+ *   - TrickplayHeader::m_count TrickplayEntry records, one per interval,
+ *   - the JPEG encoded thumbnails the entries point at.
+ *
+ *   All values are stored little endian.  Thumbnail \e n shows the
+ *   recording at roughly n * TrickplayHeader::m_interval seconds.
+ */
+class MTV_PUBLIC TrickplayIndex
+{
+  public:
+    static const char kMagic[8];
+    static const uint32_t kVersion = 1;
+
+#pragma pack(push, 1)
+    struct TrickplayHeader
+    {
+        char     m_magic[8];
+        uint32_t m_version;
+        uint32_t m_interval;  ///< seconds between thumbnails
+        uint32_t m_count;     ///< number of entries
+        uint16_t m_width;     ///< thumbnail width in pixels
+        uint16_t m_height;    ///< thumbnail height in pixels
+    };
+
+    struct TrickplayEntry
+    {
+        uint64_t m_offset;    ///< file offset of the JPEG data
+        uint32_t m_size;      ///< size of the JPEG data, 0 if missing
+        uint32_t m_reserved;
+    };
+#pragma pack(pop)
+
+    TrickplayIndex() = default;
+    ~TrickplayIndex() { Close(); }
+    TrickplayIndex(const TrickplayIndex &) = delete;            // not copyable
+    TrickplayIndex &operator=(const TrickplayIndex &) = delete; // not copyable
+
+    bool Open(const QString &filename);
+    void Close(void);
+    bool IsOpen(void) const { return m_header != nullptr; }
+
+    uint  GetInterval(void) const;
+    uint  GetCount(void) const;
+    QSize GetThumbnailSize(void) const;
+
+    QByteArray GetImageAt(uint seconds) const;
+
+    static QString GetFilename(const QString &recordingPath)
+        { return recordingPath + ".trickplay"; }
+
+    static bool Generate(const ProgramInfo &pginfo, const QString &infile,
+                         uint interval, const QSize &size,
+                         const std::function<bool()> &cancelled = nullptr);
+
+  private:
+    QFile                 m_file;
+    QByteArray            m_buffer;   ///< contents of a remote index
+    uchar                *m_data    {nullptr};
+    qint64                m_size    {0};
+    const TrickplayHeader *m_header {nullptr};
+    const TrickplayEntry  *m_entries {nullptr};
+};
+
+#endif // TRICKPLAY_INDEX_H_
@@ -76,6 +76,7 @@ using namespace std;
 #include "ringbuffer.h"                 // for RingBuffer, etc
 #include "tv_actions.h"                 // for ACTION_TOGGLESLEEP, etc
 #include "mythcodeccontext.h"
+#include "trickplayindex.h"
 
 #if ! HAVE_ROUND
 #define round(x) ((int) ((x) + 0.5))
@@ -138,6 +139,7 @@ const uint TV::kEndOfPlaybackFirstCheckTimer = 60000;
 const uint TV::kEndOfPlaybackFirstCheckTimer = 5000;
 #endif
 const uint TV::kSaveLastPlayPosTimeout       = 30000;
+const uint TV::kZapAheadDelay                = 3000;
 
 /**
  * \brief stores last program info. maintains info so long as
@@ -1037,6 +1039,7 @@ void TV::InitFromDB(void)
 {
     QMap<QString,QString> kv;
     kv["LiveTVIdleTimeout"]        = "0";
+    kv["LiveTVZapAhead"]           = "0";
     kv["BrowseMaxForward"]         = "240";
     kv["PlaybackExitPrompt"]       = "0";
     kv["AutomaticSetWatched"]      = "0";
@@ -1088,6 +1091,7 @@ void TV::InitFromDB(void)
 
     // convert from minutes to ms.
     m_dbIdleTimeout        = kv["LiveTVIdleTimeout"].toInt() * 60 * 1000;
+    m_dbZapAhead           = kv["LiveTVZapAhead"].toUInt();
     uint db_browse_max_forward  = kv["BrowseMaxForward"].toInt() * 60;
     m_dbPlaybackExitPrompt = kv["PlaybackExitPrompt"].toInt();
     m_dbAutoSetWatched     = (kv["AutomaticSetWatched"].toInt() != 0);
@@ -1102,6 +1106,7 @@ void TV::InitFromDB(void)
     m_dbBrowseAlways       = (kv["PersistentBrowseMode"].toInt() != 0);
     m_dbBrowseAllTuners    = (kv["BrowseAllTuners"].toInt() != 0);
     db_channel_ordering    = kv["ChannelOrdering"];
+    m_dbChannelOrdering    = db_channel_ordering;
     m_baseFilters         += kv["CustomFilters"];
     m_dbChannelFormat      = kv["ChannelFormat"];
     m_tryUnflaggedSkip     = (kv["TryUnflaggedSkip"].toInt() != 0);
@@ -1446,6 +1451,10 @@ void TV::GetStatus(void)
     ctx->LockDeletePlayer(__FILE__, __LINE__);
     if (ctx->m_player)
     {
+        int latency = ctx->m_player->GetLastTuneLatency();
+        if (latency >= 0)
+            status.insert("tunelatency", latency);
+
         if (!info.text["totalchapters"].isEmpty())
         {
             QList<long long> chapters;
@@ -2268,6 +2277,7 @@ void TV::HandleStateChange(PlayerContext *mctx, PlayerContext *ctx)
                 m_lockTimer.start();
                 m_lockTimerOn = true;
             }
+            ScheduleZapAhead();
         }
 
         if (mctx != ctx)
@@ -2687,6 +2697,8 @@ void TV::timerEvent(QTimerEvent *te)
         HandlePxPTimerEvent();
     else if (timer_id == m_saveLastPlayPosTimerId)
         HandleSaveLastPlayPosEvent();
+    else if (timer_id == m_zapAheadTimerId)
+        HandleZapAheadTimerEvent();
     else
         handled = false;
 
@@ -2993,6 +3005,14 @@ void TV::timerEvent(QTimerEvent *te)
         else
             SetUpdateOSDPosition(false);
         ReturnOSDLock(actx, osd);
+
+        // Follow fast forward and rewind with the trickplay thumbnails
+        osdInfo info;
+        if (actx->m_ffRewState && actx->CalcPlayerSliderPosition(info))
+        {
+            UpdateOSDTrickplay(actx, info.values["secondsplayed"],
+                               kOSDTimeout_Short);
+        }
         ReturnPlayerLock(actx);
         handled = true;
     }
@@ -6621,6 +6641,12 @@ void TV::DoSeek(PlayerContext *ctx, float time, const QString &mesg,
         }
         bool paused = ctx->m_player->IsPaused();
         UpdateOSDSeekMessage(ctx, mesg, paused ? kOSDTimeout_None : kOSDTimeout_Med);
+        osdInfo info;
+        if (ctx->CalcPlayerSliderPosition(info))
+        {
+            UpdateOSDTrickplay(ctx, info.values["secondsplayed"],
+                               paused ? kOSDTimeout_None : kOSDTimeout_Med);
+        }
     }
     else
         ctx->UnlockDeletePlayer(__FILE__, __LINE__);
@@ -7580,6 +7606,16 @@ void TV::ChangeChannel(PlayerContext *ctx, ChannelChangeDirection direction)
     if (direction == CHANNEL_DIRECTION_FAVORITE)
         direction = CHANNEL_DIRECTION_UP;
 
+    if (m_dbZapAhead && direction != CHANNEL_DIRECTION_SAME)
+    {
+        uint chanid = ZapAheadNextChannel(ctx, direction);
+        if (chanid && m_zapAheadInputs.contains(chanid))
+        {
+            ChangeChannel(ctx, chanid, "");
+            return;
+        }
+    }
+
     QString oldinputname = ctx->m_recorder->GetInput();
 
     if (ContextIsPaused(ctx, __FILE__, __LINE__))
@@ -7598,6 +7634,7 @@ void TV::ChangeChannel(PlayerContext *ctx, ChannelChangeDirection direction)
     ctx->LockDeletePlayer(__FILE__, __LINE__);
     if (ctx->m_player)
     {
+        ctx->m_player->StartTuneTimer();
         ctx->m_player->ResetCaptions();
         ctx->m_player->ResetTeletext();
     }
@@ -7613,6 +7650,8 @@ void TV::ChangeChannel(PlayerContext *ctx, ChannelChangeDirection direction)
 
     if (oldinputname != ctx->m_recorder->GetInput())
         UpdateOSDInput(ctx);
+
+    ScheduleZapAhead();
 }
 
 static uint get_chanid(const PlayerContext *ctx,
@@ -7655,6 +7694,27 @@ void TV::ChangeChannel(PlayerContext *ctx, uint chanid, const QString &chan)
         channum = ChannelUtil::GetChanNum(chanid);
     }
 
+    // An input tuned ahead to this channel already has a lock
+    auto zap = m_zapAheadInputs.constFind(chanid);
+    if (chanid && zap != m_zapAheadInputs.constEnd() &&
+        *zap != ctx->GetCardID() &&
+        kPseudoNormalLiveTV == ctx->m_pseudoLiveTVState)
+    {
+        uint inputid = *zap;
+        m_zapAheadInputs.clear();
+
+        LOG(VB_CHANNEL, LOG_INFO, LOC +
+            QString("Channel %1 is tuned ahead on input %2")
+            .arg(channum).arg(inputid));
+
+        if (!ctx->m_prevChan.empty() && ctx->m_prevChan.back() == channum)
+            ctx->m_prevChan.pop_back();
+        if (ctx->m_prevChan.empty())
+            ctx->PushPreviousChannel();
+        SwitchInputs(ctx, chanid, channum, inputid);
+        return;
+    }
+
     bool getit = false;
     if (ctx->m_recorder)
     {
@@ -7767,6 +7827,7 @@ void TV::ChangeChannel(PlayerContext *ctx, uint chanid, const QString &chan)
     ctx->LockDeletePlayer(__FILE__, __LINE__);
     if (ctx->m_player)
     {
+        ctx->m_player->StartTuneTimer();
         ctx->m_player->ResetCaptions();
         ctx->m_player->ResetTeletext();
     }
@@ -7781,6 +7842,8 @@ void TV::ChangeChannel(PlayerContext *ctx, uint chanid, const QString &chan)
 
     if (oldinputname != ctx->m_recorder->GetInput())
         UpdateOSDInput(ctx);
+
+    ScheduleZapAhead();
 }
 
 void TV::ChangeChannel(const PlayerContext *ctx, const ChannelInfoList &options)
@@ -7806,6 +7869,140 @@ void TV::ChangeChannel(const PlayerContext *ctx, const ChannelInfoList &options)
     }
 }
 
+/// \brief Tunes ahead once channel changes have settled for kZapAheadDelay.
+void TV::ScheduleZapAhead(void)
+{
+    if (!m_dbZapAhead)
+        return;
+
+    QMutexLocker locker(&m_timerIdLock);
+    if (m_zapAheadTimerId)
+        KillTimer(m_zapAheadTimerId);
+    m_zapAheadTimerId = StartTimer(kZapAheadDelay, __LINE__);
+}
+
+void TV::HandleZapAheadTimerEvent(void)
+{
+    {
+        QMutexLocker locker(&m_timerIdLock);
+        KillTimer(m_zapAheadTimerId);
+        m_zapAheadTimerId = 0;
+    }
+
+    PlayerContext *ctx = GetPlayerReadLock(0, __FILE__, __LINE__);
+    if (ctx && ctx->m_recorder && !ctx->InStateChange() &&
+        StateIsLiveTV(GetState(ctx)) &&
+        kPseudoNormalLiveTV == ctx->m_pseudoLiveTVState)
+    {
+        ZapAheadUpdate(ctx);
+    }
+    ReturnPlayerLock(ctx);
+}
+
+/** \fn TV::ZapAheadNextChannel(const PlayerContext*, ChannelChangeDirection)
+ *  \brief Returns the channel a channel change in direction is expected
+ *         to go to, or 0 if it cannot be predicted.
+ */
+uint TV::ZapAheadNextChannel(const PlayerContext *ctx,
+                             ChannelChangeDirection direction)
+{
+    uint chanid = 0;
+    uint sourceid = 0;
+    ctx->LockPlayingInfo(__FILE__, __LINE__);
+    if (ctx->m_playingInfo)
+    {
+        chanid   = ctx->m_playingInfo->GetChanID();
+        sourceid = ctx->m_playingInfo->GetSourceID();
+    }
+    ctx->UnlockPlayingInfo(__FILE__, __LINE__);
+    if (!chanid)
+        return 0;
+
+    if (m_dbUseChannelGroups || (direction == CHANNEL_DIRECTION_FAVORITE))
+    {
+        QMutexLocker locker(&m_channelGroupLock);
+        if (m_channelGroupId > -1)
+        {
+            return ChannelUtil::GetNextChannel(
+                m_channelGroupChannelList, chanid, 0, 0, direction);
+        }
+    }
+
+    if (direction == CHANNEL_DIRECTION_FAVORITE)
+        direction = CHANNEL_DIRECTION_UP;
+
+    ChannelInfoList channels = ChannelUtil::GetChannels(sourceid, true);
+    ChannelUtil::SortChannels(channels, m_dbChannelOrdering, true);
+    return ChannelUtil::GetNextChannel(channels, chanid, 0, 0, direction);
+}
+
+/** \fn TV::ZapAheadUpdate(const PlayerContext*)
+ *  \brief Asks up to m_dbZapAhead idle inputs to tune to the channels the
+ *         viewer is most likely to change to next.
+ *
+ *   Those are the channels either side of the current one and the
+ *   previous channel.  A channel change to one of them then switches to
+ *   the input holding it, which has a lock already, rather than retuning.
+ *   The backend gives the inputs up again when they are needed for
+ *   anything else or are not used within a couple of minutes.
+ */
+void TV::ZapAheadUpdate(const PlayerContext *ctx)
+{
+    m_zapAheadInputs.clear();
+
+    uint curchanid = 0;
+    ctx->LockPlayingInfo(__FILE__, __LINE__);
+    if (ctx->m_playingInfo)
+        curchanid = ctx->m_playingInfo->GetChanID();
+    ctx->UnlockPlayingInfo(__FILE__, __LINE__);
+
+    QList<uint> candidates;
+    candidates.push_back(ZapAheadNextChannel(ctx, CHANNEL_DIRECTION_UP));
+    candidates.push_back(ZapAheadNextChannel(ctx, CHANNEL_DIRECTION_DOWN));
+    QString prevchan = ctx->GetPreviousChannel();
+    if (!prevchan.isEmpty())
+        candidates.push_back(get_chanid(ctx, ctx->GetCardID(), prevchan));
+
+    // Inputs sharing a tuner cannot hold different channels
+    QSet<uint> used;
+    used.insert(ctx->GetCardID());
+    for (uint inputid : CardUtil::GetConflictingInputs(ctx->GetCardID()))
+        used.insert(inputid);
+
+    foreach (uint chanid, candidates)
+    {
+        if (m_zapAheadInputs.size() >= static_cast<int>(m_dbZapAhead))
+            break;
+        if (!chanid || chanid == curchanid || m_zapAheadInputs.contains(chanid))
+            continue;
+
+        QString channum = ChannelUtil::GetChanNum(chanid);
+        QSet<uint> tunable_on = IsTunableOn(ctx, chanid);
+        foreach (uint inputid, tunable_on)
+        {
+            if (used.contains(inputid))
+                continue;
+
+            RemoteEncoder *rec = RemoteGetExistingRecorder(inputid);
+            bool tuned = rec && rec->IsValidRecorder() &&
+                         rec->StandbyTune(channum);
+            delete rec;
+            if (!tuned)
+                continue;
+
+            LOG(VB_CHANNEL, LOG_INFO, LOC +
+                QString("Tuning channel %1 ahead on input %2")
+                .arg(channum).arg(inputid));
+
+            m_zapAheadInputs[chanid] = inputid;
+            used.insert(inputid);
+            for (uint conflict : CardUtil::GetConflictingInputs(inputid))
+                used.insert(conflict);
+            break;
+        }
+    }
+}
+
 void TV::ShowPreviousChannel(PlayerContext *ctx)
 {
     QString channum = ctx->GetPreviousChannel();
@@ -8059,6 +8256,74 @@ void TV::UpdateOSDSeekMessage(const PlayerContext *ctx,
     }
 }
 
+/// The trickplay index of one recording, loaded in the background.
+struct TrickplayState
+{
+    QMutex         m_lock;
+    QString        m_url;
+    TrickplayIndex m_index;
+};
+
+/** \fn TV::UpdateOSDTrickplay(const PlayerContext*,int,OSDTimeout)
+ *  \brief Shows the trickplay thumbnail for \p seconds into the recording.
+ *
+ *   The index is read from the backend by a pool thread the first time it
+ *   is needed, until it is ready no thumbnail is shown.
+ */
+void TV::UpdateOSDTrickplay(const PlayerContext *ctx, int seconds,
+                            enum OSDTimeout timeout)
+{
+    class TrickplayLoader : public QRunnable
+    {
+      public:
+        explicit TrickplayLoader(QSharedPointer<TrickplayState> state) :
+            m_state(std::move(state)) {}
+        void run(void) override // QRunnable
+        {
+            QMutexLocker locker(&m_state->m_lock);
+            m_state->m_index.Open(m_state->m_url);
+        }
+      private:
+        QSharedPointer<TrickplayState> m_state;
+    };
+
+    QString url;
+    ctx->LockPlayingInfo(__FILE__, __LINE__);
+    if (ctx->m_playingInfo && ctx->m_playingInfo->IsRecording() &&
+        StateIsPlaying(ctx->GetState()))
+    {
+        url = TrickplayIndex::GetFilename(ctx->m_playingInfo->GetPathname());
+    }
+    ctx->UnlockPlayingInfo(__FILE__, __LINE__);
+    if (url.isEmpty() || seconds < 0)
+        return;
+
+    if (!m_trickplay || (m_trickplay->m_url != url))
+    {
+        m_trickplay = QSharedPointer<TrickplayState>::create();
+        m_trickplay->m_url = url;
+        MThreadPool::globalInstance()->
+            start(new TrickplayLoader(m_trickplay), "TrickplayLoader");
+        return;
+    }
+
+    // Never wait for the loader on the UI thread
+    if (!m_trickplay->m_lock.tryLock())
+        return;
+    QImage image;
+    QByteArray jpeg = m_trickplay->m_index.GetImageAt(seconds);
+    if (!jpeg.isEmpty())
+        image.loadFromData(jpeg, "JPEG");
+    m_trickplay->m_lock.unlock();
+    if (image.isNull())
+        return;
+
+    OSD *osd = GetOSDLock(ctx);
+    if (osd)
+        osd->SetImage("osd_trickplay", "thumbnail", image, timeout);
+    ReturnOSDLock(ctx, osd);
+}
+
 void TV::UpdateOSDInput(const PlayerContext *ctx)
 {
     if (!ctx->m_recorder || !ctx->m_tvchain)
@@ -11,6 +11,7 @@ using namespace std;
 
 // Qt
 #include <QReadWriteLock>
+#include <QSharedPointer>
 #include <QWaitCondition>
 #include <QStringList>
 #include <QDateTime>
@@ -50,6 +51,7 @@ class TvPlayWindow;
 class TV;
 class TVBrowseHelper;
 struct osdInfo;
+struct TrickplayState;
 
 using EMBEDRETURNVOID        = void (*) (void *, bool);
 using EMBEDRETURNVOIDEPG     = void (*) (uint, const QString &, const QDateTime, TV *, bool, bool, int);
@@ -408,6 +410,7 @@ class MTV_PUBLIC TV : public QObject, public MenuItemDisplayer
     bool HandleLCDTimerEvent(void);
     void HandleLCDVolumeTimerEvent(void);
     void HandleSaveLastPlayPosEvent();
+    void HandleZapAheadTimerEvent(void);
 
     // Commands used by frontend UI screens (PlaybackBox, GuideGrid etc)
     void EditSchedule(const PlayerContext *ctx,
@@ -508,6 +511,12 @@ class MTV_PUBLIC TV : public QObject, public MenuItemDisplayer
     void ChangeChannel(PlayerContext *ctx, ChannelChangeDirection direction);
     void ChangeChannel(PlayerContext *ctx, uint chanid, const QString &channum);
 
+    // Zap ahead
+    void ScheduleZapAhead(void);
+    void ZapAheadUpdate(const PlayerContext *ctx);
+    uint ZapAheadNextChannel(const PlayerContext *ctx,
+                             ChannelChangeDirection direction);
+
     void ShowPreviousChannel(PlayerContext *ctx);
     void PopPreviousChannel(PlayerContext *ctx, bool immediate_change);
 
@@ -623,6 +632,8 @@ class MTV_PUBLIC TV : public QObject, public MenuItemDisplayer
 
     void UpdateOSDSeekMessage(const PlayerContext *ctx,
                               const QString &mesg, enum OSDTimeout timeout);
+    void UpdateOSDTrickplay(const PlayerContext *ctx, int seconds,
+                            enum OSDTimeout timeout);
     void UpdateOSDInput(const PlayerContext *ctx);
     void UpdateOSDSignal(PlayerContext *ctx, const QStringList &strlist);
     void UpdateOSDTimeoutMessage(PlayerContext *ctx);
@@ -788,6 +799,9 @@ class MTV_PUBLIC TV : public QObject, public MenuItemDisplayer
     bool              m_dbUseChannelGroups {false};
     bool              m_dbRememberLastChannelGroup {false};
     ChannelGroupList  m_dbChannelGroups;
+    QString           m_dbChannelOrdering;
+    /// Number of idle inputs to tune ahead to likely next channels
+    uint              m_dbZapAhead {0};
 
     bool              m_tryUnflaggedSkip {false};
 
@@ -939,6 +953,12 @@ class MTV_PUBLIC TV : public QObject, public MenuItemDisplayer
     volatile int        m_channelGroupId {-1};
     ChannelInfoList     m_channelGroupChannelList;
 
+    /// Channels tuned ahead on idle inputs, chanid to inputid
+    QMap<uint,uint>     m_zapAheadInputs;
+
+    /// Thumbnails of the playing recording, shown while seeking
+    QSharedPointer<TrickplayState> m_trickplay;
+
     // Network Control stuff
     MythDeque<QString> m_networkControlCommands;
 
@@ -967,6 +987,7 @@ class MTV_PUBLIC TV : public QObject, public MenuItemDisplayer
     volatile int         m_errorRecoveryTimerId    {0};
     mutable volatile int m_exitPlayerTimerId       {0};
     volatile int         m_saveLastPlayPosTimerId  {0};
+    volatile int         m_zapAheadTimerId         {0};
     TimerContextMap      m_stateChangeTimerId;
     TimerContextMap      m_signalMonitorTimerId;
 
@@ -1082,6 +1103,8 @@ class MTV_PUBLIC TV : public QObject, public MenuItemDisplayer
     static const uint kEndOfRecPromptCheckFrequency;
     static const uint kEndOfPlaybackFirstCheckTimer;
     static const uint kSaveLastPlayPosTimeout;
+    /// How long to wait after a channel change before tuning ahead in msec
+    static const uint kZapAheadDelay;
 };
 
 #endif
@@ -291,6 +291,10 @@ void TVRec::RecordPending(const ProgramInfo *rcinfo, int secsleft,
     LOG(VB_RECORD, LOG_INFO, LOC +
         QString("RecordPending on inputid [%1]").arg(rcinfo->GetInputID()));
 
+    // The tuner is needed, for this recording or one sharing it
+    if (HasFlags(kFlagStandby))
+        StopStandby();
+
     PendingInfo pending;
     pending.m_info            = new ProgramInfo(*rcinfo);
     pending.m_recordingStart  = MythDate::current().addSecs(secsleft);
@@ -1012,6 +1016,13 @@ void TVRec::HandleStateChange(void)
         return;
     }
 
+    // Whatever comes next retunes, the standby channel is not needed
+    if (HasFlags(kFlagStandby))
+    {
+        ClearFlags(kFlagStandby, __FILE__, __LINE__);
+        m_standbyChannel.clear();
+    }
+
     // Make sure EIT scan is stopped before any tuning,
     // to avoid race condition with it's tuning requests.
     if (m_scanner && HasFlags(kFlagEITScannerRunning))
@@ -1418,7 +1429,16 @@ void TVRec::run(void)
             ClearFlags(kFlagExitPlayer, __FILE__, __LINE__);
         }
 
-        if (m_scanner && m_channel &&
+        // Give up the standby channel when it has not been used in time,
+        // or when another input needs the tuner it is holding
+        if (HasFlags(kFlagStandby) &&
+            (MythDate::current() > m_standbyExpires ||
+             IsConflictingInputBusy()))
+        {
+            StopStandby();
+        }
+
+        if (m_scanner && m_channel && !HasFlags(kFlagStandby) &&
             MythDate::current() > m_eitScanStartTime)
         {
             if (!m_dvbOpt.m_dvbEitScan)
@@ -3157,6 +3177,94 @@ bool TVRec::QueueEITChannelChange(const QString &name)
     return ok;
 }
 
+/** \fn TVRec::StandbyTune(const QString&)
+ *  \brief Tunes an idle input to a channel a LiveTV frontend expects to
+ *         change to next.
+ *
+ *   The input stays idle as far as the scheduler is concerned, but when
+ *   LiveTV is started on it with this channel the tuner already has a
+ *   lock.  The channel is kept for kStandbyTimeout seconds unless asked
+ *   for again, and given up as soon as a recording is pending or an input
+ *   sharing the tuner becomes busy.
+ *
+ *  \return true if the channel is being or has been tuned
+ */
+bool TVRec::StandbyTune(const QString &channum)
+{
+    static const int kStandbyTimeout = 120;
+
+    QMutexLocker lock(&m_stateChangeLock);
+
+    if (m_internalState != kState_None || m_changeState ||
+        HasFlags(kFlagAnyRecRunning) || !CheckChannel(channum))
+    {
+        return false;
+    }
+
+    {
+        QMutexLocker pendlock(&m_pendingRecLock);
+        if (!m_pendingRecordings.empty())
+            return false;
+    }
+
+    if (IsConflictingInputBusy())
+        return false;
+
+    m_standbyExpires = MythDate::current().addSecs(kStandbyTimeout);
+    if (HasFlags(kFlagStandby) && m_standbyChannel == channum)
+        return true;
+
+    if (m_scanner && HasFlags(kFlagEITScannerRunning))
+    {
+        m_scanner->StopActiveScan();
+        ClearFlags(kFlagEITScannerRunning, __FILE__, __LINE__);
+    }
+
+    // Anything queued is EIT scanner tuning, which this replaces
+    m_tuningRequests.clear();
+
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Standby tuning to channel %1").arg(channum));
+
+    SetFlags(kFlagStandby, __FILE__, __LINE__);
+    m_standbyChannel = channum;
+    m_tuningRequests.enqueue(TuningRequest(kFlagEITScan, channum));
+    WakeEventLoop();
+
+    return true;
+}
+
+/// \brief Closes the channel tuned by StandbyTune().
+void TVRec::StopStandby(void)
+{
+    LOG(VB_RECORD, LOG_INFO, LOC +
+        QString("Releasing standby channel %1").arg(m_standbyChannel));
+
+    ClearFlags(kFlagStandby, __FILE__, __LINE__);
+    m_standbyChannel.clear();
+    if (m_internalState == kState_None && !m_changeState)
+        m_tuningRequests.enqueue(TuningRequest(kFlagKillRec));
+    if (m_scanner)
+    {
+        m_eitScanStartTime = MythDate::current().addSecs(
+            m_eitCrawlIdleStart + eit_start_rand(m_eitTransportTimeout));
+    }
+    WakeEventLoop();
+}
+
+/// \brief Whether another input that shares our tuner is in use.
+bool TVRec::IsConflictingInputBusy(void) const
+{
+    InputInfo busy_input;
+    bool busy = false;
+    s_inputsLock.lockForRead();
+    vector<uint> inputids = CardUtil::GetConflictingInputs(m_inputId);
+    for (uint i = 0; i < inputids.size() && !busy; ++i)
+        busy = RemoteIsBusy(inputids[i], busy_input);
+    s_inputsLock.unlock();
+    return busy;
+}
+
 void TVRec::GetNextProgram(BrowseDirection direction,
                            QString &title,       QString &subtitle,
                            QString &desc,        QString &category,
@@ -4073,6 +4181,10 @@ static int init_jobs(const RecordingInfo *rec, RecordingProfile &profile,
     // grab standard jobs flags from program info
     JobQueue::AddJobsToMask(rec->GetAutoRunJobs(), jobs);
 
+    // trickplay indexes are off until an interval is set
+    if (gCoreContext->GetNumSetting("TrickplayInterval", 0) > 0)
+        JobQueue::AddJobsToMask(JOB_TRICKPLAY, jobs);
+
     // disable commercial flagging on PBS, BBC, etc.
     if (rec->IsCommercialFree())
         JobQueue::RemoveJobsFromMask(JOB_COMMFLAG, jobs);
@@ -4452,6 +4564,8 @@ QString TVRec::FlagToString(uint f)
         msg += "Errored,";
     if (kFlagCancelNextRecording & f)
         msg += "CancelNextRecording,";
+    if (kFlagStandby & f)
+        msg += "Standby,";
 
     // Tuning flags
     if ((kFlagRec & f) == kFlagRec)
@@ -207,6 +207,7 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
         { SetChannel(QString("NextChannel %1").arg((int)dir)); }
     void SetChannel(const QString& name, uint requestType = kFlagDetect);
     bool QueueEITChannelChange(const QString &name);
+    bool StandbyTune(const QString &channum);
 
     int SetSignalMonitoringRate(int rate, int notifyFrontend = 1);
     int  GetPictureAttribute(PictureAttribute attr);
@@ -256,6 +257,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     bool WaitForEventThreadSleep(bool wake = true, ulong time = ULONG_MAX);
 
   private:
+    void StopStandby(void);
+    bool IsConflictingInputBusy(void) const;
     void SetRingBuffer(RingBuffer *rb);
     void SetPseudoLiveTVRecording(RecordingInfo *pi);
     void TeardownAll(void);
@@ -389,6 +392,9 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     TuningQueue        m_tuningRequests;
     TuningRequest      m_lastTuningRequest        {0};
     QDateTime          m_eitScanStartTime;
+    /// Channel a LiveTV frontend asked us to tune to in case it is next
+    QString            m_standbyChannel;
+    QDateTime          m_standbyExpires;
     mutable QMutex     m_triggerEventLoopLock     {QMutex::NonRecursive};
     QWaitCondition     m_triggerEventLoopWait;
     bool               m_triggerEventLoopSignal   {false};
@@ -436,6 +442,8 @@ class MTV_PUBLIC TVRec : public SignalMonitorListener, public QRunnable
     static const uint kFlagFinishRecording      = 0x00000008;
     static const uint kFlagErrored              = 0x00000010;
     static const uint kFlagCancelNextRecording  = 0x00000020;
+    /// idle, but tuned ahead for a LiveTV channel change
+    static const uint kFlagStandby              = 0x00000040;
 
     // Tuning flags
     /// final result desired is LiveTV recording
@@ -42,11 +42,13 @@ HEADERS += mythuiexp.h mythuisimpletext.h mythuistatetracker.h
 HEADERS += mythuianimation.h mythuiscrollbar.h
 HEADERS += mythnotificationcenter.h mythnotificationcenter_private.h
 HEADERS += mythuicomposite.h mythnotification.h
-HEADERS += mythedid.h
+HEADERS += mythedid.h xmlparsecache.h mythtexttemplate.h
+HEADERS += mythuicachemanager.h
 
 SOURCES  = mythmainwindow.cpp mythpainter.cpp mythimage.cpp mythrect.cpp
 SOURCES += myththemebase.cpp  mythpainter_qimage.cpp
 SOURCES += mythpainter_qt.cpp xmlparsebase.cpp mythuihelper.cpp
+SOURCES += xmlparsecache.cpp mythtexttemplate.cpp mythuicachemanager.cpp
 SOURCES += mythscreenstack.cpp mythgesture.cpp mythuitype.cpp mythscreentype.cpp
 SOURCES += mythuiimage.cpp mythuitext.cpp mythuifilebrowser.cpp
 SOURCES += mythuistatetype.cpp mythfontproperties.cpp
@@ -78,6 +80,7 @@ inc.files += myththemebase.h themeinfo.h
 inc.files += mythpainter_qt.h mythuistatetype.h mythuihelper.h
 inc.files += mythscreenstack.h mythscreentype.h mythuitype.h mythuiimage.h
 inc.files += mythuitext.h mythuibutton.h mythlistbutton.h xmlparsebase.h
+inc.files += mythtexttemplate.h mythuicachemanager.h
 inc.files += myththemedmenu.h mythdialogbox.h mythfontproperties.h
 inc.files += mythuiclock.h mythgesture.h mythuitextedit.h mythprogressdialog.h
 inc.files += mythuispinbox.h mythuicheckbox.h mythuibuttonlist.h mythuigroup.h
@@ -194,8 +197,8 @@ using_opengl {
     SOURCES += opengl/mythpainteropengl.cpp  opengl/mythrenderopengl.cpp
     HEADERS += opengl/mythpainteropengl.h    opengl/mythrenderopengl.h
     HEADERS += opengl/mythrenderopengldefs.h opengl/mythrenderopenglshaders.h
-    HEADERS += opengl/mythopenglperf.h
-    SOURCES += opengl/mythopenglperf.cpp
+    HEADERS += opengl/mythopenglperf.h    opengl/mythglyphcache.h
+    SOURCES += opengl/mythopenglperf.cpp  opengl/mythglyphcache.cpp
     HEADERS += opengl/mythegl.h
     SOURCES += opengl/mythegl.cpp
 
@@ -220,4 +223,11 @@ use_hidesyms {
 
 include ( ../libs-targetfix.pro )
 
+test_clean.commands = -cd test/ && $(MAKE) -f Makefile clean
+clean.depends = test_clean
+QMAKE_EXTRA_TARGETS += test_clean clean
+test_distclean.commands = -cd test/ && $(MAKE) -f Makefile distclean
+distclean.depends = test_distclean
+QMAKE_EXTRA_TARGETS += test_distclean distclean
+
 LIBS += $$EXTRA_LIBS $$LATE_LIBS
@@ -31,6 +31,11 @@ void MythFontManager::LoadFonts(const QString &directory,
     int maxDirs = MAX_DIRS;
     LoadFonts(directory, registeredFor, &maxDirs);
 
+    // Listing the sizes of every font makes Qt open every font on the system,
+    // which is most of the time this takes, so only do it if it is logged
+    if (!VERBOSE_LEVEL_CHECK(VB_GUI, LOG_DEBUG))
+        return;
+
     QFontDatabase database;
     foreach (const QString & family, database.families())
     {
@@ -6,6 +6,7 @@
 #include <iostream>
 
 // QT headers
+#include <QBuffer>
 #include <QImageReader>
 #include <QMatrix>
 #include <QNetworkReply>
@@ -293,7 +294,48 @@ bool MythImage::Load(MythImageReader *reader)
     return false;
 }
 
-bool MythImage::Load(const QString &filename)
+/** \brief Decode an image, at a smaller size if the format can do so cheaply.
+ *
+ *   Formats such as JPEG can decode straight to a fraction of their size,
+ *   which is much faster than decoding the whole image and scaling it
+ *   afterwards.  The image is never scaled up here.
+ */
+static QImage *ReadImage(QImageReader &reader, const QSize &scaledSize,
+                         bool preserveAspect)
+{
+    if (scaledSize.width() > 0 && scaledSize.height() > 0 &&
+        reader.supportsOption(QImageIOHandler::ScaledSize))
+    {
+        QSize size = reader.size();
+        if (size.isValid())
+        {
+            size = size.scaled(scaledSize, preserveAspect ? Qt::KeepAspectRatio
+                                                          : Qt::IgnoreAspectRatio);
+            if (size.width() < reader.size().width() &&
+                size.height() < reader.size().height())
+            {
+                reader.setScaledSize(size);
+            }
+        }
+    }
+
+    auto *im = new QImage();
+    if (!reader.read(im))
+    {
+        delete im;
+        return nullptr;
+    }
+    return im;
+}
+
+/** \fn MythImage::Load(const QString&, const QSize&, bool)
+ *  \brief Load an image from a local, myth:// or http:// location.
+ *
+ *   If scaledSize is valid the image may be decoded at, or close to, that
+ *   size instead of its own.  The caller is still expected to resize it.
+ */
+bool MythImage::Load(const QString &filename, const QSize &scaledSize,
+                     bool preserveAspect)
 {
     if (filename.isEmpty())
         return false;
@@ -322,8 +364,9 @@ bool MythImage::Load(const QString &filename)
 
             if (ret)
             {
-                im = new QImage();
-                im->loadFromData(data);
+                QBuffer buffer(&data);
+                QImageReader reader(&buffer);
+                im = ReadImage(reader, scaledSize, preserveAspect);
             }
         }
 #if 0
@@ -341,8 +384,9 @@ bool MythImage::Load(const QString &filename)
         QByteArray data;
         if (GetMythDownloadManager()->download(filename, &data))
         {
-            im = new QImage();
-            im->loadFromData(data);
+            QBuffer buffer(&data);
+            QImageReader reader(&buffer);
+            im = ReadImage(reader, scaledSize, preserveAspect);
         }
     }
     else
@@ -350,7 +394,10 @@ bool MythImage::Load(const QString &filename)
         QString path = filename;
         if (path.startsWith('/') ||
             GetMythUI()->FindThemeFile(path))
-            im = new QImage(path);
+        {
+            QImageReader reader(path);
+            im = ReadImage(reader, scaledSize, preserveAspect);
+        }
     }
 
     if (im && im->isNull())
@@ -15,6 +15,8 @@ using namespace std;
 #include <QApplication>
 #include <QTimer>
 #include <QHash>
+#include <QMutex>
+#include <QPair>
 #include <QFile>
 #include <QDir>
 #include <QEvent>
@@ -126,6 +128,137 @@ struct MPData {
     MediaPlayCallback m_playFn;
 };
 
+/** \class KeyBindingPrefetch
+ *  \brief This host's key bindings and jump points, read in one query each.
+ *
+ *   Registering each key used to look it up in the database, which is a few
+ *   hundred queries during startup.  While the prefetched bindings are held
+ *   RegisterKey() and RegisterJump() use them instead, and keep them up to
+ *   date with the rows they insert and update.  Anything else that changes the
+ *   tables, such as a schema upgrade, must happen before Load() or after
+ *   Clear().
+ */
+class KeyBindingPrefetch
+{
+  public:
+    struct Binding
+    {
+        QString m_keylist;
+        QString m_description;
+    };
+    using BindingKey = QPair<QString,QString>;
+
+    void Load(void);
+    void Clear(void);
+    bool FindKey(const QString &Context, const QString &Action, bool &Found,
+                 Binding &Result);
+    void SetKey(const QString &Context, const QString &Action,
+                const Binding &Value);
+    bool FindJump(const QString &Destination, bool &Found, QString &Keylist);
+    void SetJump(const QString &Destination, const QString &Keylist);
+
+  private:
+    QMutex                      m_lock;
+    bool                        m_loaded {false};
+    QHash<BindingKey, Binding>  m_keys;
+    QHash<QString, QString>     m_jumps;
+};
+
+static KeyBindingPrefetch s_keyPrefetch;
+
+void KeyBindingPrefetch::Load(void)
+{
+    QHash<BindingKey, Binding> keys;
+    QHash<QString, QString> jumps;
+
+    MSqlQuery query(MSqlQuery::InitCon());
+    query.prepare("SELECT context, action, keylist, description "
+                  "FROM keybindings WHERE hostname = :HOSTNAME ;");
+    query.bindValue(":HOSTNAME", GetMythDB()->GetHostName());
+    if (!query.exec())
+    {
+        MythDB::DBError("Prefetch Keybindings", query);
+        return;
+    }
+    while (query.next())
+    {
+        Binding binding;
+        binding.m_keylist     = query.value(2).toString();
+        binding.m_description = query.value(3).toString();
+        keys.insert(BindingKey(query.value(0).toString(),
+                               query.value(1).toString()), binding);
+    }
+
+    query.prepare("SELECT destination, keylist "
+                  "FROM jumppoints WHERE hostname = :HOSTNAME ;");
+    query.bindValue(":HOSTNAME", GetMythDB()->GetHostName());
+    if (!query.exec())
+    {
+        MythDB::DBError("Prefetch Jump Points", query);
+        return;
+    }
+    while (query.next())
+        jumps.insert(query.value(0).toString(), query.value(1).toString());
+
+    LOG(VB_GENERAL, LOG_DEBUG, LOC + QString("Prefetched %1 key bindings and "
+        "%2 jump points").arg(keys.size()).arg(jumps.size()));
+
+    QMutexLocker locker(&m_lock);
+    m_keys.swap(keys);
+    m_jumps.swap(jumps);
+    m_loaded = true;
+}
+
+void KeyBindingPrefetch::Clear(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_loaded = false;
+    m_keys.clear();
+    m_jumps.clear();
+}
+
+/// \brief Return false if the bindings are not held, else look one up.
+bool KeyBindingPrefetch::FindKey(const QString &Context, const QString &Action,
+                                 bool &Found, Binding &Result)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_loaded)
+        return false;
+    auto it = m_keys.constFind(BindingKey(Context, Action));
+    Found = it != m_keys.constEnd();
+    if (Found)
+        Result = *it;
+    return true;
+}
+
+void KeyBindingPrefetch::SetKey(const QString &Context, const QString &Action,
+                                const Binding &Value)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_loaded)
+        m_keys.insert(BindingKey(Context, Action), Value);
+}
+
+bool KeyBindingPrefetch::FindJump(const QString &Destination, bool &Found,
+                                  QString &Keylist)
+{
+    QMutexLocker locker(&m_lock);
+    if (!m_loaded)
+        return false;
+    auto it = m_jumps.constFind(Destination);
+    Found = it != m_jumps.constEnd();
+    if (Found)
+        Keylist = *it;
+    return true;
+}
+
+void KeyBindingPrefetch::SetJump(const QString &Destination, const QString &Keylist)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_loaded)
+        m_jumps.insert(Destination, Keylist);
+}
+
 class MythMainWindowPrivate
 {
   public:
@@ -1665,20 +1798,31 @@ void MythMainWindow::RegisterKey(const QString &context, const QString &action,
 
     if (d->m_useDB && query.isConnected())
     {
-        query.prepare("SELECT keylist, description FROM keybindings WHERE "
-                      "context = :CONTEXT AND action = :ACTION AND "
-                      "hostname = :HOSTNAME ;");
-        query.bindValue(":CONTEXT", context);
-        query.bindValue(":ACTION", action);
-        query.bindValue(":HOSTNAME", GetMythDB()->GetHostName());
+        bool found = false;
+        KeyBindingPrefetch::Binding binding;
+        if (!s_keyPrefetch.FindKey(context, action, found, binding))
+        {
+            query.prepare("SELECT keylist, description FROM keybindings WHERE "
+                          "context = :CONTEXT AND action = :ACTION AND "
+                          "hostname = :HOSTNAME ;");
+            query.bindValue(":CONTEXT", context);
+            query.bindValue(":ACTION", action);
+            query.bindValue(":HOSTNAME", GetMythDB()->GetHostName());
+
+            found = query.exec() && query.next();
+            if (found)
+            {
+                binding.m_keylist     = query.value(0).toString();
+                binding.m_description = query.value(1).toString();
+            }
+        }
 
-        if (query.exec() && query.next())
+        if (found)
         {
-            keybind = query.value(0).toString();
-            QString db_description = query.value(1).toString();
+            keybind = binding.m_keylist;
 
             // Update keybinding description if changed
-            if (db_description != description)
+            if (binding.m_description != description)
             {
                 LOG(VB_GENERAL, LOG_NOTICE,
                     "Updating keybinding description...");
@@ -1698,6 +1842,9 @@ void MythMainWindow::RegisterKey(const QString &context, const QString &action,
                 {
                     MythDB::DBError("Update Keybinding", query);
                 }
+
+                binding.m_description = description;
+                s_keyPrefetch.SetKey(context, action, binding);
             }
         }
         else
@@ -1718,6 +1865,10 @@ void MythMainWindow::RegisterKey(const QString &context, const QString &action,
             {
                 MythDB::DBError("Insert Keybinding", query);
             }
+
+            binding.m_keylist     = inskey;
+            binding.m_description = description;
+            s_keyPrefetch.SetKey(context, action, binding);
         }
     }
 
@@ -1725,6 +1876,23 @@ void MythMainWindow::RegisterKey(const QString &context, const QString &action,
     d->m_actionText[context][action] = description;
 }
 
+/** \fn MythMainWindow::PrefetchKeyBindings(void)
+ *  \brief Read this host's key bindings and jump points in one go.
+ *
+ *   Until ClearPrefetchedKeyBindings() is called RegisterKey() and
+ *   RegisterJump() do not query the database for each key. This may be
+ *   called from any thread, before the main window exists.
+ */
+void MythMainWindow::PrefetchKeyBindings(void)
+{
+    s_keyPrefetch.Load();
+}
+
+void MythMainWindow::ClearPrefetchedKeyBindings(void)
+{
+    s_keyPrefetch.Clear();
+}
+
 QString MythMainWindow::GetKey(const QString &context,
                                const QString &action)
 {
@@ -1829,14 +1997,23 @@ void MythMainWindow::RegisterJump(const QString &destination,
     MSqlQuery query(MSqlQuery::InitCon());
     if (query.isConnected())
     {
-        query.prepare("SELECT keylist FROM jumppoints WHERE "
-                      "destination = :DEST and hostname = :HOST ;");
-        query.bindValue(":DEST", destination);
-        query.bindValue(":HOST", GetMythDB()->GetHostName());
+        bool found = false;
+        QString keylist;
+        if (!s_keyPrefetch.FindJump(destination, found, keylist))
+        {
+            query.prepare("SELECT keylist FROM jumppoints WHERE "
+                          "destination = :DEST and hostname = :HOST ;");
+            query.bindValue(":DEST", destination);
+            query.bindValue(":HOST", GetMythDB()->GetHostName());
+
+            found = query.exec() && query.next();
+            if (found)
+                keylist = query.value(0).toString();
+        }
 
-        if (query.exec() && query.next())
+        if (found)
         {
-            keybind = query.value(0).toString();
+            keybind = keylist;
         }
         else
         {
@@ -1854,6 +2031,8 @@ void MythMainWindow::RegisterJump(const QString &destination,
             {
                 MythDB::DBError("Insert Jump Point", query);
             }
+
+            s_keyPrefetch.SetJump(destination, inskey);
         }
     }
 
@@ -66,6 +66,8 @@ class MUI_PUBLIC MythMainWindow : public QWidget
     void RegisterKey(const QString &context, const QString &action,
                      const QString &description, const QString &key);
     static QString GetKey(const QString &context, const QString &action);
+    static void PrefetchKeyBindings(void);
+    static void ClearPrefetchedKeyBindings(void);
     QString GetActionText(const QString &context, const QString &action) const;
 
     void ClearJump(const QString &destination);
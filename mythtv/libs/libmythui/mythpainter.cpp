@@ -15,17 +15,22 @@
 #include "mythfontproperties.h"
 #include "mythimage.h"
 #include "mythuianimation.h"    // UIEffects
+#include "mythuicachemanager.h"
 
 // Own header
 #include "mythpainter.h"
 
 MythPainter::MythPainter()
 {
-    SetMaximumCacheSizes(64, 48);
+    // Text and shapes are only drawn, and so evicted, on the UI thread
+    MythUICacheManager::GetCacheManager()->Register(MythUICacheManager::kPainter, this,
+        [this]() { return OldestCachedImage(); },
+        [this]() { return ExpireCachedImage(); }, false);
 }
 
 void MythPainter::Teardown(void)
 {
+    MythUICacheManager::GetCacheManager()->Unregister(MythUICacheManager::kPainter, this);
     ExpireImages(0);
 
     QMutexLocker locker(&m_allocationLock);
@@ -350,26 +355,14 @@ MythImage *MythPainter::GetImageFromString(const QString &msg,
                        QString::number(flags) +
                        QString::number(font.color().rgba()) + msg;
 
-    MythImage *im = nullptr;
-    if (m_stringToImageMap.contains(incoming))
-    {
-        m_stringExpireList.remove(incoming);
-        m_stringExpireList.push_back(incoming);
-        im = m_stringToImageMap[incoming];
-        if (im)
-            im->IncrRef();
-    }
-    else
+    MythImage *im = GetCachedImage(incoming);
+    if (!im)
     {
         im = GetFormatImage();
         im->SetFileName(QString("GetImageFromString: %1").arg(msg));
         DrawTextPriv(im, msg, flags, r, font);
 
-        im->IncrRef();
-        m_softwareCacheSize += im->bytesPerLine() * im->height();
-        m_stringToImageMap[incoming] = im;
-        m_stringExpireList.push_back(incoming);
-        ExpireImages(m_maxSoftwareCacheSize);
+        CacheImage(incoming, im);
     }
     return im;
 }
@@ -390,16 +383,8 @@ MythImage *MythPainter::GetImageFromTextLayout(const LayoutVector &layouts,
     foreach (auto layout, layouts)
         incoming += layout->text();
 
-    MythImage *im = nullptr;
-    if (m_stringToImageMap.contains(incoming))
-    {
-        m_stringExpireList.remove(incoming);
-        m_stringExpireList.push_back(incoming);
-        im = m_stringToImageMap[incoming];
-        if (im)
-            im->IncrRef();
-    }
-    else
+    MythImage *im = GetCachedImage(incoming);
+    if (!im)
     {
         im = GetFormatImage();
         im->SetFileName("GetImageFromTextLayout");
@@ -459,11 +444,7 @@ MythImage *MythPainter::GetImageFromTextLayout(const LayoutVector &layouts,
         pm.setOffset(canvas.topLeft());
         im->Assign(pm.copy(0, 0, dest.width(), dest.height()));
 
-        im->IncrRef();
-        m_softwareCacheSize += im->bytesPerLine() * im->height();
-        m_stringToImageMap[incoming] = im;
-        m_stringExpireList.push_back(incoming);
-        ExpireImages(m_maxSoftwareCacheSize);
+        CacheImage(incoming, im);
     }
     return im;
 }
@@ -509,26 +490,14 @@ MythImage* MythPainter::GetImageFromRect(const QRect &area, int radius,
 
     incoming += QString::number(hash1) + QString::number(hash2);
 
-    MythImage *im = nullptr;
-    if (m_stringToImageMap.contains(incoming))
-    {
-        m_stringExpireList.remove(incoming);
-        m_stringExpireList.push_back(incoming);
-        im = m_stringToImageMap[incoming];
-        if (im)
-            im->IncrRef();
-    }
-    else
+    MythImage *im = GetCachedImage(incoming);
+    if (!im)
     {
         im = GetFormatImage();
         im->SetFileName("GetImageFromRect");
         DrawRectPriv(im, area, radius, ellipse, fillBrush, linePen);
 
-        im->IncrRef();
-        m_softwareCacheSize += (im->bytesPerLine() * im->height());
-        m_stringToImageMap[incoming] = im;
-        m_stringExpireList.push_back(incoming);
-        ExpireImages(m_maxSoftwareCacheSize);
+        CacheImage(incoming, im);
     }
     return im;
 }
@@ -559,67 +528,91 @@ void MythPainter::CheckFormatImage(MythImage *im)
     }
 }
 
-void MythPainter::ExpireImages(int64_t max)
+/// \brief Return the cached image for Key, with a reference for the caller.
+MythImage *MythPainter::GetCachedImage(const QString &Key)
 {
-    bool recompute = false;
-    while (!m_stringExpireList.empty())
+    MythUICacheManager *cache = MythUICacheManager::GetCacheManager();
+
+    QMap<QString, MythImage*>::iterator it = m_stringToImageMap.find(Key);
+    if (it == m_stringToImageMap.end() || !*it)
     {
-        if (m_softwareCacheSize < max)
-            break;
+        cache->Miss(MythUICacheManager::kPainter);
+        return nullptr;
+    }
 
-        QString oldmsg = m_stringExpireList.front();
-        m_stringExpireList.pop_front();
+    quint64 &used = m_stringUsed[Key];
+    m_stringExpireList.remove(used);
+    used = cache->Touch();
+    m_stringExpireList.insert(used, Key);
 
-        QMap<QString, MythImage*>::iterator it =
-            m_stringToImageMap.find(oldmsg);
-        if (it == m_stringToImageMap.end())
-        {
-            recompute = true;
-            continue;
-        }
-        MythImage *oldim = *it;
-        it = m_stringToImageMap.erase(it);
+    cache->Hit(MythUICacheManager::kPainter);
+    (*it)->IncrRef();
+    return *it;
+}
 
-        if (oldim)
-        {
-            m_softwareCacheSize -= oldim->bytesPerLine() * oldim->height();
-            if (m_softwareCacheSize < 0)
-            {
-                m_softwareCacheSize = 0;
-                recompute = true;
-            }
-            oldim->DecrRef();
-        }
-    }
-    if (recompute)
-    {
-        m_softwareCacheSize = 0;
-        foreach (auto & img, m_stringToImageMap)
-            m_softwareCacheSize += img->bytesPerLine() * img->height();
-    }
+void MythPainter::CacheImage(const QString &Key, MythImage *Image)
+{
+    MythUICacheManager *cache = MythUICacheManager::GetCacheManager();
+
+    Image->IncrRef();
+    int64_t bytes = Image->bytesPerLine() * Image->height();
+    m_softwareCacheSize += bytes;
+    cache->AddBytes(MythUICacheManager::kPainter, bytes);
+
+    quint64 used = cache->Touch();
+    m_stringToImageMap[Key] = Image;
+    m_stringUsed[Key] = used;
+    m_stringExpireList.insert(used, Key);
+
+    cache->Balance();
 }
 
-// the following assume graphics hardware operates natively at 32bpp
-void MythPainter::SetMaximumCacheSizes(int hardware, int software)
+quint64 MythPainter::OldestCachedImage(void) const
 {
-    const int64_t kOneMeg = 1024 * 1024;
-    m_maxHardwareCacheSize = kOneMeg * hardware;
-    m_maxSoftwareCacheSize = kOneMeg * software;
+    return m_stringExpireList.isEmpty() ? 0 : m_stringExpireList.firstKey();
+}
 
-    bool err = false;
-    if (m_maxHardwareCacheSize < 0)
+/// \brief Remove the least recently used image.
+bool MythPainter::ExpireCachedImage(void)
+{
+    if (m_stringExpireList.isEmpty())
+        return false;
+
+    QString oldmsg = m_stringExpireList.take(m_stringExpireList.firstKey());
+    m_stringUsed.remove(oldmsg);
+
+    MythImage *oldim = m_stringToImageMap.take(oldmsg);
+    if (oldim)
     {
-        m_maxHardwareCacheSize = 0;
-        err = true;
+        int64_t bytes = oldim->bytesPerLine() * oldim->height();
+        m_softwareCacheSize -= bytes;
+        MythUICacheManager::GetCacheManager()->AddBytes(MythUICacheManager::kPainter,
+                                                        -bytes);
+        oldim->DecrRef();
     }
-    if (m_maxSoftwareCacheSize < 0)
+    return true;
+}
+
+void MythPainter::ExpireImages(int64_t max)
+{
+    while (m_softwareCacheSize >= max)
     {
-        m_maxSoftwareCacheSize = kOneMeg * 48;
-        err = true;
+        if (!ExpireCachedImage())
+            break;
     }
+}
 
-    LOG((err) ? VB_GENERAL : VB_GUI, (err) ? LOG_ERR : LOG_INFO,
-        QString("MythPainter cache sizes: Hardware %1MB, Software %2MB")
-        .arg(m_maxHardwareCacheSize / kOneMeg)
-        .arg(m_maxSoftwareCacheSize / kOneMeg));
+/// \brief Scale the automatic cache budget with the resolution in use.
+void MythPainter::SetCacheBudget(QSize ScreenSize)
+{
+    // Roughly what the separate image, text and texture caches allowed
+    static const int64_t kOneMeg    = 1024 * 1024;
+    static const int     kOneHD     = 1920 * 1080;
+    static const int64_t kImages    = 30 * kOneMeg;
+    static const int64_t kPerScreen = 160 * kOneMeg;
+
+    double hdscreens = (static_cast<double>(ScreenSize.width()) + 1) *
+                       ScreenSize.height() / kOneHD;
+    MythUICacheManager::GetCacheManager()->SetAutomaticBudget(
+        kImages + static_cast<int64_t>(qMax(hdscreens, 1.0) * kPerScreen));
 }
@@ -1,6 +1,7 @@
 #ifndef MYTHPAINTER_H_
 #define MYTHPAINTER_H_
 
+#include <QHash>
 #include <QMap>
 #include <QString>
 #include <QTextLayout>
@@ -96,7 +97,7 @@ class MUI_PUBLIC MythPainter
     bool ShowBorders(void) { return m_showBorders; }
     bool ShowTypeNames(void) { return m_showNames; }
 
-    void SetMaximumCacheSizes(int hardware, int software);
+    static void SetCacheBudget(QSize ScreenSize);
 
   protected:
     static void DrawTextPriv(MythImage *im, const QString &msg, int flags,
@@ -118,6 +119,8 @@ class MUI_PUBLIC MythPainter
     virtual MythImage* GetFormatImagePriv(void) = 0;
     virtual void DeleteFormatImagePriv(MythImage *im) = 0;
     void ExpireImages(int64_t max = 0);
+    MythImage *GetCachedImage(const QString &Key);
+    void CacheImage(const QString &Key, MythImage *Image);
 
     // This needs to be called by classes inheriting from MythPainter
     // in the destructor.
@@ -127,17 +130,19 @@ class MUI_PUBLIC MythPainter
 
     QPaintDevice *m_parent      {nullptr};
     int m_hardwareCacheSize     {0};
-    int m_maxHardwareCacheSize  {0};
 
   private:
+    quint64 OldestCachedImage(void) const;
+    bool ExpireCachedImage(void);
+
     int64_t m_softwareCacheSize {0};
-    int64_t m_maxSoftwareCacheSize {1024 * 1024 * 48};
 
     QMutex           m_allocationLock;
     QSet<MythImage*> m_allocatedImages;
 
     QMap<QString, MythImage *> m_stringToImageMap;
-    std::list<QString>         m_stringExpireList;
+    QHash<QString, quint64>    m_stringUsed;        ///< last use of each image
+    QMap<quint64, QString>     m_stringExpireList;  ///< images by last use
 
     bool m_showBorders          {false};
     bool m_showNames            {false};
@@ -0,0 +1,179 @@
+// Own header
+#include "mythtexttemplate.h"
+
+// The characters of a key, as matched by \w and # in the original expression
+static inline bool IsKeyChar(QChar c)
+{
+    return c.isLetterOrNumber() || c.isMark() || c == '_' || c == '#';
+}
+
+/// \brief Parse "KEY%" or "KEY|SUFFIX%" at Pos, returning the end or -1
+static int ParseKey(const QString &Template, int Pos, QString &Key, QString &Suffix)
+{
+    int end = Pos;
+    while (end < Template.size() && IsKeyChar(Template[end]))
+        ++end;
+    if (end == Pos || end >= Template.size())
+        return -1;
+
+    if (Template[end] == '%')
+    {
+        Key = Template.mid(Pos, end - Pos);
+        Suffix.clear();
+        return end + 1;
+    }
+
+    if (Template[end] != '|')
+        return -1;
+
+    // The suffix is at least one character, and may contain anything but %
+    int close = Template.indexOf('%', end + 2);
+    if (close < 0)
+        return -1;
+
+    Key = Template.mid(Pos, end - Pos);
+    Suffix = Template.mid(end + 1, close - end - 1);
+    return close + 1;
+}
+
+/** \fn MythTextTemplate::ParseField(const QString&, int, Token&)
+ *  \brief Parse the field that starts with the % at Start.
+ *
+ *   Where the text can be read as more than one form of field the shortest
+ *   one wins, then a "PREFIX|" over a "|c" prefix over no prefix at all, so
+ *   that "%|RATING| %" is the key RATING and not ATING.
+ *
+ *  \return the position after the closing %, or -1 if there is no field here
+ */
+int MythTextTemplate::ParseField(const QString &Template, int Start, Token &Field)
+{
+    int best = -1;
+    Token token;
+
+    // %PREFIX|KEY...
+    int bar = Start + 1;
+    while (bar < Template.size() && Template[bar] != '|' && Template[bar] != '%')
+        ++bar;
+    if (bar < Template.size() && Template[bar] == '|')
+    {
+        int end = ParseKey(Template, bar + 1, token.m_key, token.m_suffix);
+        if (end >= 0)
+        {
+            best = end;
+            token.m_text = Template.mid(Start + 1, bar - Start - 1);
+            Field = token;
+        }
+    }
+
+    // %|cKEY...
+    if (Start + 2 < Template.size() && Template[Start + 1] == '|')
+    {
+        int end = ParseKey(Template, Start + 3, token.m_key, token.m_suffix);
+        if (end >= 0 && (best < 0 || end < best))
+        {
+            best = end;
+            token.m_text = Template[Start + 2];
+            Field = token;
+        }
+    }
+
+    // %KEY...
+    int end = ParseKey(Template, Start + 1, token.m_key, token.m_suffix);
+    if (end >= 0 && (best < 0 || end < best))
+    {
+        best = end;
+        token.m_text.clear();
+        Field = token;
+    }
+
+    return best;
+}
+
+void MythTextTemplate::Compile(const QString &Template)
+{
+    m_tokens.clear();
+    m_literalSize = 0;
+    m_hasFields = false;
+
+    int literal = 0;
+    int pos = Template.indexOf('%');
+    while (pos >= 0)
+    {
+        Token field;
+        int end = ParseField(Template, pos, field);
+        if (end < 0)
+        {
+            pos = Template.indexOf('%', pos + 1);
+            continue;
+        }
+
+        if (pos > literal)
+        {
+            Token text;
+            text.m_text = Template.mid(literal, pos - literal);
+            m_literalSize += text.m_text.size();
+            m_tokens.append(text);
+        }
+
+        field.m_key = field.m_key.toLower();
+        m_tokens.append(field);
+        m_hasFields = true;
+
+        literal = end;
+        pos = Template.indexOf('%', end);
+    }
+
+    if (literal < Template.size())
+    {
+        Token text;
+        text.m_text = Template.mid(literal);
+        m_literalSize += text.m_text.size();
+        m_tokens.append(text);
+    }
+}
+
+/// \brief Whether any of the fields has a key in the map.
+bool MythTextTemplate::UsesAny(const InfoMap &Map) const
+{
+    for (const auto & token : m_tokens)
+        if (!token.m_key.isEmpty() && Map.contains(token.m_key))
+            return true;
+    return false;
+}
+
+/** \fn MythTextTemplate::Expand(const InfoMap&, QString&) const
+ *  \brief Fill in the fields from the map.
+ *
+ *  \return true if any of the fields has a key in the map, even if its value
+ *          is empty
+ */
+bool MythTextTemplate::Expand(const InfoMap &Map, QString &Result) const
+{
+    bool found = false;
+
+    Result.clear();
+    Result.reserve(m_literalSize + 64);
+
+    for (const auto & token : m_tokens)
+    {
+        if (token.m_key.isEmpty())
+        {
+            Result.append(token.m_text);
+            continue;
+        }
+
+        auto it = Map.constFind(token.m_key);
+        if (it == Map.constEnd())
+            continue;
+
+        found = true;
+        if (it->isEmpty())
+            continue;
+
+        Result.append(token.m_text);
+        Result.append(*it);
+        Result.append(token.m_suffix);
+    }
+
+    return found;
+}
@@ -0,0 +1,47 @@
+#ifndef MYTHTEXTTEMPLATE_H_
+#define MYTHTEXTTEMPLATE_H_
+
+#include <QString>
+#include <QVector>
+
+#include "mythtypes.h"
+#include "mythuiexp.h"
+
+/** \class MythTextTemplate
+ *  \brief A text template, such as "%TITLE%% - |SUBTITLE%", parsed once.
+ *
+ *   Fields take the form %KEY%, %PREFIX|KEY%, %KEY|SUFFIX% or
+ *   %PREFIX|KEY|SUFFIX%, where the prefix may also be a single character
+ *   written as %|cKEY%.  A field expands to its prefix, the value of the
+ *   lower case key in the map and its suffix, or to nothing if the value is
+ *   empty.  This is the syntax MythUIText used to match with a regular
+ *   expression on every update; compiling it to a list of literals and
+ *   fields once makes expansion a single pass of appends.
+ */
+class MUI_PUBLIC MythTextTemplate
+{
+  public:
+    MythTextTemplate() = default;
+    explicit MythTextTemplate(const QString &Template) { Compile(Template); }
+
+    void    Compile(const QString &Template);
+    bool    HasFields(void) const { return m_hasFields; }
+    bool    UsesAny(const InfoMap &Map) const;
+    bool    Expand(const InfoMap &Map, QString &Result) const;
+
+  private:
+    struct Token
+    {
+        QString m_text;    ///< the literal text, or the field prefix
+        QString m_key;     ///< empty for literal text
+        QString m_suffix;
+    };
+
+    static int ParseField(const QString &Template, int Start, Token &Field);
+
+    QVector<Token> m_tokens;
+    int            m_literalSize { 0 };
+    bool           m_hasFields   { false };
+};
+
+#endif
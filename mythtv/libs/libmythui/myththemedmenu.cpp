@@ -862,9 +862,8 @@ bool MythThemedMenu::findDepends(const QString &fileList)
         if (!filename.isEmpty() && filename.endsWith(".xml"))
             return true;
 
-        // Has plugin by this name been successfully loaded
-        MythPlugin *plugin = pluginManager->GetPlugin(file);
-        if (plugin)
+        // Has plugin by this name been found, without initialising it
+        if (pluginManager && pluginManager->IsAvailable(file))
             return true;
     }
 
@@ -113,6 +113,8 @@ void MythUIButtonList::SetActive(bool active)
 void MythUIButtonList::Reset()
 {
     m_ButtonToItem.clear();
+    m_provider = nullptr;
+    m_providedItems.clear();
 
     if (m_itemList.isEmpty())
         return;
@@ -205,7 +207,7 @@ MythUIGroup *MythUIButtonList::PrepareButton(int buttonIdx, int itemIdx,
                                              int &selectedIdx,
                                              int &button_shift)
 {
-    MythUIButtonListItem *buttonItem = m_itemList[itemIdx];
+    MythUIButtonListItem *buttonItem = ItemAt(itemIdx);
 
     buttonIdx += button_shift;
 
@@ -1309,8 +1311,7 @@ void MythUIButtonList::CalculateButtonPositions(void)
         }
     }
 
-    QList<MythUIButtonListItem *>::iterator it = m_itemList.begin() +
-                                                 m_topPosition;
+    int curItem = m_topPosition;
 
     if (m_scrollStyle == ScrollCenter || m_scrollStyle == ScrollGroupCenter)
     {
@@ -1321,13 +1322,13 @@ void MythUIButtonList::CalculateButtonPositions(void)
             if (m_wrapStyle == WrapItems && button > 0 &&
                 m_itemCount >= (int)m_itemsVisible)
             {
-                it = m_itemList.end() - button;
+                curItem = m_itemList.size() - button;
                 button = 0;
             }
         }
         else if ((m_itemCount - m_selPosition) < (int)(m_itemsVisible / 2))
         {
-            it = m_itemList.begin() + m_selPosition - (m_itemsVisible / 2);
+            curItem = m_selPosition - (m_itemsVisible / 2);
         }
     }
     else if (m_drawFromBottom && m_itemCount < (int)m_itemsVisible)
@@ -1341,15 +1342,13 @@ void MythUIButtonList::CalculateButtonPositions(void)
     MythUIStateType *realButton = nullptr;
     MythUIButtonListItem *buttonItem = nullptr;
 
-    if (it < m_itemList.begin())
-        it = m_itemList.begin();
+    if (curItem < 0)
+        curItem = 0;
 
-    int curItem = it < m_itemList.end() ? GetItemPos(*it) : 0;
-
-    while (it < m_itemList.end() && button < (int)m_itemsVisible)
+    while (curItem < m_itemList.size() && button < (int)m_itemsVisible)
     {
         realButton = m_ButtonList[button];
-        buttonItem = *it;
+        buttonItem = ItemAt(curItem);
 
         if (!realButton || !buttonItem)
             break;
@@ -1366,15 +1365,13 @@ void MythUIButtonList::CalculateButtonPositions(void)
         buttonItem->SetToRealButton(realButton, selected);
         realButton->SetVisible(true);
 
-        if (m_wrapStyle == WrapItems && it == (m_itemList.end() - 1) &&
+        if (m_wrapStyle == WrapItems && curItem == m_itemList.size() - 1 &&
             m_itemCount >= (int)m_itemsVisible)
         {
-            it = m_itemList.begin();
             curItem = 0;
         }
         else
         {
-            ++it;
             ++curItem;
         }
 
@@ -1424,6 +1421,7 @@ void MythUIButtonList::CalculateArrowStates()
     else
         DistributeButtons();
 
+    ReleaseProvidedItems();
     updateLCD();
 
     m_needsUpdate = false;
@@ -1453,6 +1451,130 @@ void MythUIButtonList::CalculateArrowStates()
     }
 }
 
+/** \fn MythUIButtonList::SetProvider(MythUIButtonListProvider*, int)
+ *  \brief Show the items of a provider instead of items added to the list.
+ *
+ *   Items are only created, and filled in by the provider, when the list
+ *   needs them, which is normally for the buttons on screen.  Once they are
+ *   more than Margin positions from the visible buttons they are deleted
+ *   again, so memory use and the time to show the list do not depend on the
+ *   number of items.
+ *
+ *   Item pointers are therefore only valid until the list is next drawn,
+ *   except for the current item.  Positions, and the data of each item,
+ *   should be used to refer to items instead.  Check state changes are
+ *   passed on to the provider, and SetValueByData() and GetItemByData()
+ *   ask it for the position, so neither depends on items that may since
+ *   have been deleted.  Anything else a screen changes on an item is lost
+ *   when the item is, so it should change the provider's data and call
+ *   ProviderChanged() instead.
+ *
+ *   The list does not own the provider.  Call ProviderChanged() when the
+ *   provider's items change, and Reset() to go back to a normal list.
+ */
+void MythUIButtonList::SetProvider(MythUIButtonListProvider *provider, int margin)
+{
+    Reset();
+
+    m_provider       = provider;
+    m_providerMargin = qMax(margin, 0);
+    ProviderChanged();
+}
+
+/** \fn MythUIButtonList::ProviderChanged(void)
+ *  \brief Drop the provided items and read the number of items again.
+ *
+ *   The current position is kept where possible.
+ */
+void MythUIButtonList::ProviderChanged(void)
+{
+    if (!m_provider)
+        return;
+
+    m_ButtonToItem.clear();
+    m_clearing = true;
+    for (int pos : qAsConst(m_providedItems))
+        delete m_itemList[pos];
+    m_providedItems.clear();
+    m_clearing = false;
+
+    int count = qMax(m_provider->GetItemCount(), 0);
+    m_itemList.clear();
+    m_itemList.reserve(count);
+    for (int i = 0; i < count; ++i)
+        m_itemList.append(nullptr);
+    m_itemCount = count;
+
+    if (count == 0)
+        m_selPosition = m_topPosition = 0;
+    else
+        SanitizePosition();
+    m_topPosition = qMax(qMin(m_topPosition, m_selPosition), 0);
+
+    Update();
+    emit itemSelected(GetItemCurrent());
+    emit DependChanged(IsEmpty());
+}
+
+/// \brief Return the item at pos, asking the provider for it if necessary.
+MythUIButtonListItem *MythUIButtonList::ItemAt(int pos) const
+{
+    MythUIButtonListItem *item = m_itemList.at(pos);
+    if (item || !m_provider)
+        return item;
+
+    // Creating items on demand does not change what the list shows
+    auto *self = const_cast<MythUIButtonList*>(this);
+    self->m_providerInsertPos = pos;
+    item = new MythUIButtonListItem(self, QString());
+    self->m_providerInsertPos = -1;
+    self->m_providedItems.insert(pos);
+    self->m_providerFilling = true;
+    m_provider->FillItem(item, pos);
+    self->m_providerFilling = false;
+    return item;
+}
+
+/// \brief Pass a provided item's new check state on to the provider.
+void MythUIButtonList::ItemChecked(MythUIButtonListItem *item)
+{
+    // While the item is filled in the provider already knows the state
+    if (!m_provider || m_providerFilling)
+        return;
+
+    int pos = m_itemList.indexOf(item);
+    if (pos >= 0)
+        m_provider->SetItemChecked(pos, item->state());
+}
+
+/// \brief Delete provided items that are well away from the visible buttons.
+void MythUIButtonList::ReleaseProvidedItems(void)
+{
+    if (!m_provider || m_providedItems.size() <= (int)m_itemsVisible + 2 * m_providerMargin)
+        return;
+
+    int first = m_topPosition - m_providerMargin;
+    int last  = m_topPosition + (int)m_itemsVisible + m_providerMargin;
+    QList<MythUIButtonListItem*> visible = m_ButtonToItem.values();
+
+    m_clearing = true;
+    for (auto it = m_providedItems.begin(); it != m_providedItems.end(); )
+    {
+        int pos = *it;
+        MythUIButtonListItem *item = m_itemList[pos];
+        if ((pos >= first && pos <= last) || pos == m_selPosition ||
+            visible.contains(item))
+        {
+            ++it;
+            continue;
+        }
+        m_itemList[pos] = nullptr;
+        delete item;
+        it = m_providedItems.erase(it);
+    }
+    m_clearing = false;
+}
+
 void MythUIButtonList::ItemVisible(MythUIButtonListItem *item)
 {
     if (item)
@@ -1461,6 +1583,13 @@ void MythUIButtonList::ItemVisible(MythUIButtonListItem *item)
 
 void MythUIButtonList::InsertItem(MythUIButtonListItem *item, int listPosition)
 {
+    // An item being created for the provider already has its place
+    if (m_providerInsertPos >= 0)
+    {
+        m_itemList[m_providerInsertPos] = item;
+        return;
+    }
+
     bool wasEmpty = m_itemList.isEmpty();
 
     if (listPosition >= 0 && listPosition <= m_itemList.count())
@@ -1498,6 +1627,16 @@ void MythUIButtonList::RemoveItem(MythUIButtonListItem *item)
     if (curIndex == -1)
         return;
 
+    // A provided item is just forgotten, and will be created again if needed
+    if (m_provider)
+    {
+        m_itemList[curIndex] = nullptr;
+        m_providedItems.remove(curIndex);
+        m_ButtonToItem.clear();
+        Update();
+        return;
+    }
+
     QMap<int, MythUIButtonListItem*>::iterator it = m_ButtonToItem.begin();
     while (it != m_ButtonToItem.end())
     {
@@ -1534,7 +1673,7 @@ void MythUIButtonList::RemoveItem(MythUIButtonListItem *item)
     Update();
 
     if (m_selPosition < m_itemCount)
-        emit itemSelected(m_itemList.at(m_selPosition));
+        emit itemSelected(ItemAt(m_selPosition));
     else
         emit itemSelected(nullptr);
 
@@ -1547,11 +1686,17 @@ void MythUIButtonList::SetValueByData(const QVariant& data)
     if (!m_initialized)
         Init();
 
-    foreach (auto item, m_itemList)
+    if (m_provider)
     {
-        if (item->GetData() == data)
+        SetItemCurrent(m_provider->GetItemPos(data));
+        return;
+    }
+
+    for (int i = 0; i < m_itemList.size(); ++i)
+    {
+        if (ItemAt(i)->GetData() == data)
         {
-            SetItemCurrent(item);
+            SetItemCurrent(i);
             return;
         }
     }
@@ -1571,7 +1716,7 @@ void MythUIButtonList::SetItemCurrent(int current, int topPosition)
     if (current == -1 || current >= m_itemList.size())
         return;
 
-    if (!m_itemList.at(current)->isEnabled())
+    if (!ItemAt(current)->isEnabled())
         return;
 
     if (current == m_selPosition &&
@@ -1596,7 +1741,7 @@ MythUIButtonListItem *MythUIButtonList::GetItemCurrent() const
         m_selPosition < 0)
         return nullptr;
 
-    return m_itemList.at(m_selPosition);
+    return ItemAt(m_selPosition);
 }
 
 int MythUIButtonList::GetIntValue() const
@@ -1639,7 +1784,7 @@ MythRect MythUIButtonList::GetButtonArea(void) const
 MythUIButtonListItem *MythUIButtonList::GetItemFirst() const
 {
     if (!m_itemList.empty())
-        return m_itemList[0];
+        return ItemAt(0);
 
     return nullptr;
 }
@@ -1681,7 +1826,7 @@ MythUIButtonListItem *MythUIButtonList::GetItemAt(int pos) const
     if (pos < 0 || pos >= m_itemList.size())
         return nullptr;
 
-    return m_itemList.at(pos);
+    return ItemAt(pos);
 }
 
 MythUIButtonListItem *MythUIButtonList::GetItemByData(const QVariant& data)
@@ -1689,8 +1834,12 @@ MythUIButtonListItem *MythUIButtonList::GetItemByData(const QVariant& data)
     if (!m_initialized)
         Init();
 
-    foreach (auto item, m_itemList)
+    if (m_provider)
+        return GetItemAt(m_provider->GetItemPos(data));
+
+    for (int i = 0; i < m_itemList.size(); ++i)
     {
+        MythUIButtonListItem *item = ItemAt(i);
         if (item->GetData() == data)
             return item;
     }
@@ -1709,7 +1858,7 @@ int MythUIButtonList::GetItemPos(MythUIButtonListItem *item) const
 void MythUIButtonList::InitButton(int itemIdx, MythUIStateType* & realButton,
                                   MythUIButtonListItem* & buttonItem)
 {
-    buttonItem = m_itemList[itemIdx];
+    buttonItem = ItemAt(itemIdx);
 
     if (m_maxVisible == 0)
     {
@@ -2075,7 +2224,7 @@ bool MythUIButtonList::MoveUp(MovementUnit unit, uint amount)
 void MythUIButtonList::FindEnabledDown(MovementUnit unit)
 {
     if (m_selPosition < 0 || m_selPosition >= m_itemList.size() ||
-        m_itemList.at(m_selPosition)->isEnabled())
+        ItemAt(m_selPosition)->isEnabled())
         return;
 
     int step = (unit == MoveRow) ? m_columns : 1;
@@ -2085,32 +2234,32 @@ void MythUIButtonList::FindEnabledDown(MovementUnit unit)
     {
         while (m_selPosition < m_itemList.size() &&
                (m_selPosition + 1) % m_columns > 0 &&
-               !m_itemList.at(m_selPosition)->isEnabled())
+               !ItemAt(m_selPosition)->isEnabled())
             ++m_selPosition;
 
-        if (m_itemList.at(m_selPosition)->isEnabled())
+        if (ItemAt(m_selPosition)->isEnabled())
             return;
 
         if (m_wrapStyle > WrapNone)
         {
             m_selPosition = m_selPosition - (m_columns - 1);
             while ((m_selPosition + 1) % m_columns > 0 &&
-                   !m_itemList.at(m_selPosition)->isEnabled())
+                   !ItemAt(m_selPosition)->isEnabled())
                 ++m_selPosition;
         }
     }
     else
     {
-        while (!m_itemList.at(m_selPosition)->isEnabled() &&
+        while (!ItemAt(m_selPosition)->isEnabled() &&
                (m_selPosition < m_itemList.size() - step))
             m_selPosition += step;
 
-        if (!m_itemList.at(m_selPosition)->isEnabled() &&
+        if (!ItemAt(m_selPosition)->isEnabled() &&
             m_wrapStyle > WrapNone)
         {
             m_selPosition = (m_selPosition + step) % m_itemList.size();
 
-            while (!m_itemList.at(m_selPosition)->isEnabled() &&
+            while (!ItemAt(m_selPosition)->isEnabled() &&
                    (m_selPosition < m_itemList.size() - step))
                 m_selPosition += step;
         }
@@ -2120,7 +2269,7 @@ void MythUIButtonList::FindEnabledDown(MovementUnit unit)
 void MythUIButtonList::FindEnabledUp(MovementUnit unit)
 {
     if (m_selPosition < 0 || m_selPosition >= m_itemList.size() ||
-        m_itemList.at(m_selPosition)->isEnabled())
+        ItemAt(m_selPosition)->isEnabled())
         return;
 
     int step = (unit == MoveRow) ? m_columns : 1;
@@ -2129,33 +2278,33 @@ void MythUIButtonList::FindEnabledUp(MovementUnit unit)
     if (unit == MoveColumn)
     {
         while (m_selPosition > 0 && (m_selPosition - 1) % m_columns > 0 &&
-               !m_itemList.at(m_selPosition)->isEnabled())
+               !ItemAt(m_selPosition)->isEnabled())
             --m_selPosition;
 
-        if (m_itemList.at(m_selPosition)->isEnabled())
+        if (ItemAt(m_selPosition)->isEnabled())
             return;
 
         if (m_wrapStyle > WrapNone)
         {
             m_selPosition = m_selPosition + (m_columns - 1);
             while ((m_selPosition - 1) % m_columns > 0 &&
-                   !m_itemList.at(m_selPosition)->isEnabled())
+                   !ItemAt(m_selPosition)->isEnabled())
                 --m_selPosition;
         }
     }
     else
     {
-        while (!m_itemList.at(m_selPosition)->isEnabled() &&
+        while (!ItemAt(m_selPosition)->isEnabled() &&
                (m_selPosition - step >= 0))
             m_selPosition -= step;
 
-        if (!m_itemList.at(m_selPosition)->isEnabled() &&
+        if (!ItemAt(m_selPosition)->isEnabled() &&
             m_wrapStyle > WrapNone)
         {
             m_selPosition = m_itemList.size() - 1;
 
             while (m_selPosition > 0 &&
-                   !m_itemList.at(m_selPosition)->isEnabled() &&
+                   !ItemAt(m_selPosition)->isEnabled() &&
                    (m_selPosition - step >= 0))
                 m_selPosition -= step;
         }
@@ -2292,17 +2441,14 @@ bool MythUIButtonList::MoveToNamedPosition(const QString &position_name)
 
     bool found_it = false;
     int selectedPosition = 0;
-    QList<MythUIButtonListItem *>::iterator it = m_itemList.begin();
-
-    while (it != m_itemList.end())
+    while (selectedPosition < m_itemList.size())
     {
-        if ((*it)->GetText() == position_name)
+        if (ItemAt(selectedPosition)->GetText() == position_name)
         {
             found_it = true;
             break;
         }
 
-        ++it;
         ++selectedPosition;
     }
 
@@ -2315,7 +2461,7 @@ bool MythUIButtonList::MoveToNamedPosition(const QString &position_name)
 
 bool MythUIButtonList::MoveItemUpDown(MythUIButtonListItem *item, bool up)
 {
-    if (GetItemCurrent() != item)
+    if (m_provider || GetItemCurrent() != item)
         return false;
 
     if (item == m_itemList.first() && up)
@@ -2337,7 +2483,7 @@ bool MythUIButtonList::MoveItemUpDown(MythUIButtonListItem *item, bool up)
         else
             ++m_selPosition;
 
-        if (item == m_itemList.at(m_topPosition))
+        if (item == ItemAt(m_topPosition))
             ++m_topPosition;
     }
     else
@@ -2361,10 +2507,20 @@ bool MythUIButtonList::MoveItemUpDown(MythUIButtonListItem *item, bool up)
 
 void MythUIButtonList::SetAllChecked(MythUIButtonListItem::CheckState state)
 {
-    QMutableListIterator<MythUIButtonListItem *> it(m_itemList);
+    if (m_provider)
+    {
+        // Only the items that exist need changing, the provider fills in
+        // the rest as they are created
+        m_provider->SetAllChecked(state);
+        m_providerFilling = true;
+        for (int pos : qAsConst(m_providedItems))
+            m_itemList[pos]->setChecked(state);
+        m_providerFilling = false;
+        return;
+    }
 
-    while (it.hasNext())
-        it.next()->setChecked(state);
+    for (int i = 0; i < m_itemList.size(); ++i)
+        ItemAt(i)->setChecked(state);
 }
 
 void MythUIButtonList::Init()
@@ -3551,8 +3707,12 @@ void MythUIButtonListItem::setChecked(MythUIButtonListItem::CheckState state)
 
     m_state = state;
 
-    if (m_parent && m_isVisible)
-        m_parent->Update();
+    if (m_parent)
+    {
+        m_parent->ItemChecked(this);
+        if (m_isVisible)
+            m_parent->Update();
+    }
 }
 
 void MythUIButtonListItem::setCheckable(bool flag)
@@ -6,6 +6,7 @@
 // Qt headers
 #include <QHash>
 #include <QList>
+#include <QSet>
 #include <QString>
 #include <QVariant>
 
@@ -131,6 +132,41 @@ class MUI_PUBLIC MythUIButtonListItem
     friend class MythGenericTree;
 };
 
+/**
+ * \class MythUIButtonListProvider
+ *
+ * \brief Supplies the items of a MythUIButtonList as they are needed, so
+ *        that very long lists do not have to be built up front.
+ *
+ * Items are deleted again once they scroll well out of view, so the
+ * provider, not the item, holds the state of each position.  FillItem()
+ * must set everything the item shows, including its check state.
+ *
+ * \sa MythUIButtonList::SetProvider()
+ */
+class MUI_PUBLIC MythUIButtonListProvider
+{
+  public:
+    virtual ~MythUIButtonListProvider() = default;
+
+    /// The number of items in the list
+    virtual int  GetItemCount(void) const = 0;
+    /// Fill in the text, images, states and data of the item at a position
+    virtual void FillItem(MythUIButtonListItem *item, int pos) = 0;
+    /// The position of the item with this data, or -1 if there is none
+    virtual int  GetItemPos(const QVariant &data) const = 0;
+    /// Remember the check state of the item at a position.  Only lists
+    /// with checkable items need to implement this.
+    virtual void SetItemChecked(int /*pos*/,
+                                MythUIButtonListItem::CheckState /*state*/) {}
+    /// Remember the check state of every item
+    virtual void SetAllChecked(MythUIButtonListItem::CheckState state)
+    {
+        for (int pos = 0; pos < GetItemCount(); ++pos)
+            SetItemChecked(pos, state);
+    }
+};
+
 /**
  * \class MythUIButtonList
  *
@@ -212,6 +248,9 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     void LoadInBackground(int start = 0, int pageSize = 20);
     int  StopLoad(void);
 
+    void SetProvider(MythUIButtonListProvider *provider, int margin = 10);
+    void ProviderChanged(void);
+
   public slots:
     void Select();
     void Deselect();
@@ -235,6 +274,9 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     virtual void Init();
 
     void InsertItem(MythUIButtonListItem *item, int listPosition = -1);
+    MythUIButtonListItem *ItemAt(int pos) const;
+    void ReleaseProvidedItems(void);
+    void ItemChecked(MythUIButtonListItem *item);
 
     int minButtonWidth(const MythRect & area);
     int minButtonHeight(const MythRect & area);
@@ -339,6 +381,12 @@ class MUI_PUBLIC MythUIButtonList : public MythUIType
     QList<MythUIButtonListItem*> m_itemList;
     int m_nextItemLoaded              {0};
 
+    MythUIButtonListProvider *m_provider {nullptr};
+    int m_providerMargin              {10};
+    int m_providerInsertPos           {-1};
+    bool m_providerFilling            {false};
+    QSet<int> m_providedItems;
+
     bool m_drawFromBottom             {false};
 
     QString     m_lcdTitle;
@@ -0,0 +1,266 @@
+// Qt
+#include <QFile>
+#include <QStringList>
+
+// MythTV
+#include "mythcorecontext.h"
+#include "mythlogging.h"
+#include "mythmiscutil.h"
+
+// MythUI
+#include "mythuicachemanager.h"
+
+#define LOC QString("UICache: ")
+
+static const qint64 kOneMeg          = 1024 * 1024;
+static const qint64 kMinimumBudget   = 16 * kOneMeg;
+static const int    kLowMemoryMB     = 64;
+static const int    kEnoughMemoryMB  = 128;
+static const int    kPressureCheckMs = 5000;
+static const int    kStatsLogMs      = 60000;
+
+/// \brief Memory available to new allocations, in MB, or -1 if unknown.
+static int AvailableMemoryMB(void)
+{
+#ifdef __linux__
+    // Free memory from sysinfo() does not include the page cache, which the
+    // kernel will give up as needed, so it is low on any busy system
+    QFile meminfo("/proc/meminfo");
+    if (meminfo.open(QIODevice::ReadOnly))
+    {
+        QByteArray line;
+        while (!(line = meminfo.readLine()).isEmpty())
+        {
+            if (line.startsWith("MemAvailable:"))
+            {
+                QList<QByteArray> fields = line.simplified().split(' ');
+                if (fields.size() >= 2)
+                    return static_cast<int>(fields[1].toLongLong() / 1024);
+            }
+        }
+    }
+#endif
+    int totalMB = 0;
+    int freeMB = 0;
+    int totalVM = 0;
+    int freeVM = 0;
+    if (getMemStats(totalMB, freeMB, totalVM, freeVM))
+        return freeMB;
+    return -1;
+}
+
+MythUICacheManager* MythUICacheManager::GetCacheManager(void)
+{
+    static MythUICacheManager s_manager;
+    return &s_manager;
+}
+
+/** \fn MythUICacheManager::Register(Pool, const void*, const OldestFunc&, const EvictFunc&, bool)
+ *  \brief Let Balance() evict entries from a cache.
+ *
+ *   If AnyThread is false the cache is only evicted when Balance() is called
+ *   from the UI thread.  Owner is only used to match the call to Unregister.
+ */
+void MythUICacheManager::Register(Pool Which, const void *Owner,
+                                  const OldestFunc &Oldest,
+                                  const EvictFunc &Evict, bool AnyThread)
+{
+    QMutexLocker locker(&m_lock);
+    m_pools[Which].m_owner     = Owner;
+    m_pools[Which].m_oldest    = Oldest;
+    m_pools[Which].m_evict     = Evict;
+    m_pools[Which].m_anyThread = AnyThread;
+}
+
+void MythUICacheManager::Unregister(Pool Which, const void *Owner)
+{
+    QMutexLocker locker(&m_lock);
+    if (m_pools[Which].m_owner == Owner)
+        m_pools[Which] = Callbacks();
+}
+
+void MythUICacheManager::AddBytes(Pool Which, qint64 Bytes)
+{
+    m_bytes[Which].fetchAndAddOrdered(Bytes);
+    m_used.fetchAndAddOrdered(Bytes);
+}
+
+/// \brief Use a fixed budget, or the automatic one if Bytes is 0.
+void MythUICacheManager::SetBudget(qint64 Bytes)
+{
+    QMutexLocker locker(&m_lock);
+    m_budget = Bytes;
+    m_limit = 0;
+    LOG(VB_GUI, LOG_INFO, LOC + QString("Budget %1MB%2")
+        .arg((m_budget ? m_budget : m_automaticBudget) / kOneMeg)
+        .arg(m_budget ? "" : " (automatic)"));
+}
+
+/// \brief Set the budget used when there is no UICacheBudget setting.
+void MythUICacheManager::SetAutomaticBudget(qint64 Bytes)
+{
+    QMutexLocker locker(&m_lock);
+    m_automaticBudget = qMax(Bytes, kMinimumBudget);
+    m_limit = 0;
+    if (!m_budget)
+    {
+        LOG(VB_GUI, LOG_INFO, LOC + QString("Budget %1MB (automatic)")
+            .arg(m_automaticBudget / kOneMeg));
+    }
+}
+
+/** \fn MythUICacheManager::LimitBudget(qint64)
+ *  \brief Keep the budget below Bytes, e.g. after the GPU ran out of memory.
+ *
+ *   The limit holds until the budget is next set.
+ */
+void MythUICacheManager::LimitBudget(qint64 Bytes)
+{
+    QMutexLocker locker(&m_lock);
+    m_limit = qMax(Bytes, kMinimumBudget);
+    LOG(VB_GENERAL, LOG_NOTICE, LOC + QString("Limiting budget to %1MB")
+        .arg(m_limit / kOneMeg));
+}
+
+qint64 MythUICacheManager::GetBudget(void) const
+{
+    QMutexLocker locker(&m_lock);
+    qint64 budget = m_budget ? m_budget : m_automaticBudget;
+    if (m_limit)
+        budget = qMin(budget, m_limit);
+    if (m_pressureLimit)
+        budget = qMin(budget, m_pressureLimit);
+    return budget;
+}
+
+/** \fn MythUICacheManager::Balance(void)
+ *  \brief Evict the least recently used entries until the caches fit.
+ *
+ *   Away from the UI thread only the caches that allow it are evicted, and
+ *   only once they are well over the budget, so that the choice of what to
+ *   evict is normally made with every cache taking part.
+ */
+void MythUICacheManager::Balance(void)
+{
+    bool uithread = gCoreContext->IsUIThread();
+    if (uithread)
+    {
+        CheckMemoryPressure();
+        if (!m_statsTimer.isValid() || m_statsTimer.elapsed() > kStatsLogMs)
+        {
+            m_statsTimer.start();
+            LOG(VB_GUI, LOG_DEBUG, LOC + GetStatsString());
+        }
+    }
+
+    qint64 budget = GetBudget();
+    if (!uithread)
+        budget += budget / 4;
+    if (GetUsed() <= budget)
+        return;
+
+    std::array<Callbacks,kPoolCount> pools;
+    {
+        QMutexLocker locker(&m_lock);
+        pools = m_pools;
+    }
+
+    std::array<bool,kPoolCount> blocked {};
+    for (int i = 0; i < kPoolCount; ++i)
+        blocked[i] = !pools[i].m_evict || !(pools[i].m_anyThread || uithread);
+
+    while (GetUsed() > budget)
+    {
+        int victim = -1;
+        quint64 oldest = 0;
+        for (int i = 0; i < kPoolCount; ++i)
+        {
+            if (blocked[i])
+                continue;
+            quint64 stamp = pools[i].m_oldest();
+            if (!stamp)
+                blocked[i] = true;
+            else if (victim < 0 || stamp < oldest)
+            {
+                victim = i;
+                oldest = stamp;
+            }
+        }
+
+        if (victim < 0)
+            break;
+
+        if (pools[victim].m_evict())
+            Evicted(static_cast<Pool>(victim));
+        else
+            blocked[victim] = true;
+    }
+}
+
+/// \brief Reduce the budget while the system is short of memory.
+void MythUICacheManager::CheckMemoryPressure(void)
+{
+    if (m_pressureTimer.isValid() && m_pressureTimer.elapsed() < kPressureCheckMs)
+        return;
+    m_pressureTimer.start();
+
+    int available = AvailableMemoryMB();
+    if (available < 0)
+        return;
+
+    QMutexLocker locker(&m_lock);
+    if (available < kLowMemoryMB)
+    {
+        // Keep shrinking for as long as the pressure lasts
+        qint64 limit = qMax((GetUsed() * 3) / 4, kMinimumBudget);
+        if (!m_pressureLimit || limit < m_pressureLimit)
+        {
+            m_pressureLimit = limit;
+            LOG(VB_GUI, LOG_NOTICE, LOC +
+                QString("%1MB of memory available, reducing budget to %2MB")
+                .arg(available).arg(m_pressureLimit / kOneMeg));
+        }
+    }
+    else if (m_pressureLimit && available > kEnoughMemoryMB)
+    {
+        m_pressureLimit = 0;
+        LOG(VB_GUI, LOG_INFO, LOC +
+            QString("%1MB of memory available, restoring budget").arg(available));
+    }
+}
+
+MythUICacheManager::Stats MythUICacheManager::GetStats(Pool Which) const
+{
+    Stats stats;
+    stats.m_bytes     = m_bytes[Which].loadAcquire();
+    stats.m_hits      = m_hits[Which].loadAcquire();
+    stats.m_misses    = m_misses[Which].loadAcquire();
+    stats.m_evictions = m_evictions[Which].loadAcquire();
+    return stats;
+}
+
+QString MythUICacheManager::GetStatsString(void) const
+{
+    QStringList pools;
+    for (int i = 0; i < kPoolCount; ++i)
+    {
+        Stats stats = GetStats(static_cast<Pool>(i));
+        pools << QString("%1 %2KB, %3 hits, %4 misses, %5 evictions")
+            .arg(PoolName(static_cast<Pool>(i))).arg(stats.m_bytes / 1024)
+            .arg(stats.m_hits).arg(stats.m_misses).arg(stats.m_evictions);
+    }
+    return QString("%1KB of %2KB used. ").arg(GetUsed() / 1024)
+        .arg(GetBudget() / 1024) + pools.join("; ");
+}
+
+const char* MythUICacheManager::PoolName(Pool Which)
+{
+    switch (Which)
+    {
+        case kImages:   return "images";
+        case kPainter:  return "painter";
+        case kTextures: return "textures";
+        default:        break;
+    }
+    return "unknown";
+}
@@ -0,0 +1,113 @@
+#ifndef MYTHUICACHEMANAGER_H_
+#define MYTHUICACHEMANAGER_H_
+
+// C++
+#include <array>
+#include <functional>
+
+// Qt
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QString>
+
+// MythTV
+#include "mythuiexp.h"
+
+/** \class MythUICacheManager
+ *  \brief One memory budget for the image caches of the UI.
+ *
+ *   Decoded images in MythUIHelper, rendered text and shapes in MythPainter
+ *   and textures in the GPU painters used to be limited separately, so each
+ *   could fill its own limit while the others held images that had not been
+ *   drawn for minutes.  The caches now report their size here and stamp each
+ *   entry with Touch() when it is used.  When the total is over the budget the
+ *   entry with the oldest stamp is evicted, whichever cache holds it.
+ *
+ *   The budget is the UICacheBudget setting in MB, or scales with the screen
+ *   size if that is 0.  It is reduced while the system is short of memory.
+ *
+ *   Caches that are only safe to use from the UI thread are only evicted when
+ *   Balance() is called there, which each cache does as it adds an entry.
+ */
+class MUI_PUBLIC MythUICacheManager
+{
+  public:
+    enum Pool
+    {
+        kImages   = 0,  ///< decoded images, MythUIHelper
+        kPainter  = 1,  ///< rendered text and shapes, MythPainter
+        kTextures = 2,  ///< textures, MythOpenGLPainter
+        kPoolCount
+    };
+
+    struct Stats
+    {
+        qint64  m_bytes     { 0 };
+        quint64 m_hits      { 0 };
+        quint64 m_misses    { 0 };
+        quint64 m_evictions { 0 };
+    };
+
+    /// Return the oldest stamp of an entry that can be evicted, 0 if none
+    using OldestFunc = std::function<quint64(void)>;
+    /// Evict the entry with the oldest stamp, false if there is none
+    using EvictFunc  = std::function<bool(void)>;
+
+    static MythUICacheManager* GetCacheManager(void);
+
+    void    Register(Pool Which, const void *Owner, const OldestFunc &Oldest,
+                     const EvictFunc &Evict, bool AnyThread);
+    void    Unregister(Pool Which, const void *Owner);
+
+    quint64 Touch(void) { return static_cast<quint64>(++m_clock); }
+    void    AddBytes(Pool Which, qint64 Bytes);
+    void    Hit(Pool Which)     { ++m_hits[Which]; }
+    void    Miss(Pool Which)    { ++m_misses[Which]; }
+    void    Evicted(Pool Which) { ++m_evictions[Which]; }
+
+    void    SetBudget(qint64 Bytes);
+    void    SetAutomaticBudget(qint64 Bytes);
+    void    LimitBudget(qint64 Bytes);
+    qint64  GetBudget(void) const;
+    qint64  GetUsed(void) const { return m_used.loadAcquire(); }
+    bool    IsOverBudget(void) const { return GetUsed() > GetBudget(); }
+
+    void    Balance(void);
+    Stats   GetStats(Pool Which) const;
+    QString GetStatsString(void) const;
+
+    static const char* PoolName(Pool Which);
+
+  private:
+    MythUICacheManager() = default;
+    Q_DISABLE_COPY(MythUICacheManager)
+
+    void    CheckMemoryPressure(void);
+
+    struct Callbacks
+    {
+        const void *m_owner    { nullptr };
+        OldestFunc m_oldest    { nullptr };
+        EvictFunc  m_evict     { nullptr };
+        bool       m_anyThread { false };
+    };
+
+    mutable QMutex                    m_lock;
+    std::array<Callbacks,kPoolCount>  m_pools;
+    qint64                            m_budget          { 0 };
+    qint64                            m_automaticBudget { 190 * 1024 * 1024 };
+    qint64                            m_limit           { 0 };
+    qint64                            m_pressureLimit   { 0 };
+    QElapsedTimer                     m_pressureTimer;
+    QElapsedTimer                     m_statsTimer;
+
+    QAtomicInteger<quint64>           m_clock           { 0 };
+    QAtomicInteger<qint64>            m_used            { 0 };
+    std::array<QAtomicInteger<qint64>,kPoolCount>  m_bytes     {};
+    std::array<QAtomicInteger<quint64>,kPoolCount> m_hits      {};
+    std::array<QAtomicInteger<quint64>,kPoolCount> m_misses    {};
+    std::array<QAtomicInteger<quint64>,kPoolCount> m_evictions {};
+};
+
+#endif
@@ -39,6 +39,7 @@
 #include "themeinfo.h"
 #include "x11colors.h"
 #include "mythdisplay.h"
+#include "mythuicachemanager.h"
 
 #define LOC      QString("MythUIHelper: ")
 
@@ -99,6 +100,9 @@ public:
 
     void Init();
     void StoreGUIsettings(void);
+    QString FindOldestIdleImage(quint64 &Used);
+    quint64 OldestCachedImage(void);
+    bool ExpireCachedImage(void);
 
     bool      m_themeloaded {false}; ///< Do we have a palette and pixmap to use?
     QString   m_menuthemepathname;
@@ -119,16 +123,16 @@ public:
 #else
     QMap<QString, qint64> m_cacheTrack;
 #endif
+    // Last use of each image, as a MythUICacheManager stamp
+    QHash<QString, quint64> m_cacheUsed;
     QMutex *m_cacheLock                      {nullptr};
 
 #if QT_VERSION < QT_VERSION_CHECK(5,10,0)
     QAtomicInt m_cacheSize                   {0};
-    QAtomicInt m_maxCacheSize                {30 * 1024 * 1024};
 #else
     // This change is because of the QImage change from byteCount() to
     // sizeInBytes(), the latter returning a 64bit value.
     QAtomicInteger<qint64> m_cacheSize       {0};
-    QAtomicInteger<qint64> m_maxCacheSize    {30 * 1024 * 1024};
 #endif
 
     // The part of the screen(s) allocated for the GUI. Unless
@@ -168,6 +172,9 @@ int MythUIHelperPrivate::h_override = -1;
 
 MythUIHelperPrivate::~MythUIHelperPrivate()
 {
+    MythUICacheManager::GetCacheManager()->Unregister(MythUICacheManager::kImages,
+                                                      this);
+
     QMutableMapIterator<QString, MythImage *> i(m_imageCache);
 
     while (i.hasNext())
@@ -179,6 +186,7 @@ MythUIHelperPrivate::~MythUIHelperPrivate()
     }
 
     m_cacheTrack.clear();
+    m_cacheUsed.clear();
 
     delete m_cacheLock;
     delete m_imageThreadPool;
@@ -205,6 +213,60 @@ void MythUIHelperPrivate::Init(void)
     m_userThemeDir = sgroup.GetFirstDir(true);
 }
 
+/** \fn MythUIHelperPrivate::FindOldestIdleImage(quint64&)
+ *  \brief Return the key of the least recently used image that nothing else
+ *         holds a reference to, or an empty string if there is none.
+ */
+QString MythUIHelperPrivate::FindOldestIdleImage(quint64 &Used)
+{
+    QString oldestKey;
+    Used = 0;
+    for (auto it = m_imageCache.cbegin(); it != m_imageCache.cend(); ++it)
+    {
+        quint64 used = m_cacheUsed.value(it.key());
+        if (!oldestKey.isEmpty() && used >= Used)
+            continue;
+        if (2 == it.value()->IncrRef())
+        {
+            Used = used;
+            oldestKey = it.key();
+        }
+        it.value()->DecrRef();
+    }
+    return oldestKey;
+}
+
+quint64 MythUIHelperPrivate::OldestCachedImage(void)
+{
+    QMutexLocker locker(m_cacheLock);
+    quint64 used = 0;
+    if (FindOldestIdleImage(used).isEmpty())
+        return 0;
+    return qMax(used, static_cast<quint64>(1));
+}
+
+/// \brief Remove the least recently used image that is not in use.
+bool MythUIHelperPrivate::ExpireCachedImage(void)
+{
+    QMutexLocker locker(m_cacheLock);
+    quint64 used = 0;
+    QString oldestKey = FindOldestIdleImage(used);
+
+    if (oldestKey.isEmpty())
+        return false;
+
+    LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
+        QString("Cache too big (%1), removing :%2:")
+        .arg(m_cacheSize.fetchAndAddOrdered(0)).arg(oldestKey));
+
+    MythImage *image = m_imageCache.take(oldestKey);
+    image->SetIsInCache(false);
+    image->DecrRef();
+    m_cacheTrack.remove(oldestKey);
+    m_cacheUsed.remove(oldestKey);
+    return true;
+}
+
 /**
  * Apply any user overrides to the screen geometry
  */
@@ -288,12 +350,13 @@ void MythUIHelper::Init(MythUIMenuCallbacks &cbs)
     d->Init();
     d->m_callbacks = cbs;
 
-    d->m_maxCacheSize.fetchAndStoreRelease(
-        GetMythDB()->GetNumSetting("UIImageCacheSize", 30) * 1024 * 1024);
-
-    LOG(VB_GUI, LOG_INFO, LOC +
-        QString("MythUI Image Cache size set to %1 bytes")
-        .arg(d->m_maxCacheSize.fetchAndAddRelease(0)));
+    // Images are shared between threads, so may be evicted from any of them
+    MythUICacheManager *cache = MythUICacheManager::GetCacheManager();
+    cache->Register(MythUICacheManager::kImages, d,
+                    [this]() { return d->OldestCachedImage(); },
+                    [this]() { return d->ExpireCachedImage(); }, true);
+    cache->SetBudget(static_cast<qint64>(
+        GetMythDB()->GetNumSetting("UICacheBudget", 0)) * 1024 * 1024);
 }
 
 // This init is used for showing the startup UI that is shown
@@ -380,8 +443,10 @@ void MythUIHelper::UpdateImageCache(void)
     }
 
     d->m_cacheTrack.clear();
+    d->m_cacheUsed.clear();
 
-    d->m_cacheSize.fetchAndStoreOrdered(0);
+    MythUICacheManager::GetCacheManager()->AddBytes(MythUICacheManager::kImages,
+        -d->m_cacheSize.fetchAndStoreOrdered(0));
 
     ClearOldImageCache();
     PruneCacheDir(GetRemoteCacheDir());
@@ -399,10 +464,14 @@ MythImage *MythUIHelper::GetImageFromCache(const QString &url)
 #else
         d->m_cacheTrack[url] = MythDate::current().toSecsSinceEpoch();
 #endif
+        d->m_cacheUsed[url] = MythUICacheManager::GetCacheManager()->Touch();
+        MythUICacheManager::GetCacheManager()->Hit(MythUICacheManager::kImages);
         d->m_imageCache[url]->IncrRef();
         return d->m_imageCache[url];
     }
 
+    MythUICacheManager::GetCacheManager()->Miss(MythUICacheManager::kImages);
+
     /*
         if (QFileInfo(url).exists())
         {
@@ -420,10 +489,13 @@ void MythUIHelper::IncludeInCacheSize(MythImage *im)
     if (im)
     {
 #if QT_VERSION < QT_VERSION_CHECK(5,10,0)
-        d->m_cacheSize.fetchAndAddOrdered(im->byteCount());
+        qint64 bytes = im->byteCount();
 #else
-        d->m_cacheSize.fetchAndAddOrdered(im->sizeInBytes());
+        qint64 bytes = im->sizeInBytes();
 #endif
+        d->m_cacheSize.fetchAndAddOrdered(bytes);
+        MythUICacheManager::GetCacheManager()->AddBytes(
+            MythUICacheManager::kImages, bytes);
     }
 }
 
@@ -432,10 +504,13 @@ void MythUIHelper::ExcludeFromCacheSize(MythImage *im)
     if (im)
     {
 #if QT_VERSION < QT_VERSION_CHECK(5,10,0)
-        d->m_cacheSize.fetchAndAddOrdered(-im->byteCount());
+        qint64 bytes = im->byteCount();
 #else
-        d->m_cacheSize.fetchAndAddOrdered(-im->sizeInBytes());
+        qint64 bytes = im->sizeInBytes();
 #endif
+        d->m_cacheSize.fetchAndAddOrdered(-bytes);
+        MythUICacheManager::GetCacheManager()->AddBytes(
+            MythUICacheManager::kImages, -bytes);
     }
 }
 
@@ -456,69 +531,11 @@ MythImage *MythUIHelper::CacheImage(const QString &url, MythImage *im,
         im->save(dstfile, "PNG");
     }
 
-    // delete the oldest cached images until we fall below threshold.
-    QMutexLocker locker(d->m_cacheLock);
+    // Make room by evicting whatever, in this or the painter's caches, has
+    // gone longest without being used
+    MythUICacheManager::GetCacheManager()->Balance();
 
-    while ((d->m_cacheSize.fetchAndAddOrdered(0) +
-#if QT_VERSION < QT_VERSION_CHECK(5,10,0)
-	   im->byteCount()
-#else
-	   im->sizeInBytes()
-#endif
-	    ) >=
-           d->m_maxCacheSize.fetchAndAddOrdered(0) &&
-           !d->m_imageCache.empty())
-    {
-        QMap<QString, MythImage *>::iterator it = d->m_imageCache.begin();
-#if QT_VERSION < QT_VERSION_CHECK(5,8,0)
-        uint oldestTime = MythDate::current().toTime_t();
-#else
-        qint64 oldestTime = MythDate::current().toSecsSinceEpoch();
-#endif
-        QString oldestKey = it.key();
-
-        int count = 0;
-
-        for (; it != d->m_imageCache.end(); ++it)
-        {
-            if (d->m_cacheTrack[it.key()] < oldestTime)
-            {
-                if ((2 == it.value()->IncrRef()) && (it.value() != im))
-                {
-                    oldestTime = d->m_cacheTrack[it.key()];
-                    oldestKey = it.key();
-                    count++;
-                }
-                it.value()->DecrRef();
-            }
-        }
-
-        LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
-            QString("%1 images are eligible for expiry").arg(count));
-
-        if (count > 0)
-        {
-            LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
-                QString("Cache too big (%1), removing :%2:")
-                .arg(d->m_cacheSize.fetchAndAddOrdered(0) +
-#if QT_VERSION < QT_VERSION_CHECK(5,10,0)
-		     im->byteCount()
-#else
-		     im->sizeInBytes()
-#endif
-		     )
-                .arg(oldestKey));
-
-            d->m_imageCache[oldestKey]->SetIsInCache(false);
-            d->m_imageCache[oldestKey]->DecrRef();
-            d->m_imageCache.remove(oldestKey);
-            d->m_cacheTrack.remove(oldestKey);
-        }
-        else
-        {
-            break;
-        }
-    }
+    QMutexLocker locker(d->m_cacheLock);
 
     QMap<QString, MythImage *>::iterator it = d->m_imageCache.find(url);
 
@@ -531,6 +548,7 @@ MythImage *MythUIHelper::CacheImage(const QString &url, MythImage *im,
 #else
         d->m_cacheTrack[url] = MythDate::current().toSecsSinceEpoch();
 #endif
+        d->m_cacheUsed[url] = MythUICacheManager::GetCacheManager()->Touch();
 
         im->SetIsInCache(true);
         LOG(VB_GUI | VB_FILE, LOG_INFO, LOC +
@@ -563,6 +581,7 @@ void MythUIHelper::RemoveFromCacheByURL(const QString &url)
         d->m_imageCache[url]->DecrRef();
         d->m_imageCache.remove(url);
         d->m_cacheTrack.remove(url);
+        d->m_cacheUsed.remove(url);
     }
 
     QString dstfile;
@@ -1248,6 +1267,8 @@ MythImage *MythUIHelper::LoadCacheImage(QString srcfile, const QString& label,
         if (d->m_imageCache.contains(label) &&
             d->m_cacheTrack[label] + kImageCacheTimeout > now)
         {
+            d->m_cacheUsed[label] = MythUICacheManager::GetCacheManager()->Touch();
+            MythUICacheManager::GetCacheManager()->Hit(MythUICacheManager::kImages);
             d->m_imageCache[label]->IncrRef();
             return d->m_imageCache[label];
         }
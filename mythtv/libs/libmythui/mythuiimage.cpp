@@ -35,6 +35,10 @@ class ImageLoadThread;
 
 #define LOC      QString("MythUIImage(0x%1): ").arg((uint64_t)this,0,16)
 
+// Image thread pool priorities, the lowest value is run first
+static const int kImageLoadVisible = 0;
+static const int kImageLoadHidden  = 1;
+
 /////////////////////////////////////////////////////
 
 ImageProperties::ImageProperties(const ImageProperties& other)
@@ -273,10 +277,19 @@ class ImageLoader
             image = painter->GetFormatImage();
             bool ok = false;
 
+            // Decode straight to the forced size when nothing done to the
+            // image before the resize below depends on its original size
+            QSize scaledSize;
+            if (bResize && w > 0 && h > 0 && !imProps.m_isReflected &&
+                !imProps.m_isOriented)
+            {
+                scaledSize = QSize(w, h);
+            }
+
             if (imageReader)
                 ok = image->Load(imageReader);
             else
-                ok = image->Load(filename);
+                ok = image->Load(filename, scaledSize, imProps.m_preserveAspect);
 
             if (!ok)
             {
@@ -484,9 +497,10 @@ class ImageLoadThread : public QRunnable
   public:
     ImageLoadThread(MythUIImage *parent, MythPainter *painter,
                     const ImageProperties &imProps, QString basefile,
-                    int number, ImageCacheMode mode) :
+                    int number, ImageCacheMode mode, int generation) :
         m_parent(parent), m_painter(painter), m_imageProperties(imProps),
-        m_basefile(std::move(basefile)), m_number(number), m_cacheMode(mode)
+        m_basefile(std::move(basefile)), m_number(number), m_cacheMode(mode),
+        m_generation(generation)
     {
     }
 
@@ -495,6 +509,16 @@ class ImageLoadThread : public QRunnable
         bool aborted = false;
         QString filename =  m_imageProperties.m_filename;
 
+        // The image was loaded again, or cleared, while this was queued,
+        // e.g. a button list item that has scrolled out of view.
+        if (m_parent->m_loadGeneration.loadAcquire() != m_generation)
+        {
+            auto *le = new ImageLoadEvent(m_parent, nullptr, m_basefile,
+                                          filename, m_number, true);
+            QCoreApplication::postEvent(m_parent, le);
+            return;
+        }
+
         // NOTE Do NOT use MythImageReader::supportsAnimation here, it defeats
         // the point of caching remote images
         if (ImageLoader::SupportsAnimation(filename))
@@ -535,6 +559,7 @@ private:
     QString         m_basefile;
     int             m_number;
     ImageCacheMode  m_cacheMode;
+    int             m_generation;
 };
 
 /////////////////////////////////////////////////////////////////
@@ -974,6 +999,9 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
 
     d->m_updateLock.unlock();
 
+    // Anything still queued from an earlier load is no longer wanted
+    int generation = m_loadGeneration.fetchAndAddOrdered(1) + 1;
+
     QString filename = bFilename;
 
     if (bFilename.isEmpty())
@@ -1045,8 +1073,12 @@ bool MythUIImage::Load(bool allowLoadInBackground, bool forceStat)
             m_runningThreads++;
             auto *bImgThread = new ImageLoadThread(this, GetPainter(),
                                     imProps, bFilename, i,
-                                    static_cast<ImageCacheMode>(cacheMode2));
-            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad");
+                                    static_cast<ImageCacheMode>(cacheMode2),
+                                    generation);
+            // Images that are on screen are decoded before those that are not
+            int priority = IsVisible(true) ? kImageLoadVisible : kImageLoadHidden;
+            GetMythUI()->GetImageThreadPool()->start(bImgThread, "ImageLoad",
+                                                     priority);
         }
         else
         {
@@ -1,6 +1,7 @@
 #ifndef MYTHUI_IMAGE_H_
 #define MYTHUI_IMAGE_H_
 
+#include <QAtomicInt>
 #include <QDateTime>
 #include <QHash>
 #include <QMutex>
@@ -183,6 +184,7 @@ class MUI_PUBLIC MythUIImage : public MythUIType
     ImageProperties m_imageProperties;
 
     int             m_runningThreads     {0};
+    QAtomicInt      m_loadGeneration     {0};
 
     bool            m_showingRandomImage {false};
     QString         m_imageDirectory;
@@ -195,6 +197,7 @@ class MUI_PUBLIC MythUIImage : public MythUIType
     bool            m_animatedImage      {false};
 
     friend class MythUIImagePrivate;
+    friend class ImageLoadThread;
     friend class MythThemeBase;
     friend class MythUIButtonListItem;
     friend class MythUIProgressBar;
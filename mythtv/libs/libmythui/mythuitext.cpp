@@ -96,40 +96,10 @@ void MythUIText::Reset()
 
 void MythUIText::ResetMap(const InfoMap &map)
 {
-    QString newText = GetTemplateText();
+    const MythTextTemplate &compiled = GetCompiledTemplate();
 
-    if (newText.isEmpty())
-        newText = GetDefaultText();
-
-    QRegExp regexp("%(([^\\|%]+)?\\||\\|(.))?([\\w#]+)(\\|(.+))?%");
-    regexp.setMinimal(true);
-
-    bool replaced = map.contains(objectName());
-
-    if (!replaced && !newText.isEmpty() && newText.contains(regexp))
-    {
-        int pos = 0;
-
-        QString translatedTemplate = qApp->translate("ThemeUI",
-                                                     newText.toUtf8());
-
-        while ((pos = regexp.indexIn(translatedTemplate, pos)) != -1)
-        {
-            QString key = regexp.cap(4).toLower().trimmed();
-
-            if (map.contains(key))
-            {
-                replaced = true;
-                break;
-            }
-            pos += regexp.matchedLength();
-        }
-    }
-
-    if (replaced)
-    {
+    if (map.contains(objectName()) || compiled.UsesAny(map))
         Reset();
-    }
 }
 
 void MythUIText::SetText(const QString &text)
@@ -157,49 +127,15 @@ void MythUIText::SetText(const QString &text)
 
 void MythUIText::SetTextFromMap(const InfoMap &map)
 {
-    QString newText = GetTemplateText();
-
-    if (newText.isEmpty())
-        newText = GetDefaultText();
+    const MythTextTemplate &compiled = GetCompiledTemplate();
 
-    QRegExp regexp("%(([^\\|%]+)?\\||\\|(.))?([\\w#]+)(\\|(.+))?%");
-    regexp.setMinimal(true);
-
-    if (!newText.isEmpty() && newText.contains(regexp))
+    if (compiled.HasFields())
     {
-        int pos = 0;
-
-        QString translatedTemplate = qApp->translate("ThemeUI",
-                                                     newText.toUtf8());
+        QString newText;
+        bool replaced = compiled.Expand(map, newText);
 
-        QString tempString = translatedTemplate;
-        bool replaced = map.contains(objectName());
-
-        while ((pos = regexp.indexIn(translatedTemplate, pos)) != -1)
-        {
-            QString key = regexp.cap(4).toLower().trimmed();
-            QString replacement;
-
-            if (map.contains(key))
-            {
-                replaced = true;
-            }
-            if (!map.value(key).isEmpty())
-            {
-                replacement = QString("%1%2%3%4")
-                .arg(regexp.cap(2))
-                .arg(regexp.cap(3))
-                .arg(map.value(key))
-                .arg(regexp.cap(6));
-            }
-
-            tempString.replace(regexp.cap(0), replacement);
-            pos += regexp.matchedLength();
-        }
-        if (replaced)
-        {
-            SetText(tempString);
-        }
+        if (replaced || map.contains(objectName()))
+            SetText(newText);
     }
     else if (map.contains(objectName()))
     {
@@ -207,6 +143,26 @@ void MythUIText::SetTextFromMap(const InfoMap &map)
     }
 }
 
+/** \brief Return the template, or the default text, in its compiled form.
+ *
+ *   It is compiled when the theme is loaded, and again only if the text it
+ *   came from has changed since.
+ */
+const MythTextTemplate &MythUIText::GetCompiledTemplate(void)
+{
+    const QString &source = m_TemplateText.isEmpty() ? m_DefaultMessage
+                                                     : m_TemplateText;
+
+    if (source != m_compiledSource)
+    {
+        m_compiledSource = source;
+        m_compiledTemplate.Compile(
+            qApp->translate("ThemeUI", source.toUtf8()));
+    }
+
+    return m_compiledTemplate;
+}
+
 void MythUIText::SetFontProperties(const MythFontProperties &fontProps)
 {
     m_FontStates.insert("default", fontProps);
@@ -1638,6 +1594,8 @@ void MythUIText::CopyFrom(MythUIType *base)
     SetText(text->m_Message);
     m_CutMessage = text->m_CutMessage;
     m_TemplateText = text->m_TemplateText;
+    m_compiledTemplate = text->m_compiledTemplate;
+    m_compiledSource = text->m_compiledSource;
 
     m_ShrinkNarrow = text->m_ShrinkNarrow;
     m_Cutdown = text->m_Cutdown;
@@ -1698,5 +1656,6 @@ void MythUIText::Finalize(void)
             .arg(objectName()).arg(GetXMLLocation()));
         m_Cutdown = Qt::ElideNone;
     }
+    GetCompiledTemplate();
     FillCutMessage();
 }
@@ -10,6 +10,7 @@
 #include "mythtypes.h"
 
 // Mythui headers
+#include "mythtexttemplate.h"
 #include "mythuitype.h"
 #include "mythmainwindow.h" // for MythMainWindow::drawRefresh
 
@@ -105,6 +106,7 @@ class MUI_PUBLIC MythUIText : public MythUIType, public StorageUser
     bool GetNarrowWidth(const QStringList & paragraphs,
                         const QTextOption & textoption, qreal & width);
     void FillCutMessage(void);
+    const MythTextTemplate &GetCompiledTemplate(void);
 
     int      m_Justification      {Qt::AlignLeft | Qt::AlignTop};
     MythRect m_OrigDisplayRect;
@@ -117,6 +119,8 @@ class MUI_PUBLIC MythUIText : public MythUIType, public StorageUser
     QString m_CutMessage;
     QString m_DefaultMessage;
     QString m_TemplateText;
+    MythTextTemplate m_compiledTemplate;
+    QString m_compiledSource;
 
 #if 0 // Not currently used
     bool m_usingAltArea           {false};
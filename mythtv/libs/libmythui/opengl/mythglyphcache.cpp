@@ -0,0 +1,341 @@
+// Std
+#include <algorithm>
+#include <cstdlib>
+
+// Qt
+#include <QFontMetrics>
+#include <QGlyphRun>
+#include <QPainter>
+#include <QTextLayout>
+
+// MythTV
+#include "mythlogging.h"
+#include "mythfontproperties.h"
+#include "mythglyphcache.h"
+
+#define LOC QString("GlyphCache: ")
+
+/// Maximum number of shaped strings kept for DrawText
+static const int kMaxShapedStrings = 2000;
+
+MythGlyphCache::MythGlyphCache(int PageSize, int MaxPages)
+  : m_pageSize(PageSize),
+    m_maxPages(MaxPages)
+{
+}
+
+/// \brief Return true if text in this font can be drawn from the atlas.
+bool MythGlyphCache::CanRender(const MythFontProperties &Font)
+{
+    // Outlines are stroked paths and gradients need the whole string, so
+    // both are left to the image based text path.
+    return !Font.hasOutline() && Font.GetBrush().style() == Qt::SolidPattern;
+}
+
+void MythGlyphCache::Clear(void)
+{
+    m_pages.clear();
+    m_fonts.clear();
+    m_fontIndexes.clear();
+    m_glyphs.clear();
+    m_shaped.clear();
+    m_shapedExpiry.clear();
+}
+
+/*! \brief Lay out a string as MythPainter::DrawTextPriv would draw it.
+ *
+ * The quads are positioned relative to Area and do not include the shadow.
+ * \return false if the glyphs do not fit in the atlas, in which case the
+ * caller should fall back to rendering an image.
+ */
+bool MythGlyphCache::GetText(const QString &Text, int Flags, const QRect &Area,
+                             const MythFontProperties &Font, Quads &Result)
+{
+    ++m_serial;
+    const ShapedText *shaped = Shape(Text, Flags, Area, Font);
+    if (!shaped)
+        return false;
+
+    Result.reserve(Result.size() + shaped->m_glyphs.size());
+    for (const auto & glyph : shaped->m_glyphs)
+        if (!AddGlyph(glyph.m_font, glyph.m_index, Area.topLeft() + glyph.m_position, Result))
+            return false;
+    return true;
+}
+
+/*! \brief Add the glyphs of already shaped layouts, as drawn at Origin.
+ *
+ * Only the layout text is handled. Layouts with their own formats must go
+ * through the image path.
+ */
+bool MythGlyphCache::GetTextLayout(const LayoutVector &Layouts, const QPoint &Origin,
+                                   Quads &Result)
+{
+    ++m_serial;
+    for (auto * layout : Layouts)
+    {
+        QPointF origin = QPointF(Origin) + layout->position();
+        QList<QGlyphRun> runs = layout->glyphRuns();
+        for (const auto & run : runs)
+        {
+            int font = GetFontIndex(run.rawFont());
+            QVector<quint32> indexes   = run.glyphIndexes();
+            QVector<QPointF> positions = run.positions();
+            for (int i = 0; i < indexes.size() && i < positions.size(); ++i)
+                if (!AddGlyph(font, indexes[i], (origin + positions[i]).toPoint(), Result))
+                    return false;
+        }
+    }
+    return true;
+}
+
+const MythGlyphCache::ShapedText* MythGlyphCache::Shape(const QString &Text, int Flags,
+                                                        const QRect &Area,
+                                                        const MythFontProperties &Font)
+{
+    QString key = Font.GetHash() + QString::number(Area.width()) + "x" +
+                  QString::number(Area.height()) + ":" +
+                  QString::number(Flags) + ":" + Text;
+
+    auto it = m_shaped.find(key);
+    if (it != m_shaped.end())
+    {
+        m_shapedExpiry.splice(m_shapedExpiry.end(), m_shapedExpiry, it->m_expiry);
+        return &(*it);
+    }
+
+    QPoint shadowOffset(0, 0);
+    QColor shadowColor;
+    int shadowAlpha = 255;
+    if (Font.hasShadow())
+        Font.GetShadow(shadowOffset, shadowColor, shadowAlpha);
+
+    QFont face = Font.face();
+    QFontMetrics fm(face);
+
+    // Same layout rules as QPainter::drawText for the flags we use
+    QString text = Text;
+    text.replace(QLatin1Char('\n'), QChar::LineSeparator);
+    QTextLayout layout(text, face);
+    QTextOption option(static_cast<Qt::Alignment>(Flags) & Qt::AlignHorizontal_Mask);
+    option.setWrapMode((Flags & Qt::TextWordWrap) ? QTextOption::WordWrap
+                                                   : QTextOption::ManualWrap);
+    layout.setTextOption(option);
+    layout.setCacheEnabled(true);
+
+    qreal height = 0;
+    layout.beginLayout();
+    for (;;)
+    {
+        QTextLine line = layout.createLine();
+        if (!line.isValid())
+            break;
+        line.setLineWidth(Area.width());
+        line.setPosition(QPointF(0, height));
+        height += line.height();
+    }
+    layout.endLayout();
+
+    // And the same padding as MythPainter::DrawTextPriv
+    int totalHeight = fm.height() + std::abs(shadowOffset.y());
+    int offsetX = std::max(0, -shadowOffset.x());
+    int offsetY = (Flags & Qt::TextWordWrap) ? 0 : (Area.height() - totalHeight) / 2;
+    offsetY += std::max(0, -shadowOffset.y());
+    if (Flags & Qt::AlignBottom)
+        offsetY += Area.height() - static_cast<int>(height);
+    else if (Flags & Qt::AlignVCenter)
+        offsetY += (Area.height() - static_cast<int>(height)) / 2;
+
+    ShapedText shaped;
+    QList<QGlyphRun> runs = layout.glyphRuns();
+    for (const auto & run : runs)
+    {
+        int font = GetFontIndex(run.rawFont());
+        QVector<quint32> indexes   = run.glyphIndexes();
+        QVector<QPointF> positions = run.positions();
+        for (int i = 0; i < indexes.size() && i < positions.size(); ++i)
+        {
+            QPoint position = (positions[i] + QPointF(offsetX, offsetY)).toPoint();
+            shaped.m_glyphs.append({ font, indexes[i], position });
+        }
+    }
+
+    while (m_shaped.size() >= kMaxShapedStrings)
+    {
+        m_shaped.remove(m_shapedExpiry.front());
+        m_shapedExpiry.pop_front();
+    }
+
+    shaped.m_expiry = m_shapedExpiry.insert(m_shapedExpiry.end(), key);
+    return &(*m_shaped.insert(key, shaped));
+}
+
+int MythGlyphCache::GetFontIndex(const QRawFont &Font)
+{
+    QString key = QString("%1:%2:%3:%4:%5").arg(Font.familyName()).arg(Font.styleName())
+        .arg(Font.pixelSize()).arg(Font.weight()).arg(Font.style());
+    auto it = m_fontIndexes.constFind(key);
+    if (it != m_fontIndexes.constEnd())
+        return *it;
+
+    int index = m_fonts.size();
+    m_fonts.append(Font);
+    m_glyphs.append(QHash<quint32,Glyph>());
+    m_fontIndexes.insert(key, index);
+    return index;
+}
+
+bool MythGlyphCache::AddGlyph(int FontIndex, quint32 Index, const QPoint &Position,
+                              Quads &Result)
+{
+    Glyph glyph { };
+    if (!GetGlyph(FontIndex, Index, glyph))
+        return false;
+
+    // Whitespace
+    if (glyph.m_page < 0)
+        return true;
+
+    m_pages[glyph.m_page].m_lastUsed = m_serial;
+    Result.append({ glyph.m_page, glyph.m_source,
+                    QRect(Position + glyph.m_offset, glyph.m_source.size()) });
+    return true;
+}
+
+bool MythGlyphCache::GetGlyph(int FontIndex, quint32 Index, Glyph &Result)
+{
+    auto it = m_glyphs[FontIndex].constFind(Index);
+    if (it != m_glyphs[FontIndex].constEnd())
+    {
+        Result = *it;
+        return true;
+    }
+
+    // Pad by a pixel as the bounds are not exact for hinted glyphs
+    const QRawFont &font = m_fonts[FontIndex];
+    QRect bounds = font.boundingRect(Index).toAlignedRect();
+    if (bounds.isEmpty())
+    {
+        Result = { -1, QRect(), QPoint() };
+        m_glyphs[FontIndex].insert(Index, Result);
+        return true;
+    }
+    bounds.adjust(-1, -1, 1, 1);
+
+    int page = 0;
+    QPoint position;
+    if (!Allocate(bounds.size(), page, position))
+        return false;
+
+    QGlyphRun run;
+    run.setRawFont(font);
+    run.setGlyphIndexes({ Index });
+    run.setPositions({ QPointF(0.0, 0.0) });
+
+    // Glyphs are white and take their color from the vertices
+    QPainter painter(&m_pages[page].m_image);
+    painter.setPen(Qt::white);
+    painter.drawGlyphRun(QPointF(position - bounds.topLeft()), run);
+    painter.end();
+    m_pages[page].m_changed |= QRect(position, bounds.size());
+
+    Result = { page, QRect(position, bounds.size()), bounds.topLeft() };
+    m_glyphs[FontIndex].insert(Index, Result);
+    return true;
+}
+
+bool MythGlyphCache::Allocate(const QSize &Size, int &PageIndex, QPoint &Position)
+{
+    if (Size.width() >= m_pageSize || Size.height() >= m_pageSize)
+        return false;
+
+    for (int i = 0; i < m_pages.size(); ++i)
+    {
+        if (AllocateInPage(m_pages[i], Size, Position))
+        {
+            PageIndex = i;
+            return true;
+        }
+    }
+
+    if (m_pages.size() < m_maxPages)
+    {
+        Page page;
+        page.m_image = QImage(m_pageSize, m_pageSize, QImage::Format_RGBA8888);
+        page.m_image.fill(Qt::transparent);
+        page.m_changed = page.m_image.rect();
+        m_pages.append(page);
+        PageIndex = m_pages.size() - 1;
+        LOG(VB_GPU, LOG_INFO, LOC + QString("Created atlas page %1 (%2x%2)")
+            .arg(PageIndex).arg(m_pageSize));
+        return AllocateInPage(m_pages.last(), Size, Position);
+    }
+
+    if (!EvictPage(PageIndex))
+        return false;
+    return AllocateInPage(m_pages[PageIndex], Size, Position);
+}
+
+/// \brief Find space on a shelf of a similar height, or start a new shelf.
+bool MythGlyphCache::AllocateInPage(Page &CurrentPage, const QSize &Size, QPoint &Position)
+{
+    int width  = Size.width() + 1;
+    int height = Size.height() + 1;
+
+    for (auto & shelf : CurrentPage.m_shelves)
+    {
+        if ((height <= shelf.m_height) && (height * 4 >= shelf.m_height * 3) &&
+            (shelf.m_used + width <= m_pageSize))
+        {
+            Position = QPoint(shelf.m_used, shelf.m_top);
+            shelf.m_used += width;
+            return true;
+        }
+    }
+
+    if (CurrentPage.m_bottom + height > m_pageSize)
+        return false;
+
+    Position = QPoint(0, CurrentPage.m_bottom);
+    CurrentPage.m_shelves.append({ CurrentPage.m_bottom, height, width });
+    CurrentPage.m_bottom += height;
+    return true;
+}
+
+/// \brief Empty the least recently used page that the current text does not use.
+bool MythGlyphCache::EvictPage(int &PageIndex)
+{
+    PageIndex = -1;
+    for (int i = 0; i < m_pages.size(); ++i)
+    {
+        if (m_pages[i].m_lastUsed == m_serial)
+            continue;
+        if (PageIndex < 0 || m_pages[i].m_lastUsed < m_pages[PageIndex].m_lastUsed)
+            PageIndex = i;
+    }
+
+    if (PageIndex < 0)
+    {
+        LOG(VB_GPU, LOG_DEBUG, LOC + "Text does not fit in the atlas");
+        return false;
+    }
+
+    LOG(VB_GPU, LOG_DEBUG, LOC + QString("Evicting atlas page %1").arg(PageIndex));
+    Page &page = m_pages[PageIndex];
+    page.m_image.fill(Qt::transparent);
+    page.m_shelves.clear();
+    page.m_bottom  = 0;
+    page.m_changed = page.m_image.rect();
+
+    for (auto & glyphs : m_glyphs)
+    {
+        for (auto it = glyphs.begin(); it != glyphs.end(); )
+        {
+            if (it->m_page == PageIndex)
+                it = glyphs.erase(it);
+            else
+                ++it;
+        }
+    }
+    return true;
+}
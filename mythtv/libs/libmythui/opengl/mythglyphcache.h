@@ -0,0 +1,123 @@
+#ifndef MYTHGLYPHCACHE_H
+#define MYTHGLYPHCACHE_H
+
+// Qt
+#include <QHash>
+#include <QImage>
+#include <QRawFont>
+#include <QRect>
+#include <QVector>
+
+// MythTV
+#include "mythpainter.h"
+
+// Std
+#include <list>
+
+class MythFontProperties;
+
+/*! \class MythGlyphCache
+ *  \brief Rasterises glyphs once and packs them into a few shared atlas pages.
+ *
+ * Text is turned into a list of quads, each of which maps a glyph in one of
+ * the pages to its place on screen. The pages are plain images; it is up to
+ * the painter to upload the part of a page returned by GetPageChanges().
+ *
+ * Strings drawn through DrawText are shaped once per font and the resulting
+ * runs are kept in a small LRU cache, so redrawing the same text is only a
+ * hash lookup. QTextLayouts from MythUIText are already shaped and are read
+ * directly.
+ *
+ * The number of pages is fixed. When they are all full the least recently
+ * used page that is not needed by the text being laid out is emptied, so
+ * texture memory never grows beyond MaxPages * PageSize^2 * 4 bytes.
+ */
+class MUI_PUBLIC MythGlyphCache
+{
+  public:
+    struct Quad
+    {
+        int   m_page;
+        QRect m_source;
+        QRect m_destination;
+    };
+    using Quads = QVector<Quad>;
+
+    explicit MythGlyphCache(int PageSize = 1024, int MaxPages = 4);
+
+    static bool CanRender(const MythFontProperties &Font);
+
+    bool  GetText(const QString &Text, int Flags, const QRect &Area,
+                  const MythFontProperties &Font, Quads &Result);
+    bool  GetTextLayout(const LayoutVector &Layouts, const QPoint &Origin,
+                        Quads &Result);
+    void  Clear(void);
+
+    int   PageCount(void) const            { return m_pages.size(); }
+    int   PageSize(void) const             { return m_pageSize; }
+    const QImage& GetPage(int Page) const  { return m_pages[Page].m_image; }
+    QRect GetPageChanges(int Page) const   { return m_pages[Page].m_changed; }
+    void  ClearPageChanges(int Page)       { m_pages[Page].m_changed = QRect(); }
+
+  private:
+    struct Glyph
+    {
+        int    m_page;
+        QRect  m_source;
+        QPoint m_offset;    ///< top left of the glyph image from its origin
+    };
+
+    struct Shelf
+    {
+        int m_top;
+        int m_height;
+        int m_used;
+    };
+
+    struct Page
+    {
+        QImage          m_image;
+        QVector<Shelf>  m_shelves;
+        int             m_bottom   { 0 };
+        uint64_t        m_lastUsed { 0 };
+        QRect           m_changed;      ///< area drawn since the last upload
+    };
+
+    /// One glyph of a shaped string, relative to the top left of the text
+    struct ShapedGlyph
+    {
+        int     m_font;
+        quint32 m_index;
+        QPoint  m_position;
+    };
+
+    struct ShapedText
+    {
+        QVector<ShapedGlyph> m_glyphs;
+        std::list<QString>::iterator m_expiry;
+    };
+
+    int   GetFontIndex(const QRawFont &Font);
+    bool  AddGlyph(int FontIndex, quint32 Index, const QPoint &Position,
+                   Quads &Result);
+    bool  GetGlyph(int FontIndex, quint32 Index, Glyph &Result);
+    bool  Allocate(const QSize &Size, int &PageIndex, QPoint &Position);
+    bool  AllocateInPage(Page &CurrentPage, const QSize &Size, QPoint &Position);
+    bool  EvictPage(int &PageIndex);
+    const ShapedText* Shape(const QString &Text, int Flags, const QRect &Area,
+                            const MythFontProperties &Font);
+
+    int                              m_pageSize;
+    int                              m_maxPages;
+    QVector<Page>                    m_pages;
+    uint64_t                         m_serial { 0 };
+
+    QVector<QRawFont>                m_fonts;
+    QHash<QString,int>               m_fontIndexes;
+    QVector<QHash<quint32,Glyph> >   m_glyphs;
+
+    QHash<QString,ShapedText>        m_shaped;
+    std::list<QString>               m_shapedExpiry;
+};
+
+#endif // MYTHGLYPHCACHE_H
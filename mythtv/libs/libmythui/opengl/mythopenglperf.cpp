@@ -11,10 +11,12 @@
 */
 MythOpenGLPerf::MythOpenGLPerf(QString Name,
                                QVector<QString> Names,
-                               int SampleCount)
+                               int SampleCount,
+                               uint64_t LogMask)
   : m_name(std::move(Name)),
     m_totalSamples(SampleCount),
-    m_timerNames(std::move(Names))
+    m_timerNames(std::move(Names)),
+    m_logMask(LogMask)
 {
     while (m_timerData.size() < m_timerNames.size())
         m_timerData.append(0);
@@ -81,7 +83,7 @@ void MythOpenGLPerf::LogSamples(void)
             total += m_timerData[i];
             m_timerData[i] = 0;
         }
-        LOG(VB_GPUVIDEO, LOG_INFO, m_name + results.join(" ") +
+        LOG(m_logMask, LOG_INFO, m_name + results.join(" ") +
             QString(" Total fps: %1").arg(1000000000.0 / (static_cast<double>(total) / m_sampleCount)));
         m_sampleCount = 0;
     }
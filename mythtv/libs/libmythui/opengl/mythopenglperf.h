@@ -29,11 +29,13 @@ class QOpenGLTimeMonitor
 
 // MythTV
 #include "mythuiexp.h"
+#include "mythlogging.h"
 
 class MUI_PUBLIC MythOpenGLPerf : public QOpenGLTimeMonitor
 {
   public:
-    MythOpenGLPerf(QString Name, QVector<QString> Names, int SampleCount = 30);
+    MythOpenGLPerf(QString Name, QVector<QString> Names, int SampleCount = 30,
+                   uint64_t LogMask = VB_GPUVIDEO);
     void RecordSample    (void);
     void LogSamples      (void);
     int  GetTimersRunning(void);
@@ -46,6 +48,7 @@ class MUI_PUBLIC MythOpenGLPerf : public QOpenGLTimeMonitor
     int  m_timersRunning           { 0 };
     QVector<GLuint64> m_timerData  { 0 };
     QVector<QString>  m_timerNames { };
+    uint64_t          m_logMask    { VB_GPUVIDEO };
 };
 
 #endif // MYTHOPENGLPERF_H
@@ -7,8 +7,12 @@
 
 // MythTV
 #include "mythmainwindow_internal.h"
+#include "mythfontproperties.h"
+#include "mythrect.h"
 #include "mythrenderopengl.h"
+#include "mythopenglperf.h"
 #include "mythpainteropengl.h"
+#include "mythuicachemanager.h"
 
 using namespace std;
 
@@ -16,16 +20,20 @@ MythOpenGLPainter::MythOpenGLPainter(MythRenderOpenGL *Render, QWidget *Parent)
   : m_parent(Parent),
     m_render(Render)
 {
-    m_mappedTextures.reserve(MAX_BUFFER_POOL);
+    MythUICacheManager::GetCacheManager()->Register(MythUICacheManager::kTextures, this,
+        [this]() { return OldestTexture(); },
+        [this]() { return ExpireTexture(); }, false);
 }
 
 MythOpenGLPainter::~MythOpenGLPainter()
 {
+    MythUICacheManager::GetCacheManager()->Unregister(MythUICacheManager::kTextures, this);
     OpenGLLocker locker(m_render);
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
         m_render->logDebugMarker("PAINTER_RELEASE_START");
     Teardown();
     MythOpenGLPainter::FreeResources();
+    delete m_openGLPerf;
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
         m_render->logDebugMarker("PAINTER_RELEASE_END");
 }
@@ -33,17 +41,20 @@ MythOpenGLPainter::~MythOpenGLPainter()
 void MythOpenGLPainter::FreeResources(void)
 {
     OpenGLLocker locker(m_render);
+    DiscardBatches();
     ClearCache();
     DeleteTextures();
-    if (m_mappedBufferPoolReady)
-    {
-        for (auto & buf : m_mappedBufferPool)
-        {
-            delete buf;
-            buf = nullptr;
-        }
-        m_mappedBufferPoolReady = false;
-    }
+    DeleteGlyphTextures();
+    if (m_render)
+        m_render->DeleteTexture(m_whiteTexture);
+    m_whiteTexture = nullptr;
+}
+
+void MythOpenGLPainter::SetTarget(QOpenGLFramebufferObject *NewTarget)
+{
+    if (NewTarget != m_target)
+        FlushBatches();
+    m_target = NewTarget;
 }
 
 void MythOpenGLPainter::DeleteTextures(void)
@@ -56,12 +67,24 @@ void MythOpenGLPainter::DeleteTextures(void)
     while (!m_textureDeleteList.empty())
     {
         MythGLTexture *texture = m_textureDeleteList.front();
-        m_hardwareCacheSize -= MythRenderOpenGL::GetTextureDataSize(texture);
+        int bytes = MythRenderOpenGL::GetTextureDataSize(texture);
+        m_hardwareCacheSize -= bytes;
+        MythUICacheManager::GetCacheManager()->AddBytes(MythUICacheManager::kTextures,
+                                                        -bytes);
         m_render->DeleteTexture(texture);
         m_textureDeleteList.pop_front();
     }
 }
 
+void MythOpenGLPainter::DeleteGlyphTextures(void)
+{
+    if (m_render)
+        for (auto * texture : m_glyphTextures)
+            m_render->DeleteTexture(texture);
+    m_glyphTextures.clear();
+    m_glyphCache.Clear();
+}
+
 void MythOpenGLPainter::ClearCache(void)
 {
     LOG(VB_GENERAL, LOG_INFO, "Clearing OpenGL painter cache.");
@@ -72,9 +95,10 @@ void MythOpenGLPainter::ClearCache(void)
     {
         it.next();
         m_textureDeleteList.push_back(m_imageToTextureMap[it.key()]);
-        m_ImageExpireList.remove(it.key());
     }
     m_imageToTextureMap.clear();
+    m_imageUsed.clear();
+    m_ImageExpireList.clear();
 }
 
 void MythOpenGLPainter::Begin(QPaintDevice *Parent)
@@ -106,25 +130,11 @@ void MythOpenGLPainter::Begin(QPaintDevice *Parent)
         }
     }
 
-    if (!m_mappedBufferPoolReady)
-    {
-        m_mappedBufferPoolReady = true;
-        // initialise the VBO pool
-        for (auto & buf : m_mappedBufferPool)
-            buf = m_render->CreateVBO(static_cast<int>(MythRenderOpenGL::kVertexSize));
-    }
-
     // check if we need to adjust cache sizes
     if (m_lastSize != m_parent->size())
     {
-        // This will scale the cache depending on the resolution in use
-        static const int s_onehd = 1920 * 1080;
-        static const int s_basesize = 64;
         m_lastSize = m_parent->size();
-        float hdscreens = (static_cast<float>(m_lastSize.width() + 1) * m_lastSize.height()) / s_onehd;
-        int cpu = qMax(static_cast<int>(hdscreens * s_basesize), s_basesize);
-        int gpu = cpu * 3 / 2;
-        SetMaximumCacheSizes(gpu, cpu);
+        SetCacheBudget(m_lastSize);
     }
 
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
@@ -140,6 +150,22 @@ void MythOpenGLPainter::Begin(QPaintDevice *Parent)
         m_render->SetBackground(0, 0, 0, 0);
         m_render->ClearFramebuffer();
     }
+
+    // Time the UI when we own the frame. Video playback times its own frames.
+    if (!m_target && m_swapControl && !m_openGLPerfChecked &&
+        VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
+    {
+        m_openGLPerfChecked = true;
+        m_openGLPerf = new MythOpenGLPerf("GLUIPerf: ", { "Draw:", "Swap:" }, 30, VB_GPU);
+        if (!m_openGLPerf->isCreated())
+        {
+            delete m_openGLPerf;
+            m_openGLPerf = nullptr;
+        }
+    }
+
+    if (m_openGLPerf && !m_target && m_swapControl && !m_openGLPerf->GetTimersRunning())
+        m_openGLPerf->RecordSample();
 }
 
 void MythOpenGLPainter::End(void)
@@ -150,6 +176,12 @@ void MythOpenGLPainter::End(void)
         return;
     }
 
+    FlushBatches();
+
+    bool timed = m_openGLPerf && (m_openGLPerf->GetTimersRunning() != 0);
+    if (timed)
+        m_openGLPerf->RecordSample();
+
     if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_INFO))
         m_render->logDebugMarker("PAINTER_FRAME_END");
     if (m_target == nullptr && m_swapControl)
@@ -157,9 +189,21 @@ void MythOpenGLPainter::End(void)
         m_render->Flush();
         m_render->swapBuffers();
     }
+
+    if (timed)
+    {
+        m_openGLPerf->RecordSample();
+        m_openGLPerf->LogSamples();
+    }
     m_render->doneCurrent();
 
-    m_mappedTextures.clear();
+    if (VERBOSE_LEVEL_CHECK(VB_GPU, LOG_DEBUG) && (++m_frames >= 300))
+    {
+        LOG(VB_GPU, LOG_DEBUG, QString("Painter: %1 quads in %2 draws per frame")
+            .arg(m_frameQuads / m_frames).arg(m_frameDraws / m_frames));
+        m_frames = m_frameQuads = m_frameDraws = 0;
+    }
+
     MythPainter::End();
 }
 
@@ -168,17 +212,23 @@ MythGLTexture* MythOpenGLPainter::GetTextureFromCache(MythImage *Image)
     if (!m_render)
         return nullptr;
 
+    MythUICacheManager *cache = MythUICacheManager::GetCacheManager();
+
     if (m_imageToTextureMap.contains(Image))
     {
         if (!Image->IsChanged())
         {
-            m_ImageExpireList.remove(Image);
-            m_ImageExpireList.push_back(Image);
+            quint64 &used = m_imageUsed[Image];
+            m_ImageExpireList.remove(used);
+            used = cache->Touch();
+            m_ImageExpireList.insert(used, Image);
+            cache->Hit(MythUICacheManager::kTextures);
             return m_imageToTextureMap[Image];
         }
         DeleteFormatImagePriv(Image);
     }
 
+    cache->Miss(MythUICacheManager::kTextures);
     Image->SetChanged(false);
 
     MythGLTexture *texture = nullptr;
@@ -195,70 +245,295 @@ MythGLTexture* MythOpenGLPainter::GetTextureFromCache(MythImage *Image)
             return nullptr;
         }
 
-        // Shrink the cache size
-        m_maxHardwareCacheSize = (3 * m_hardwareCacheSize) / 4;
-        LOG(VB_GENERAL, LOG_NOTICE, QString(
-                "Shrinking UIPainterMaxCacheHW to %1KB")
-            .arg(m_maxHardwareCacheSize / 1024));
+        // Shrink the cache, and keep it below what the GPU managed to hold
+        int target = (3 * m_hardwareCacheSize) / 4;
+        cache->LimitBudget(cache->GetUsed() - (m_hardwareCacheSize - target));
 
-        while (m_hardwareCacheSize > m_maxHardwareCacheSize)
-        {
-            MythImage *expiredIm = m_ImageExpireList.front();
-            m_ImageExpireList.pop_front();
-            DeleteFormatImagePriv(expiredIm);
-            DeleteTextures();
-        }
+        while (m_hardwareCacheSize > target && ExpireTexture()) {}
     }
 
     CheckFormatImage(Image);
-    m_hardwareCacheSize += MythRenderOpenGL::GetTextureDataSize(texture);
+    int bytes = MythRenderOpenGL::GetTextureDataSize(texture);
+    m_hardwareCacheSize += bytes;
+    cache->AddBytes(MythUICacheManager::kTextures, bytes);
+    quint64 used = cache->Touch();
     m_imageToTextureMap[Image] = texture;
-    m_ImageExpireList.push_back(Image);
+    m_imageUsed[Image] = used;
+    m_ImageExpireList.insert(used, Image);
 
-    while (m_hardwareCacheSize > m_maxHardwareCacheSize)
-    {
-        MythImage *expiredIm = m_ImageExpireList.front();
-        m_ImageExpireList.pop_front();
-        DeleteFormatImagePriv(expiredIm);
-        DeleteTextures();
-    }
+    cache->Balance();
 
     return texture;
 }
 
+quint64 MythOpenGLPainter::OldestTexture(void) const
+{
+    return m_ImageExpireList.isEmpty() ? 0 : m_ImageExpireList.firstKey();
+}
+
+/** \fn MythOpenGLPainter::ExpireTexture(void)
+ *  \brief Delete the least recently used texture.
+ *
+ *   This may be called by MythUICacheManager while another cache is adding
+ *   an image part way through a frame, and pending quads may use the texture.
+ */
+bool MythOpenGLPainter::ExpireTexture(void)
+{
+    if (m_ImageExpireList.isEmpty())
+        return false;
+
+    FlushBatches();
+    DeleteFormatImagePriv(m_ImageExpireList.first());
+    DeleteTextures();
+    return true;
+}
+
 void MythOpenGLPainter::DrawImage(const QRect &Dest, MythImage *Image,
                                   const QRect &Source, int Alpha)
 {
     if (m_render)
     {
-        // Drawing an image  multiple times with the same VBO will stall most GPUs as
-        // the VBO is re-mapped whilst still in use. Use a pooled VBO instead.
         MythGLTexture *texture = GetTextureFromCache(Image);
-        if (texture && m_mappedTextures.contains(texture))
+        if (texture)
+            AddQuad(texture, Source, Dest, qRgba(255, 255, 255, Alpha));
+    }
+}
+
+/*! \brief Queue a quad for drawing with the others from the same texture.
+ *
+ * A quad may join an earlier batch for its texture as long as nothing queued
+ * since then overlaps it, otherwise it starts a new batch. This keeps the
+ * drawing order that blending depends on, while a list of buttons with the
+ * same background, or a page of text, collapses into a handful of draws.
+ */
+void MythOpenGLPainter::AddQuad(MythGLTexture *Texture, const QRect &Source,
+                                const QRect &Dest, QRgb Color)
+{
+    static const int kMaxLookback = 16;
+
+    MythGLQuad quad { Source, Dest, Color };
+    int last = max(0, m_batchCount - kMaxLookback);
+    for (int i = m_batchCount - 1; i >= last; --i)
+    {
+        Batch &batch = m_batches[i];
+        if (batch.m_texture == Texture)
+        {
+            batch.m_quads.append(quad);
+            batch.m_bounds |= Dest;
+            return;
+        }
+        if (batch.m_bounds.intersects(Dest))
+            break;
+    }
+
+    if (m_batchCount >= m_batches.size())
+        m_batches.append(Batch());
+    Batch &batch = m_batches[m_batchCount++];
+    batch.m_texture = Texture;
+    batch.m_bounds  = Dest;
+    batch.m_quads.append(quad);
+}
+
+/// \brief Draw all queued quads. Must be called before any other GL drawing.
+void MythOpenGLPainter::FlushBatches(void)
+{
+    if (!m_batchCount)
+        return;
+
+    for (int i = 0; i < m_batchCount; ++i)
+    {
+        Batch &batch = m_batches[i];
+        if (m_render)
+            m_render->DrawBitmaps(batch.m_texture, m_target, batch.m_quads);
+        m_frameQuads += batch.m_quads.size();
+        batch.m_quads.resize(0);
+    }
+    m_frameDraws += m_batchCount;
+    m_batchCount = 0;
+}
+
+void MythOpenGLPainter::DiscardBatches(void)
+{
+    for (int i = 0; i < m_batchCount; ++i)
+        m_batches[i].m_quads.resize(0);
+    m_batchCount = 0;
+}
+
+/// \brief A small white texture, so solid rectangles can be batched with images.
+MythGLTexture* MythOpenGLPainter::GetWhiteTexture(void)
+{
+    if (!m_whiteTexture && m_render)
+    {
+        QImage image(4, 4, QImage::Format_ARGB32);
+        image.fill(Qt::white);
+        m_whiteTexture = m_render->CreateTextureFromQImage(&image);
+        // Stretch it to any size
+        if (m_whiteTexture)
+            m_whiteTexture->m_crop = false;
+    }
+    return m_whiteTexture;
+}
+
+static bool HasFormats(const LayoutVector &Layouts)
+{
+    foreach (auto layout, Layouts)
+    {
+#if QT_VERSION >= QT_VERSION_CHECK(5,6,0)
+        if (!layout->formats().isEmpty())
+#else
+        if (!layout->additionalFormats().isEmpty())
+#endif
+            return true;
+    }
+    return false;
+}
+
+/*! \brief Draw text from the glyph atlas, falling back to a text image.
+ *
+ * Unlike the image path, changing text does not create a new texture: the
+ * glyphs are already in the atlas and the string is one draw per atlas page.
+ */
+void MythOpenGLPainter::DrawText(const QRect &Area, const QString &Message, int Flags,
+                                 const MythFontProperties &Font, int Alpha,
+                                 const QRect &BoundRect)
+{
+    m_glyphQuads.clear();
+    if (m_render && MythGlyphCache::CanRender(Font) &&
+        m_glyphCache.GetText(Message, Flags, Area, Font, m_glyphQuads))
+    {
+        QPoint shadowOffset;
+        QColor shadowColor;
+        int shadowAlpha = 255;
+        if (Font.hasShadow())
+            Font.GetShadow(shadowOffset, shadowColor, shadowAlpha);
+        DrawGlyphs(BoundRect.isEmpty() ? Area : Area & BoundRect, shadowOffset, Font, Alpha);
+        return;
+    }
+    MythPainter::DrawText(Area, Message, Flags, Font, Alpha, BoundRect);
+}
+
+void MythOpenGLPainter::DrawTextLayout(const QRect &Canvas, const LayoutVector &Layouts,
+                                       const FormatVector &Formats,
+                                       const MythFontProperties &Font, int Alpha,
+                                       const QRect &Dest)
+{
+    m_glyphQuads.clear();
+    if (m_render && !Canvas.isNull() && Formats.isEmpty() && !HasFormats(Layouts) &&
+        MythGlyphCache::CanRender(Font) &&
+        m_glyphCache.GetTextLayout(Layouts, Dest.topLeft() + Canvas.topLeft(), m_glyphQuads))
+    {
+        QPoint shadowOffset;
+        QColor shadowColor;
+        int shadowAlpha = 255;
+        if (Font.hasShadow())
         {
-            QOpenGLBuffer *vbo = texture->m_vbo;
-            texture->m_vbo = m_mappedBufferPool[m_mappedBufferPoolIdx];
-            texture->m_destination = QRect();
-            m_render->DrawBitmap(texture, m_target, Source, Dest, nullptr, Alpha);
-            texture->m_destination = QRect();
-            texture->m_vbo = vbo;
-            if (++m_mappedBufferPoolIdx >= MAX_BUFFER_POOL)
-                m_mappedBufferPoolIdx = 0;
+            Font.GetShadow(shadowOffset, shadowColor, shadowAlpha);
+            MythPoint shadow(shadowOffset);
+            shadow.NormPoint();
+            shadowOffset = shadow.toQPoint();
+        }
+
+        // The image path draws into an image of the canvas size and crops it
+        QRect clip(Dest.topLeft(), QSize(min(Canvas.width(), Dest.width()),
+                                         min(Canvas.height(), Dest.height())));
+        DrawGlyphs(clip, shadowOffset, Font, Alpha);
+        return;
+    }
+    MythPainter::DrawTextLayout(Canvas, Layouts, Formats, Font, Alpha, Dest);
+}
+
+/// \brief Upload the parts of the atlas pages that have changed.
+void MythOpenGLPainter::UpdateGlyphTextures(void)
+{
+    for (int i = 0; i < m_glyphCache.PageCount(); ++i)
+    {
+        if (i >= m_glyphTextures.size())
+            m_glyphTextures.append(nullptr);
+
+        QRect changed = m_glyphCache.GetPageChanges(i);
+        if (changed.isEmpty() && m_glyphTextures[i])
+            continue;
+
+        // Queued text may use this page as it was
+        FlushBatches();
+
+        const QImage &page = m_glyphCache.GetPage(i);
+        MythGLTexture *texture = m_glyphTextures[i];
+        if (!texture || !texture->m_texture)
+        {
+            m_render->DeleteTexture(texture);
+            QImage image(page);
+            m_glyphTextures[i] = m_render->CreateTextureFromQImage(&image);
         }
         else
         {
-            m_render->DrawBitmap(texture, m_target, Source, Dest, nullptr, Alpha);
-            m_mappedTextures.append(texture);
+            // Upload whole rows, which are contiguous in the image
+            texture->m_texture->bind();
+            m_render->glTexSubImage2D(GL_TEXTURE_2D, 0, 0, changed.top(), page.width(),
+                                      changed.height(), GL_RGBA, GL_UNSIGNED_BYTE,
+                                      page.constScanLine(changed.top()));
+            texture->m_texture->release();
         }
+        m_glyphCache.ClearPageChanges(i);
+    }
+}
+
+void MythOpenGLPainter::DrawGlyphs(const QRect &Clip, const QPoint &ShadowOffset,
+                                   const MythFontProperties &Font, int Alpha)
+{
+    if (m_glyphQuads.isEmpty())
+        return;
+
+    UpdateGlyphTextures();
+
+    if (Font.hasShadow())
+    {
+        QPoint offset;
+        QColor color;
+        int alpha = 255;
+        Font.GetShadow(offset, color, alpha);
+        color.setAlpha(alpha);
+        AddGlyphQuads(Clip, ShadowOffset, color, Alpha);
+    }
+    AddGlyphQuads(Clip, QPoint(), Font.color(), Alpha);
+}
+
+/// \brief Queue the current glyph quads, clipped and tinted.
+void MythOpenGLPainter::AddGlyphQuads(const QRect &Clip, const QPoint &Offset,
+                                      const QColor &Color, int Alpha)
+{
+    QRgb color = qRgba(Color.red(), Color.green(), Color.blue(),
+                       (Color.alpha() * Alpha) / 255);
+    for (const auto & quad : m_glyphQuads)
+    {
+        if (quad.m_page >= m_glyphTextures.size() || !m_glyphTextures[quad.m_page])
+            continue;
+        QRect dest = quad.m_destination.translated(Offset);
+        QRect clipped = dest & Clip;
+        if (clipped.isEmpty())
+            continue;
+        AddQuad(m_glyphTextures[quad.m_page],
+                QRect(quad.m_source.topLeft() + (clipped.topLeft() - dest.topLeft()), clipped.size()),
+                clipped, color);
     }
 }
 
 void MythOpenGLPainter::DrawRect(const QRect &Area, const QBrush &FillBrush,
                                  const QPen &LinePen, int Alpha)
 {
+    if (FillBrush.style() == Qt::SolidPattern && LinePen.style() == Qt::NoPen &&
+        m_render && GetWhiteTexture())
+    {
+        QColor color = FillBrush.color();
+        AddQuad(m_whiteTexture, QRect(0, 0, 4, 4), Area,
+                qRgba(color.red(), color.green(), color.blue(), (color.alpha() * Alpha) / 255));
+        return;
+    }
+
     if ((FillBrush.style() == Qt::SolidPattern ||
          FillBrush.style() == Qt::NoBrush) && m_render)
     {
+        FlushBatches();
         m_render->DrawRect(m_target, Area, FillBrush, LinePen, Alpha);
         return;
     }
@@ -272,6 +547,7 @@ void MythOpenGLPainter::DrawRoundRect(const QRect &Area, int CornerRadius,
     if ((FillBrush.style() == Qt::SolidPattern ||
          FillBrush.style() == Qt::NoBrush) && m_render)
     {
+        FlushBatches();
         m_render->DrawRoundRect(m_target, Area, CornerRadius, FillBrush,
                                   LinePen, Alpha);
         return;
@@ -286,18 +562,20 @@ void MythOpenGLPainter::DeleteFormatImagePriv(MythImage *Image)
         QMutexLocker locker(&m_textureDeleteLock);
         m_textureDeleteList.push_back(m_imageToTextureMap[Image]);
         m_imageToTextureMap.remove(Image);
-        m_ImageExpireList.remove(Image);
+        m_ImageExpireList.remove(m_imageUsed.take(Image));
     }
 }
 
 void MythOpenGLPainter::PushTransformation(const UIEffects &Fx, QPointF Center)
 {
+    FlushBatches();
     if (m_render)
         m_render->PushTransformation(Fx, Center);
 }
 
 void MythOpenGLPainter::PopTransformation(void)
 {
+    FlushBatches();
     if (m_render)
         m_render->PopTransformation();
 }
@@ -2,23 +2,23 @@
 #define MYTHPAINTER_OPENGL_H_
 
 // Qt
+#include <QHash>
+#include <QMap>
 #include <QMutex>
 #include <QQueue>
 
 // MythTV
 #include "mythpainter.h"
 #include "mythimage.h"
+#include "mythglyphcache.h"
+#include "mythrenderopengl.h"
 
 // Std
 #include <list>
 
 class QWidget;
-class MythGLTexture;
-class MythRenderOpenGL;
-class QOpenGLBuffer;
 class QOpenGLFramebufferObject;
-
-#define MAX_BUFFER_POOL 70
+class MythOpenGLPerf;
 
 class MUI_PUBLIC MythOpenGLPainter : public MythPainter
 {
@@ -26,7 +26,7 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
     explicit MythOpenGLPainter(MythRenderOpenGL *Render = nullptr, QWidget *Parent = nullptr);
    ~MythOpenGLPainter() override;
 
-    void SetTarget(QOpenGLFramebufferObject* NewTarget) { m_target = NewTarget; }
+    void SetTarget(QOpenGLFramebufferObject* NewTarget);
     void SetSwapControl(bool Swap) { m_swapControl = Swap; }
     void DeleteTextures(void);
 
@@ -39,6 +39,12 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
     void Begin(QPaintDevice *Parent) override;
     void End() override;
     void DrawImage(const QRect &Dest, MythImage *Image, const QRect &Source, int Alpha) override;
+    void DrawText(const QRect &Area, const QString &Message, int Flags,
+                  const MythFontProperties &Font, int Alpha,
+                  const QRect &BoundRect) override;
+    void DrawTextLayout(const QRect &Canvas, const LayoutVector &Layouts,
+                        const FormatVector &Formats, const MythFontProperties &Font,
+                        int Alpha, const QRect &Dest) override;
     void DrawRect(const QRect &Area, const QBrush &FillBrush,
                   const QPen &LinePen, int Alpha) override;
     void DrawRoundRect(const QRect &Area, int CornerRadius,
@@ -49,6 +55,19 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
   protected:
     void  ClearCache(void);
     MythGLTexture* GetTextureFromCache(MythImage *Image);
+    quint64 OldestTexture(void) const;
+    bool  ExpireTexture(void);
+    void  UpdateGlyphTextures(void);
+    void  DeleteGlyphTextures(void);
+    void  DrawGlyphs(const QRect &Clip, const QPoint &ShadowOffset,
+                     const MythFontProperties &Font, int Alpha);
+    void  AddGlyphQuads(const QRect &Clip, const QPoint &Offset,
+                        const QColor &Color, int Alpha);
+    void  AddQuad(MythGLTexture *Texture, const QRect &Source,
+                  const QRect &Dest, QRgb Color);
+    void  FlushBatches(void);
+    void  DiscardBatches(void);
+    MythGLTexture* GetWhiteTexture(void);
 
     // MythPainter
     MythImage* GetFormatImagePriv(void) override { return new MythImage(this); }
@@ -62,14 +81,31 @@ class MUI_PUBLIC MythOpenGLPainter : public MythPainter
     QSize             m_lastSize { };
 
     QMap<MythImage *, MythGLTexture*> m_imageToTextureMap;
-    std::list<MythImage *>     m_ImageExpireList;
+    QHash<MythImage *, quint64> m_imageUsed;       ///< last use of each texture
+    QMap<quint64, MythImage *> m_ImageExpireList;  ///< textures by last use
     std::list<MythGLTexture*>  m_textureDeleteList;
     QMutex                     m_textureDeleteLock;
 
-    QVector<MythGLTexture*>    m_mappedTextures;
-    QOpenGLBuffer*             m_mappedBufferPool[MAX_BUFFER_POOL] { nullptr };
-    int                        m_mappedBufferPoolIdx { 0 };
-    bool                       m_mappedBufferPoolReady { false };
+    MythGlyphCache             m_glyphCache;
+    QVector<MythGLTexture*>    m_glyphTextures;
+    MythGlyphCache::Quads      m_glyphQuads;
+    MythGLTexture*             m_whiteTexture { nullptr };
+
+    /// Quads waiting to be drawn, in drawing order, with one texture per batch
+    struct Batch
+    {
+        MythGLTexture*      m_texture { nullptr };
+        QRect               m_bounds;
+        QVector<MythGLQuad> m_quads;
+    };
+    QVector<Batch>             m_batches;
+    int                        m_batchCount { 0 };
+
+    MythOpenGLPerf*            m_openGLPerf { nullptr };
+    bool                       m_openGLPerfChecked { false };
+    int                        m_frames { 0 };
+    int                        m_frameQuads { 0 };
+    int                        m_frameDraws { 0 };
 };
 
 #endif
@@ -1,6 +1,8 @@
 // Std
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <utility>
 using std::min;
 
 // Qt
@@ -886,6 +888,111 @@ void MythRenderOpenGL::DrawBitmap(MythGLTexture **Textures, uint TextureCount,
     doneCurrent();
 }
 
+/*! \brief Draw many parts of one texture with a single draw call.
+ *
+ * Each quad is drawn from its source to its destination, tinted by its own
+ * color, so quads with different alpha values can share a draw. Sources are
+ * cropped in the same way as DrawBitmap. The vertices are interleaved and
+ * streamed into a single buffer that is respecified for every call, so the
+ * driver never has to wait for the previous draw to finish.
+ */
+void MythRenderOpenGL::DrawBitmaps(MythGLTexture *Texture, QOpenGLFramebufferObject *Target,
+                                   const QVector<MythGLQuad> &Quads)
+{
+    if (Quads.isEmpty() || !Texture || !(Texture->m_texture || Texture->m_textureId) ||
+        Texture->m_size.isEmpty())
+    {
+        return;
+    }
+
+    makeCurrent();
+    if (!m_quadBuffer)
+        m_quadBuffer = CreateVBO(static_cast<int>(kVertexSize));
+    if (!m_quadBuffer)
+    {
+        doneCurrent();
+        return;
+    }
+
+    BindFramebuffer(Target);
+    QOpenGLShaderProgram* program = m_defaultPrograms[kShaderDefault];
+    SetShaderProjection(program);
+
+    program->setUniformValue("s_texture0", 0);
+    ActiveTexture(GL_TEXTURE0);
+    if (Texture->m_texture)
+        Texture->m_texture->bind();
+    else
+        glBindTexture(Texture->m_target, Texture->m_textureId);
+
+    // Two triangles per quad
+    QSize size = Texture->m_size;
+    bool normalised = Texture->m_target != QOpenGLTexture::TargetRectangle;
+    GLfloat xscale  = normalised ? size.width()  : 1.0F;
+    GLfloat yscale  = normalised ? size.height() : 1.0F;
+    m_quadData.resize(Quads.size() * 6);
+    MythGLVertex* vertex = m_quadData.data();
+
+    for (const auto & quad : Quads)
+    {
+        const QRect &src = quad.m_source;
+        const QRect &dst = quad.m_destination;
+        int width  = Texture->m_crop ? min(src.width(),  size.width())  : src.width();
+        int height = Texture->m_crop ? min(src.height(), size.height()) : src.height();
+        GLfloat sleft   = src.left() / xscale;
+        GLfloat stop    = src.top() / yscale;
+        GLfloat sright  = (src.left() + width) / xscale;
+        GLfloat sbottom = (src.top() + height) / yscale;
+        if (!Texture->m_flip)
+            std::swap(stop, sbottom);
+
+        width  = Texture->m_crop ? min(width, dst.width())   : dst.width();
+        height = Texture->m_crop ? min(height, dst.height()) : dst.height();
+        GLfloat left   = dst.left();
+        GLfloat top    = dst.top();
+        GLfloat right  = dst.left() + width;
+        GLfloat bottom = dst.top() + height;
+
+        const MythGLVertex corners[4] =
+        {
+            { { left,  top    }, { sleft,  stop    }, { 0, 0, 0, 0 } },
+            { { left,  bottom }, { sleft,  sbottom }, { 0, 0, 0, 0 } },
+            { { right, top    }, { sright, stop    }, { 0, 0, 0, 0 } },
+            { { right, bottom }, { sright, sbottom }, { 0, 0, 0, 0 } }
+        };
+        for (int index : { 0, 1, 2, 2, 1, 3 })
+        {
+            *vertex = corners[index];
+            vertex->m_color[0] = static_cast<GLubyte>(qRed(quad.m_color));
+            vertex->m_color[1] = static_cast<GLubyte>(qGreen(quad.m_color));
+            vertex->m_color[2] = static_cast<GLubyte>(qBlue(quad.m_color));
+            vertex->m_color[3] = static_cast<GLubyte>(qAlpha(quad.m_color));
+            vertex++;
+        }
+    }
+
+    m_quadBuffer->bind();
+    m_quadBuffer->allocate(m_quadData.constData(),
+                           m_quadData.size() * static_cast<int>(sizeof(MythGLVertex)));
+
+    static const GLsizei kStride = sizeof(MythGLVertex);
+    glEnableVertexAttribArray(VERTEX_INDEX);
+    glEnableVertexAttribArray(TEXTURE_INDEX);
+    glEnableVertexAttribArray(COLOR_INDEX);
+    glVertexAttribPointerI(VERTEX_INDEX, VERTEX_SIZE, GL_FLOAT, GL_FALSE, kStride,
+                           static_cast<GLuint>(offsetof(MythGLVertex, m_position)));
+    glVertexAttribPointerI(TEXTURE_INDEX, TEXTURE_SIZE, GL_FLOAT, GL_FALSE, kStride,
+                           static_cast<GLuint>(offsetof(MythGLVertex, m_texcoord)));
+    glVertexAttribPointerI(COLOR_INDEX, 4, GL_UNSIGNED_BYTE, GL_TRUE, kStride,
+                           static_cast<GLuint>(offsetof(MythGLVertex, m_color)));
+    glDrawArrays(GL_TRIANGLES, 0, m_quadData.size());
+    glDisableVertexAttribArray(COLOR_INDEX);
+    glDisableVertexAttribArray(TEXTURE_INDEX);
+    glDisableVertexAttribArray(VERTEX_INDEX);
+    QOpenGLBuffer::release(QOpenGLBuffer::VertexBuffer);
+    doneCurrent();
+}
+
 static const float kLimitedRangeOffset = (16.0F / 255.0F);
 static const float kLimitedRangeScale  = (219.0F / 255.0F);
 
@@ -1199,6 +1306,8 @@ void MythRenderOpenGL::ReleaseResources(void)
     DeleteDefaultShaders();
     ExpireVertices();
     ExpireVBOS();
+    delete m_quadBuffer;
+    m_quadBuffer = nullptr;
     if (m_coreProfile && m_vao)
     {
         QOpenGLExtraFunctions extra(nullptr);
@@ -18,6 +18,8 @@
 #include <QMutex>
 #include <QMatrix4x4>
 #include <QStack>
+#include <QColor>
+#include <QVector>
 
 // MythTV
 #include "mythuiexp.h"
@@ -69,6 +71,22 @@ class MUI_PUBLIC MythGLTexture
     Q_DISABLE_COPY(MythGLTexture)
 };
 
+/// One part of a texture for MythRenderOpenGL::DrawBitmaps
+struct MythGLQuad
+{
+    QRect m_source;
+    QRect m_destination;
+    QRgb  m_color;      ///< tint, including the alpha of the quad
+};
+
+/// Interleaved vertex layout used by MythRenderOpenGL::DrawBitmaps
+struct MythGLVertex
+{
+    GLfloat m_position[2];
+    GLfloat m_texcoord[2];
+    GLubyte m_color[4];
+};
+
 enum DefaultShaders
 {
     kShaderSimple  = 0,
@@ -148,6 +166,8 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
                      QOpenGLFramebufferObject *Target,
                      const QRect &Source, const QRect &Destination,
                      QOpenGLShaderProgram *Program, int Rotation);
+    void  DrawBitmaps(MythGLTexture *Texture, QOpenGLFramebufferObject *Target,
+                      const QVector<MythGLQuad> &Quads);
     void  DrawRect(QOpenGLFramebufferObject *Target,
                    const QRect &Area, const QBrush &FillBrush,
                    const QPen &LinePen, int Alpha);
@@ -197,6 +217,8 @@ class MUI_PUBLIC MythRenderOpenGL : public QOpenGLContext, public QOpenGLFunctio
     QList<uint64_t>              m_vertexExpiry;
     QMap<uint64_t,QOpenGLBuffer*>m_cachedVBOS;
     QList<uint64_t>              m_vboExpiry;
+    QOpenGLBuffer*               m_quadBuffer { nullptr };
+    QVector<MythGLVertex>        m_quadData;
 
     // Locking
     QMutex     m_lock { QMutex::Recursive };
@@ -0,0 +1,205 @@
+/*
+ *  Class TestMythTextTemplate
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <QRegExp>
+
+#include "test_mythtexttemplate.h"
+
+// The expansion MythUIText::SetTextFromMap used before templates were compiled
+static QString RegexExpand(const QString &Template, const InfoMap &Map)
+{
+    QRegExp regexp("%(([^\\|%]+)?\\||\\|(.))?([\\w#]+)(\\|(.+))?%");
+    regexp.setMinimal(true);
+
+    int pos = 0;
+    QString tempString = Template;
+
+    while ((pos = regexp.indexIn(Template, pos)) != -1)
+    {
+        QString key = regexp.cap(4).toLower().trimmed();
+        QString replacement;
+
+        if (!Map.value(key).isEmpty())
+        {
+            replacement = QString("%1%2%3%4")
+            .arg(regexp.cap(2))
+            .arg(regexp.cap(3))
+            .arg(Map.value(key))
+            .arg(regexp.cap(6));
+        }
+
+        tempString.replace(regexp.cap(0), replacement);
+        pos += regexp.matchedLength();
+    }
+
+    return tempString;
+}
+
+void TestMythTextTemplate::initTestCase(void)
+{
+    // Roughly what ProgramInfo::ToMap gives for a recording
+    m_map["title"]            = "Doctor Who";
+    m_map["subtitle"]         = "The Day of the Doctor";
+    m_map["titlesubtitle"]    = "Doctor Who - The Day of the Doctor";
+    m_map["description"]      = "In 2013, something terrible is awakening in "
+                                "London's National Gallery.";
+    m_map["description0"]     = m_map["description"];
+    m_map["category"]         = "Drama";
+    m_map["season"]           = "7";
+    m_map["episode"]          = "14";
+    m_map["totalepisodes"]    = "";
+    m_map["s00e00"]           = "s07e14";
+    m_map["00x00"]            = "7x14";
+    m_map["syndicatedepisode"] = "";
+    m_map["year"]             = "2013";
+    m_map["yearstars"]        = "(2013)";
+    m_map["stars"]            = "";
+    m_map["rating"]           = "PG";
+    m_map["startdate"]        = "Sat 23 November";
+    m_map["starttime"]        = "19:50";
+    m_map["enddate"]          = "Sat 23 November";
+    m_map["endtime"]          = "21:05";
+    m_map["timedate"]         = "Sat 23 November, 19:50 - 21:05";
+    m_map["recstartdate"]     = "Sat 23 November";
+    m_map["recstarttime"]     = "19:48";
+    m_map["recendtime"]       = "21:10";
+    m_map["lenmins"]          = "75 minutes";
+    m_map["lentime"]          = "1 hour 15 mins";
+    m_map["channum"]          = "101";
+    m_map["callsign"]         = "BBC One";
+    m_map["channame"]         = "BBC One HD";
+    m_map["chanid"]           = "1101";
+    m_map["inetref"]          = "tmdb3.py_1234";
+    m_map["originalairdate"]  = "2013-11-23";
+    m_map["playgroup"]        = "Default";
+    m_map["recgroup"]         = "Default";
+    m_map["storagegroup"]     = "Default";
+    m_map["recordingprofile"] = "Default";
+    m_map["filesize_str"]     = "6.2 GB";
+    m_map["programflags"]     = "";
+    m_map["videoproperties"]  = "HDTV";
+    m_map["audioproperties"]  = "Stereo";
+    m_map["subtitletype"]     = "";
+    m_map["partnumber"]       = "";
+    m_map["parttotal"]        = "";
+    m_map["director"]         = "Nick Hurran";
+    m_map["cast"]             = "Matt Smith, David Tennant, Billie Piper";
+    m_map["rectype"]          = "Record One";
+    m_map["recstatus"]        = "Recorded";
+    m_map["lastmodifieddate"] = "Sat 23 November";
+    m_map["lastmodifiedtime"] = "21:12";
+
+    m_templates << "%TITLE%"
+                << "%SUBTITLE%"
+                << "%TITLE%% - |SUBTITLE%"
+                << "%Season |SEASON| %%Episode |EPISODE%"
+                << "%STARTDATE|, %%STARTTIME% - %ENDTIME%"
+                << "%YEARSTARS| %%CATEGORY%"
+                << "%CHANNUM% %CALLSIGN%"
+                << "%(|LENMINS|)%"
+                << "%DESCRIPTION%"
+                << "%\n\nDirector: |DIRECTOR%%\n\nCast: |CAST%";
+}
+
+void TestMythTextTemplate::Expand_data(void)
+{
+    QTest::addColumn<QString>("tmpl");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("key")          << "%TITLE%" << "Doctor Who";
+    QTest::newRow("lowercase")    << "%title%" << "Doctor Who";
+    QTest::newRow("prefix")       << "%TITLE%% - |SUBTITLE%"
+                                  << "Doctor Who - The Day of the Doctor";
+    QTest::newRow("both")         << "%Season |SEASON| %%Episode |EPISODE%"
+                                  << "Season 7 Episode 14";
+    QTest::newRow("suffix")       << "%STARTDATE|, %%STARTTIME% - %ENDTIME%"
+                                  << "Sat 23 November, 19:50 - 21:05";
+    QTest::newRow("brackets")     << "%(|YEAR|)%" << "(2013)";
+    QTest::newRow("char prefix")  << "%|(RATING|)%" << "(PG)";
+    QTest::newRow("empty value")  << "%TITLE% %(|STARS|) %" << "Doctor Who ";
+    QTest::newRow("missing key")  << "%TITLE%%\n(|UNKNOWN|)%" << "Doctor Who";
+    QTest::newRow("literal %")    << "100% %TITLE%" << "100% Doctor Who";
+    QTest::newRow("no fields")    << "Recordings" << "Recordings";
+}
+
+void TestMythTextTemplate::Expand(void)
+{
+    QFETCH(QString, tmpl);
+    QFETCH(QString, expected);
+
+    QString result;
+    MythTextTemplate(tmpl).Expand(m_map, result);
+    QCOMPARE(result, expected);
+    QCOMPARE(RegexExpand(tmpl, m_map), expected);
+}
+
+void TestMythTextTemplate::MissingKeys(void)
+{
+    MythTextTemplate compiled("Title: %TITLE%% - |SUBTITLE%");
+    QVERIFY(compiled.HasFields());
+
+    QString result;
+    QVERIFY(!compiled.Expand(InfoMap(), result));
+    QCOMPARE(result, QString("Title: "));
+
+    // A key that is present but empty still counts as found
+    InfoMap map;
+    map["title"] = "";
+    QVERIFY(compiled.Expand(map, result));
+    QCOMPARE(result, QString("Title: "));
+
+    QVERIFY(!MythTextTemplate("Recordings").HasFields());
+}
+
+void TestMythTextTemplate::UsesAny(void)
+{
+    MythTextTemplate compiled("%TITLE%% - |SUBTITLE%");
+    InfoMap map;
+    QVERIFY(!compiled.UsesAny(map));
+    map["description"] = "text";
+    QVERIFY(!compiled.UsesAny(map));
+    map["subtitle"] = "";
+    QVERIFY(compiled.UsesAny(map));
+}
+
+/// The text widgets of one recording in a button list, as before
+void TestMythTextTemplate::Regex_timing(void)
+{
+    QBENCHMARK {
+        for (const auto & tmpl : qAsConst(m_templates))
+            QVERIFY(!RegexExpand(tmpl, m_map).isEmpty());
+    }
+}
+
+/// The same widgets, with the templates compiled at theme load
+void TestMythTextTemplate::Compiled_timing(void)
+{
+    QVector<MythTextTemplate> compiled;
+    for (const auto & tmpl : qAsConst(m_templates))
+        compiled.append(MythTextTemplate(tmpl));
+
+    QString result;
+    QBENCHMARK {
+        for (const auto & tmpl : qAsConst(compiled))
+        {
+            tmpl.Expand(m_map, result);
+            QVERIFY(!result.isEmpty());
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestMythTextTemplate)
@@ -0,0 +1,198 @@
+/*
+ *  Class TestMythUIButtonList
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <QVector>
+
+#include "mythuibuttonlist.h"
+#include "mythuigroup.h"
+#include "mythuistatetype.h"
+
+#include "test_mythuibuttonlist.h"
+
+using CheckState = MythUIButtonListItem::CheckState;
+
+/// Items are kept this far from the visible buttons
+static const int kMargin  = 5;
+/// Buttons shown by TestList
+static const int kVisible = 10;
+
+/// Numbered, checkable items, with the check states kept here
+class NumberProvider : public MythUIButtonListProvider
+{
+  public:
+    explicit NumberProvider(int count)
+      : m_checked(count, MythUIButtonListItem::NotChecked) {}
+
+    int GetItemCount(void) const override
+        { return m_checked.size(); }
+
+    void FillItem(MythUIButtonListItem *item, int pos) override
+    {
+        item->SetText(QString::number(pos));
+        item->SetData(pos);
+        item->setCheckable(true);
+        item->setChecked(m_checked[pos]);
+        m_filled++;
+    }
+
+    int GetItemPos(const QVariant &data) const override
+    {
+        bool ok = false;
+        int pos = data.toInt(&ok);
+        return (ok && pos >= 0 && pos < GetItemCount()) ? pos : -1;
+    }
+
+    void SetItemChecked(int pos, CheckState state) override
+        { m_checked[pos] = state; }
+
+    QVector<CheckState> m_checked;
+    int                 m_filled {0};
+};
+
+/// A vertical list of ten buttons, built without a theme
+class TestList : public MythUIButtonList
+{
+  public:
+    TestList()
+      : MythUIButtonList(nullptr, "list", QRect(0, 0, 100, 100), false, false)
+    {
+        auto *buttonItem = new MythUIStateType(this, "buttonitem");
+        auto *active = new MythUIGroup(buttonItem, "active");
+        active->SetArea(MythRect(0, 0, 100, 100 / kVisible));
+        buttonItem->AddObject("active", active);
+        SetButtonArea(MythRect(0, 0, 100, 100));
+    }
+
+    /// Lay the buttons out, as drawing the list would
+    void Layout(void) { QCOMPARE(GetVisibleCount(), (uint)kVisible); }
+
+    int  ItemsCreated(void) const { return m_providedItems.size(); }
+    bool HasItem(int pos) const { return m_itemList.at(pos) != nullptr; }
+};
+
+/// Only the items around the visible buttons are created
+void TestMythUIButtonList::Provider_visibleOnly(void)
+{
+    NumberProvider provider(100000);
+    TestList list;
+    list.SetProvider(&provider, kMargin);
+    list.Layout();
+
+    QCOMPARE(list.GetCount(), 100000);
+    QVERIFY(provider.m_filled <= kVisible);
+    QCOMPARE(list.GetItemCurrent()->GetText(), QString("0"));
+}
+
+/// Items scrolled well out of view are deleted, and created again on
+/// the way back
+void TestMythUIButtonList::Provider_scroll(void)
+{
+    NumberProvider provider(1000);
+    TestList list;
+    list.SetProvider(&provider, kMargin);
+    list.Layout();
+
+    for (int page = 0; page < 50; page++)
+    {
+        list.MoveDown(MythUIButtonList::MovePage);
+        list.Layout();
+        QVERIFY(list.ItemsCreated() <= kVisible + (2 * kMargin) + 2);
+    }
+    int pos = list.GetCurrentPos();
+    QVERIFY(pos >= 50 * (kVisible - 1));
+    QCOMPARE(list.GetItemCurrent()->GetText(), QString::number(pos));
+    QVERIFY(!list.HasItem(0));
+
+    list.SetItemCurrent(0);
+    list.Layout();
+    QVERIFY(list.HasItem(0));
+    QVERIFY(!list.HasItem(pos));
+    QCOMPARE(list.GetItemAt(0)->GetText(), QString("0"));
+    QCOMPARE(list.GetItemCurrent()->GetData().toInt(), 0);
+}
+
+/// A check state set on an item survives the item being deleted
+void TestMythUIButtonList::Provider_checkState(void)
+{
+    NumberProvider provider(1000);
+    TestList list;
+    list.SetProvider(&provider, kMargin);
+    list.Layout();
+
+    list.GetItemAt(3)->setChecked(MythUIButtonListItem::FullChecked);
+    QCOMPARE(provider.m_checked[3], MythUIButtonListItem::FullChecked);
+
+    list.SetItemCurrent(900);
+    list.Layout();
+    QVERIFY(!list.HasItem(3));
+
+    list.SetItemCurrent(0);
+    list.Layout();
+    QCOMPARE(list.GetItemAt(3)->state(), MythUIButtonListItem::FullChecked);
+    QCOMPARE(list.GetItemAt(4)->state(), MythUIButtonListItem::NotChecked);
+}
+
+/// SetAllChecked() reaches every position without creating the items
+void TestMythUIButtonList::Provider_setAllChecked(void)
+{
+    NumberProvider provider(1000);
+    TestList list;
+    list.SetProvider(&provider, kMargin);
+    list.Layout();
+
+    int filled = provider.m_filled;
+    list.SetAllChecked(MythUIButtonListItem::FullChecked);
+    QCOMPARE(provider.m_filled, filled);
+    QCOMPARE(provider.m_checked.count(MythUIButtonListItem::FullChecked), 1000);
+    QCOMPARE(list.GetItemAt(0)->state(), MythUIButtonListItem::FullChecked);
+
+    list.SetItemCurrent(999);
+    list.Layout();
+    QCOMPARE(list.GetItemAt(999)->state(), MythUIButtonListItem::FullChecked);
+}
+
+/// Selecting by data asks the provider for the position
+void TestMythUIButtonList::Provider_selectByData(void)
+{
+    NumberProvider provider(1000);
+    TestList list;
+    list.SetProvider(&provider, kMargin);
+    list.Layout();
+
+    int filled = provider.m_filled;
+    list.SetValueByData(750);
+    QCOMPARE(list.GetCurrentPos(), 750);
+    QVERIFY(provider.m_filled - filled <= 1);
+    list.Layout();
+    QCOMPARE(list.GetItemCurrent()->GetText(), QString("750"));
+
+    // Unknown data leaves the selection alone
+    list.SetValueByData(5000);
+    QCOMPARE(list.GetCurrentPos(), 750);
+
+    MythUIButtonListItem *item = list.GetItemByData(42);
+    QVERIFY(item != nullptr);
+    QCOMPARE(item->GetText(), QString("42"));
+    QVERIFY(list.GetItemByData(-1) == nullptr);
+
+    list.MoveUp(MythUIButtonList::MovePage);
+    list.Layout();
+    QVERIFY(list.GetCurrentPos() < 750);
+    QCOMPARE(list.GetItemCurrent()->GetData().toInt(), list.GetCurrentPos());
+}
+
+QTEST_APPLESS_MAIN(TestMythUIButtonList)
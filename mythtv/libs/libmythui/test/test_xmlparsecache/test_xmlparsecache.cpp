@@ -0,0 +1,268 @@
+/*
+ *  Class TestXMLParseCache
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301 USA
+ */
+#include <QDomDocument>
+
+#include "xmlparsebase.h"
+
+#include "test_xmlparsecache.h"
+
+// Compare two elements, ignoring attribute order, comments and locations
+static bool SameElement(const QDomElement &A, const QDomElement &B)
+{
+    if (A.tagName() != B.tagName())
+        return false;
+
+    QDomNamedNodeMap attra = A.attributes();
+    QDomNamedNodeMap attrb = B.attributes();
+    int counta = attra.count() - (A.hasAttribute(XMLParseCache::kLocationAttribute) ? 1 : 0);
+    int countb = attrb.count() - (B.hasAttribute(XMLParseCache::kLocationAttribute) ? 1 : 0);
+    if (counta != countb)
+        return false;
+    for (int i = 0; i < attra.count(); ++i)
+    {
+        QDomAttr attr = attra.item(i).toAttr();
+        if (attr.name() == XMLParseCache::kLocationAttribute)
+            continue;
+        if (B.attribute(attr.name()) != attr.value())
+            return false;
+    }
+
+    QDomNode a = A.firstChild();
+    QDomNode b = B.firstChild();
+    for (;;)
+    {
+        while (!a.isNull() && !a.isElement() && !a.isText())
+            a = a.nextSibling();
+        if (a.isNull() || b.isNull())
+            break;
+        if (a.isElement() != b.isElement() || a.isCDATASection() != b.isCDATASection())
+            return false;
+        if (a.isElement() && !SameElement(a.toElement(), b.toElement()))
+            return false;
+        if (a.isText() && a.nodeValue() != b.nodeValue())
+            return false;
+        a = a.nextSibling();
+        b = b.nextSibling();
+    }
+    return a.isNull() && b.isNull();
+}
+
+/// Write a theme file with the given number of windows, each with a few widgets
+QString TestXMLParseCache::WriteTheme(const QString &Name, int Windows)
+{
+    QString filename = m_dir.path() + "/" + Name;
+    QFile f(filename);
+    if (!f.open(QIODevice::WriteOnly))
+        return QString();
+
+    QTextStream out(&f);
+    out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        << "<!DOCTYPE mythuitheme SYSTEM \"http://www.mythtv.org/schema/mythuitheme.dtd\">\n"
+        << "<mythuitheme>\n"
+        << "    <include>base.xml</include>\n";
+    for (int i = 0; i < Windows; ++i)
+    {
+        out << QString("    <window name=\"window%1\" include=\"extra.xml\">\n").arg(i)
+            << "        <!-- A comment -->\n"
+            << "        <textarea name=\"title\" from=\"basetextarea\">\n"
+            << "            <area>20,10,1240,40</area>\n"
+            << "            <value><![CDATA[Title & <more>]]></value>\n"
+            << "            <align>hcenter,vcenter</align>\n"
+            << "        </textarea>\n"
+            << "        <buttonlist name=\"list\" from=\"basebuttonlist\">\n"
+            << "            <area>20,60,600,600</area>\n"
+            << "            <statetype name=\"buttonitem\">\n"
+            << "                <state name=\"active\">\n"
+            << "                    <shape name=\"background\">\n"
+            << "                        <fill style=\"gradient\">\n"
+            << "                            <gradient start=\"#333333\" end=\"#111111\" alpha=\"255\" />\n"
+            << "                        </fill>\n"
+            << "                    </shape>\n"
+            << "                </state>\n"
+            << "            </statetype>\n"
+            << "        </buttonlist>\n"
+            << "    </window>\n";
+    }
+    out << "</mythuitheme>\n";
+    return filename;
+}
+
+void TestXMLParseCache::initTestCase(void)
+{
+    QVERIFY(m_dir.isValid());
+    m_theme = WriteTheme("theme.xml", 200);
+    QVERIFY(!m_theme.isEmpty());
+}
+
+void TestXMLParseCache::RoundTrip(void)
+{
+    XMLParseCache cache(m_dir.path() + "/roundtrip");
+    XMLParseCache::FilePtr compiled = cache.Get(m_theme);
+    QVERIFY(compiled);
+    QCOMPARE(compiled->Count(), 201);
+
+    const XMLParseCache::Entry &include = compiled->GetEntry(0);
+    QCOMPARE(include.m_tag, QString("include"));
+    QCOMPARE(include.m_text, QString("base.xml"));
+
+    int index = compiled->Find("window", "window17");
+    QCOMPARE(index, 18);
+    QCOMPARE(compiled->GetEntry(index).m_include, QString("extra.xml"));
+    QCOMPARE(compiled->Find("window", "missing"), -1);
+
+    QDomDocument original;
+    QFile f(m_theme);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QVERIFY(original.setContent(&f));
+    QDomElement expected = original.documentElement().firstChildElement("window");
+    for (int i = 0; i < 17; ++i)
+        expected = expected.nextSiblingElement("window");
+
+    QDomDocument doc;
+    QDomElement element = compiled->GetElement(doc, index);
+    QVERIFY(SameElement(element, expected));
+
+    QDomElement value = element.firstChildElement("textarea").firstChildElement("value");
+    QVERIFY(value.firstChild().isCDATASection());
+    QCOMPARE(value.text(), QString("Title & <more>"));
+}
+
+void TestXMLParseCache::ReadFromDisk(void)
+{
+    QString cachedir = m_dir.path() + "/disk";
+    {
+        XMLParseCache cache(cachedir);
+        QVERIFY(cache.Get(m_theme));
+    }
+    QCOMPARE(QDir(cachedir).entryList(QDir::Files).size(), 1);
+
+    // A new cache, as in a new session, reads the compiled file
+    XMLParseCache cache(cachedir);
+    XMLParseCache::FilePtr compiled = cache.Get(m_theme);
+    QVERIFY(compiled);
+    QCOMPARE(compiled->Count(), 201);
+    QDomDocument doc;
+    QDomElement element = compiled->GetElement(doc, compiled->Find("window", "window199"));
+    QCOMPARE(element.attribute("name"), QString("window199"));
+}
+
+void TestXMLParseCache::Recompile(void)
+{
+    XMLParseCache cache(m_dir.path() + "/recompile");
+    QString filename = WriteTheme("changing.xml", 2);
+    XMLParseCache::FilePtr compiled = cache.Get(filename);
+    QVERIFY(compiled);
+    QCOMPARE(compiled->Count(), 3);
+
+    WriteTheme("changing.xml", 5);
+    compiled = cache.Get(filename);
+    QVERIFY(compiled);
+    QCOMPARE(compiled->Count(), 6);
+}
+
+void TestXMLParseCache::InvalidXML(void)
+{
+    XMLParseCache cache(m_dir.path() + "/invalid");
+    QString filename = m_dir.path() + "/invalid.xml";
+    QFile f(filename);
+    QVERIFY(f.open(QIODevice::WriteOnly));
+    f.write("<mythuitheme><window name=\"a\"></mythuitheme>");
+    f.close();
+
+    QVERIFY(!cache.Get(filename));
+    QVERIFY(!cache.Get(m_dir.path() + "/missing.xml"));
+}
+
+void TestXMLParseCache::LineNumbers(void)
+{
+    XMLParseCache cache(m_dir.path() + "/lines");
+    XMLParseCache::FilePtr compiled = cache.Get(m_theme);
+    QVERIFY(compiled);
+
+    QDomDocument original;
+    QFile f(m_theme);
+    QVERIFY(f.open(QIODevice::ReadOnly));
+    QVERIFY(original.setContent(&f));
+    QDomElement expected = original.documentElement().firstChildElement("window");
+    expected = expected.nextSiblingElement("window");
+
+    QDomDocument doc;
+    QDomElement element = compiled->GetElement(doc, compiled->Find("window", "window1"));
+    QCOMPARE(element.lineNumber(), -1);
+    QCOMPARE(XMLParseBase::GetLineNumber(element), expected.lineNumber());
+
+    QDomElement area = element.firstChildElement("buttonlist").firstChildElement("area");
+    QDomElement expectedArea = expected.firstChildElement("buttonlist").firstChildElement("area");
+    QCOMPARE(XMLParseBase::GetLineNumber(area), expectedArea.lineNumber());
+    QCOMPARE(XMLParseBase::GetLineNumber(expectedArea), expectedArea.lineNumber());
+}
+
+void TestXMLParseCache::Expire(void)
+{
+    QString first = WriteTheme("first.xml", 50);
+    QString second = WriteTheme("second.xml", 50);
+
+    // Room for one of the files only
+    XMLParseCache small(m_dir.path() + "/expire", 1);
+    XMLParseCache::FilePtr compiled = small.Get(first);
+    QVERIFY(compiled);
+    QCOMPARE(small.Get(first), compiled);
+    QVERIFY(small.Get(second));
+    XMLParseCache::FilePtr reread = small.Get(first);
+    QVERIFY(reread);
+    QVERIFY(reread != compiled);
+    QCOMPARE(reread->Count(), compiled->Count());
+
+    // Both fit, so the most recently used one stays
+    XMLParseCache large(m_dir.path() + "/expire");
+    compiled = large.Get(first);
+    QVERIFY(large.Get(second));
+    QCOMPARE(large.Get(first), compiled);
+}
+
+/// What loading one window cost without the cache
+void TestXMLParseCache::ParseXML_timing(void)
+{
+    QBENCHMARK {
+        QDomDocument doc;
+        QFile f(m_theme);
+        f.open(QIODevice::ReadOnly);
+        doc.setContent(&f);
+        QDomElement e = doc.documentElement().firstChildElement("window");
+        while (!e.isNull() && e.attribute("name") != "window150")
+            e = e.nextSiblingElement("window");
+        QVERIFY(!e.isNull());
+    }
+}
+
+/// Loading the same window from a compiled file, as at startup
+void TestXMLParseCache::LoadCompiled_timing(void)
+{
+    QString cachedir = m_dir.path() + "/timing";
+    XMLParseCache(cachedir).Get(m_theme);
+
+    QBENCHMARK {
+        XMLParseCache cache(cachedir);
+        XMLParseCache::FilePtr compiled = cache.Get(m_theme);
+        QDomDocument doc;
+        QDomElement e = compiled->GetElement(doc, compiled->Find("window", "window150"));
+        QVERIFY(!e.isNull());
+    }
+}
+
+QTEST_APPLESS_MAIN(TestXMLParseCache)
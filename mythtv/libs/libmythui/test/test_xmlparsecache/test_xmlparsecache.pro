@@ -0,0 +1,26 @@
+include ( ../../../../settings.pro )
+
+QT += xml sql network widgets testlib
+
+TEMPLATE = app
+TARGET = test_xmlparsecache
+INCLUDEPATH += ../..
+INCLUDEPATH += ../../../libmythbase
+
+LIBS += -L../.. -lmythui-$$LIBVERSION
+LIBS += -L../../../libmythbase -lmythbase-$$LIBVERSION
+
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../..
+QMAKE_LFLAGS += -Wl,$$_RPATH_$(PWD)/../../../libmythbase
+
+# Input
+HEADERS += test_xmlparsecache.h
+SOURCES += test_xmlparsecache.cpp
+
+QMAKE_CLEAN += $(TARGET) $(TARGETA) $(TARGETD) $(TARGET0) $(TARGET1) $(TARGET2)
+QMAKE_CLEAN += ; ( cd $(OBJECTS_DIR) && rm -f *.gcov *.gcda *.gcno )
+
+LIBS += $$EXTRA_LIBS $$LATE_LIBS
+
+# Fix runtime linking on Ubuntu 17.10.
+linux:QMAKE_LFLAGS += -Wl,--disable-new-dtags
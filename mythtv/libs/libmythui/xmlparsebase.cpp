@@ -47,6 +47,7 @@
 #include "mythuivideo.h"
 #include "mythuieditbar.h"
 #include "mythfontproperties.h"
+#include "xmlparsecache.h"
 
 #define LOC      QString("XMLParseBase: ")
 
@@ -62,6 +63,18 @@ QString XMLParseBase::getFirstText(QDomElement &element)
     return QString();
 }
 
+/**
+ *  \brief Return the source line of an element, including elements decoded
+ *         from XMLParseCache, which have no QDom line number.
+ */
+int XMLParseBase::GetLineNumber(const QDomElement &element)
+{
+    if (element.lineNumber() > 0)
+        return element.lineNumber();
+    QString location = element.attribute(XMLParseCache::kLocationAttribute);
+    return location.section(':', 0, 0).toInt();
+}
+
 bool XMLParseBase::parseBool(const QString &text)
 {
     QString s = text.toLower();
@@ -569,7 +582,7 @@ MythUIType *XMLParseBase::ParseUIType(
 
     QFileInfo fi(filename);
     uitype->SetXMLName(name);
-    uitype->SetXMLLocation(fi.fileName(), element.lineNumber());
+    uitype->SetXMLLocation(fi.fileName(), GetLineNumber(element));
 
     // If this was copied from another uitype then it already has a depends
     // map so we want to append to that one
@@ -637,6 +650,16 @@ bool XMLParseBase::WindowExists(const QString &xmlfile,
     foreach (const auto & dir, searchpath)
     {
         QString themefile = dir + xmlfile;
+
+        if (XMLParseCache::Enabled())
+        {
+            XMLParseCache::FilePtr compiled =
+                XMLParseCache::GetThemeCache()->Get(themefile);
+            if (compiled && compiled->Find("window", windowname) >= 0)
+                return true;
+            continue;
+        }
+
         QFile f(themefile);
 
         if (!f.open(QIODevice::ReadOnly))
@@ -714,6 +737,9 @@ bool XMLParseBase::doLoad(const QString &windowname,
                           bool onlyLoadWindows,
                           bool showWarnings)
 {
+    if (XMLParseCache::Enabled())
+        return doLoadCompiled(windowname, parent, filename, onlyLoadWindows, showWarnings);
+
     QDomDocument doc;
     QFile f(filename);
 
@@ -774,64 +800,119 @@ bool XMLParseBase::doLoad(const QString &windowname,
             }
 
             if (!onlyLoadWindows)
+                ParseBaseElement(filename, e, parent, showWarnings);
+        }
+        n = n.nextSibling();
+    }
+    return !onlyLoadWindows;
+}
+
+/** \fn XMLParseBase::doLoadCompiled(const QString&, MythUIType*, const QString&, bool, bool)
+ *  \brief As doLoad, but using the compiled copy of the file in the theme cache.
+ *
+ *   Only the elements that are needed are decoded, so loading one window
+ *   skips everything else in the file.
+ */
+bool XMLParseBase::doLoadCompiled(const QString &windowname,
+                                  MythUIType *parent,
+                                  const QString &filename,
+                                  bool onlyLoadWindows,
+                                  bool showWarnings)
+{
+    XMLParseCache::FilePtr compiled = XMLParseCache::GetThemeCache()->Get(filename);
+    if (!compiled)
+        return false;
+
+    QDomDocument doc;
+    for (int i = 0; i < compiled->Count(); ++i)
+    {
+        const XMLParseCache::Entry &entry = compiled->GetEntry(i);
+        if (entry.m_tag == "include" && !entry.m_text.isEmpty())
+            LoadBaseTheme(entry.m_text);
+
+        if (onlyLoadWindows && entry.m_tag == "window")
+        {
+            if (entry.m_name.isEmpty())
             {
-                QString type = e.tagName();
-                if (type == "font" || type == "fontdef")
-                {
-                    bool global = (GetGlobalObjectStore() == parent);
-                    MythFontProperties *font = MythFontProperties::ParseFromXml(
-                        filename, e, parent, global, showWarnings);
-
-                    if (!global && font)
-                    {
-                        QString name = e.attribute("name");
-                        parent->AddFont(name, font);
-                    }
-                    delete font;
-                }
-                else if (type == "imagetype" ||
-                         type == "textarea" ||
-                         type == "group" ||
-                         type == "textedit" ||
-                         type == "button" ||
-                         type == "buttonlist" ||
-                         type == "buttonlist2" ||
-                         type == "buttontree" ||
-                         type == "spinbox" ||
-                         type == "checkbox" ||
-                         type == "statetype" ||
-                         type == "window" ||
-                         type == "clock" ||
-                         type == "progressbar" ||
-                         type == "scrollbar" ||
-                         type == "webbrowser" ||
-                         type == "guidegrid" ||
-                         type == "shape" ||
-                         type == "editbar" ||
-                         type == "video")
-                {
+                LOG(VB_GENERAL, LOG_ERR, LOC +
+                    QString("%1: Window needs a name").arg(filename));
+                return false;
+            }
 
-                    // We don't want widgets in base.xml
-                    // depending on each other so ignore dependsMap
-                    QMap<QString, QString> dependsMap;
-                    MythUIType *uitype = nullptr;
-                    uitype = ParseUIType(filename, e, type, parent,
-                                         nullptr, showWarnings, dependsMap);
-                    if (uitype)
-                        uitype->ConnectDependants(true);
-                }
-                else
-                {
-                    VERBOSE_XML(VB_GENERAL, LOG_ERR, filename, e,
-                                "Unknown widget type");
-                }
+            if (!entry.m_include.isEmpty())
+                LoadBaseTheme(entry.m_include);
+
+            if (entry.m_name == windowname)
+            {
+                QDomElement e = compiled->GetElement(doc, i);
+                ParseChildren(filename, e, parent, showWarnings);
+                return true;
             }
         }
-        n = n.nextSibling();
+
+        if (!onlyLoadWindows)
+        {
+            QDomElement e = compiled->GetElement(doc, i);
+            ParseBaseElement(filename, e, parent, showWarnings);
+        }
     }
     return !onlyLoadWindows;
 }
 
+void XMLParseBase::ParseBaseElement(const QString &filename, QDomElement &e,
+                                    MythUIType *parent, bool showWarnings)
+{
+    QString type = e.tagName();
+    if (type == "font" || type == "fontdef")
+    {
+        bool global = (GetGlobalObjectStore() == parent);
+        MythFontProperties *font = MythFontProperties::ParseFromXml(
+            filename, e, parent, global, showWarnings);
+
+        if (!global && font)
+        {
+            QString name = e.attribute("name");
+            parent->AddFont(name, font);
+        }
+        delete font;
+    }
+    else if (type == "imagetype" ||
+             type == "textarea" ||
+             type == "group" ||
+             type == "textedit" ||
+             type == "button" ||
+             type == "buttonlist" ||
+             type == "buttonlist2" ||
+             type == "buttontree" ||
+             type == "spinbox" ||
+             type == "checkbox" ||
+             type == "statetype" ||
+             type == "window" ||
+             type == "clock" ||
+             type == "progressbar" ||
+             type == "scrollbar" ||
+             type == "webbrowser" ||
+             type == "guidegrid" ||
+             type == "shape" ||
+             type == "editbar" ||
+             type == "video")
+    {
+        // We don't want widgets in base.xml
+        // depending on each other so ignore dependsMap
+        QMap<QString, QString> dependsMap;
+        MythUIType *uitype = nullptr;
+        uitype = ParseUIType(filename, e, type, parent,
+                             nullptr, showWarnings, dependsMap);
+        if (uitype)
+            uitype->ConnectDependants(true);
+    }
+    else
+    {
+        VERBOSE_XML(VB_GENERAL, LOG_ERR, filename, e,
+                    "Unknown widget type");
+    }
+}
+
 bool XMLParseBase::LoadBaseTheme(void)
 {
     bool ok = false;
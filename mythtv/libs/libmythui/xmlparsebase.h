@@ -15,7 +15,8 @@ class QBrush;
     LOG(type, level, LOC + QString("%1\n\t\t\t"                           \
                              "Location: %2 @ %3\n\t\t\t"                  \
                              "Name: '%4'\tType: '%5'")                    \
-            .arg(msg).arg(filename).arg((element).lineNumber())             \
+            .arg(msg).arg(filename)                                       \
+            .arg(XMLParseBase::GetLineNumber(element))                    \
             .arg((element).attribute("name", "")).arg((element).tagName()))
 
 
@@ -23,6 +24,7 @@ class MUI_PUBLIC XMLParseBase
 {
   public:
     static QString getFirstText(QDomElement &element);
+    static int GetLineNumber(const QDomElement &element);
     static bool parseBool(const QString &text);
     static bool parseBool(QDomElement &element);
     static MythPoint parsePoint(const QString &text, bool normalize = true);
@@ -65,6 +67,11 @@ class MUI_PUBLIC XMLParseBase
     static bool doLoad(const QString &windowname, MythUIType *parent,
                        const QString &filename,
                        bool onlyLoadWindows, bool showWarnings);
+    static bool doLoadCompiled(const QString &windowname, MythUIType *parent,
+                               const QString &filename,
+                               bool onlyLoadWindows, bool showWarnings);
+    static void ParseBaseElement(const QString &filename, QDomElement &element,
+                                 MythUIType *parent, bool showWarnings);
     static void ConnectDependants(MythUIType * parent,
                                     QMap<QString, QString> &dependsMap);
 
@@ -0,0 +1,426 @@
+// Own header
+#include "xmlparsecache.h"
+
+// C++/C headers
+#include <cstdlib>
+#include <functional>
+#include <utility>
+
+// QT headers
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QDomDocument>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+// libmyth headers
+#include "mythlogging.h"
+
+// Mythui headers
+#include "mythuihelper.h"
+#include "xmlparsebase.h"
+
+#define LOC      QString("XMLParseCache: ")
+
+static const quint32 kCacheMagic   = 0x4d544843; // MTHC
+static const quint32 kCacheVersion = 2;
+
+const QString XMLParseCache::kLocationAttribute = "mythui-location";
+
+enum NodeKind : quint8
+{
+    kNodeElement = 1,
+    kNodeText    = 2,
+    kNodeCData   = 3,
+};
+
+XMLParseCache::XMLParseCache(QString CacheDir, qint64 MaxMemory)
+  : m_cacheDir(std::move(CacheDir)),
+    m_maxMemory(MaxMemory)
+{
+}
+
+/// \brief The cache used for the theme, kept in the theme cache directory.
+XMLParseCache* XMLParseCache::GetThemeCache(void)
+{
+    static XMLParseCache s_cache;
+    s_cache.SetCacheDir(GetMythUI()->GetThemeCacheDir() + "/xml");
+    return &s_cache;
+}
+
+bool XMLParseCache::Enabled(void)
+{
+    static bool s_enabled = (getenv("DISABLETHEMECACHE") == nullptr);
+    return s_enabled;
+}
+
+void XMLParseCache::SetCacheDir(const QString &CacheDir)
+{
+    QMutexLocker locker(&m_lock);
+    m_cacheDir = CacheDir;
+}
+
+void XMLParseCache::Clear(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_files.clear();
+    m_lru.clear();
+    m_memoryUsed = 0;
+}
+
+void XMLParseCache::Insert(const QString &Filename, const FilePtr &Compiled)
+{
+    Remove(Filename);
+    m_files.insert(Filename, Compiled);
+    m_lru.push_back(Filename);
+    m_memoryUsed += Compiled->MemoryUsed();
+
+    // Always keep the newest file, even if it is bigger than the budget
+    while ((m_memoryUsed > m_maxMemory) && (m_lru.size() > 1))
+        Remove(m_lru.front());
+}
+
+void XMLParseCache::Remove(const QString &Filename)
+{
+    auto it = m_files.find(Filename);
+    if (it == m_files.end())
+        return;
+    m_memoryUsed -= (*it)->MemoryUsed();
+    m_files.erase(it);
+    m_lru.remove(Filename);
+}
+
+/** \fn XMLParseCache::Get(const QString&)
+ *  \brief Return the compiled form of a theme file.
+ *
+ *   Recently used files are kept in memory, others are read from the cache
+ *   directory or compiled from the XML.
+ *
+ *   \return nullptr if the file does not exist or is not valid XML
+ */
+XMLParseCache::FilePtr XMLParseCache::Get(const QString &Filename)
+{
+    QFileInfo info(Filename);
+    if (!info.isFile())
+        return nullptr;
+
+    qint64 size = info.size();
+    qint64 modified = info.lastModified().toMSecsSinceEpoch();
+
+    QMutexLocker locker(&m_lock);
+    auto it = m_files.constFind(Filename);
+    if (it != m_files.constEnd() && (*it)->m_size == size &&
+        (*it)->m_modified == modified)
+    {
+        m_lru.remove(Filename);
+        m_lru.push_back(Filename);
+        return *it;
+    }
+
+    QString path = GetCachePath(Filename);
+    FilePtr result = ReadCompiled(path, size, modified);
+    if (!result)
+    {
+        QSharedPointer<File> compiled = Compile(Filename, size, modified);
+        if (!compiled)
+            return nullptr;
+        WriteCompiled(path, *compiled);
+        result = compiled;
+    }
+
+    Insert(Filename, result);
+    return result;
+}
+
+QString XMLParseCache::GetCachePath(const QString &Filename) const
+{
+    if (m_cacheDir.isEmpty())
+        return QString();
+
+    QByteArray hash = QCryptographicHash::hash(
+        QFileInfo(Filename).absoluteFilePath().toUtf8(), QCryptographicHash::Md5);
+    return m_cacheDir + "/" + QFileInfo(Filename).completeBaseName() + "." +
+        hash.toHex() + ".bin";
+}
+
+XMLParseCache::FilePtr XMLParseCache::ReadCompiled(const QString &Path, qint64 Size,
+                                                   qint64 Modified) const
+{
+    if (Path.isEmpty())
+        return nullptr;
+
+    QFile f(Path);
+    if (!f.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    QDataStream stream(&f);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != kCacheMagic || version != kCacheVersion)
+        return nullptr;
+
+    QSharedPointer<File> result(new File);
+    if (!result->Read(stream) || result->m_size != Size ||
+        result->m_modified != Modified)
+    {
+        return nullptr;
+    }
+
+    LOG(VB_GUI | VB_FILE, LOG_DEBUG, LOC + QString("Using compiled %1").arg(Path));
+    return result;
+}
+
+void XMLParseCache::WriteCompiled(const QString &Path, const File &Compiled) const
+{
+    if (Path.isEmpty())
+        return;
+
+    QDir().mkpath(m_cacheDir);
+    QSaveFile f(Path);
+    if (!f.open(QIODevice::WriteOnly))
+    {
+        LOG(VB_GUI | VB_FILE, LOG_WARNING, LOC +
+            QString("Unable to write %1").arg(Path));
+        return;
+    }
+
+    QDataStream stream(&f);
+    stream << kCacheMagic << kCacheVersion;
+    Compiled.Write(stream);
+    if (!f.commit())
+    {
+        LOG(VB_GUI | VB_FILE, LOG_WARNING, LOC +
+            QString("Unable to write %1").arg(Path));
+    }
+}
+
+/// \brief Parse a theme file and encode it.
+QSharedPointer<XMLParseCache::File> XMLParseCache::Compile(const QString &Filename,
+                                                           qint64 Size, qint64 Modified)
+{
+    QDomDocument doc;
+    QFile f(Filename);
+
+    if (!f.open(QIODevice::ReadOnly))
+        return nullptr;
+
+    QString errorMsg;
+    int errorLine = 0;
+    int errorColumn = 0;
+
+    if (!doc.setContent(&f, false, &errorMsg, &errorLine, &errorColumn))
+    {
+        LOG(VB_GENERAL, LOG_ERR, LOC +
+            QString("Location: '%1' @ %2 column: %3"
+                    "\n\t\t\tError: %4")
+                .arg(qPrintable(Filename)).arg(errorLine).arg(errorColumn)
+                .arg(qPrintable(errorMsg)));
+        return nullptr;
+    }
+
+    f.close();
+
+    QSharedPointer<File> result(new File);
+    result->m_size = Size;
+    result->m_modified = Modified;
+
+    QHash<QString,quint32> strings;
+    auto intern = [&](const QString &String)
+    {
+        auto it = strings.constFind(String);
+        if (it != strings.constEnd())
+            return *it;
+        auto index = static_cast<quint32>(result->m_strings.size());
+        result->m_strings.append(String);
+        strings.insert(String, index);
+        return index;
+    };
+
+    QDataStream stream(&result->m_nodes, QIODevice::WriteOnly);
+
+    // Elements are written depth first, with the number of children first
+    std::function<void(const QDomNode&)> encode = [&](const QDomNode &Node)
+    {
+        if (Node.isElement())
+        {
+            QDomElement element = Node.toElement();
+            QDomNamedNodeMap attributes = element.attributes();
+            stream << static_cast<quint8>(kNodeElement) << intern(element.tagName())
+                   << static_cast<qint32>(element.lineNumber())
+                   << static_cast<qint32>(element.columnNumber())
+                   << static_cast<quint32>(attributes.count());
+            for (int i = 0; i < attributes.count(); ++i)
+            {
+                QDomAttr attr = attributes.item(i).toAttr();
+                stream << intern(attr.name()) << intern(attr.value());
+            }
+
+            QDomNodeList children = element.childNodes();
+            quint32 count = 0;
+            for (int i = 0; i < children.count(); ++i)
+                if (children.at(i).isElement() || children.at(i).isText())
+                    count++;
+            stream << count;
+            for (int i = 0; i < children.count(); ++i)
+                if (children.at(i).isElement() || children.at(i).isText())
+                    encode(children.at(i));
+        }
+        else if (Node.isCDATASection())
+        {
+            stream << static_cast<quint8>(kNodeCData) << intern(Node.nodeValue());
+        }
+        else
+        {
+            stream << static_cast<quint8>(kNodeText) << intern(Node.nodeValue());
+        }
+    };
+
+    QDomNode n = doc.documentElement().firstChild();
+    while (!n.isNull())
+    {
+        QDomElement e = n.toElement();
+        if (!e.isNull())
+        {
+            Entry entry;
+            entry.m_tag     = e.tagName();
+            entry.m_name    = e.attribute("name", "");
+            entry.m_include = e.attribute("include", "");
+            if (entry.m_tag == "include")
+                entry.m_text = XMLParseBase::getFirstText(e);
+            entry.m_offset  = static_cast<quint32>(result->m_nodes.size());
+            result->m_entries.append(entry);
+            encode(e);
+        }
+        n = n.nextSibling();
+    }
+
+    LOG(VB_GUI | VB_FILE, LOG_INFO, LOC + QString("Compiled %1: %2 elements, %3 strings")
+        .arg(Filename).arg(result->m_entries.size()).arg(result->m_strings.size()));
+    return result;
+}
+
+bool XMLParseCache::File::Read(QDataStream &Stream)
+{
+    quint32 count = 0;
+    Stream >> m_size >> m_modified >> m_strings >> count;
+    if (Stream.status() != QDataStream::Ok)
+        return false;
+
+    m_entries.resize(static_cast<int>(count));
+    for (auto & entry : m_entries)
+    {
+        Stream >> entry.m_tag >> entry.m_name >> entry.m_include >> entry.m_text
+               >> entry.m_offset;
+    }
+    Stream >> m_nodes;
+    return Stream.status() == QDataStream::Ok;
+}
+
+void XMLParseCache::File::Write(QDataStream &Stream) const
+{
+    Stream << m_size << m_modified << m_strings << static_cast<quint32>(m_entries.size());
+    for (const auto & entry : m_entries)
+    {
+        Stream << entry.m_tag << entry.m_name << entry.m_include << entry.m_text
+               << entry.m_offset;
+    }
+    Stream << m_nodes;
+}
+
+/// \brief Approximate memory used by the compiled file
+qint64 XMLParseCache::File::MemoryUsed(void) const
+{
+    qint64 used = m_nodes.size();
+    for (const auto & string : m_strings)
+        used += string.size() * static_cast<qint64>(sizeof(QChar));
+    for (const auto & entry : m_entries)
+    {
+        used += (entry.m_tag.size() + entry.m_name.size() +
+                 entry.m_include.size() + entry.m_text.size()) *
+                static_cast<qint64>(sizeof(QChar));
+    }
+    return used;
+}
+
+/// \brief Return the index of the top level element with this tag and name, or -1
+int XMLParseCache::File::Find(const QString &Tag, const QString &Name) const
+{
+    for (int i = 0; i < m_entries.size(); ++i)
+        if (m_entries[i].m_tag == Tag && m_entries[i].m_name == Name)
+            return i;
+    return -1;
+}
+
+/** \fn XMLParseCache::File::GetElement(QDomDocument&, int) const
+ *  \brief Decode one top level element, and everything below it, into Doc.
+ */
+QDomElement XMLParseCache::File::GetElement(QDomDocument &Doc, int Index) const
+{
+    if (Index < 0 || Index >= m_entries.size())
+        return {};
+
+    // The decoded elements need a parent in the document to stay alive
+    QDomNode root = Doc.documentElement();
+    if (root.isNull())
+        root = Doc.appendChild(Doc.createElement("mythuitheme"));
+
+    QDataStream stream(m_nodes);
+    stream.skipRawData(static_cast<int>(m_entries[Index].m_offset));
+    DecodeNode(stream, Doc, root);
+    return root.lastChild().toElement();
+}
+
+void XMLParseCache::File::DecodeNode(QDataStream &Stream, QDomDocument &Doc,
+                                     QDomNode &Parent) const
+{
+    quint8 kind = 0;
+    quint32 value = 0;
+    Stream >> kind >> value;
+    if (Stream.status() != QDataStream::Ok ||
+        value >= static_cast<quint32>(m_strings.size()))
+    {
+        return;
+    }
+
+    if (kind == kNodeText)
+    {
+        Parent.appendChild(Doc.createTextNode(m_strings[static_cast<int>(value)]));
+        return;
+    }
+
+    if (kind == kNodeCData)
+    {
+        Parent.appendChild(Doc.createCDATASection(m_strings[static_cast<int>(value)]));
+        return;
+    }
+
+    QDomElement element = Doc.createElement(m_strings[static_cast<int>(value)]);
+    qint32 line = 0;
+    qint32 column = 0;
+    quint32 count = 0;
+    Stream >> line >> column >> count;
+    if (line > 0)
+        element.setAttribute(kLocationAttribute, QString("%1:%2").arg(line).arg(column));
+    for (quint32 i = 0; i < count && Stream.status() == QDataStream::Ok; ++i)
+    {
+        quint32 name = 0;
+        quint32 attr = 0;
+        Stream >> name >> attr;
+        if (name < static_cast<quint32>(m_strings.size()) &&
+            attr < static_cast<quint32>(m_strings.size()))
+        {
+            element.setAttribute(m_strings[static_cast<int>(name)],
+                                 m_strings[static_cast<int>(attr)]);
+        }
+    }
+
+    Parent.appendChild(element);
+
+    Stream >> count;
+    for (quint32 i = 0; i < count && Stream.status() == QDataStream::Ok; ++i)
+        DecodeNode(Stream, Doc, element);
+}
@@ -0,0 +1,109 @@
+#ifndef XMLPARSECACHE_H_
+#define XMLPARSECACHE_H_
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include <list>
+
+#include "mythuiexp.h"
+
+class QDomDocument;
+class QDomElement;
+class QDomNode;
+class QDataStream;
+
+/** \class XMLParseCache
+ *  \brief Keeps theme XML files in a compiled binary form.
+ *
+ *   The first time a theme file is used it is parsed with QDomDocument and
+ *   written to the cache directory as a string table, an index of its top
+ *   level elements and a compact encoding of the element tree.  Later loads,
+ *   including those in other sessions, read the compiled file instead and
+ *   only decode the elements that are asked for, so opening one window from a
+ *   large file no longer parses the whole file.
+ *
+ *   Compiled files are checked against the size and modification time of
+ *   their source, so editing or upgrading a theme recompiles it.
+ *
+ *   At most kMaxMemory bytes (by default) of compiled files are kept in memory, the
+ *   least recently used files are dropped first.
+ *
+ *   QDomElement line numbers can't be set, so elements decoded from the
+ *   cache carry their source line and column in the kLocationAttribute
+ *   attribute instead, see XMLParseBase::GetLineNumber().  Set
+ *   DISABLETHEMECACHE in the environment to always parse the XML.
+ */
+class MUI_PUBLIC XMLParseCache
+{
+  public:
+    /// Attribute holding "line:column" of an element decoded from the cache
+    static const QString kLocationAttribute;
+    /// Default bytes of compiled files kept in memory
+    static const qint64  kMaxMemory = 8 * 1024 * 1024;
+
+    /// A top level element of a theme file
+    struct Entry
+    {
+        QString m_tag;
+        QString m_name;     ///< the name attribute
+        QString m_include;  ///< the include attribute
+        QString m_text;     ///< the text of an \<include\> element
+        quint32 m_offset  { 0 };  ///< where the element starts in the node data
+    };
+
+    class File
+    {
+        friend class XMLParseCache;
+      public:
+        int          Count(void) const          { return m_entries.size(); }
+        const Entry& GetEntry(int Index) const  { return m_entries[Index]; }
+        int          Find(const QString &Tag, const QString &Name) const;
+        QDomElement  GetElement(QDomDocument &Doc, int Index) const;
+
+      private:
+        bool Read(QDataStream &Stream);
+        void Write(QDataStream &Stream) const;
+        void DecodeNode(QDataStream &Stream, QDomDocument &Doc, QDomNode &Parent) const;
+        qint64 MemoryUsed(void) const;
+
+        qint64          m_size     { 0 };
+        qint64          m_modified { 0 };
+        QStringList     m_strings;
+        QVector<Entry>  m_entries;
+        QByteArray      m_nodes;
+    };
+    using FilePtr = QSharedPointer<const File>;
+
+    explicit XMLParseCache(QString CacheDir = QString(), qint64 MaxMemory = kMaxMemory);
+
+    static XMLParseCache* GetThemeCache(void);
+
+    void    SetCacheDir(const QString &CacheDir);
+    FilePtr Get(const QString &Filename);
+    void    Clear(void);
+
+    static bool Enabled(void);
+
+  private:
+    QString GetCachePath(const QString &Filename) const;
+    FilePtr ReadCompiled(const QString &Path, qint64 Size, qint64 Modified) const;
+    static QSharedPointer<File> Compile(const QString &Filename, qint64 Size, qint64 Modified);
+    void    WriteCompiled(const QString &Path, const File &Compiled) const;
+    void    Insert(const QString &Filename, const FilePtr &Compiled);
+    void    Remove(const QString &Filename);
+
+    QMutex                  m_lock;
+    QString                 m_cacheDir;
+    qint64                  m_maxMemory   { kMaxMemory };
+    QHash<QString,FilePtr>  m_files;
+    std::list<QString>      m_lru;              ///< least recently used first
+    qint64                  m_memoryUsed  { 0 };
+};
+
+#endif
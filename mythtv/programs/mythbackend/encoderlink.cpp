@@ -906,6 +906,21 @@ bool EncoderLink::CheckChannel(const QString &name)
     return false;
 }
 
+/** \fn EncoderLink::StandbyTune(const QString&)
+ *  \brief Tunes an idle recorder ahead of a LiveTV channel change.
+ *         <b>This only works on local recorders.</b>
+ *  \sa TVRec::StandbyTune(const QString&),
+ *      RemoteEncoder::StandbyTune(const QString&)
+ */
+bool EncoderLink::StandbyTune(const QString &channum)
+{
+    if (m_local)
+        return m_tv->StandbyTune(channum);
+
+    LOG(VB_GENERAL, LOG_ERR, "Should be local only query: StandbyTune");
+    return false;
+}
+
 /** \fn EncoderLink::ShouldSwitchToAnotherInput(const QString&)
  *  \brief Checks if named channel exists on current tuner, or
  *         another tuner.
@@ -127,6 +127,7 @@ class EncoderLink
                                 PictureAttribute  attr,
                                 bool              direction);
     bool CheckChannel(const QString &name);
+    bool StandbyTune(const QString &channum);
     bool ShouldSwitchToAnotherInput(const QString &channelid);
     bool CheckChannelPrefix(const QString &prefix, uint &complete_valid_channel_on_rec,
                             bool &is_extra_char_useful, QString &needed_spacer);
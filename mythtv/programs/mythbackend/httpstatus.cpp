@@ -39,6 +39,7 @@
 #include "jobqueue.h"
 #include "upnp.h"
 #include "mythdate.h"
+#include "mythmetrics.h"
 #include "tv_rec.h"
 
 /////////////////////////////////////////////////////////////////////////////
@@ -69,6 +70,8 @@ HttpStatusMethod HttpStatus::GetMethod( const QString &sURI )
     if (sURI == "GetStatusHTML"        ) return( HSM_GetStatusHTML   );
     if (sURI == "GetStatus"            ) return( HSM_GetStatusXML    );
     if (sURI == "xml"                  ) return( HSM_GetStatusXML    );
+    if (sURI == "metrics"              ) return( HSM_GetMetrics      );
+    if (sURI == "GetMetrics"           ) return( HSM_GetMetrics      );
 
     return( HSM_Unknown );
 }
@@ -102,6 +105,7 @@ bool HttpStatus::ProcessRequest( HTTPRequest *pRequest )
             {
                 case HSM_GetStatusXML   : GetStatusXML   ( pRequest ); return true;
                 case HSM_GetStatusHTML  : GetStatusHTML  ( pRequest ); return true;
+                case HSM_GetMetrics     : GetMetrics     ( pRequest ); return true;
 
                 default:
                 {
@@ -163,6 +167,21 @@ void HttpStatus::GetStatusHTML( HTTPRequest *pRequest )
     PrintStatus( stream, &doc );
 }
 
+/////////////////////////////////////////////////////////////////////////////
+// Live recorder metrics, in the Prometheus text format, for /Status/metrics
+/////////////////////////////////////////////////////////////////////////////
+
+void HttpStatus::GetMetrics( HTTPRequest *pRequest )
+{
+    pRequest->m_eResponseType     = ResponseTypeOther;
+    pRequest->m_sResponseTypeText = "text/plain; version=0.0.4; charset=utf-8";
+    pRequest->m_mapRespHeaders[ "Cache-Control" ] = "no-cache";
+
+    QTextStream stream( &pRequest->m_response );
+    stream.setCodec("UTF-8");
+    stream << MythMetrics::ToPrometheus("mythtv_");
+}
+
 static QString setting_to_localtime(const char *setting)
 {
     QString origDateString = gCoreContext->GetSetting(setting);
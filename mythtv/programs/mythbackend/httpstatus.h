@@ -22,7 +22,8 @@ enum HttpStatusMethod
 {
     HSM_Unknown         =  0,
     HSM_GetStatusHTML   =  1,
-    HSM_GetStatusXML    =  2
+    HSM_GetStatusXML    =  2,
+    HSM_GetMetrics      =  3
 
 };
 
@@ -57,6 +58,7 @@ class HttpStatus : public HttpServerExtension
 
         void    GetStatusXML      ( HTTPRequest *pRequest );
         void    GetStatusHTML     ( HTTPRequest *pRequest );
+        static void GetMetrics    ( HTTPRequest *pRequest );
 
         void    FillStatusXML     ( QDomDocument *pDoc);
     
@@ -2461,6 +2461,7 @@ void MainServer::DoDeleteThread(DeleteStruct *ds)
     nameFilters.push_back(fInfo.fileName() + ".tmp");
     nameFilters.push_back(fInfo.fileName() + ".old");
     nameFilters.push_back(fInfo.fileName() + ".map");
+    nameFilters.push_back(fInfo.fileName() + ".trickplay");
     nameFilters.push_back(fInfo.fileName() + ".tmp.map");
     nameFilters.push_back(fInfo.baseName() + ".srt");  // e.g. 1234_20150213165800.srt
 
@@ -4754,6 +4755,11 @@ void MainServer::HandleRecorderQuery(QStringList &slist, QStringList &commands,
         QString name = slist[2];
         retlist << QString::number((int)(enc->CheckChannel(name)));
     }
+    else if (command == "STANDBY_TUNE")
+    {
+        QString name = slist[2];
+        retlist << QString::number((int)(enc->StandbyTune(name)));
+    }
     else if (command == "SHOULD_SWITCH_CARD")
     {
         QString chanid = slist[2];
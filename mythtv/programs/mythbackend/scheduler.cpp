@@ -2906,6 +2906,7 @@ bool Scheduler::AssignGroupInput(RecordingInfo &ri,
 
     uint bestid = 0;
     uint betterid = 0;
+    uint standbyid = 0;
     QDateTime now = MythDate::current();
 
     // Check each child input to find the best one to use.
@@ -2990,7 +2991,17 @@ bool Scheduler::AssignGroupInput(RecordingInfo &ri,
         m_schedLock.lock();
         if (m_recListChanged)
             return false;
-        if (!isbusy)
+        if (!isbusy && rctv->IsLocal() &&
+            (rctv->GetFlags() & TVRec::kFlagStandby))
+        {
+            // Free, but keep it for LiveTV zapping if another input is
+            LOG(VB_SCHEDULE, LOG_DEBUG,
+                QString("Input %1 is free but tuned ahead for livetv")
+                .arg(inputid));
+            if (!standbyid)
+                standbyid = inputid;
+        }
+        else if (!isbusy)
         {
             LOG(VB_SCHEDULE, LOG_DEBUG,
                 QString("Input %1 is free").arg(inputid));
@@ -3006,6 +3017,8 @@ bool Scheduler::AssignGroupInput(RecordingInfo &ri,
         }
     }
 
+    if (!bestid)
+        bestid = standbyid;
     if (!bestid)
         bestid = betterid;
 
@@ -36,6 +36,7 @@
 #include "storagegroup.h"
 #include "programinfo.h"
 #include "previewgenerator.h"
+#include "trickplayindex.h"
 #include "requesthandler/fileserverutil.h"
 #include "httprequest.h"
 #include "serviceUtil.h"
@@ -712,6 +713,63 @@ QFileInfo Content::GetRecording( int              nRecordedId,
 //
 /////////////////////////////////////////////////////////////////////////////
 
+QFileInfo Content::GetTrickplayIndex( int              nRecordedId,
+                                      int              nChanId,
+                                      const QDateTime &recstarttsRaw )
+{
+    if ((nRecordedId <= 0) &&
+        (nChanId <= 0 || !recstarttsRaw.isValid()))
+        throw QString("Recorded ID or Channel ID and StartTime appears invalid.");
+
+    // ------------------------------------------------------------------
+    // Read Recording From Database
+    // ------------------------------------------------------------------
+
+    ProgramInfo pginfo;
+    if (nRecordedId > 0)
+        pginfo = ProgramInfo(nRecordedId);
+    else
+        pginfo = ProgramInfo(nChanId, recstarttsRaw.toUTC());
+
+    if (!pginfo.GetChanID())
+    {
+        LOG(VB_UPNP, LOG_ERR, QString("GetTrickplayIndex - for '%1' failed")
+            .arg(nRecordedId));
+
+        return QFileInfo();
+    }
+
+    if (pginfo.GetHostname().toLower() != gCoreContext->GetHostName().toLower())
+    {
+        // We only handle requests for local resources
+
+        QString sMsg =
+            QString("GetTrickplayIndex: Wrong Host '%1' request from '%2'.")
+                          .arg( gCoreContext->GetHostName())
+                          .arg( pginfo.GetHostname() );
+
+        LOG(VB_UPNP, LOG_ERR, sMsg);
+
+        throw HttpRedirectException( pginfo.GetHostname() );
+    }
+
+    // ----------------------------------------------------------------------
+    // The index is built by the job queue once the recording finishes, it
+    // is never generated on request.  See TrickplayIndex for the file layout.
+    // ----------------------------------------------------------------------
+
+    QString sFileName = TrickplayIndex::GetFilename(GetPlaybackURL(&pginfo));
+
+    if (QFile::exists( sFileName ))
+        return QFileInfo( sFileName );
+
+    return QFileInfo();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 QFileInfo Content::GetMusic( int nId )
 {
     QString sFileName;
@@ -951,6 +1009,18 @@ DTC::LiveStreamInfo *Content::StopLiveStream( int nId )
 //
 /////////////////////////////////////////////////////////////////////////////
 
+bool Content::SetLiveStreamPlayhead( int nId, int nSegment )
+{
+    if (nSegment < 0 || nSegment > 0xFFFF)
+        throw QString( "Segment is out of range" );
+
+    return HTTPLiveStream::SetPlayheadSegment(nId, nSegment);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 DTC::LiveStreamInfo *Content::GetLiveStream( int nId )
 {
     auto *hls = new HTTPLiveStream(nId);
@@ -82,6 +82,10 @@ class Content : public ContentServices
                                                   int              ChanId,
                                                   const QDateTime &recstarttsRaw ) override; // ContentServices
 
+        QFileInfo           GetTrickplayIndex   ( int              RecordedId,
+                                                  int              ChanId,
+                                                  const QDateTime &recstarttsRaw ) override; // ContentServices
+
         QFileInfo           GetMusic            ( int Id ) override; // ContentServices
         QFileInfo           GetVideo            ( int Id ) override; // ContentServices
 
@@ -125,6 +129,9 @@ class Content : public ContentServices
 
         DTC::LiveStreamInfo     *StopLiveStream         ( int Id ) override; // ContentServices
         bool                     RemoveLiveStream       ( int Id ) override; // ContentServices
+
+        bool                     SetLiveStreamPlayhead  ( int Id,
+                                                          int Segment ) override; // ContentServices
 };
 
 // --------------------------------------------------------------------------
@@ -258,6 +265,13 @@ class ScriptableContent : public QObject
                 return m_obj.RemoveLiveStream(Id);
             )
         }
+
+        bool SetLiveStreamPlayhead( int Id, int Segment )
+        {
+            SCRIPT_CATCH_EXCEPTION( false,
+                return m_obj.SetLiveStreamPlayhead(Id, Segment);
+            )
+        }
 };
 
 // NOLINTNEXTLINE(modernize-use-auto)
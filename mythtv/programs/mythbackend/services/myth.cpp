@@ -44,6 +44,7 @@
 #include "hardwareprofile.h"
 #include "mythtimezone.h"
 #include "mythdate.h"
+#include "mythmetrics.h"
 #include "mythversion.h"
 #include "serviceUtil.h"
 #include "scheduler.h"
@@ -1066,6 +1067,34 @@ DTC::BackendInfo* Myth::GetBackendInfo( void )
 //
 /////////////////////////////////////////////////////////////////////////////
 
+DTC::MetricList* Myth::GetMetrics( const QString &sPrefix )
+{
+    auto *pList = new DTC::MetricList();
+
+    pList->setAsOf( MythDate::current() );
+
+    for (const auto &sample : MythMetrics::Snapshot(sPrefix))
+    {
+        QStringList labels;
+        for (auto it = sample.m_labels.cbegin(); it != sample.m_labels.cend(); ++it)
+            labels << QString("%1=%2").arg(it.key(), it.value());
+
+        DTC::Metric *pMetric = pList->AddNewMetric();
+        pMetric->setName       ( sample.m_name );
+        pMetric->setType       ( sample.m_type == MythMetric::kCounter ?
+                                 "counter" : "gauge" );
+        pMetric->setDescription( sample.m_help );
+        pMetric->setLabels     ( labels.join(",") );
+        pMetric->setValue      ( sample.m_value );
+    }
+
+    return pList;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+//
+/////////////////////////////////////////////////////////////////////////////
+
 bool Myth::ManageDigestUser( const QString &sAction,
                              const QString &sUserName,
                              const QString &sPassword,
@@ -143,6 +143,8 @@ class Myth : public MythServices
 
         DTC::BackendInfo*   GetBackendInfo      ( void ) override; // MythServices
 
+        DTC::MetricList*    GetMetrics          ( const QString &Prefix ) override; // MythServices
+
         bool                ManageDigestUser    ( const QString &Action,
                                                   const QString &UserName,
                                                   const QString &Password,
@@ -413,6 +415,14 @@ class ScriptableMyth : public QObject
                 return m_obj.GetBackendInfo();
             )
         }
+
+        QObject* GetMetrics( const QString &Prefix )
+        {
+            SCRIPT_CATCH_EXCEPTION( nullptr,
+                return m_obj.GetMetrics( Prefix );
+            )
+        }
+
         bool ManageDigestUser( const QString &Action,
                                const QString &UserName,
                                const QString &Password,
@@ -1838,6 +1838,22 @@ static HostSpinBoxSetting *LiveTVIdleTimeout()
     return gs;
 }
 
+static HostSpinBoxSetting *LiveTVZapAhead()
+{
+    auto *gs = new HostSpinBoxSetting("LiveTVZapAhead", 0, 4, 1);
+
+    gs->setLabel(PlaybackSettings::tr("Live TV zap ahead inputs"));
+
+    gs->setValue(0);
+
+    gs->setHelpText(PlaybackSettings::tr("Number of idle tuners to tune in "
+                                         "advance to the channels you are "
+                                         "likely to change to next, so that "
+                                         "changing to them is faster. "
+                                         "0 disables this."));
+    return gs;
+}
+
 // static HostCheckBoxSetting *PlaybackPreview()
 // {
 //     HostCheckBoxSetting *gc = new HostCheckBoxSetting("PlaybackPreview");
@@ -4195,6 +4211,7 @@ void PlaybackSettings::Load(void)
     general->addChild(AutomaticSetWatched());
     general->addChild(ContinueEmbeddedTVPlay());
     general->addChild(LiveTVIdleTimeout());
+    general->addChild(LiveTVZapAhead());
 
 #if CONFIG_DEBUGTYPE
     general->addChild(FFmpegDemuxer());
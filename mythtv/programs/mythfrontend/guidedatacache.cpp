@@ -0,0 +1,228 @@
+// c++
+#include <algorithm>
+
+// Qt
+#include <QElapsedTimer>
+#include <QStringList>
+
+// MythTV
+#include "mythdate.h"
+#include "mythdbcon.h"
+#include "mythlogging.h"
+
+// mythfrontend
+#include "guidedatacache.h"
+
+#define LOC QString("GuideDataCache: ")
+
+static qint64 BlockStart(const QDateTime &Time)
+{
+    qint64 secs = Time.toSecsSinceEpoch();
+    return secs - (((secs % GuideDataCache::kBlockSecs) + GuideDataCache::kBlockSecs) %
+                   GuideDataCache::kBlockSecs);
+}
+
+GuideDataCache::GuideDataCache(int MaxBlocks)
+  : m_maxBlocks(MaxBlocks)
+{
+}
+
+/** \fn GuideDataCache::GetPrograms(const QVector<uint>&, const QDateTime&, const QDateTime&, const ProgramList&)
+ *  \brief Return the programs of each channel that are on between Start and End.
+ *
+ *   The selection matches the single channel query GuideGrid used before:
+ *   programs that end at or after Start, start at or before End and started
+ *   no more than a day before Start.  The caller owns the returned lists.
+ */
+QVector<ProgramList*> GuideDataCache::GetPrograms(const QVector<uint> &ChanIDs,
+                                                  const QDateTime &Start,
+                                                  const QDateTime &End,
+                                                  const ProgramList &SchedList)
+{
+    Load(ChanIDs, Start, End, SchedList);
+
+    QMutexLocker locker(&m_lock);
+    QDateTime startlimit = Start.addDays(-1);
+    qint64 first = BlockStart(Start);
+    qint64 last  = BlockStart(End);
+
+    QVector<ProgramList*> result;
+    result.reserve(ChanIDs.size());
+    for (uint chanid : ChanIDs)
+    {
+        auto *proglist = new ProgramList();
+        for (qint64 block = first; block <= last; block += kBlockSecs)
+        {
+            auto it = m_blocks.find(BlockKey(chanid, block));
+            if (it == m_blocks.end())
+                continue;
+            it->m_lastUsed = m_serial;
+
+            // Programs that started in an earlier block were added from it
+            QDateTime blockstart = MythDate::fromSecsSinceEpoch(static_cast<uint>(block));
+            for (const auto & pginfo : it->m_programs)
+            {
+                QDateTime starttime = pginfo.GetScheduledStartTime();
+                if (block != first && starttime < blockstart)
+                    continue;
+                if (pginfo.GetScheduledEndTime() < Start || starttime > End ||
+                    starttime < startlimit)
+                {
+                    continue;
+                }
+                proglist->push_back(new ProgramInfo(pginfo));
+            }
+        }
+        result.push_back(proglist);
+    }
+
+    Expire();
+    return result;
+}
+
+/// \brief Load the window into the cache, if it is not already there.
+void GuideDataCache::Prefetch(const QVector<uint> &ChanIDs,
+                              const QDateTime &Start, const QDateTime &End,
+                              const ProgramList &SchedList)
+{
+    Load(ChanIDs, Start, End, SchedList);
+
+    QMutexLocker locker(&m_lock);
+    Expire();
+}
+
+void GuideDataCache::Clear(void)
+{
+    QMutexLocker locker(&m_lock);
+    m_blocks.clear();
+    ++m_generation;
+}
+
+/** \fn GuideDataCache::Load(const QVector<uint>&, const QDateTime&, const QDateTime&, const ProgramList&)
+ *  \brief Load the missing blocks of the window, with one query per block.
+ *
+ *   Called without m_lock held.  The missing blocks are found under the lock,
+ *   queried without it, so that a slow query doesn't stall the UI thread
+ *   behind a prefetch, and stored under it again.  Results are dropped if
+ *   the cache was cleared while they were being loaded, as they may carry
+ *   an old recording status.
+ */
+void GuideDataCache::Load(const QVector<uint> &ChanIDs, const QDateTime &Start,
+                          const QDateTime &End, const ProgramList &SchedList)
+{
+    qint64 now   = MythDate::current().toSecsSinceEpoch();
+    qint64 first = BlockStart(Start);
+    qint64 last  = BlockStart(End);
+
+    QVector<QPair<qint64,QVector<uint> > > missing;
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&m_lock);
+        ++m_serial;
+        generation = m_generation;
+        for (qint64 block = first; block <= last; block += kBlockSecs)
+        {
+            QVector<uint> chanids;
+            for (uint chanid : ChanIDs)
+            {
+                auto it = m_blocks.find(BlockKey(chanid, block));
+                if (it != m_blocks.end() && (now - it->m_loaded) < kMaxBlockAge)
+                {
+                    it->m_lastUsed = m_serial;
+                    continue;
+                }
+                if (!chanids.contains(chanid))
+                    chanids.push_back(chanid);
+            }
+            if (!chanids.empty())
+                missing.push_back(qMakePair(block, chanids));
+        }
+    }
+
+    for (const auto & load : missing)
+    {
+        qint64 block = load.first;
+        const QVector<uint> &chanids = load.second;
+
+        QElapsedTimer timer;
+        timer.start();
+
+        QStringList chanlist;
+        for (uint chanid : chanids)
+            chanlist.push_back(QString::number(chanid));
+
+        QDateTime blockstart = MythDate::fromSecsSinceEpoch(static_cast<uint>(block));
+        MSqlBindings bindings;
+        QString querystr = QString(
+            "WHERE program.chanid IN (%1) "
+            "  AND program.endtime >= :STARTTS "
+            "  AND program.starttime < :ENDTS "
+            "  AND program.starttime >= :STARTLIMITTS "
+            "  AND program.manualid = 0 ").arg(chanlist.join(","));
+        bindings[":STARTTS"]      = blockstart;
+        bindings[":ENDTS"]        = blockstart.addSecs(kBlockSecs);
+        bindings[":STARTLIMITTS"] = blockstart.addDays(-1);
+
+        ProgramList proglist;
+        if (!LoadFromProgram(proglist, querystr, bindings, SchedList))
+            continue;
+
+        QHash<uint,std::vector<ProgramInfo> > loaded;
+        for (uint chanid : chanids)
+            loaded[chanid];
+        for (auto * pginfo : proglist)
+        {
+            auto it = loaded.find(pginfo->GetChanID());
+            if (it != loaded.end())
+                it->push_back(*pginfo);
+        }
+
+        QMutexLocker locker(&m_lock);
+        if (generation != m_generation)
+            return;
+        for (auto it = loaded.begin(); it != loaded.end(); ++it)
+        {
+            Block &entry = m_blocks[BlockKey(it.key(), block)];
+            entry.m_programs.swap(*it);
+            entry.m_loaded   = now;
+            entry.m_lastUsed = m_serial;
+        }
+
+        LOG(VB_GUI, LOG_DEBUG, LOC +
+            QString("Loaded %1 programs for %2 channels from %3 in %4ms")
+                .arg(proglist.size()).arg(chanids.size())
+                .arg(MythDate::toString(blockstart, MythDate::ISODate))
+                .arg(timer.elapsed()));
+    }
+}
+
+/// \brief Drop the least recently used blocks once there are too many.
+void GuideDataCache::Expire(void)
+{
+    if (m_blocks.size() <= m_maxBlocks)
+        return;
+
+    // Go down to 90% so that this does not run on every request
+    QVector<quint64> used;
+    used.reserve(m_blocks.size());
+    for (auto it = m_blocks.cbegin(); it != m_blocks.cend(); ++it)
+        used.push_back(it->m_lastUsed);
+    int remove = m_blocks.size() - (m_maxBlocks * 9 / 10);
+    std::nth_element(used.begin(), used.begin() + remove - 1, used.end());
+    quint64 threshold = used[remove - 1];
+
+    for (auto it = m_blocks.begin(); it != m_blocks.end() && remove > 0; )
+    {
+        if (it->m_lastUsed <= threshold && it->m_lastUsed != m_serial)
+        {
+            it = m_blocks.erase(it);
+            --remove;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    LOG(VB_GUI, LOG_DEBUG, LOC + QString("%1 blocks cached").arg(m_blocks.size()));
+}
@@ -0,0 +1,74 @@
+#ifndef GUIDEDATACACHE_H_
+#define GUIDEDATACACHE_H_
+
+// c++
+#include <vector>
+
+// Qt
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+#include <QVector>
+
+// MythTV
+#include "programinfo.h"
+
+/** \class GuideDataCache
+ *  \brief Program guide listings for GuideGrid, loaded a window at a time.
+ *
+ *   Listings are held in fixed blocks of time per channel.  A request for a
+ *   set of channels and a time window loads every missing block of the window
+ *   with one query per block, rather than one query per channel, and keeps
+ *   the blocks so that scrolling back, or to a window already prefetched,
+ *   does not touch the database.
+ *
+ *   Blocks are dropped, least recently used first, once there are more than
+ *   the maximum, and are reloaded once they are older than kMaxBlockAge so
+ *   that new listings still show up in an open guide.  The recording status
+ *   of the cached programs comes from the schedule at the time they were
+ *   loaded, so the cache must be cleared when the schedule changes.
+ *
+ *   All methods are thread safe.  The database is queried without the lock
+ *   held, so two threads asking for the same missing block may both load it.
+ */
+class GuideDataCache
+{
+  public:
+    explicit GuideDataCache(int MaxBlocks = 3000);
+   ~GuideDataCache() = default;
+
+    QVector<ProgramList*> GetPrograms(const QVector<uint> &ChanIDs,
+                                      const QDateTime &Start, const QDateTime &End,
+                                      const ProgramList &SchedList);
+    void Prefetch(const QVector<uint> &ChanIDs,
+                  const QDateTime &Start, const QDateTime &End,
+                  const ProgramList &SchedList);
+    void Clear(void);
+
+    static const int kBlockSecs   = 4 * 60 * 60;
+    static const int kMaxBlockAge = 5 * 60;
+
+  private:
+    Q_DISABLE_COPY(GuideDataCache)
+
+    using BlockKey = QPair<uint,qint64>; // chanid, start of the block
+    struct Block
+    {
+        std::vector<ProgramInfo> m_programs;
+        qint64                   m_loaded   { 0 };
+        quint64                  m_lastUsed { 0 };
+    };
+
+    void Load(const QVector<uint> &ChanIDs, const QDateTime &Start,
+              const QDateTime &End, const ProgramList &SchedList);
+    void Expire(void);
+
+    QMutex                  m_lock;
+    QHash<BlockKey,Block>   m_blocks;
+    int                     m_maxBlocks { 3000 };
+    quint64                 m_serial    { 0 };
+    quint64                 m_generation { 0 }; ///< incremented by Clear()
+};
+
+#endif
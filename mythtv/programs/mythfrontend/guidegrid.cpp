@@ -277,12 +277,19 @@ public:
             return false;
         }
 
+        // Load all of the missing rows together
+        QVector<int> missing;
         for (unsigned int i = 0; i < m_numRows; ++i)
+            if (!m_proglists[i])
+                missing.push_back(m_chanNums[i]);
+        QVector<ProgramList*> loaded =
+            m_guide->getProgramListsFromProgram(missing);
+
+        for (unsigned int i = 0, j = 0; i < m_numRows; ++i)
         {
             unsigned int row = i + m_firstRow;
             if (!m_proglists[i])
-                m_proglists[i] =
-                    m_guide->getProgramListFromProgram(m_chanNums[i]);
+                m_proglists[i] = loaded[j++];
             fillProgramRowInfosWith(row,
                                     m_currentStartTime,
                                     m_proglists[i]);
@@ -344,6 +351,34 @@ public:
     QVector<bool> m_unavailables;
 };
 
+// Loads listings that are likely to be needed next into the guide data
+// cache.  There is nothing to do in the UI thread.
+class GuidePrefetch : public GuideUpdaterBase
+{
+public:
+    GuidePrefetch(GuideGrid *guide, uint startChan, QDateTime startTime,
+                  QVector<uint> chanids, QDateTime start, QDateTime end)
+        : GuideUpdaterBase(guide), m_currentStartChannel(startChan),
+          m_currentStartTime(std::move(startTime)), m_chanIds(std::move(chanids)),
+          m_start(std::move(start)), m_end(std::move(end)) {}
+    bool ExecuteNonUI(void) override // GuideUpdaterBase
+    {
+        // Skip it if the guide has moved on again
+        if (m_currentStartChannel == m_guide->GetCurrentStartChannel() &&
+            m_currentStartTime == m_guide->GetCurrentStartTime())
+        {
+            m_guide->prefetchPrograms(m_chanIds, m_start, m_end);
+        }
+        return false;
+    }
+    void ExecuteUI(void) override {} // GuideUpdaterBase
+    const uint m_currentStartChannel;
+    const QDateTime m_currentStartTime;
+    const QVector<uint> m_chanIds;
+    const QDateTime m_start;
+    const QDateTime m_end;
+};
+
 class UpdateGuideEvent : public QEvent
 {
 public:
@@ -574,6 +609,8 @@ void GuideGrid::Load(void)
     setStartChannel((int)(m_currentStartChannel) - (m_channelCount / 2));
     m_channelCount = min(m_channelCount, maxchannel + 1);
 
+    QVector<int> chanNums;
+    QVector<int> rows;
     for (int y = 0; y < m_channelCount; ++y)
     {
         int chanNum = y + m_currentStartChannel;
@@ -585,8 +622,15 @@ void GuideGrid::Load(void)
         if (chanNum < 0)
             chanNum = 0;
 
-        delete m_programs[y];
-        m_programs[y] = getProgramListFromProgram(chanNum);
+        chanNums.push_back(chanNum);
+        rows.push_back(y);
+    }
+
+    QVector<ProgramList*> proglists = getProgramListsFromProgram(chanNums);
+    for (int i = 0; i < rows.size(); ++i)
+    {
+        delete m_programs[rows[i]];
+        m_programs[rows[i]] = proglists[i];
     }
 }
 
@@ -1521,28 +1565,99 @@ void GuideGrid::fillProgramInfos(bool useExistingData)
     fillProgramRowInfos(-1, useExistingData);
 }
 
-ProgramList *GuideGrid::getProgramListFromProgram(int chanNum)
+/** \fn GuideGrid::getProgramListsFromProgram(const QVector<int>&)
+ *  \brief Return the programs in the current time window for each channel.
+ *
+ *   The listings come from the guide data cache, which loads whatever it
+ *   does not have for all of the channels at once.
+ */
+QVector<ProgramList*> GuideGrid::getProgramListsFromProgram(const QVector<int> &chanNums)
 {
-    auto *proglist = new ProgramList();
+    if (chanNums.empty())
+        return QVector<ProgramList*>();
 
-    if (proglist)
+    QVector<uint> chanids;
+    chanids.reserve(chanNums.size());
+    for (int chanNum : chanNums)
     {
-        MSqlBindings bindings;
-        QString querystr = "WHERE program.chanid = :CHANID "
-                           "  AND program.endtime >= :STARTTS "
-                           "  AND program.starttime <= :ENDTS "
-                           "  AND program.starttime >= :STARTLIMITTS "
-                           "  AND program.manualid = 0 ";
-        QDateTime starttime = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
-        bindings[":CHANID"]  = GetChannelInfo(chanNum)->m_chanId;
-        bindings[":STARTTS"] = starttime;
-        bindings[":STARTLIMITTS"] = starttime.addDays(-1);
-        bindings[":ENDTS"] = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+        const ChannelInfo *chinfo = GetChannelInfo(chanNum);
+        chanids.push_back(chinfo ? chinfo->m_chanId : 0);
+    }
+
+    QDateTime starttime = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
+    QDateTime endtime = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+    return m_guideData.GetPrograms(chanids, starttime, endtime, m_recList);
+}
+
+void GuideGrid::prefetchPrograms(const QVector<uint> &chanids,
+                                 const QDateTime &start, const QDateTime &end)
+{
+    m_guideData.Prefetch(chanids, start, end, m_recList);
+}
+
+/** \fn GuideGrid::queuePrefetch(void)
+ *  \brief Queue loading the page the user is most likely to go to next.
+ *
+ *   That is the next page in the direction of the last move, or the next
+ *   page of channels when the guide has just opened.  The work runs on the
+ *   guide's helper thread after the visible page has been filled.
+ */
+void GuideGrid::queuePrefetch(void)
+{
+    int count = GetChannelCount();
+    if (!count || m_channelCount <= 0)
+        return;
 
-        LoadFromProgram(*proglist, querystr, bindings, m_recList);
+    QDateTime start = m_currentStartTime.addSecs(0 - m_currentStartTime.time().second());
+    QDateTime end = m_currentEndTime.addSecs(0 - m_currentEndTime.time().second());
+    qint64 span = start.secsTo(end);
+    int first = m_currentStartChannel;
+
+    switch (m_lastMove)
+    {
+        case kScrollUp :
+        case kPageUp :
+            first -= m_channelCount;
+            break;
+        case kScrollLeft :
+        case kPageLeft :
+            start = start.addSecs(-span);
+            end = end.addSecs(-span);
+            break;
+        case kScrollRight :
+        case kPageRight :
+            start = start.addSecs(span);
+            end = end.addSecs(span);
+            break;
+        case kDayLeft :
+            start = start.addDays(-1);
+            end = end.addDays(-1);
+            break;
+        case kDayRight :
+            start = start.addDays(1);
+            end = end.addDays(1);
+            break;
+        default :
+            first += m_channelCount;
+            break;
     }
 
-    return proglist;
+    // Another page of channels is only worth loading if there is one
+    if (first != (int)m_currentStartChannel && count <= m_channelCount)
+        return;
+
+    QVector<uint> chanids;
+    for (int i = 0; i < min(m_channelCount, count); ++i)
+    {
+        int chanNum = (((first + i) % count) + count) % count;
+        const ChannelInfo *chinfo = GetChannelInfo(chanNum);
+        if (chinfo)
+            chanids.push_back(chinfo->m_chanId);
+    }
+
+    auto *updater = new GuidePrefetch(this, m_currentStartChannel, m_currentStartTime,
+                                      chanids, start, end);
+    m_threadPool.start(new GuideHelper(this, updater), "GuideHelper");
 }
 
 void GuideGrid::fillProgramRowInfos(int firstRow, bool useExistingData)
@@ -1609,6 +1724,9 @@ void GuideGrid::fillProgramRowInfos(int firstRow, bool useExistingData)
                    m_verticalLayout, m_firstTime, m_lastTime);
     auto *updater = new GuideUpdateProgramRow(this, gs, proglists);
     m_threadPool.start(new GuideHelper(this, updater), "GuideHelper");
+
+    if (allRows)
+        queuePrefetch();
 }
 
 void GuideUpdateProgramRow::fillProgramRowInfosWith(int row,
@@ -1858,6 +1976,7 @@ void GuideGrid::customEvent(QEvent *event)
         {
             GuideHelper::Wait(this);
             LoadFromScheduler(m_recList);
+            m_guideData.Clear();
             fillProgramInfos();
         }
         else if (message == "STOP_VIDEO_REFRESH_TIMER")
@@ -2243,7 +2362,9 @@ void GuideGrid::generateListings()
     maxchannel = max((int)GetChannelCount() - 1, 0);
     m_channelCount = min(m_guideGrid->getChannelCount(), maxchannel + 1);
 
+    GuideHelper::Wait(this);
     LoadFromScheduler(m_recList);
+    m_guideData.Clear();
     fillProgramInfos();
 }
 
@@ -2426,6 +2547,7 @@ void GuideGrid::cursorUp()
 
 void GuideGrid::moveLeftRight(MoveVector movement)
 {
+    m_lastMove = movement;
     switch (movement)
     {
         case kScrollLeft :
@@ -2457,6 +2579,7 @@ void GuideGrid::moveLeftRight(MoveVector movement)
 
 void GuideGrid::moveUpDown(MoveVector movement)
 {
+    m_lastMove = movement;
     switch (movement)
     {
         case kScrollDown :
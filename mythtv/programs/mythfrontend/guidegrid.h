@@ -23,6 +23,7 @@ using namespace std;
 #include "tv_play.h"
 
 // mythfrontend
+#include "guidedatacache.h"
 #include "schedulecommon.h"
 
 using namespace std;
@@ -209,9 +210,12 @@ class GuideGrid : public ScheduleCommon, public JumpToChannelListener
     void fillProgramInfos(bool useExistingData = false);
     // Set row=-1 to fill all rows.
     void fillProgramRowInfos(int row, bool useExistingData);
+    void queuePrefetch(void);
 public:
     // These need to be public so that the helper classes can operate.
-    ProgramList *getProgramListFromProgram(int chanNum);
+    QVector<ProgramList*> getProgramListsFromProgram(const QVector<int> &chanNums);
+    void prefetchPrograms(const QVector<uint> &chanids,
+                          const QDateTime &start, const QDateTime &end);
     void updateProgramsUI(unsigned int firstRow, unsigned int numRows,
                           int progPast,
                           const QVector<ProgramList*> &proglists,
@@ -244,11 +248,13 @@ private:
     vector<ProgramList*> m_programs;
     ProgInfoGuideArray m_programInfos {};
     ProgramList  m_recList;
+    GuideDataCache m_guideData;
 
     QDateTime m_originalStartTime;
     QDateTime m_currentStartTime;
     QDateTime m_currentEndTime;
     uint      m_currentStartChannel       {0};
+    MoveVector m_lastMove                 {kPageDown};
     uint      m_startChanID;
     QString   m_startChanNum;
 
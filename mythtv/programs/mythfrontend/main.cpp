@@ -14,6 +14,7 @@ using namespace std;
 #include <QTextCodec>
 #include <QApplication>
 #include <QTimer>
+#include <QElapsedTimer>
 #ifdef Q_OS_MAC
 #include <QProcessEnvironment>
 #endif
@@ -86,6 +87,7 @@ using namespace std;
 #include "mythversion.h"
 #include "taskqueue.h"
 #include "cleanupguard.h"
+#include "mythstartuptasks.h"
 #include "standardsettings.h"
 #include "settingshelper.h"
 
@@ -1724,6 +1726,24 @@ static void CleanupMyOldInUsePrograms(void)
         MythDB::DBError("CleanupMyOldInUsePrograms", query);
 }
 
+/// \brief Initialise the plugins one at a time once the main menu is showing
+static void InitDeferredPlugins(void)
+{
+    static QElapsedTimer s_timer;
+    if (!s_timer.isValid())
+        s_timer.start();
+
+    if (g_pmanager && g_pmanager->InitDeferred())
+    {
+        // Let the main menu draw and handle keys between plugins
+        QTimer::singleShot(0, InitDeferredPlugins);
+        return;
+    }
+
+    LOG(VB_GENERAL, LOG_INFO, QString("Plugins initialised in %1ms")
+        .arg(s_timer.elapsed()));
+}
+
 static bool WasAutomaticStart(void)
 {
     bool autoStart = false;
@@ -1892,6 +1912,8 @@ int main(int argc, char **argv)
     if (retval != GENERIC_EXIT_OK)
         return retval;
 
+    MythStartupTasks startup("Frontend");
+
     bool ResetSettings = false;
 
     if (cmdline.toBool("prompt"))
@@ -1913,6 +1935,7 @@ int main(int argc, char **argv)
     }
 
     fe_sd_notify("STATUS=Connecting to database.");
+    startup.Phase("Database");
     gContext = new MythContext(MYTH_BINARY_VERSION, true);
     gCoreContext->SetAsFrontend(true);
 
@@ -1937,6 +1960,7 @@ int main(int argc, char **argv)
 
     if (!cmdline.toBool("noupnp"))
     {
+        startup.Phase("UPnP");
         fe_sd_notify("STATUS=Creating UPnP media renderer");
         g_pUPnp  = new MediaRenderer();
         if (!g_pUPnp->isInitialized())
@@ -1970,6 +1994,14 @@ int main(int argc, char **argv)
         return GENERIC_EXIT_OK;
     }
 
+    // Unless the schema is upgraded nothing changes the key bindings before
+    // they are registered, so they can be read while the UI is set up
+    bool prefetchKeys =
+        gCoreContext->GetSetting("DBSchemaVer") == MYTH_DATABASE_VERSION;
+    if (prefetchKeys)
+        startup.Start("Key bindings", MythMainWindow::PrefetchKeyBindings);
+    startup.Start("In-use cleanup", CleanupMyOldInUsePrograms);
+
     qApp->setSetuidAllowed(true);
 
     if (revokeRoot() != 0)
@@ -1995,14 +2027,17 @@ int main(int argc, char **argv)
 #endif
 
     fe_sd_notify("STATUS=Initializing LCD");
+    startup.Phase("LCD");
     LCD::SetupLCD();
     if (LCD *lcd = LCD::Get())
         lcd->setupLEDs(RemoteGetRecordingMask);
 
     fe_sd_notify("STATUS=Loading translation");
+    startup.Phase("Translation");
     MythTranslation::load("mythfrontend");
 
     fe_sd_notify("STATUS=Loading themes");
+    startup.Phase("Theme");
     QString themename = gCoreContext->GetSetting("Theme", DEFAULT_UI_THEME);
 
     QString themedir = GetMythUI()->FindThemeDir(themename);
@@ -2024,6 +2059,9 @@ int main(int argc, char **argv)
         return GENERIC_EXIT_NO_THEME;
     }
 
+    // The main window registers the global keys as it is created
+    startup.Phase("Main window");
+    startup.Wait("Key bindings");
     MythMainWindow *mainWindow = GetMythMainWindow();
     mainWindow->Init(false);
     mainWindow->setWindowTitle(qApp->translate("(MythFrontendMain)",
@@ -2051,6 +2089,7 @@ int main(int argc, char **argv)
             return GENERIC_EXIT_NO_THEME;
     }
 
+    startup.Phase("Schema");
     if (!UpgradeTVDatabaseSchema(false, false, true))
     {
         LOG(VB_GENERAL, LOG_ERR,
@@ -2060,6 +2099,10 @@ int main(int argc, char **argv)
 
     WriteDefaults();
 
+    startup.Phase("Keys");
+    if (!prefetchKeys)
+        MythMainWindow::PrefetchKeyBindings();
+
     // Refresh Global/Main Menu keys after DB update in case there was no DB
     // when they were written originally
     mainWindow->ReloadKeys();
@@ -2070,17 +2113,25 @@ int main(int argc, char **argv)
     TV::InitKeys();
     SetFuncPtrs();
 
-    internal_media_init();
+    // Plugins may change their key bindings when they upgrade their schema
+    MythMainWindow::ClearPrefetchedKeyBindings();
 
-    CleanupMyOldInUsePrograms();
+    internal_media_init();
 
     setHttpProxy();
 
+    // The plugins are initialised once the main menu is showing, or when
+    // they are first used. Loading their libraries can start now.
     fe_sd_notify("STATUS=Initializing plugins");
-    g_pmanager = new MythPluginManager();
+    startup.Phase("Plugins");
+    g_pmanager = new MythPluginManager(true);
     gCoreContext->SetPluginManager(g_pmanager);
+    QStringList deferredPlugins = g_pmanager->GetDeferredPlugins();
+    startup.Start("Plugin libraries", [deferredPlugins]()
+        { MythPluginManager::PreloadLibraries(deferredPlugins); });
 
     fe_sd_notify("STATUS=Initializing media monitor");
+    startup.Phase("Media monitor");
     MediaMonitor *mon = MediaMonitor::GetMediaMonitor();
     if (mon)
     {
@@ -2089,6 +2140,7 @@ int main(int argc, char **argv)
     }
 
     fe_sd_notify("STATUS=Initializing network control");
+    startup.Phase("Network control");
     NetworkControl *networkControl = nullptr;
     if (gCoreContext->GetBoolSetting("NetworkControlEnabled", false))
     {
@@ -2109,11 +2161,13 @@ int main(int argc, char **argv)
     GetMythMainWindow()->SetEffectsEnabled(true);
     gLoaded = true;
 #endif
+    startup.Phase("Main menu");
     if (!RunMenu(themedir, themename) && !resetTheme(themedir, themename))
     {
         return GENERIC_EXIT_NO_THEME;
     }
     fe_sd_notify("STATUS=Loading theme updates");
+    startup.Phase("Services");
     ThemeUpdateChecker *themeUpdateChecker = nullptr;
     if (gCoreContext->GetBoolSetting("ThemeUpdateNofications", true))
         themeUpdateChecker = new ThemeUpdateChecker();
@@ -2134,6 +2188,16 @@ int main(int argc, char **argv)
 #endif
     housekeeping->Start();
 
+    if (cmdline.toBool("runplugin") || cmdline.toBool("jumppoint"))
+    {
+        // Plugins register their jump points as they are initialised
+        while (g_pmanager->InitDeferred()) {}
+    }
+    else
+    {
+        QTimer::singleShot(0, InitDeferredPlugins);
+    }
+
 
     if (cmdline.toBool("runplugin"))
     {
@@ -2180,6 +2244,8 @@ int main(int argc, char **argv)
         standbyScreen();
     }
 
+    startup.Report();
+
     // Provide systemd ready notification (for type=notify units)
     fe_sd_notify("STATUS=");
     fe_sd_notify("READY=1");
@@ -116,12 +116,6 @@ bool ProgLister::Create()
     connect(m_progList, SIGNAL(itemSelected(MythUIButtonListItem*)),
             this,       SLOT(  HandleSelected(  MythUIButtonListItem*)));
 
-    connect(m_progList, SIGNAL(itemVisible(MythUIButtonListItem*)),
-            this,       SLOT(  HandleVisible(  MythUIButtonListItem*)));
-
-    connect(m_progList, SIGNAL(itemLoaded(MythUIButtonListItem*)),
-            this,       SLOT(  HandleVisible(  MythUIButtonListItem*)));
-
     if (m_type == plPreviouslyRecorded)
     {
         connect(m_progList, SIGNAL(itemClicked(MythUIButtonListItem*)),
@@ -1506,44 +1500,57 @@ void ProgLister::RestoreSelection(const ProgramInfo *selected,
     m_progList->SetItemCurrent(i + 1, i + 1 - selectedOffset);
 }
 
-void ProgLister::HandleVisible(MythUIButtonListItem *item)
+/** \fn ProgLister::FillItem(MythUIButtonListItem*,int)
+ *  \brief Fills in the list item for the program at \p pos.
+ *
+ *   The list only asks for the items it shows, so long search results
+ *   no longer need a button list item per program up front.
+ */
+void ProgLister::FillItem(MythUIButtonListItem *item, int pos)
 {
-    auto *pginfo = item->GetData().value<ProgramInfo*>();
+    if (pos < 0 || pos >= static_cast<int>(m_itemList.size()))
+        return;
 
-    if (item->GetText("is_item_initialized").isNull())
-    {
-        InfoMap infoMap;
-        pginfo->ToMap(infoMap);
+    ProgramInfo *pginfo = m_itemList[pos];
+    item->SetData(QVariant::fromValue(pginfo));
 
-        QString state = RecStatus::toUIState(pginfo->GetRecordingStatus());
-        if ((state == "warning") && (plPreviouslyRecorded == m_type))
-            state = "disabled";
+    InfoMap infoMap;
+    pginfo->ToMap(infoMap);
 
-        item->SetTextFromMap(infoMap, state);
+    QString state = RecStatus::toUIState(pginfo->GetRecordingStatus());
+    if ((state == "warning") && (plPreviouslyRecorded == m_type))
+        state = "disabled";
 
-        if (m_type == plTitle)
-        {
-            QString tempSubTitle = pginfo->GetSubtitle();
-            if (tempSubTitle.trimmed().isEmpty())
-                tempSubTitle = pginfo->GetTitle();
-            item->SetText(tempSubTitle, "titlesubtitle", state);
-        }
+    item->SetTextFromMap(infoMap, state);
 
-        item->DisplayState(QString::number(pginfo->GetStars(10)),
-                           "ratingstate");
+    if (m_type == plTitle)
+    {
+        QString tempSubTitle = pginfo->GetSubtitle();
+        if (tempSubTitle.trimmed().isEmpty())
+            tempSubTitle = pginfo->GetTitle();
+        item->SetText(tempSubTitle, "titlesubtitle", state);
+    }
 
-        item->DisplayState(state, "status");
+    item->DisplayState(QString::number(pginfo->GetStars(10)),
+                       "ratingstate");
 
-        // Mark this button list item as initialized.
-        item->SetText("yes", "is_item_initialized");
+    item->DisplayState(state, "status");
+}
+
+int ProgLister::GetItemPos(const QVariant &data) const
+{
+    auto *pginfo = data.value<ProgramInfo*>();
+    for (size_t i = 0; i < m_itemList.size(); ++i)
+    {
+        if (m_itemList[i] == pginfo)
+            return static_cast<int>(i);
     }
+    return -1;
 }
 
 void ProgLister::UpdateButtonList(void)
 {
-    for (auto it : m_itemList)
-        new MythUIButtonListItem(m_progList, "", QVariant::fromValue(it));
-    m_progList->LoadInBackground();
+    m_progList->SetProvider(this);
 
     if (m_positionText)
     {
@@ -6,6 +6,7 @@
 #include <QString>
 
 // MythTV headers
+#include "mythuibuttonlist.h"
 #include "programinfo.h" // for ProgramList
 #include "schedulecommon.h"
 #include "proglist_helpers.h"
@@ -28,7 +29,7 @@ enum ProgListType {
     plPreviouslyRecorded
 };
 
-class ProgLister : public ScheduleCommon
+class ProgLister : public ScheduleCommon, public MythUIButtonListProvider
 {
     friend class PhrasePopup;
     friend class TimePopup;
@@ -49,9 +50,13 @@ class ProgLister : public ScheduleCommon
     bool keyPressEvent(QKeyEvent *event) override; // MythScreenType
     void customEvent(QEvent *event) override; // ScheduleCommon
 
+    int  GetItemCount(void) const override // MythUIButtonListProvider
+        { return static_cast<int>(m_itemList.size()); }
+    void FillItem(MythUIButtonListItem *item, int pos) override; // MythUIButtonListProvider
+    int  GetItemPos(const QVariant &data) const override; // MythUIButtonListProvider
+
   protected slots:
     void HandleSelected(MythUIButtonListItem *item);
-    void HandleVisible(MythUIButtonListItem *item);
 
     void DeleteOldEpisode(bool ok);
     void DeleteOldSeries(bool ok);
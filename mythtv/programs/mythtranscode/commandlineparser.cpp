@@ -36,6 +36,16 @@ void MythTranscodeCommandLineParser::LoadArguments(void)
     add(QStringList{"-m", "--mpeg2"}, "mpeg2", false,
             "Specifies that a lossless transcode should be used.", "")
         ->SetGroup("Encoding");
+    add("--remux", "remux", false,
+            "Specifies that a lossless transcode copying packets "
+            "should be used.",
+            "Applies the cutlist by copying packets between keyframes "
+            "without decoding them.  The output is always an MPEG-TS "
+            "file, so the video must be a codec MPEG-TS can carry.  "
+            "Lossless transcode profiles only remux H.264 and HEVC "
+            "recordings automatically, MPEG-2 uses its own lossless "
+            "transcoder.")
+        ->SetGroup("Encoding");
     add(QStringList{"-e", "--ostream"}, "ostream", "",
             "Output stream type: ps, dvd, ts (Default: ps)", "")
         ->SetGroup("Encoding");
@@ -113,6 +123,11 @@ void MythTranscodeCommandLineParser::LoadArguments(void)
         ->SetChildOf("hls");
     add("--hlsstreamid", "hlsstreamid", -1, "Stream ID to process", "")
         ->SetChildOf("hls");
+    add("--hlssegments", "hlssegments", "", "Range of segments to process",
+            "Only write segments <first>-<last> of the stream, for use when "
+            "a stream is transcoded by several processes in parallel.  "
+            "Leave <last> empty or 0 to continue to the end of the file.")
+        ->SetChildOf("hls");
     add(QStringList{"-d", "--delete"}, "delete", false,
             "Delete original after successful transcoding", "")
         ->SetGroup("Encoding");
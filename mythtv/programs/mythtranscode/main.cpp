@@ -21,6 +21,7 @@ using namespace std;
 #include "mythdate.h"
 #include "transcode.h"
 #include "mpeg2fix.h"
+#include "remuxer.h"
 #include "remotefile.h"
 #include "mythtranslation.h"
 #include "loggingserver.h"
@@ -158,6 +159,7 @@ int main(int argc, char *argv[])
     bool build_index = false;
     bool fifosync = false;
     bool mpeg2 = false;
+    bool remux = false;
     bool fifo_info = false;
     bool cleanCut = false;
     QMap<QString, QString> settingsOverride;
@@ -349,6 +351,8 @@ int main(int argc, char *argv[])
         recorderOptions = cmdline.toString("recopt");
     if (cmdline.toBool("mpeg2"))
         mpeg2 = true;
+    if (cmdline.toBool("remux"))
+        remux = true;
     if (cmdline.toBool("ostream"))
     {
         if (cmdline.toString("ostream") == "dvd")
@@ -591,6 +595,22 @@ int main(int argc, char *argv[])
             transcode->SetHLSMaxSegments(cmdline.toInt("maxsegments"));
         if (cmdline.toBool("noaudioonly"))
             transcode->DisableAudioOnlyHLS();
+        if (cmdline.toBool("hlssegments"))
+        {
+            QStringList range = cmdline.toString("hlssegments").split("-");
+            int first = range[0].toInt();
+            int last = (range.size() > 1) ? range[1].toInt() : 0;
+            if ((first < 1) || ((last != 0) && (last < first)))
+            {
+                LOG(VB_GENERAL, LOG_ERR,
+                    QString("Invalid segment range '%1'")
+                        .arg(cmdline.toString("hlssegments")));
+                delete transcode;
+                delete pginfo;
+                return GENERIC_EXIT_INVALID_CMDLINE;
+            }
+            transcode->SetHLSSegmentRange(first, last);
+        }
     }
 
     if (cmdline.toBool("avf") || cmdline.toBool("hls"))
@@ -610,7 +630,7 @@ int main(int argc, char *argv[])
     if (!recorderOptions.isEmpty())
         transcode->SetRecorderOptions(recorderOptions);
     int result = 0;
-    if ((!mpeg2 && !build_index) || cmdline.toBool("hls"))
+    if ((!mpeg2 && !remux && !build_index) || cmdline.toBool("hls"))
     {
         result = transcode->TranscodeFile(infile, outfile,
                                           profilename, useCutlist,
@@ -708,6 +728,42 @@ int main(int argc, char *argv[])
         delete m2f;
         m2f = nullptr;
     }
+    else if ((result == REENCODE_REMUX) || remux)
+    {
+        void (*update_func)(float) = nullptr;
+        int (*check_func)() = nullptr;
+        if (useCutlist)
+        {
+            LOG(VB_GENERAL, LOG_INFO, "Honoring the cutlist while remuxing");
+            if (deleteMap.isEmpty())
+                pginfo->QueryCutList(deleteMap);
+        }
+        if (jobID >= 0)
+        {
+           glbl_jobID = jobID;
+           update_func = &UpdateJobQueue;
+           check_func = &CheckJobQueue;
+        }
+
+        Remuxer remuxer(pginfo, infile, outfile, deleteMap,
+                        update_func, check_func);
+        result = remuxer.Start();
+        if (result == REENCODE_OK)
+        {
+            posMap = remuxer.GetPositionMap();
+            durMap = remuxer.GetDurationMap();
+            if (update_index)
+                UpdatePositionMap(posMap, durMap, nullptr, pginfo);
+            else
+                UpdatePositionMap(posMap, durMap, outfile + QString(".map"),
+                                  pginfo);
+
+            RecordingInfo recInfo(*pginfo);
+            RecordingFile *recFile = recInfo.GetRecordingFile();
+            recFile->m_containerFormat = formatMPEG2_TS;
+            recFile->Save();
+        }
+    }
 
     if (result == REENCODE_OK)
     {
@@ -0,0 +1,300 @@
+#include "remuxer.h"
+
+#include <cmath>
+#include <utility>
+
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QPair>
+#include <QStringList>
+
+#include "mythlogging.h"
+#include "mythcorecontext.h"
+#include "programinfo.h"
+#include "avformatwriter.h"
+#include "transcodedefs.h"
+
+extern "C" {
+#include "libavformat/avformat.h"
+}
+
+Remuxer::Remuxer(const ProgramInfo *pginfo, QString infile, QString outfile,
+                 const frm_dir_map_t &deleteMap,
+                 void (*update_func)(float), int (*check_abort)())
+  : m_pginfo(pginfo),
+    m_infile(std::move(infile)),
+    m_outfile(std::move(outfile)),
+    m_deleteMap(deleteMap),
+    m_updateStatus(update_func),
+    m_checkAbort(check_abort)
+{
+}
+
+/** \fn Remuxer::BuildSpans(double)
+ *  \brief Turn the cutlist into the list of spans to keep.
+ *
+ *   Both ends of every span are moved out to a keyframe, so no kept
+ *   frame loses its reference frames.  The keyframe times come from the
+ *   duration map, or from the position map and \p fps when there is no
+ *   duration map.  Without either the spans are not snapped and each cut
+ *   starts at the first keyframe after it.
+ */
+bool Remuxer::BuildSpans(double fps)
+{
+    frm_pos_map_t keyframes;
+    if (m_pginfo)
+    {
+        m_pginfo->QueryPositionMap(keyframes, MARK_DURATION_MS);
+        if (keyframes.isEmpty())
+        {
+            frm_pos_map_t posMap;
+            m_pginfo->QueryPositionMap(posMap, MARK_GOP_BYFRAME);
+            for (auto it = posMap.cbegin(); it != posMap.cend(); ++it)
+                keyframes[it.key()] = llround(it.key() * 1000.0 / fps);
+        }
+    }
+
+    if (keyframes.isEmpty())
+    {
+        LOG(VB_GENERAL, LOG_WARNING,
+            "Remux: No position map, cuts will not start on keyframes");
+    }
+
+    auto toMs = [&](long long frame, bool after)
+    {
+        auto it = keyframes.lowerBound(frame);
+        if (after && (it != keyframes.cend()))
+            return (int64_t)*it;
+        if (!after && (it != keyframes.cend()) && (it.key() == frame))
+            return (int64_t)*it;
+        if (!after && (it != keyframes.cbegin()))
+            return (int64_t)*(--it);
+        return (int64_t)llround(frame * 1000.0 / fps);
+    };
+
+    QVector<QPair<long long, long long> > keep;
+    long long start = 0;
+    bool inCut = false;
+    for (auto it = m_deleteMap.cbegin(); it != m_deleteMap.cend(); ++it)
+    {
+        if (*it == MARK_CUT_START && !inCut)
+        {
+            if ((long long)it.key() > start)
+                keep.push_back(qMakePair(start, (long long)it.key()));
+            inCut = true;
+        }
+        else if (*it == MARK_CUT_END && inCut)
+        {
+            start = it.key();
+            inCut = false;
+        }
+        else if (*it == MARK_CUT_END && (it == m_deleteMap.cbegin()))
+        {
+            // A cutlist starting with an end cuts from the beginning
+            start = it.key();
+        }
+    }
+    if (!inCut)
+        keep.push_back(qMakePair(start, -1LL));
+
+    m_spans.clear();
+    int64_t written = 0;
+    for (const auto &range : keep)
+    {
+        Span span {};
+        span.m_start = toMs(range.first, false);
+        span.m_end   = (range.second < 0) ? INT64_MAX : toMs(range.second, true);
+
+        // Snapping can make neighbouring spans meet or overlap
+        if (!m_spans.isEmpty() && (span.m_start <= m_spans.last().m_end))
+        {
+            written -= m_spans.last().m_end - m_spans.last().m_start;
+            m_spans.last().m_end = span.m_end;
+            written += m_spans.last().m_end - m_spans.last().m_start;
+            continue;
+        }
+
+        span.m_shift = span.m_start - written;
+        written += span.m_end - span.m_start;
+        m_spans.push_back(span);
+    }
+
+    QStringList spanStr;
+    for (const auto &span : m_spans)
+    {
+        spanStr << QString("%1-%2").arg(span.m_start)
+            .arg((span.m_end == INT64_MAX) ? QString("end") :
+                 QString::number(span.m_end));
+    }
+    LOG(VB_GENERAL, LOG_INFO,
+        QString("Remux: Keeping (ms) %1").arg(spanStr.join(",")));
+
+    return !m_spans.isEmpty();
+}
+
+int Remuxer::FindSpan(int64_t ms) const
+{
+    for (int i = 0; i < m_spans.size(); ++i)
+    {
+        if ((ms >= m_spans[i].m_start - m_tolerance) &&
+            (ms < m_spans[i].m_end - m_tolerance))
+            return i;
+    }
+    return -1;
+}
+
+/** \fn Remuxer::Start(void)
+ *  \brief Copy the kept spans of the input to the output file.
+ *
+ *   Video follows its keyframes: a keyframe decides whether the frames
+ *   up to the next keyframe are kept, so a GOP is never split.  Audio and
+ *   subtitle packets are kept by their own timestamps.
+ *
+ *   \return REENCODE_OK, REENCODE_STOPPED or REENCODE_ERROR
+ */
+int Remuxer::Start(void)
+{
+    QByteArray ifarray = m_infile.toLocal8Bit();
+    AVFormatContext *ic = nullptr;
+
+    LOG(VB_GENERAL, LOG_INFO, QString("Remux: Opening %1").arg(m_infile));
+
+    int ret = avformat_open_input(&ic, ifarray.constData(), nullptr, nullptr);
+    if (ret)
+    {
+        LOG(VB_GENERAL, LOG_ERR,
+            QString("Couldn't open input file, error #%1").arg(ret));
+        return REENCODE_ERROR;
+    }
+
+    ret = avformat_find_stream_info(ic, nullptr);
+    int videoIndex = (ret < 0) ? -1 :
+        av_find_best_stream(ic, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (videoIndex < 0)
+    {
+        LOG(VB_GENERAL, LOG_ERR, "Remux: No video stream found");
+        avformat_close_input(&ic);
+        return REENCODE_ERROR;
+    }
+
+    AVStream *videoStream = ic->streams[videoIndex];
+    double fps = av_q2d(videoStream->avg_frame_rate);
+    if (fps <= 0.0)
+        fps = av_q2d(videoStream->r_frame_rate);
+    if (fps <= 0.0)
+        fps = 29.97;
+    m_tolerance = (int64_t)(500.0 / fps);
+
+    if (!BuildSpans(fps))
+    {
+        LOG(VB_GENERAL, LOG_ERR, "Remux: The cutlist removes everything");
+        avformat_close_input(&ic);
+        return REENCODE_ERROR;
+    }
+
+    auto *avfw = new AVFormatWriter();
+    avfw->SetFilename(m_outfile);
+    avfw->SetContainer("mpegts");
+    if (!avfw->InitCopy(ic) || !avfw->OpenFile())
+    {
+        LOG(VB_GENERAL, LOG_ERR, "Remux: Unable to open output file");
+        delete avfw;
+        avformat_close_input(&ic);
+        return REENCODE_ERROR;
+    }
+
+    int64_t startTime = (ic->start_time == AV_NOPTS_VALUE) ? 0 :
+        av_rescale_q(ic->start_time, AV_TIME_BASE_Q, {1, 1000});
+    int64_t inputSize = QFileInfo(m_infile).size();
+    int videoSpan = -1;
+    long long videoFrames = 0;
+    double totalDuration = 0.0;
+    int result = REENCODE_OK;
+
+    QElapsedTimer statusTimer;
+    statusTimer.start();
+
+    AVPacket pkt;
+    av_init_packet(&pkt);
+
+    while (av_read_frame(ic, &pkt) >= 0)
+    {
+        AVStream *st = ic->streams[pkt.stream_index];
+        int64_t ts = (pkt.pts != AV_NOPTS_VALUE) ? pkt.pts : pkt.dts;
+        bool isVideo = (pkt.stream_index == videoIndex);
+        bool isKey = (pkt.flags & AV_PKT_FLAG_KEY) != 0;
+
+        int span = -1;
+        if (ts != AV_NOPTS_VALUE)
+        {
+            int64_t ms = av_rescale_q(ts, st->time_base, {1, 1000}) - startTime;
+            span = FindSpan(ms);
+        }
+        if (isVideo)
+        {
+            if (isKey && (ts != AV_NOPTS_VALUE))
+                videoSpan = span;
+            span = videoSpan;
+        }
+
+        if (span >= 0)
+        {
+            int64_t shift = av_rescale_q(m_spans[span].m_shift, {1, 1000},
+                                         st->time_base);
+            if (pkt.pts != AV_NOPTS_VALUE)
+                pkt.pts -= shift;
+            if (pkt.dts != AV_NOPTS_VALUE)
+                pkt.dts -= shift;
+
+            long long pos = avfw->GetFilePosition();
+            double duration = (pkt.duration > 0) ?
+                av_q2d(st->time_base) * pkt.duration * 1000 : 1000.0 / fps;
+
+            ret = avfw->WriteCopyPacket(&pkt, st->time_base);
+            if (ret < 0)
+            {
+                av_packet_unref(&pkt);
+                result = REENCODE_ERROR;
+                break;
+            }
+
+            if (isVideo && ret > 0)
+            {
+                if (isKey)
+                {
+                    m_posMap[videoFrames] = pos;
+                    m_durMap[videoFrames] = llround(totalDuration);
+                }
+                totalDuration += duration;
+                videoFrames++;
+            }
+        }
+
+        av_packet_unref(&pkt);
+
+        if (statusTimer.elapsed() > 1000)
+        {
+            statusTimer.restart();
+            if (m_checkAbort && m_checkAbort())
+            {
+                result = REENCODE_STOPPED;
+                break;
+            }
+            if (m_updateStatus && (inputSize > 0))
+                m_updateStatus(avio_tell(ic->pb) * 100.0F / inputSize);
+        }
+    }
+
+    avfw->CloseFile();
+    delete avfw;
+    avformat_close_input(&ic);
+
+    if (result == REENCODE_OK)
+    {
+        LOG(VB_GENERAL, LOG_INFO,
+            QString("Remux: Wrote %1 video frames, %2 seconds")
+                .arg(videoFrames).arg(llround(totalDuration / 1000)));
+    }
+
+    return result;
+}
@@ -0,0 +1,66 @@
+#ifndef REMUXER_H
+#define REMUXER_H
+
+#include <cstdint>
+
+#include <QString>
+#include <QVector>
+
+#include "programtypes.h"               // for frm_dir_map_t, frm_pos_map_t
+
+class ProgramInfo;
+struct AVFormatContext;
+
+/** \class Remuxer
+ *  \brief Applies a cutlist by copying packets, without decoding.
+ *
+ *   The recording is cut at keyframes taken from its position map and the
+ *   kept parts are written back to back through AVFormatWriter, with their
+ *   timestamps moved to close the gaps.  The output is always MPEG-TS,
+ *   so only codecs MPEG-TS can carry are remuxed.  Lossless transcode
+ *   profiles use it automatically for H.264 and HEVC recordings only,
+ *   MPEG-2 recordings still go through MPEG2fixup.
+ *
+ *   The seek table of the new file is collected while writing, and is
+ *   available from GetPositionMap() and GetDurationMap() afterwards.
+ */
+class Remuxer
+{
+  public:
+    Remuxer(const ProgramInfo *pginfo, QString infile, QString outfile,
+            const frm_dir_map_t &deleteMap,
+            void (*update_func)(float) = nullptr,
+            int (*check_abort)() = nullptr);
+
+    int Start(void);
+
+    const frm_pos_map_t &GetPositionMap(void) const { return m_posMap; }
+    const frm_pos_map_t &GetDurationMap(void) const { return m_durMap; }
+
+  private:
+    /// A part of the input to keep, in milliseconds from its start
+    struct Span
+    {
+        int64_t m_start;
+        int64_t m_end;
+        int64_t m_shift;    ///< how much earlier the span is in the output
+    };
+
+    bool BuildSpans(double fps);
+    int  FindSpan(int64_t ms) const;
+
+    const ProgramInfo *m_pginfo;
+    QString            m_infile;
+    QString            m_outfile;
+    frm_dir_map_t      m_deleteMap;
+    void             (*m_updateStatus)(float);
+    int              (*m_checkAbort)();
+
+    QVector<Span>      m_spans;
+    int64_t            m_tolerance {20};
+
+    frm_pos_map_t      m_posMap;    ///< keyframe positions of the output
+    frm_pos_map_t      m_durMap;    ///< keyframe times of the output
+};
+
+#endif // REMUXER_H
@@ -10,6 +10,7 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QtAlgorithms>
+#include <QFile>
 
 #include "mythconfig.h"
 
@@ -210,6 +211,18 @@ int Transcode::TranscodeFile(const QString &inputname,
     HTTPLiveStream *hls = nullptr;
     int hlsSegmentSize = 0;
     int hlsSegmentFrames = 0;
+    // A segment job writes only part of a stream transcoded in parallel,
+    // the job for the first segment also sets the stream up.
+    bool hlsSegmentJob = m_hlsMode && (m_hlsStreamID != -1) &&
+                         (m_hlsFirstSegment > 0);
+    bool hlsSetup = !hlsSegmentJob || (m_hlsFirstSegment == 1);
+    int64_t hlsEndFrame = 0;
+    bool hlsRangeDone = false;
+    // Segment jobs start segment n at frame n * hlsSegmentLength, so that
+    // every job splits the stream in the same places.
+    double hlsSegmentLength = 0.0;
+    uint16_t hlsBoundarySegment = 0;
+    int64_t hlsNextBoundary = 0;
 
 #if !CONFIG_LIBMP3LAME
     (void)profileName;
@@ -225,8 +238,11 @@ int Transcode::TranscodeFile(const QString &inputname,
         if (m_hlsStreamID != -1)
         {
             hls = new HTTPLiveStream(m_hlsStreamID);
-            hls->UpdateStatus(kHLSStatusStarting);
-            hls->UpdateStatusMessage("Transcoding Starting");
+            if (hlsSetup)
+            {
+                hls->UpdateStatus(kHLSStatusStarting);
+                hls->UpdateStatusMessage("Transcoding Starting");
+            }
             m_cmdWidth = hls->GetWidth();
             m_cmdHeight = hls->GetHeight();
             m_cmdBitrate = hls->GetBitrate();
@@ -489,11 +505,14 @@ int Transcode::TranscodeFile(const QString &inputname,
             avfw->SetContainer("mpegts");
             avfw->SetVideoCodec("libx264");
             avfw->SetAudioCodec("aac");
-            hls->UpdateStatus(kHLSStatusStarting);
-            hls->UpdateStatusMessage("Transcoding Starting");
-            hls->UpdateSizeInfo(newWidth, newHeight, video_width, video_height);
+            if (hlsSetup)
+            {
+                hls->UpdateStatus(kHLSStatusStarting);
+                hls->UpdateStatusMessage("Transcoding Starting");
+                hls->UpdateSizeInfo(newWidth, newHeight, video_width, video_height);
+            }
 
-            if (!hls->InitForWrite())
+            if (hlsSetup && !hls->InitForWrite())
             {
                 LOG(VB_GENERAL, LOG_ERR, "hls->InitForWrite() failed");
                 SetPlayerContext(nullptr);
@@ -527,7 +546,27 @@ int Transcode::TranscodeFile(const QString &inputname,
             if (avfw2)
                 avfw2->SetKeyFrameDist(30);
 
-            hls->AddSegment();
+            if (hlsSegmentJob)
+            {
+                hls->StartSegmentJob(m_hlsFirstSegment);
+
+                // Segments written by different jobs must share a time base
+                avfw->SetTimecodeOffset(0);
+                if (avfw2)
+                    avfw2->SetTimecodeOffset(0);
+
+                hlsSegmentLength = segmentSize * video_frame_rate;
+                hlsBoundarySegment = m_hlsFirstSegment - 1;
+                hlsNextBoundary =
+                    (int64_t)(hlsBoundarySegment * hlsSegmentLength);
+                if (m_hlsLastSegment)
+                {
+                    hlsEndFrame =
+                        (int64_t)(m_hlsLastSegment * hlsSegmentLength);
+                }
+            }
+            else
+                hls->AddSegment();
             avfw->SetFilename(hls->GetCurrentFilename());
             if (avfw2)
                 avfw2->SetFilename(hls->GetCurrentFilename(true));
@@ -642,6 +681,14 @@ int Transcode::TranscodeFile(const QString &inputname,
             return REENCODE_MPEG2TRANS;
         }
 
+        if ((encodingType == "H.264" || encodingType == "HEVC") &&
+            get_bool_option(m_recProfile, "transcodelossless"))
+        {
+            LOG(VB_GENERAL, LOG_NOTICE, "Switching to lossless remux.");
+            SetPlayerContext(nullptr);
+            return REENCODE_REMUX;
+        }
+
         // Recorder setup
         if (get_bool_option(m_recProfile, "transcodelossless"))
         {
@@ -1064,6 +1111,15 @@ int Transcode::TranscodeFile(const QString &inputname,
     else
         LOG(VB_GENERAL, LOG_INFO, "Transcoding Video and Audio");
 
+    if (hlsSegmentJob && (m_hlsFirstSegment > 1))
+    {
+        auto startFrame = (uint64_t)hlsNextBoundary;
+        LOG(VB_GENERAL, LOG_INFO,
+            QString("HLS: Writing segments %1-%2 starting at frame %3")
+                .arg(m_hlsFirstSegment).arg(m_hlsLastSegment).arg(startFrame));
+        GetPlayer()->TranscodeSeek(startFrame);
+    }
+
     auto *videoBuffer =
         new VideoDecodeBuffer(GetPlayer(), videoOutput, honorCutList);
     MThreadPool::globalInstance()->start(videoBuffer, "VideoDecodeBuffer");
@@ -1077,7 +1133,7 @@ int Transcode::TranscodeFile(const QString &inputname,
     bool stopSignalled = false;
     VideoFrame *lastDecode = nullptr;
 
-    if (hls)
+    if (hls && hlsSetup)
     {
         hls->UpdateStatus(kHLSStatusRunning);
         hls->UpdateStatusMessage("Transcoding");
@@ -1459,7 +1515,11 @@ int Transcode::TranscodeFile(const QString &inputname,
 
             if (m_avfMode)
             {
-                if (halfFramerate && !skippedLastFrame)
+                // Segment jobs drop the odd frames, so the frames dropped
+                // don't depend on where a job started.
+                bool skipFrame = hlsSegmentJob ?
+                    ((lastDecode->frameNumber % 2) != 0) : !skippedLastFrame;
+                if (halfFramerate && skipFrame)
                 {
                     skippedLastFrame = true;
                 }
@@ -1467,7 +1527,44 @@ int Transcode::TranscodeFile(const QString &inputname,
                 {
                     skippedLastFrame = false;
 
-                    if ((hls) &&
+                    if (hlsSegmentJob)
+                    {
+                        // Each segment starts with a keyframe at its fixed
+                        // first frame, the job for the next range forces
+                        // the same keyframe where this job stops.
+                        if (lastDecode->frameNumber >= hlsNextBoundary)
+                        {
+                            avfw->ForceKeyFrame();
+                            ++hlsBoundarySegment;
+                            hlsNextBoundary =
+                                (int64_t)(hlsBoundarySegment * hlsSegmentLength);
+                        }
+
+                        if (avfw->GetFramesWritten() &&
+                            avfw->NextFrameIsForcedKeyFrame())
+                        {
+                            uint16_t finished = hls->GetCurrentSegment();
+                            if (m_hlsLastSegment &&
+                                (finished >= m_hlsLastSegment))
+                            {
+                                // Every frame before the next range has
+                                // left the encoder, the rest is not ours.
+                                hlsRangeDone = true;
+                                stopSignalled = true;
+                            }
+                            else
+                            {
+                                hls->NextSegment();
+                                avfw->ReOpen(hls->GetCurrentFilename());
+
+                                if (avfw2)
+                                    avfw2->ReOpen(hls->GetCurrentFilename(true));
+
+                                hls->CompleteSegment(finished);
+                            }
+                        }
+                    }
+                    else if ((hls) &&
                         (avfw->GetFramesWritten()) &&
                         (hlsSegmentFrames > hlsSegmentSize) &&
                         (avfw->NextFrameIsKeyFrame()))
@@ -1481,9 +1578,13 @@ int Transcode::TranscodeFile(const QString &inputname,
                         hlsSegmentFrames = 0;
                     }
 
-                    if (avfw->WriteVideoFrame(rescale ? &frame : lastDecode) > 0)
+                    if (!hlsRangeDone &&
+                        avfw->WriteVideoFrame(rescale ? &frame : lastDecode) > 0)
                     {
-                        lastWrittenTime = frame.timecode + timecodeOffset;
+                        // Audio past the range belongs to the next job
+                        if (!hlsEndFrame ||
+                            (lastDecode->frameNumber < hlsEndFrame))
+                            lastWrittenTime = frame.timecode + timecodeOffset;
                         if (hls)
                             ++hlsSegmentFrames;
                     }
@@ -1570,7 +1671,7 @@ int Transcode::TranscodeFile(const QString &inputname,
                 total_frame_count = GetPlayer()->GetCurrentFrameCount();
                 int percentage = curFrameNum * 100 / total_frame_count;
 
-                if (hls)
+                if (hls && !hlsSegmentJob)
                     hls->UpdatePercentComplete(percentage);
 
                 if (jobID >= 0)
@@ -1630,7 +1731,22 @@ int Transcode::TranscodeFile(const QString &inputname,
     delete avfw;
     delete avfw2;
 
-    if (hls)
+    if (hls && hlsSegmentJob)
+    {
+        // The stream's status is kept by whoever started the jobs, a
+        // stopped job only has to drop its partial segment.
+        if (hlsRangeDone || !stopSignalled)
+        {
+            hls->CompleteSegment(hls->GetCurrentSegment());
+        }
+        else
+        {
+            QFile::remove(hls->GetCurrentFilename());
+            QFile::remove(hls->GetCurrentFilename(true));
+        }
+        delete hls;
+    }
+    else if (hls)
     {
         if (!stopSignalled)
         {
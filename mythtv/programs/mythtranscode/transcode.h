@@ -29,6 +29,8 @@ class Transcode : public QObject
     void SetHLSMode(void) { m_hlsMode = true; }
     void SetHLSStreamID(int streamid) { m_hlsStreamID = streamid; }
     void SetHLSMaxSegments(int segments) { m_hlsMaxSegments = segments; }
+    void SetHLSSegmentRange(int first, int last)
+        { m_hlsFirstSegment = first; m_hlsLastSegment = last; }
     void SetCMDContainer(const QString& container) { m_cmdContainer = container; }
     void SetCMDAudioCodec(const QString& codec) { m_cmdAudioCodec = codec; }
     void SetCMDVideoCodec(const QString& codec) { m_cmdVideoCodec = codec; }
@@ -64,6 +66,8 @@ class Transcode : public QObject
     int                  m_hlsStreamID         { -1 };
     bool                 m_hlsDisableAudioOnly { false };
     int                  m_hlsMaxSegments      { 0 };
+    int                  m_hlsFirstSegment     { 0 };
+    int                  m_hlsLastSegment      { 0 };
     QString              m_cmdContainer        { "mpegts" };
     QString              m_cmdAudioCodec       { "aac" };
     QString              m_cmdVideoCodec       { "libx264" };
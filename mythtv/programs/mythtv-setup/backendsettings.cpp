@@ -567,10 +567,13 @@ static GlobalTextEditSetting *startupCommand()
 
 static HostSpinBoxSetting *JobQueueMaxSimultaneousJobs()
 {
-    auto *gc = new HostSpinBoxSetting("JobQueueMaxSimultaneousJobs", 1, 10, 1);
+    auto *gc = new HostSpinBoxSetting("JobQueueMaxSimultaneousJobs", 0, 10, 1,
+                                      8, QObject::tr("Automatic"));
     gc->setLabel(QObject::tr("Maximum simultaneous jobs on this backend"));
     gc->setHelpText(QObject::tr("The Job Queue will be limited to running "
-                    "this many simultaneous jobs on this backend."));
+                    "this many simultaneous jobs on this backend. When set "
+                    "to Automatic, jobs are started based on the number "
+                    "of CPU cores and the current system load."));
     gc->setValue(1);
     return gc;
 };
@@ -579,12 +582,30 @@ static HostSpinBoxSetting *JobQueueCheckFrequency()
 {
     auto *gc = new HostSpinBoxSetting("JobQueueCheckFrequency", 5, 300, 5);
     gc->setLabel(QObject::tr("Job Queue check frequency (secs)"));
-    gc->setHelpText(QObject::tr("When looking for new jobs to process, the "
-                    "Job Queue will wait this many seconds between checks."));
+    gc->setHelpText(QObject::tr("New and finished jobs are picked up "
+                    "immediately. In addition the Job Queue will check "
+                    "for work this often, to catch scheduled jobs and "
+                    "missed notifications."));
     gc->setValue(60);
     return gc;
 };
 
+static HostComboBoxSetting *JobQueueMaxLoadPerCore()
+{
+    auto *gc = new HostComboBoxSetting("JobQueueMaxLoadPerCore");
+    gc->setLabel(QObject::tr("Maximum load per CPU core"));
+    gc->addSelection("0.5", "0.5");
+    gc->addSelection("0.75", "0.75");
+    gc->addSelection("1.0", "1.0", true);
+    gc->addSelection("1.5", "1.5");
+    gc->addSelection("2.0", "2.0");
+    gc->setHelpText(QObject::tr("When the maximum number of simultaneous "
+                    "jobs is set to Automatic, no new job is started while "
+                    "the one minute system load average is above this "
+                    "value times the number of CPU cores."));
+    return gc;
+};
+
 static HostComboBoxSetting *JobQueueCPU()
 {
     auto *gc = new HostComboBoxSetting("JobQueueCPU");
@@ -716,6 +737,28 @@ static HostCheckBoxSetting *JobAllowPreview()
     return gc;
 };
 
+static HostCheckBoxSetting *JobAllowTrickplay()
+{
+    auto *gc = new HostCheckBoxSetting("JobAllowTrickplay");
+    gc->setLabel(QObject::tr("Allow trickplay index jobs"));
+    gc->setValue(true);
+    gc->setHelpText(QObject::tr("If enabled, allow jobs of this type to "
+                                "run on this backend."));
+    return gc;
+};
+
+static GlobalSpinBoxSetting *TrickplayInterval()
+{
+    auto *gc = new GlobalSpinBoxSetting("TrickplayInterval", 0, 60, 1, 8,
+                                        QObject::tr("Disabled"));
+    gc->setLabel(QObject::tr("Trickplay thumbnail interval (secs)"));
+    gc->setValue(0);
+    gc->setHelpText(QObject::tr("If set, after a recording finishes a "
+                    "small thumbnail is saved this often through it, for "
+                    "previews while seeking during playback."));
+    return gc;
+};
+
 static GlobalTextEditSetting *JobQueueTranscodeCommand()
 {
     auto *gc = new GlobalTextEditSetting("JobQueueTranscodeCommand");
@@ -984,6 +1027,7 @@ BackendSettings::BackendSettings()
     auto* group5 = new GroupSetting();
     group5->setLabel(QObject::tr("Job Queue (Backend-Specific)"));
     group5->addChild(JobQueueMaxSimultaneousJobs());
+    group5->addChild(JobQueueMaxLoadPerCore());
     group5->addChild(JobQueueCheckFrequency());
     group5->addChild(JobQueueWindowStart());
     group5->addChild(JobQueueWindowEnd());
@@ -992,6 +1036,7 @@ BackendSettings::BackendSettings()
     group5->addChild(JobAllowCommFlag());
     group5->addChild(JobAllowTranscode());
     group5->addChild(JobAllowPreview());
+    group5->addChild(JobAllowTrickplay());
     group5->addChild(JobAllowUserJob(1));
     group5->addChild(JobAllowUserJob(2));
     group5->addChild(JobAllowUserJob(3));
@@ -1006,6 +1051,7 @@ BackendSettings::BackendSettings()
     group6->addChild(JobQueueTranscodeCommand());
     group6->addChild(AutoTranscodeBeforeAutoCommflag());
     group6->addChild(SaveTranscoding());
+    group6->addChild(TrickplayInterval());
     addChild(group6);
 
     auto* group7 = new GroupSetting();